@@ -93,6 +93,15 @@ class  TopicDataType {
          */
         RTPS_DllAPI inline const char* getName() const { return m_topicDataTypeName.c_str(); }
 
+        /**
+         * Tells whether the type is plain, i.e. its serialized representation, after the encapsulation header and
+         * using the native endianness, is exactly its memory layout, and it always occupies m_typeSize bytes
+         * including the 4 bytes of the encapsulation header. The sample itself is therefore m_typeSize - 4 bytes.
+         * Samples of plain types can be loaned directly from the payload of the history changes.
+         * @return True if the type is plain.
+         */
+        RTPS_DllAPI virtual bool is_plain() const { return false; }
+
         //! Maximum serialized size of the type in bytes.
         //! If the type has unbounded fields, and therefore cannot have a maximum size, use 0.
         uint32_t m_typeSize;
@@ -75,6 +75,39 @@ public:
             void* Data,
             rtps::WriteParams& wparams);
 
+    /**
+     * Loan a sample placed directly on the payload of a new change of the history, so it is sent without being
+     * serialized. Only allowed for plain types (see TopicDataType::is_plain).
+     * The loaned sample follows the 4 byte encapsulation header, so it has room for m_typeSize - 4 bytes and is
+     * aligned to 4 bytes. The loan must be given back with write_loaned or discard_loan.
+     * @return Pointer to the loaned sample, nullptr if the type is not plain or no change could be reserved.
+     */
+    void* loan_sample();
+
+    /**
+     * Write a sample previously obtained with loan_sample. The loan is given back even on failure.
+     * @param sample Pointer to the loaned sample.
+     * @return True if correct
+     */
+    bool write_loaned(void* sample);
+
+    /**
+     * Write with params a sample previously obtained with loan_sample. The loan is given back even on failure.
+     * @param sample Pointer to the loaned sample.
+     * @param wparams Extra write parameters.
+     * @return True if correct
+     */
+    bool write_loaned(
+            void* sample,
+            rtps::WriteParams& wparams);
+
+    /**
+     * Give back a sample previously obtained with loan_sample without writing it.
+     * @param sample Pointer to the loaned sample.
+     * @return True if the sample was loaned by this publisher.
+     */
+    bool discard_loan(void* sample);
+
     /**
      * Dispose of a previously written data.
      * @param Data Pointer to the data.
@@ -294,6 +294,8 @@ class RTPSParticipantAttributes
             setName("RTPSParticipant");
             sendSocketBufferSize = 0;
             listenSocketBufferSize = 0;
+            receiveWorkerThreads = 0;
+            sendQueueSize = 0;
             participantID = -1;
             useBuiltinTransports = true;
         }
@@ -307,6 +309,8 @@ class RTPSParticipantAttributes
                    (this->defaultMulticastLocatorList == b.defaultMulticastLocatorList) &&
                    (this->sendSocketBufferSize == b.sendSocketBufferSize) &&
                    (this->listenSocketBufferSize == b.listenSocketBufferSize) &&
+                   (this->receiveWorkerThreads == b.receiveWorkerThreads) &&
+                   (this->sendQueueSize == b.sendQueueSize) &&
                    (this->builtin == b.builtin) &&
                    (this->port == b.port) &&
                    (this->userData == b.userData) &&
@@ -340,6 +344,21 @@ class RTPSParticipantAttributes
          */
         uint32_t listenSocketBufferSize;
 
+        /*! Number of worker threads processing the messages of each listen resource. With a zero value messages are
+         * processed by the thread reading the socket. Otherwise the reading thread only queues the messages, and
+         * the messages coming from the same participant are always processed in order by the same worker.
+         * Default value: 0.
+         */
+        uint32_t receiveWorkerThreads;
+
+        /*! Maximum number of bytes waiting to be sent to each destination locator. With a zero value messages are
+         * sent by the thread generating them. Otherwise they are queued and sent by a participant thread, which
+         * sends the reliability control messages (HEARTBEAT, ACKNACK, GAP) before the queued DATA and DATA_FRAG
+         * messages of the same destination.
+         * Default value: 0.
+         */
+        uint32_t sendQueueSize;
+
         //! Optionally allow user defined GuidPrefix_t
         GuidPrefix_t prefix;
 
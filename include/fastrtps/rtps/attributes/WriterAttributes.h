@@ -54,14 +54,31 @@ struct WriterTimes
     Duration_t nackResponseDelay;
     //!This time allows the RTPSWriter to ignore nack messages too soon after the data as sent, default value 0s.
     Duration_t nackSupressionDuration;
+    /**
+     * Adapt the periodic HB to the readers with unacknowledged data, instead of using heartbeatPeriod: twice their
+     * HEARTBEAT to ACKNACK round-trip time, doubled for each HB they leave unanswered. Default value false.
+     */
+    bool adaptiveHeartbeat;
+    //! Lower bound of the adaptive HB period, default value 10ms.
+    Duration_t heartbeatPeriodMin;
+    //! Upper bound of the adaptive HB period, default value 3s.
+    Duration_t heartbeatPeriodMax;
+    /**
+     * Window during which the ACKNACKs of readers sharing a multicast locator are merged, so each repair is sent once
+     * through that locator. The response to ACKNACKs is delayed by at least this time. Default value 0s (disabled).
+     */
+    Duration_t nackAggregationWindow;
 
     WriterTimes()
+        : adaptiveHeartbeat(false)
     {
         //initialHeartbeatDelay.fraction = 50*1000*1000;
         initialHeartbeatDelay.nanosec = 12*1000*1000;
         heartbeatPeriod.seconds = 3;
         //nackResponseDelay.fraction = 20*1000*1000;
         nackResponseDelay.nanosec = 5*1000*1000;
+        heartbeatPeriodMin.nanosec = 10*1000*1000;
+        heartbeatPeriodMax.seconds = 3;
     }
 
     virtual ~WriterTimes() {}
@@ -71,7 +88,11 @@ struct WriterTimes
         return (this->initialHeartbeatDelay == b.initialHeartbeatDelay) &&
                (this->heartbeatPeriod == b.heartbeatPeriod) &&
                (this->nackResponseDelay == b.nackResponseDelay) &&
-               (this->nackSupressionDuration == b.nackSupressionDuration);
+               (this->nackSupressionDuration == b.nackSupressionDuration) &&
+               (this->adaptiveHeartbeat == b.adaptiveHeartbeat) &&
+               (this->heartbeatPeriodMin == b.heartbeatPeriodMin) &&
+               (this->heartbeatPeriodMax == b.heartbeatPeriodMax) &&
+               (this->nackAggregationWindow == b.nackAggregationWindow);
     }
 };
 
@@ -212,6 +212,16 @@ class PDP
      */
     virtual bool removeRemoteParticipant(GUID_t& partGUID);
 
+    /**
+     * Adds or removes the unicast locators of a remote participant to the peers receiving compressed messages,
+     * when it announced it can decompress the codec used by this participant.
+     * @param pdata Pointer to the RTPSParticipantProxyData object.
+     * @param added true when the participant is discovered or updated, false when it is removed.
+     */
+    void update_compression_peer(
+            const ParticipantProxyData* pdata,
+            bool added);
+
     //!Pointer to the builtin protocols object.
     BuiltinProtocols* mp_builtin;
     /**
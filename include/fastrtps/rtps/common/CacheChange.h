@@ -75,6 +75,8 @@ namespace eprosima
                 bool isRead;
                 //!Source TimeStamp (only used in Readers)
                 Time_t sourceTimestamp;
+                //!Time at which the change was received by the transport, zero if unknown (only used in Readers)
+                Time_t receptionTimestamp;
 
                 WriteParams write_params;
                 bool is_untyped_;
@@ -125,6 +127,7 @@ namespace eprosima
                     instanceHandle = ch_ptr->instanceHandle;
                     sequenceNumber = ch_ptr->sequenceNumber;
                     sourceTimestamp = ch_ptr->sourceTimestamp;
+                    receptionTimestamp = ch_ptr->receptionTimestamp;
                     write_params = ch_ptr->write_params;
 
                     bool ret = serializedPayload.copy(&ch_ptr->serializedPayload, (ch_ptr->is_untyped_ ? false : true));
@@ -144,6 +147,7 @@ namespace eprosima
                     instanceHandle = ch_ptr->instanceHandle;
                     sequenceNumber = ch_ptr->sequenceNumber;
                     sourceTimestamp = ch_ptr->sourceTimestamp;
+                    receptionTimestamp = ch_ptr->receptionTimestamp;
                     write_params = ch_ptr->write_params;
 
                     // Copy certain values from serializedPayload
@@ -236,6 +240,8 @@ namespace eprosima
                     : status_(UNSENT)
                     , is_relevant_(true)
                     , change_(nullptr)
+                    , fragment_count_(0)
+                    , unsent_fragments_tail_(0)
                 {
                 }
 
@@ -244,7 +250,9 @@ namespace eprosima
                     , is_relevant_(ch.is_relevant_)
                     , seq_num_(ch.seq_num_)
                     , change_(ch.change_)
+                    , fragment_count_(ch.fragment_count_)
                     , unsent_fragments_(ch.unsent_fragments_)
+                    , unsent_fragments_tail_(ch.unsent_fragments_tail_)
                 {
                 }
 
@@ -255,14 +263,9 @@ namespace eprosima
                     , is_relevant_(true)
                     , seq_num_(change->sequenceNumber)
                     , change_(change)
+                    , fragment_count_(change->getFragmentSize() != 0 ? change->getFragmentCount() : 0)
+                    , unsent_fragments_tail_(fragment_count_ != 0 ? 1 : 0) // Indexed on 1
                 {
-                    if (change->getFragmentSize() != 0)
-                    {
-                        for (uint32_t i = 1; i != change->getFragmentCount() + 1; i++)
-                        {
-                            unsent_fragments_.insert(i); // Indexed on 1
-                        }
-                    }
                 }
 
                 ChangeForReader_t(const SequenceNumber_t& seq_num)
@@ -270,6 +273,8 @@ namespace eprosima
                     , is_relevant_(true)
                     , seq_num_(seq_num)
                     , change_(nullptr)
+                    , fragment_count_(0)
+                    , unsent_fragments_tail_(0)
                 {
                 }
 
@@ -281,7 +286,9 @@ namespace eprosima
                     is_relevant_ = ch.is_relevant_;
                     seq_num_ = ch.seq_num_;
                     change_ = ch.change_;
+                    fragment_count_ = ch.fragment_count_;
                     unsent_fragments_ = ch.unsent_fragments_;
+                    unsent_fragments_tail_ = ch.unsent_fragments_tail_;
                     return *this;
                 }
 
@@ -334,16 +341,22 @@ namespace eprosima
                     return change_ != nullptr;
                 }
 
+                /**
+                 * Get the first unsent fragments, as many as fit on a FragmentNumberSet_t.
+                 * @return Set of unsent fragments.
+                 */
                 FragmentNumberSet_t getUnsentFragments() const
                 {
-                    FragmentNumberSet_t rv;
-                    auto min = unsent_fragments_.begin();
-                    if (min != unsent_fragments_.end())
+                    FragmentNumberSet_t rv(unsent_fragments_);
+                    if (unsent_fragments_tail_ != 0)
                     {
-                        rv.base(*min);
-                        for (FragmentNumber_t fn : unsent_fragments_)
+                        if (rv.empty())
+                        {
+                            rv.base(unsent_fragments_tail_);
+                        }
+
+                        for (FragmentNumber_t fn = unsent_fragments_tail_; fn <= fragment_count_ && rv.add(fn); ++fn)
                         {
-                            rv.add(fn);
                         }
                     }
 
@@ -352,30 +365,95 @@ namespace eprosima
 
                 void markAllFragmentsAsUnsent()
                 {
-                   if (change_ != nullptr && change_->getFragmentSize() != 0)
+                   if (change_ != nullptr && fragment_count_ != 0)
                    {
-                       for (uint32_t i = 1; i != change_->getFragmentCount() + 1; i++)
-                       {
-                           unsent_fragments_.insert(i); // Indexed on 1
-                       }
+                       unsent_fragments_.base(1);
+                       unsent_fragments_tail_ = 1; // Indexed on 1
                    }
                 }
 
                 void markFragmentsAsSent(const FragmentNumber_t& sentFragment)
                 {
-                    unsent_fragments_.erase(sentFragment);
+                    if (unsent_fragments_tail_ != 0 && sentFragment >= unsent_fragments_tail_)
+                    {
+                        if (sentFragment > unsent_fragments_tail_)
+                        {
+                            // Fragments between the tail and the sent one stay unsent. If they do not fit on the
+                            // set, the sent fragment is kept as unsent and will be sent again.
+                            FragmentNumberSet_t span(unsent_fragments_.empty() ?
+                                    unsent_fragments_tail_ : unsent_fragments_.base());
+                            if (!span.add(sentFragment - 1))
+                            {
+                                return;
+                            }
+
+                            for (FragmentNumber_t fn = unsent_fragments_tail_; fn < sentFragment; ++fn)
+                            {
+                                add_unsent_fragment(fn);
+                            }
+                        }
+
+                        unsent_fragments_tail_ = sentFragment < fragment_count_ ? sentFragment + 1 : 0;
+                    }
+                    else
+                    {
+                        unsent_fragments_.remove(sentFragment);
+                    }
                 }
 
                 void markFragmentsAsUnsent(const FragmentNumberSet_t& unsentFragments)
                 {
                     unsentFragments.for_each([this](FragmentNumber_t element)
                     {
-                        unsent_fragments_.insert(element);
+                        if (element == 0 || element > fragment_count_ ||
+                                (unsent_fragments_tail_ != 0 && element >= unsent_fragments_tail_))
+                        {
+                            return;
+                        }
+
+                        if (!add_unsent_fragment(element))
+                        {
+                            // Does not fit on the set. All the fragments from it are marked as unsent.
+                            FragmentNumberSet_t lower(unsent_fragments_.base());
+                            unsent_fragments_.for_each([&lower, element](FragmentNumber_t fn)
+                            {
+                                if (fn < element)
+                                {
+                                    lower.add(fn);
+                                }
+                            });
+                            unsent_fragments_ = lower;
+                            unsent_fragments_tail_ = element;
+                        }
                     });
                 }
 
                 private:
 
+                //! Adds a fragment to the set of unsent ones, moving the base of the set down if needed.
+                bool add_unsent_fragment(FragmentNumber_t fragment)
+                {
+                    if (unsent_fragments_.empty())
+                    {
+                        unsent_fragments_.base(fragment);
+                    }
+                    else if (fragment < unsent_fragments_.base())
+                    {
+                        FragmentNumberSet_t moved(fragment);
+                        if (!moved.add(unsent_fragments_.max()))
+                        {
+                            return false;
+                        }
+                        unsent_fragments_.for_each([&moved](FragmentNumber_t fn)
+                        {
+                            moved.add(fn);
+                        });
+                        unsent_fragments_ = moved;
+                    }
+
+                    return unsent_fragments_.add(fragment);
+                }
+
                 //!Status
                 ChangeForReaderStatus_t status_;
 
@@ -389,7 +467,14 @@ namespace eprosima
                 //const CacheChange_t* change_;
                 CacheChange_t* change_;
 
-                std::set<FragmentNumber_t> unsent_fragments_;
+                //! Number of fragments of the change. Zero when not fragmented.
+                uint32_t fragment_count_;
+
+                //! Unsent fragments before unsent_fragments_tail_.
+                FragmentNumberSet_t unsent_fragments_;
+
+                //! All fragments from this one to the last are unsent. Zero when there is no such run.
+                FragmentNumber_t unsent_fragments_tail_;
             };
 
             struct ChangeForReaderCmp
@@ -24,6 +24,7 @@
 
 #include <cstdint>
 #include <cstring>
+#include <functional>
 
 namespace eprosima{
 namespace fastrtps{
@@ -564,5 +565,44 @@ inline std::ostream& operator<<(std::ostream& output,const GUID_t& guid)
 }
 }
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+
+namespace std {
+
+//! Hash of an EntityId_t, so it can be used as key of unordered containers.
+template<>
+struct hash<eprosima::fastrtps::rtps::EntityId_t>
+{
+    size_t operator()(const eprosima::fastrtps::rtps::EntityId_t& id) const
+    {
+        uint32_t value;
+        memcpy(&value, id.value, sizeof(value));
+        return hash<uint32_t>()(value);
+    }
+};
+
+//! Hash of a GUID_t, so it can be used as key of unordered containers.
+template<>
+struct hash<eprosima::fastrtps::rtps::GUID_t>
+{
+    size_t operator()(const eprosima::fastrtps::rtps::GUID_t& guid) const
+    {
+        // FNV-1a
+        uint32_t value = 2166136261u;
+        for (eprosima::fastrtps::rtps::octet o : guid.guidPrefix.value)
+        {
+            value = (value ^ o) * 16777619u;
+        }
+        for (eprosima::fastrtps::rtps::octet o : guid.entityId.value)
+        {
+            value = (value ^ o) * 16777619u;
+        }
+        return static_cast<size_t>(value);
+    }
+};
+
+} // namespace std
+
+#endif
 
 #endif /* RTPS_GUID_H_ */
@@ -40,6 +40,7 @@ namespace rtps {
 #define LOCATOR_KIND_UDPv6 2
 #define LOCATOR_KIND_TCPv4 4
 #define LOCATOR_KIND_TCPv6 8
+#define LOCATOR_KIND_SHM 16
 
 //!@brief Class Locator_t, uniquely identifies a communication channel for a particular transport.
 //For example, an address+port combination in the case of UDP.
@@ -54,6 +55,7 @@ public:
         * LOCATOR_KIND_UDPv6
         * LOCATOR_KIND_TCPv4
         * LOCATOR_KIND_TCPv6
+        * LOCATOR_KIND_SHM
         */
     int32_t kind;
     uint32_t port;
@@ -134,7 +136,8 @@ public:
 
 inline bool IsAddressDefined(const Locator_t& loc)
 {
-    if (loc.kind == LOCATOR_KIND_UDPv4 || loc.kind == LOCATOR_KIND_TCPv4) // WAN addr in TCPv4 is optional, isn't?
+    if (loc.kind == LOCATOR_KIND_UDPv4 || loc.kind == LOCATOR_KIND_TCPv4 ||
+            loc.kind == LOCATOR_KIND_SHM) // WAN addr in TCPv4 is optional, isn't?
     {
         for (uint8_t i = 12; i < 16; ++i)
         {
@@ -197,6 +200,15 @@ inline std::ostream& operator<<(std::ostream& output, const Locator_t& loc)
         }
         output << ":" << loc.port;
     }
+    else if (loc.kind == LOCATOR_KIND_SHM)
+    {
+        output << "SHM:" << std::hex << std::setfill('0');
+        for (uint8_t i = 12; i < 16; ++i)
+        {
+            output << std::setw(2) << (int)loc.address[i];
+        }
+        output << std::dec << std::setfill(' ') << ":" << loc.port;
+    }
     return output;
 }
 
@@ -325,9 +337,9 @@ public:
         }
     }
 
-    RTPS_DllAPI bool contains(const Locator_t& loc)
+    RTPS_DllAPI bool contains(const Locator_t& loc) const
     {
-        for (LocatorListIterator it = this->begin(); it != this->end(); ++it)
+        for (LocatorListConstIterator it = this->begin(); it != this->end(); ++it)
         {
             if (IsAddressDefined(*it))
             {
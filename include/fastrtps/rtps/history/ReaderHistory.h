@@ -76,7 +76,8 @@ public:
      * */
     RTPS_DllAPI bool remove_changes_with_guid(const GUID_t& a_guid);
     /**
-     * Sort the CacheChange_t from the History by timestamp
+     * Sort the CacheChange_t from the History by timestamp, writer GUID and sequence number.
+     * The history keeps this order when changes are added, so it is only needed after modifying the changes.
      */
     RTPS_DllAPI void sortCacheChanges();
     /**
@@ -93,6 +94,15 @@ public:
     RTPS_DllAPI bool get_min_change_from(CacheChange_t** min_change, const GUID_t& writerGuid);
 
 protected:
+    /**
+     * Remove a CacheChange_t from the ReaderHistory.
+     * @param a_change Pointer to the CacheChange to remove.
+     * @param release_cache Whether the change is given back to the pool. When false, the caller must give it back
+     * later with release_Cache.
+     * @return True if removed.
+     */
+    bool remove_change(CacheChange_t* a_change, bool release_cache);
+
     //!Pointer to the reader
     RTPSReader* mp_reader;
     //!Pointer to the semaphore, used to halt execution until new message arrives.
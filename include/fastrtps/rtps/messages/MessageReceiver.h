@@ -26,6 +26,11 @@
 #include <fastrtps/rtps/writer/StatelessWriter.h>
 #include <fastrtps/rtps/writer/StatefulWriter.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <unordered_map>
+
 
 namespace eprosima {
 namespace fastrtps{
@@ -60,10 +65,12 @@ class MessageReceiver
 
         /**
          * Process a new CDR message.
+         * It should not be called concurrently on the same MessageReceiver.
          * @param[in] loc Locator indicating the sending address.
          * @param[in] msg Pointer to the message
+         * @param[in] reception_timestamp Time at which the message was received, or zero if unknown.
          */
-        void processCDRMsg(const Locator_t& loc, CDRMessage_t*msg);
+        void processCDRMsg(const Locator_t& loc, CDRMessage_t*msg, const Time_t& reception_timestamp = c_TimeZero);
 
         //!Pointer to the Listen Resource that contains this MessageReceiver.
 
@@ -72,13 +79,42 @@ class MessageReceiver
         CDRMessage_t m_crypto_msg;
 #endif
         // Functions to associate/remove associatedendpoints
+        // removeEndpoint waits until the message being processed, if any, no longer uses the endpoint.
         void associateEndpoint(Endpoint *to_add);
         void removeEndpoint(Endpoint *to_remove);
 
     private:
-        std::vector<RTPSWriter *> AssociatedWriters;
-        std::vector<RTPSReader *> AssociatedReaders;
+        //!Endpoints associated to this receiver. Never modified once published.
+        struct AssociatedEndpoints
+        {
+            std::vector<RTPSWriter *> writers;
+            std::vector<RTPSReader *> readers;
+            //!Associated writers indexed by their entity id.
+            std::unordered_map<EntityId_t, RTPSWriter*> writers_by_id;
+            //!Associated readers indexed by their entity id.
+            std::unordered_map<EntityId_t, RTPSReader*> readers_by_id;
+            //!Associated readers accepting messages directed to ENTITYID_UNKNOWN.
+            std::vector<RTPSReader*> unknown_id_readers;
+        };
+
+        //!Latest snapshot of the associated endpoints. Accessed with std::atomic_load / std::atomic_store.
+        std::shared_ptr<const AssociatedEndpoints> endpoints_;
+        //!Serializes the publication of new snapshots.
         std::mutex mtx;
+        //!Snapshot used by the message being processed.
+        std::shared_ptr<const AssociatedEndpoints> current_endpoints_;
+        //!Increased when a message starts and when it finishes being processed, so it is odd meanwhile.
+        std::atomic<uint32_t> processing_count_;
+        //!Number of threads blocked in wait_message_processed.
+        std::atomic<uint32_t> processing_waiters_;
+        //!Protects processed_cond_.
+        std::mutex processed_mtx_;
+        //!Notified when a message finishes being processed while someone waits for it.
+        std::condition_variable processed_cond_;
+        //!Readers of unknown_id_readers that may accept the messages of each writer. Filled on demand.
+        std::unordered_map<GUID_t, std::vector<RTPSReader*>> readers_by_writer_;
+        //!Participant reader matching epoch when readers_by_writer_ was last cleared.
+        uint32_t readers_by_writer_epoch_;
         //!Protocol version of the message
         ProtocolVersion_t sourceVersion;
         //!VendorID that created the message
@@ -91,6 +127,8 @@ class MessageReceiver
         bool haveTimestamp;
         //!Timestamp associated with the message
         Time_t timestamp;
+        //!Time at which the message was received
+        Time_t reception_timestamp_;
         //!Version of the protocol used by the receiving end.
         ProtocolVersion_t destVersion;
 
@@ -140,6 +178,31 @@ class MessageReceiver
         bool proc_Submsg_HeartbeatFrag(CDRMessage_t*msg, SubmessageHeader_t* smh);
         bool proc_Submsg_SecureMessage(CDRMessage_t*msg, SubmessageHeader_t* smh);
         bool proc_Submsg_SecureSubMessage(CDRMessage_t*msg, SubmessageHeader_t* smh);
+        ///@}
+
+        //! Waits until the message being processed, if any, has finished.
+        void wait_message_processed();
+
+        //! Takes the latest snapshot of the associated endpoints to process a new message.
+        void update_current_endpoints();
+
+        /**
+         * Calls a functor for every associated reader a submessage should be given to.
+         * Should only be called while processing a message.
+         * @param reader_id Reader entity id of the submessage.
+         * @param writer_guid GUID of the writer that sent the submessage.
+         * @param callback Functor receiving a RTPSReader*.
+         */
+        template<typename Functor>
+        void find_all_readers(const EntityId_t& reader_id, const GUID_t& writer_guid, const Functor& callback);
+
+        /**
+         * Returns the readers accepting messages directed to ENTITYID_UNKNOWN that may accept messages
+         * from a writer. Should only be called while processing a message.
+         * @param writer_guid GUID of the writer.
+         * @return Cached list of readers.
+         */
+        const std::vector<RTPSReader*>& readers_for_writer(const GUID_t& writer_guid);
 
         RTPSParticipantImpl* participant_;
 };
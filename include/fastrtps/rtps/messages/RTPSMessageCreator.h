@@ -110,14 +110,21 @@ class RTPSMessageCreator
 
         static bool addMessageData(CDRMessage_t* msg, GuidPrefix_t& guidprefix, const CacheChange_t* change,
                 TopicKind_t topicKind, const EntityId_t& readerId, bool expectsInlineQos, InlineQosWriter* inlineQos);
+        /**
+         * @param[out] payload_position When not null, the serialized payload is not copied into msg. The submessage
+         * is built as if it were there and the position where it goes is returned, so it can be sent from where
+         * it is stored.
+         */
         static bool addSubmessageData(CDRMessage_t* msg, const CacheChange_t* change,
-                TopicKind_t topicKind, const EntityId_t& readerId, bool expectsInlineQos, InlineQosWriter* inlineQos);
+                TopicKind_t topicKind, const EntityId_t& readerId, bool expectsInlineQos, InlineQosWriter* inlineQos,
+                uint32_t* payload_position = nullptr);
 
         static bool addMessageDataFrag(CDRMessage_t* msg, GuidPrefix_t& guidprefix, const CacheChange_t* change, uint32_t fragment_number,
                 TopicKind_t topicKind, const EntityId_t& readerId, bool expectsInlineQos, InlineQosWriter* inlineQos);
+        //! @param[out] payload_position Same as in addSubmessageData.
         static bool addSubmessageDataFrag(CDRMessage_t* msg, const CacheChange_t* change, uint32_t fragment_number,
                 uint32_t sample_size, TopicKind_t topicKind, const EntityId_t& readerId, bool expectsInlineQos,
-                InlineQosWriter* inlineQos);
+                InlineQosWriter* inlineQos, uint32_t* payload_position = nullptr);
 
         static bool addMessageGap(CDRMessage_t* msg, const GuidPrefix_t& guidprefix, const GuidPrefix_t& remoteGuidPrefix,
                 const SequenceNumber_t& seqNumFirst, const SequenceNumberSet_t& seqNumList,const EntityId_t& readerId,const EntityId_t& writerId);
@@ -22,6 +22,7 @@
 #ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
 
 #include "../messages/RTPSMessageCreator.h"
+#include "../network/SenderResource.h"
 #include "../../qos/ParameterList.h"
 #include <fastrtps/rtps/common/FragmentNumber.h>
 
@@ -44,6 +45,18 @@ class RTPSMessageGroup_t
 {
     public:
 
+        //! Payloads of a message that can be sent from where they are stored. Further ones are copied.
+        static const size_t max_gathered_payloads = 8;
+
+        //! Payload sent from where it is stored instead of being copied into rtpsmsg_fullmsg_.
+        struct GatheredPayload
+        {
+            //! Position in rtpsmsg_fullmsg_ where the payload goes.
+            uint32_t position;
+            const octet* data;
+            uint32_t size;
+        };
+
         RTPSMessageGroup_t(uint32_t payload, GuidPrefix_t participant_guid):
             rtpsmsg_submessage_(payload),
             rtpsmsg_fullmsg_(payload)
@@ -53,6 +66,8 @@ class RTPSMessageGroup_t
         {
             CDRMessage::initCDRMsg(&rtpsmsg_fullmsg_);
             RTPSMessageCreator::addHeader(&rtpsmsg_fullmsg_, participant_guid);
+            gathered_payloads_.reserve(max_gathered_payloads);
+            buffers_.reserve(2 * max_gathered_payloads + 1);
         }
 
         CDRMessage_t rtpsmsg_submessage_;
@@ -62,6 +77,14 @@ class RTPSMessageGroup_t
 #if HAVE_SECURITY
         CDRMessage_t rtpsmsg_encrypt_;
 #endif
+
+        std::vector<GatheredPayload> gathered_payloads_;
+
+        //! Slices the message is sent as when it has gathered payloads.
+        std::vector<NetworkBuffer> buffers_;
+
+        //! Destination locators of the message being built, when they are not fixed.
+        LocatorList_t current_locators_;
 };
 
 class RTPSWriter;
@@ -181,13 +204,13 @@ class RTPSWriter;
 
         /**
          * Adds a GAP message to the group.
-         * @param changesSeqNum Set of missed sequence numbers.
+         * @param changesSeqNum Missed sequence numbers, in increasing order and without repetitions.
          * @param remote_readers List of destination GUIDs.
          * @param locators List of destination locators.
          * @return True when message was added to the group.
          */
         bool add_gap(
-                std::set<SequenceNumber_t>& changesSeqNum,
+                const std::vector<SequenceNumber_t>& changesSeqNum,
                 const std::vector<GUID_t>& remote_readers,
                 const LocatorList_t& locators);
 
@@ -223,7 +246,7 @@ class RTPSWriter;
                 int32_t count,
                 const LocatorList_t locators);
 
-        uint32_t get_current_bytes_processed() { return currentBytesSent_ + full_msg_->length; }
+        uint32_t get_current_bytes_processed() { return currentBytesSent_ + full_msg_->length + gathered_bytes_; }
 
     private:
 
@@ -242,7 +265,23 @@ class RTPSWriter;
         void check_and_maybe_flush(const LocatorList_t& locator_list,
                 const std::vector<GUID_t>& remote_endpoints);
 
-        bool insert_submessage(const std::vector<GUID_t>& remote_endpoints);
+        //! Adds a single GAP submessage.
+        bool add_gap(const SequenceNumber_t& gap_start, const SequenceNumberSet_t& gap_list,
+                const std::vector<GUID_t>& remote_readers, const LocatorList_t& locators);
+
+        /**
+         * Appends the submessage to the message, flushing it first if there is no room.
+         * @param remote_endpoints Destination GUIDs.
+         * @param payload Payload left out of the submessage to be sent from where it is, or nullptr.
+         * @param payload_position Position in the submessage where payload goes.
+         */
+        bool insert_submessage(const std::vector<GUID_t>& remote_endpoints,
+                const NetworkBuffer* payload = nullptr, uint32_t payload_position = 0);
+
+        bool append_submessage(const NetworkBuffer* payload, uint32_t payload_position);
+
+        //! Whether a payload of the given size is left out of the submessage and sent from where it is.
+        bool should_gather_payload(const CacheChange_t& change, uint32_t payload_size) const;
 
         bool add_info_dst_in_buffer(CDRMessage_t* buffer, const std::vector<GUID_t>& remote_endpoints);
 
@@ -256,9 +295,18 @@ class RTPSWriter;
 
         CDRMessage_t* submessage_msg_;
 
+        std::vector<RTPSMessageGroup_t::GatheredPayload>* gathered_payloads_;
+
+        std::vector<NetworkBuffer>* buffers_;
+
+        //! Bytes of the message in gathered payloads, not included in full_msg_->length.
+        uint32_t gathered_bytes_;
+
+        bool gather_payloads_;
+
         uint32_t currentBytesSent_;
 
-        LocatorList_t current_locators_;
+        LocatorList_t* current_locators_;
 
         GuidPrefix_t current_dst_;
 
@@ -0,0 +1,153 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MESSAGE_COMPRESSION_H
+#define MESSAGE_COMPRESSION_H
+
+#include "../common/Locator.h"
+#include "../attributes/PropertyPolicy.h"
+#include "../../fastrtps_dll.h"
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace eprosima{
+namespace fastrtps{
+namespace rtps{
+
+/**
+ * Filter compressing whole RTPS messages before they are handed to the send resources, and decompressing them
+ * before they reach the MessageReceiver.
+ *
+ * A compressed message keeps the RTPS header, with the protocol id changed to 'RTPZ', followed by the codec
+ * (1 byte), 3 reserved bytes, the length of the submessages (4 bytes, big endian) and the compressed submessages.
+ *
+ * It is enabled with the participant property "fastrtps.compression.codec" ("lz4" or "zstd"). Participants
+ * with it announce the codecs they can decompress on discovery, and messages are only compressed towards the
+ * unicast locators of the participants that announced the codec being used.
+ * @ingroup NETWORK_MODULE
+ */
+class MessageCompression
+{
+public:
+
+    enum Codec : octet
+    {
+        NONE = 0,
+        LZ4 = 1,
+        ZSTD = 2
+    };
+
+    //! Counters of all the messages compressed by this process.
+    struct Statistics
+    {
+        uint64_t messages;
+        uint64_t uncompressed_bytes;
+        uint64_t compressed_bytes;
+    };
+
+    //! Codec used to compress messages: "lz4" or "zstd".
+    RTPS_DllAPI static const char* const codec_property;
+    //! Messages smaller than this number of bytes are sent as they are. Default 512.
+    RTPS_DllAPI static const char* const threshold_property;
+    //! Compression level (LZ4 acceleration or zstd level). Default 1.
+    RTPS_DllAPI static const char* const level_property;
+    //! Property announced on discovery with the codecs a participant can decompress.
+    RTPS_DllAPI static const char* const accepted_codecs_property;
+
+    /**
+     * Creates the filter configured by the given properties.
+     * @return nullptr if compression is not configured or its codec is not available in this build.
+     */
+    static MessageCompression* create(const PropertyPolicy& properties);
+
+    RTPS_DllAPI static bool is_available(Codec codec);
+
+    //! Comma separated list of the codecs available in this build.
+    static std::string available_codecs();
+
+    RTPS_DllAPI static Statistics statistics();
+
+    static bool is_compressed(
+            const octet* data,
+            uint32_t size);
+
+    /**
+     * Restores a compressed message.
+     * @param buffer Where the RTPS message is written.
+     * @param length Length of the restored message.
+     * @return false if the message is corrupted, its codec is not available or it doesn't fit in the buffer.
+     */
+    static bool decompress(
+            const octet* data,
+            uint32_t size,
+            octet* buffer,
+            uint32_t buffer_capacity,
+            uint32_t& length);
+
+    MessageCompression(
+            Codec codec,
+            uint32_t threshold,
+            int level);
+
+    ~MessageCompression();
+
+    Codec codec() const
+    {
+        return codec_;
+    }
+
+    //! Whether a participant announcing the given accepted codecs can receive the messages compressed by this filter.
+    bool is_accepted_by(const std::string& accepted_codecs) const;
+
+    void add_peer(const LocatorList_t& locators);
+
+    void remove_peer(const LocatorList_t& locators);
+
+    bool is_peer(const Locator_t& locator) const;
+
+    /**
+     * Compresses a message into an internal buffer, valid until the next call.
+     * It is not thread safe, so calls have to be serialized.
+     * @return false if the message is smaller than the threshold or it doesn't get smaller.
+     */
+    bool compress(
+            const octet* data,
+            uint32_t size,
+            const octet*& compressed,
+            uint32_t& compressed_size);
+
+private:
+
+    Codec codec_;
+    uint32_t threshold_;
+    int level_;
+    void* context_;
+    std::vector<octet> buffer_;
+
+    // Number of participants announcing each locator
+    std::map<Locator_t, uint32_t> peers_;
+    mutable std::mutex peers_mutex_;
+
+    MessageCompression(const MessageCompression&) = delete;
+    MessageCompression& operator=(const MessageCompression&) = delete;
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // MESSAGE_COMPRESSION_H
@@ -75,11 +75,14 @@ class NetworkFactory
          * @param local Locator from which to listen.
          * @param maxMsgSize Maximum size of the message.
          * @param returned_resources_list List that will be filled with the created ReceiverResources.
+         * @param receive_worker_threads Number of threads processing the messages of each created resource.
+         * Zero means the messages are processed by the transport thread.
          */
         bool BuildReceiverResources(
                 Locator_t& local,
                 uint32_t maxMsgSize,
-                std::vector<std::shared_ptr<ReceiverResource>>& returned_resources_list);
+                std::vector<std::shared_ptr<ReceiverResource>>& returned_resources_list,
+                uint32_t receive_worker_threads = 0);
 
         void NormalizeLocators(LocatorList_t& locators);
 
@@ -18,6 +18,7 @@
 #include <functional>
 #include <vector>
 #include <memory>
+#include <mutex>
 #include "../messages/MessageReceiver.h"
 #include "../../transport/TransportInterface.h"
 
@@ -42,6 +43,8 @@ class ReceiverResource : public TransportReceiverInterface
 public:
     /**
     * Method called by the transport when receiving data.
+    * When the resource has receive workers, the data is only copied and queued on the worker assigned to
+    * the participant that sent it.
     * @param data Pointer to the received data.
     * @param size Number of bytes received.
     * @param localLocator Locator identifying the local endpoint.
@@ -50,6 +53,17 @@ public:
     virtual void OnDataReceived(const octet* data, const uint32_t size,
         const Locator_t& localLocator, const Locator_t& remoteLocator) override;
 
+    /**
+    * Method called by the transport when receiving data along with the time at which it was received.
+    * @param data Pointer to the received data.
+    * @param size Number of bytes received.
+    * @param localLocator Locator identifying the local endpoint.
+    * @param remoteLocator Locator identifying the remote endpoint.
+    * @param reception_timestamp Time at which the data was received by the host.
+    */
+    virtual void OnDataReceived(const octet* data, const uint32_t size,
+        const Locator_t& localLocator, const Locator_t& remoteLocator, const Time_t& reception_timestamp) override;
+
     /**
      * Reports whether this resource supports the given local locator (i.e., said locator
      * maps to the transport channel managed by this resource).
@@ -68,6 +82,12 @@ public:
     */
     void UnregisterReceiver(MessageReceiver* receiver);
 
+    /**
+     * Number of MessageReceiver objects that should be registered on this resource.
+     * When the resource has receive workers, each worker needs its own MessageReceiver.
+     */
+    uint32_t number_of_receivers() const;
+
     /**
      * Closes related ChannelResources.
      */
@@ -86,7 +106,13 @@ private:
     ReceiverResource(const ReceiverResource&) = delete;
     ReceiverResource& operator=(const ReceiverResource&) = delete;
 
-    ReceiverResource(TransportInterface&, const Locator_t&, uint32_t);
+    ReceiverResource(TransportInterface&, const Locator_t&, uint32_t, uint32_t receive_worker_threads = 0);
+
+    //! Stops the receive workers, discarding the messages still queued.
+    void stop_workers();
+
+    class ReceiveWorker;
+
     std::function<void()> Cleanup;
     std::function<bool(const Locator_t&)> LocatorMapsToManagedChannel;
     bool mValid; // Post-construction validity check for the NetworkFactory
@@ -94,6 +120,10 @@ private:
     std::mutex mtx;
     MessageReceiver* receiver;
     CDRMessage_t msg;
+    uint32_t max_message_size_;
+    //! Buffer for the decompressed messages, allocated when the first compressed message is received.
+    std::unique_ptr<CDRMessage_t> decompressed_msg_;
+    std::vector<std::unique_ptr<ReceiveWorker>> workers_;
 };
 
 } // namespace rtps
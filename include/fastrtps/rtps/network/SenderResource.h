@@ -15,6 +15,9 @@
 #ifndef SENDER_RESOURCE_H
 #define SENDER_RESOURCE_H
 
+#include <fastrtps/rtps/common/Locator.h>
+
+#include <cstring>
 #include <functional>
 #include <vector>
 
@@ -26,7 +29,25 @@ class RTPSParticipantImpl;
 class MessageReceiver;
 class ChannelResource;
 class TransportInterface;
-class Locator_t;
+
+/**
+ * Slice of a message to be sent. A message can be given to a sender resource as several slices, so large
+ * payloads are sent from where they are stored instead of being copied next to the submessage headers.
+ * @ingroup NETWORK_MODULE
+ */
+struct NetworkBuffer
+{
+    NetworkBuffer(
+            const octet* buf,
+            uint32_t len)
+        : buffer(buf)
+        , size(len)
+    {
+    }
+
+    const octet* buffer;
+    uint32_t size;
+};
 
 /**
  * RAII object that encapsulates the Send operation over one chanel in an unknown transport.
@@ -59,6 +80,68 @@ public:
         return returned_value;
     }
 
+    /**
+     * Sends the same data to several destination locators, through the channel managed by this resource.
+     * Transports supporting it deliver to all destinations in a single operation; otherwise the data is
+     * sent to each destination in turn.
+     * @param data Raw data slice to be sent.
+     * @param dataLength Length of the data to be sent. Will be used as a boundary for
+     * the previous parameter.
+     * @param destination_locators Locators describing the destination endpoints.
+     * @return Success of the send operation on all destinations.
+     */
+    bool send(const octet* data, uint32_t dataLength, const LocatorList_t& destination_locators)
+    {
+        if (send_multiple_lambda_)
+        {
+            return send_multiple_lambda_(data, dataLength, destination_locators);
+        }
+
+        bool returned_value = true;
+
+        for (const Locator_t& destination_locator : destination_locators)
+        {
+            returned_value &= send(data, dataLength, destination_locator);
+        }
+
+        return returned_value;
+    }
+
+    /**
+     * Sends a message made of several slices to several destination locators, through the channel managed by
+     * this resource. Transports supporting it hand the slices to the system as they are; otherwise they are
+     * gathered into a single buffer first.
+     * @param buffers Slices of the message, in order.
+     * @param total_bytes Sum of the sizes of the slices.
+     * @param destination_locators Locators describing the destination endpoints.
+     * @return Success of the send operation on all destinations.
+     */
+    bool send(
+            const std::vector<NetworkBuffer>& buffers,
+            uint32_t total_bytes,
+            const LocatorList_t& destination_locators)
+    {
+        if (send_gather_lambda_)
+        {
+            return send_gather_lambda_(buffers, total_bytes, destination_locators);
+        }
+
+        if (buffers.size() == 1)
+        {
+            return send(buffers.front().buffer, total_bytes, destination_locators);
+        }
+
+        std::vector<octet> message(total_bytes);
+        uint32_t position = 0;
+        for (const NetworkBuffer& buffer : buffers)
+        {
+            memcpy(message.data() + position, buffer.buffer, buffer.size);
+            position += buffer.size;
+        }
+
+        return send(message.data(), total_bytes, destination_locators);
+    }
+
     /**
      * Resources can only be transfered through move semantics. Copy, assignment, and
      * construction outside of the factory are forbidden.
@@ -67,6 +150,8 @@ public:
     {
         clean_up.swap(rValueResource.clean_up);
         send_lambda_.swap(rValueResource.send_lambda_);
+        send_multiple_lambda_.swap(rValueResource.send_multiple_lambda_);
+        send_gather_lambda_.swap(rValueResource.send_gather_lambda_);
     }
 
     virtual ~SenderResource() = default;
@@ -81,6 +166,8 @@ protected:
 
     std::function<void()> clean_up;
     std::function<bool(const octet*, uint32_t, const Locator_t&)> send_lambda_;
+    std::function<bool(const octet*, uint32_t, const LocatorList_t&)> send_multiple_lambda_;
+    std::function<bool(const std::vector<NetworkBuffer>&, uint32_t, const LocatorList_t&)> send_gather_lambda_;
 
 private:
 
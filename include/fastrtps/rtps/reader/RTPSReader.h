@@ -95,6 +95,13 @@ public:
      */
     RTPS_DllAPI bool acceptMsgDirectedTo(EntityId_t& entityId);
 
+    /**
+     * Returns false only if the reader will certainly discard the messages sent by a writer.
+     * @param writer_guid GUID of the writer.
+     * @return True if the reader may accept messages from the writer.
+     */
+    RTPS_DllAPI bool may_accept_messages_from(const GUID_t& writer_guid);
+
     /**
      * Processes a new DATA message. Previously the message must have been accepted by function acceptMsgDirectedTo.
      *
@@ -233,16 +240,9 @@ public:
     //! The liveliness changed status struct as defined in the DDS
     LivelinessChangedStatus liveliness_changed_status_;
 
-    inline void enableMessagesFromUnkownWriters(bool enable)
-    {
-        m_acceptMessagesFromUnkownWriters = enable;
-    }
+    void enableMessagesFromUnkownWriters(bool enable);
 
-    void setTrustedWriter(EntityId_t writer)
-    {
-        m_acceptMessagesFromUnkownWriters=false;
-        m_trustedWriterEntityId = writer;
-    }
+    void setTrustedWriter(EntityId_t writer);
 
     protected:
 
@@ -25,9 +25,10 @@
 #include "../common/Types.h"
 #include "../common/Locator.h"
 #include "../common/CacheChange.h"
+#include "../common/SequenceNumber.h"
 #include "../attributes/ReaderAttributes.h"
 
-#include<set>
+#include <vector>
 
 // Testing purpose
 #ifndef TEST_FRIENDS
@@ -110,10 +111,11 @@ namespace eprosima
                     bool areThereMissing();
 
                     /**
-                     * The method returns a vector containing all missing changes.
-                     * @return Vector of missing changes..
+                     * The method returns the set of missing changes, starting at the first change not received.
+                     * Missing changes that do not fit on the set are left out.
+                     * @return Set of missing changes.
                      */
-                    const std::vector<ChangeFromWriter_t>  missing_changes();
+                    SequenceNumberSet_t missing_changes();
 
                     size_t unknown_missing_changes_up_to(const SequenceNumber_t& seqNum);
 
@@ -153,43 +155,69 @@ namespace eprosima
 
                 private:
 
+                    /*!
+                     * Status bits of 32 consecutive changes of the window.
+                     * A change which is neither received nor missing has status UNKNOWN.
+                     */
+                    struct ChangesFromWriterWord
+                    {
+                        uint32_t received;
+                        uint32_t missing;
+                        uint32_t irrelevant;
+                    };
+
                     /*!
                      * @brief Add ChangeFromWriter_t up to the sequenceNumber passed, but not including this.
                      * Ex: If you have seqNums 1,2,3 and you receive seqNum 6, you need to add 4 and 5.
                      * @param sequence_number
                      * @param default_status ChangeFromWriter_t added will be created with this ChangeFromWriterStatus_t.
-                     * @return True if sequence_number will be the next after last element in the m_changesFromW container.
+                     * @return True if sequence_number will be the next after the last change in the window.
                      * @remarks No thread-safe.
                      */
                     bool maybe_add_changes_from_writer_up_to(const SequenceNumber_t& sequence_number, const ChangeFromWriterStatus_t default_status = ChangeFromWriterStatus_t::UNKNOWN);
 
                     bool received_change_set(const SequenceNumber_t& seqNum, bool is_relevance);
 
+                    /*!
+                     * @brief Returns the information kept about a change of the window.
+                     * @remarks No thread-safe.
+                     */
+                    ChangeFromWriter_t change_from_writer(const SequenceNumber_t& seqNum) const;
+
+                    //! Moves the low mark over the received changes at the beginning of the window.
                     void cleanup();
 
+                    //! Forgets the changes up to the sequence number passed, including it.
+                    void advance_low_mark(const SequenceNumber_t& seqNum);
+
+                    //! Releases the words of the window below the low mark, keeping their memory.
+                    void compact_window();
+
+                    //! Word of the window holding a change, and the mask of its bit.
+                    ChangesFromWriterWord& window_word(const SequenceNumber_t& seqNum, uint32_t& mask);
+
+                    const ChangesFromWriterWord& window_word(const SequenceNumber_t& seqNum, uint32_t& mask) const;
+
                     //Print Method for log purposes
                     void print_changes_fromWriter_test2();
 
                     //!Mutex Pointer
                     std::recursive_mutex* mp_mutex;
 
-                    //!Vector containing the ChangeFromWriter_t objects.
-                    std::set<ChangeFromWriter_t, ChangeFromWriterCmp> m_changesFromW;
+                    //! All changes up to this one were received or lost.
                     SequenceNumber_t changesFromWLowMark_;
 
-                    //! Store last ChacheChange_t notified.
-                    SequenceNumber_t lastNotified_;
+                    //! Last change kept in the window. Equal to changesFromWLowMark_ when the window is empty.
+                    SequenceNumber_t changesFromWHighMark_;
+
+                    //! Sequence number of the first bit of the window.
+                    SequenceNumber_t changesFromWBase_;
 
-                    void for_each_set_status_from(decltype(m_changesFromW)::iterator first,
-                            decltype(m_changesFromW)::iterator last,
-                            ChangeFromWriterStatus_t status,
-                            ChangeFromWriterStatus_t new_status);
+                    //! Status of the changes from changesFromWBase_. Its memory is reused as the window slides.
+                    std::vector<ChangesFromWriterWord> changesFromW_;
 
-                    void for_each_set_status_from_and_maybe_remove(decltype(m_changesFromW)::iterator first,
-                            decltype(m_changesFromW)::iterator last,
-                            ChangeFromWriterStatus_t status,
-                            ChangeFromWriterStatus_t orstatus,
-                            ChangeFromWriterStatus_t new_status);
+                    //! Store last ChacheChange_t notified.
+                    SequenceNumber_t lastNotified_;
             };
 
         } /* namespace rtps */
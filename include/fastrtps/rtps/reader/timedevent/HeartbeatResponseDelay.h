@@ -66,6 +66,8 @@ class HeartbeatResponseDelay:public TimedEvent
             LocatorList_t m_destination_locators;
             //!List of destination endpoints
             std::vector<GUID_t> m_remote_endpoints;
+            //!Missing changes with some fragments received. Kept to reuse its memory on every response.
+            std::vector<CacheChange_t*> m_uncompleted_changes;
 
     };
 }
@@ -19,10 +19,12 @@
 #define FASTRTPS_RTPS_WRITER_READERPROXY_H_
 #ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
 #include <algorithm>
+#include <chrono>
 #include <mutex>
 #include <set>
 #include <memory>
 #include <atomic>
+#include <vector>
 #include "../common/Types.h"
 #include "../common/Locator.h"
 #include "../common/SequenceNumber.h"
@@ -40,6 +42,10 @@ class NackSupressionDuration;
 
 /**
  * ReaderProxy class that helps to keep the state of a specific Reader with respect to the RTPSWriter.
+ *
+ * The changes of the writer's history are not copied for each reader. Their state is given by a set of marks
+ * (acknowledged, irrelevant, unacknowledged, underway and unsent ranges), and only the changes whose state differs
+ * from the one of their range are kept, as exceptions.
  * @ingroup WRITER_MODULE
  */
 class ReaderProxy
@@ -103,6 +109,13 @@ public:
      */
     bool requested_changes_set(const SequenceNumberSet_t& seq_num_set);
 
+    /**
+     * Add the sequence numbers of the changes marked as requested to a bitmap.
+     * Those not fitting in the range of the bitmap are left out.
+     * @param seq_num_set Bitmap where the sequence numbers are added.
+     */
+    void get_requested_changes(SequenceNumberSet_t& seq_num_set) const;
+
     /**
     * Applies the given function object to every unsent change.
     * @param max_seq Maximum sequence number to be considered without including it.
@@ -115,40 +128,42 @@ public:
             const SequenceNumber_t& max_seq,
             BinaryFunction f) const
     {
-        if (!changes_for_reader_.empty())
+        std::vector<CacheChange_t*>::const_iterator history_it = history_lower_bound(changes_low_mark_ + 1);
+        std::vector<CacheChange_t*>::const_iterator history_end = history_lower_bound(max_seq);
+
+        for (SequenceNumber_t current_seq = changes_low_mark_ + 1; current_seq < max_seq; ++current_seq)
         {
-            SequenceNumber_t current_seq = changes_low_mark_ + 1;
-            ChangeConstIterator it = changes_for_reader_.begin();
-            while (it != changes_for_reader_.end())
+            while (history_it != history_end && (*history_it)->sequenceNumber < current_seq)
+            {
+                ++history_it;
+            }
+
+            // Irrelevant changes, changes not added and changes removed from history are informed as irrelevant.
+            if (current_seq <= irrelevant_changes_mark_ || current_seq > changes_high_mark_ ||
+                    history_it == history_end || (*history_it)->sequenceNumber != current_seq)
+            {
+                f(current_seq, nullptr);
+                continue;
+            }
+
+            ChangeConstIterator it = find_change(current_seq);
+            if (it != changes_for_reader_.end())
             {
-                // Holes before this change are informed as irrelevant.
-                SequenceNumber_t change_seq = it->getSequenceNumber();
-                for(; current_seq < change_seq; ++current_seq)
+                if (!it->isRelevant())
                 {
                     f(current_seq, nullptr);
                 }
-
-                // We then inform of this change if it is unsent, and go to the next one.
-                if (it->getStatus() == UNSENT)
+                else if (it->getStatus() == UNSENT)
                 {
-                    f(current_seq, &(*it));
+                    // The function may change the state of the reader
+                    ChangeForReader_t change(*it);
+                    f(current_seq, &change);
                 }
-                ++current_seq;
-                ++it;
             }
-
-            // After the last change has been checked, there may be a hole at the end.
-            for (; current_seq < max_seq; ++current_seq)
-            {
-                f(current_seq, nullptr);
-            }
-        }
-        else
-        {
-            // This may be entered if all changes where removed before being acknowledged.
-            for (SequenceNumber_t seq = changes_low_mark_ + 1; seq < max_seq; ++seq)
+            else if (current_seq > underway_changes_mark_)
             {
-                f(seq, nullptr);
+                ChangeForReader_t change(*history_it);
+                f(current_seq, &change);
             }
         }
     }
@@ -292,6 +307,50 @@ public:
         return false;
     }
 
+    /**
+     * Called when a periodic HEARTBEAT asking for a response is sent to this reader, to measure how long it takes to
+     * be acknowledged. Piggybacked heartbeats are not reported, so at most one heartbeat per period is counted as
+     * unanswered.
+     * @param now Time the heartbeat was sent.
+     */
+    void heartbeat_sent(const std::chrono::steady_clock::time_point& now);
+
+    /**
+     * Called when an ACKNACK from this reader is accepted.
+     * @param now Time the acknack was received.
+     */
+    void acknack_received(const std::chrono::steady_clock::time_point& now);
+
+    /**
+     * Get the smoothed time from a HEARTBEAT to the ACKNACK answering it, which includes the response delay of the
+     * reader.
+     * @return the smoothed round-trip time in milliseconds, 0 while it has not been measured.
+     */
+    double acknack_rtt_millisec() const
+    {
+        return acknack_rtt_millisec_;
+    }
+
+    /**
+     * Get the number of heartbeats sent to this reader since it last answered.
+     * @return the number of consecutive heartbeats left unanswered.
+     */
+    uint32_t unanswered_heartbeats() const
+    {
+        return unanswered_heartbeats_;
+    }
+
+    /**
+     * Get the heartbeat period suited to this reader: twice its round-trip time. The period is doubled for each
+     * consecutive heartbeat the reader left unanswered after the first one, so silent readers are not flooded.
+     * @param min_millisec Lower bound, also used while the round-trip time is unknown.
+     * @param max_millisec Upper bound.
+     * @return the heartbeat period in milliseconds.
+     */
+    double heartbeat_period_millisec(
+            double min_millisec,
+            double max_millisec) const;
+
     /**
      * Process an incoming NACKFRAG submessage.
      * @param reader_guid Destination guid of the submessage.
@@ -332,7 +391,7 @@ public:
     void update_nack_supression_interval(const Duration_t& interval);
 
     /**
-     * Check if there are gaps in the list of ChangeForReader_t.
+     * Check if there are irrelevant or removed changes before the last change added.
      * return True if there are gaps, else false.
      */
     bool are_there_gaps();
@@ -347,7 +406,7 @@ private:
     StatefulWriter* writer_;
     //!To fool RTPSMessageGroup when using this proxy as single destination
     ResourceLimitedVector<GUID_t> guid_as_vector_;
-    //!Set of the changes and its state.
+    //!Changes whose state is not the one given by the marks, ordered by sequence number.
     ResourceLimitedVector<ChangeForReader_t, std::true_type> changes_for_reader_;
     //! Timed Event to manage the delay to mark a change as UNACKED after sending it.
     std::shared_ptr<NackSupressionDuration> nack_supression_event_;
@@ -357,8 +416,25 @@ private:
     uint32_t last_acknack_count_;
     //! Last  NACKFRAG count.
     uint32_t last_nackfrag_count_;
-
+    //! Time the last heartbeat waiting for an answer was sent.
+    std::chrono::steady_clock::time_point last_heartbeat_time_;
+    //! Is there a heartbeat waiting for an answer?
+    bool heartbeat_pending_;
+    //! Heartbeats sent since the reader last answered.
+    uint32_t unanswered_heartbeats_;
+    //! Smoothed HEARTBEAT to ACKNACK round-trip time.
+    double acknack_rtt_millisec_;
+
+    //! Changes up to this one are acknowledged.
     SequenceNumber_t changes_low_mark_;
+    //! Changes after the low mark up to this one are irrelevant.
+    SequenceNumber_t irrelevant_changes_mark_;
+    //! Changes after the irrelevant mark up to this one are unacknowledged.
+    SequenceNumber_t unacknowledged_changes_mark_;
+    //! Changes after the unacknowledged mark up to this one are underway.
+    SequenceNumber_t underway_changes_mark_;
+    //! Last relevant change added. Changes after the underway mark up to this one are unsent.
+    SequenceNumber_t changes_high_mark_;
 
     using ChangeIterator = ResourceLimitedVector<ChangeForReader_t, std::true_type>::iterator;
     using ChangeConstIterator = ResourceLimitedVector<ChangeForReader_t, std::true_type>::const_iterator;
@@ -400,6 +476,85 @@ private:
      * @return Iterator pointing to the change, changes_for_reader_.end() if not found.
      */
     ChangeConstIterator find_change(const SequenceNumber_t& seq_num) const;
+
+    /**
+     * @brief Add a change with its own state, keeping the collection ordered.
+     * @param change Change to add.
+     * @return Iterator pointing to the added change, changes_for_reader_.end() if it could not be added.
+     */
+    ChangeIterator insert_change(const ChangeForReader_t& change);
+
+    /**
+     * @brief Get the state of a change given by the marks.
+     * @param seq_num Sequence number of a change between the irrelevant and the high marks.
+     * @return Status of the range the change belongs to.
+     */
+    ChangeForReaderStatus_t default_status(const SequenceNumber_t& seq_num) const;
+
+    /**
+     * @brief Check if a change is irrelevant for the reader, or no longer in the history.
+     * @param seq_num Sequence number of a change after the low mark.
+     * @return true when the change is a hole, false otherwise.
+     */
+    bool is_hole(const SequenceNumber_t& seq_num) const;
+
+    /**
+     * @brief Check if all the changes between two sequence numbers are holes.
+     * @param first Sequence number before the first change to check.
+     * @param last Sequence number after the last change to check.
+     * @return true when there are only holes between both sequence numbers, false otherwise.
+     */
+    bool only_holes_between(
+            const SequenceNumber_t& first,
+            const SequenceNumber_t& last) const;
+
+    /**
+     * @brief Change the status of a relevant change, moving the marks when possible.
+     * @param it Iterator pointing to the change, changes_for_reader_.end() if its state is given by the marks.
+     * @param seq_num Sequence number of the change.
+     * @param status Status to apply.
+     * @return true when the status has changed, false otherwise.
+     */
+    bool change_status(
+            ChangeIterator it,
+            const SequenceNumber_t& seq_num,
+            ChangeForReaderStatus_t status);
+
+    /**
+     * @brief Mark changes up to a sequence number as acknowledged.
+     * @param seq_num New low mark. It should not be lower than the current one.
+     */
+    void advance_low_mark(const SequenceNumber_t& seq_num);
+
+    /**
+     * @brief Move the high mark back to the last change that is not a hole.
+     * @param removed_seq_num Sequence number of a change being removed from history, which is taken as a hole.
+     */
+    void trim_high_mark(const SequenceNumber_t& removed_seq_num);
+
+    /**
+     * @brief Find the first change of the writer's history not lower than a sequence number.
+     * @param seq_num Sequence number to find.
+     * @return Iterator pointing to the change on the writer's history.
+     */
+    std::vector<CacheChange_t*>::const_iterator history_lower_bound(const SequenceNumber_t& seq_num) const;
+
+    /**
+     * @brief Find a change on the writer's history.
+     * @param seq_num Sequence number to find.
+     * @return Pointer to the change, nullptr if not found.
+     */
+    CacheChange_t* history_change(const SequenceNumber_t& seq_num) const;
+
+    /**
+     * @brief Count the changes of the writer's history in a range.
+     * @param first Sequence number before the first change to count.
+     * @param last Sequence number of the last change to count.
+     * @return Number of changes with a sequence number greater than first and not greater than last.
+     */
+    size_t history_count(
+            const SequenceNumber_t& first,
+            const SequenceNumber_t& last) const;
 };
 
 } /* namespace rtps */
@@ -25,6 +25,7 @@
 #include "timedevent/PeriodicHeartbeat.h"
 #include "../../utils/collections/ResourceLimitedVector.hpp"
 #include <condition_variable>
+#include <memory>
 #include <mutex>
 
 
@@ -35,6 +36,7 @@ namespace rtps {
 class ReaderProxy;
 class NackResponseDelay;
 class TimedCallback;
+template<class T> class RTPSWriterCollector;
 
 /**
  * Class StatefulWriter, specialization of RTPSWriter that maintains information of each matched Reader.
@@ -288,6 +290,31 @@ private:
 
     void check_acked_status();
 
+    //! Restarts the periodic heartbeat, adapting its period first when adaptive heartbeat is enabled.
+    void restart_periodic_heartbeat_nts_();
+
+    //! Period of the periodic heartbeat suited to the readers with unacknowledged data.
+    double adaptive_heartbeat_period_nts_() const;
+
+    //! Merges the changes requested by the readers sharing a multicast locator, so they are repaired together.
+    void merge_multicast_requests_nts_();
+
+    /**
+     * Selects the destinations of a submessage addressed to some of the matched readers.
+     * The precomputed lists of the writer or the reader are used when the submessage goes to all of
+     * them or to only one.
+     * @param readers Readers the submessage is addressed to.
+     * @param guids Returns the GUIDs of the readers.
+     * @param locators Returns the locators the submessage has to be sent to.
+     */
+    void select_destinations_nts_(
+            const std::vector<ReaderProxy*>& readers,
+            const std::vector<GUID_t>*& guids,
+            const LocatorList_t*& locators);
+
+    //! Sends a GAP for the irrelevant changes collected, grouping the readers with the same changes.
+    void send_irrelevant_changes_nts_(RTPSMessageGroup& group);
+
     /**
      * @brief A method called when the ack timer expires
      * @details Only used if disable positive ACKs QoS is enabled
@@ -311,6 +338,27 @@ private:
 
     std::vector<std::unique_ptr<FlowController> > m_controllers;
 
+    //! Changes and fragments to be sent on push mode. Reused between calls to send_any_unsent_changes.
+    std::unique_ptr<RTPSWriterCollector<ReaderProxy*>> relevant_changes_;
+    //! Irrelevant changes to be notified with a GAP, ordered by reader. Reused between calls.
+    std::vector<std::pair<ReaderProxy*, SequenceNumber_t>> irrelevant_changes_;
+    //! Scratch list of the readers a GAP is addressed to.
+    std::vector<ReaderProxy*> gap_readers_;
+    //! Scratch list of the sequence numbers notified on a GAP.
+    std::vector<SequenceNumber_t> gap_sequences_;
+    //! Readers the destinations below were computed for, when they cannot be taken from a precomputed list.
+    std::vector<ReaderProxy*> destination_readers_;
+    //! Destination GUIDs of destination_readers_.
+    std::vector<GUID_t> destination_guids_;
+    //! Destination locators of destination_readers_.
+    LocatorList_t destination_locators_;
+    //! Scratch list of per-reader locator lists to be shrinked.
+    std::vector<LocatorList_t> locator_lists_;
+    //! Scratch list of the different multicast locators of the matched readers.
+    std::vector<Locator_t> multicast_locators_;
+    //! Scratch list of the readers listening on a multicast locator.
+    std::vector<ReaderProxy*> multicast_readers_;
+
     StatefulWriter& operator=(const StatefulWriter&) = delete;
 };
 
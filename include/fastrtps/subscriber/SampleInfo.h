@@ -46,6 +46,8 @@ public:
 	uint16_t ownershipStrength;
 	//!Source timestamp of the sample.
 	rtps::Time_t sourceTimestamp;
+	//!Time at which the sample was received by the transport. Zero when the transport does not provide it.
+	rtps::Time_t receptionTimestamp;
 	//!InstanceHandle of the data
 	rtps::InstanceHandle_t iHandle;
 
@@ -82,6 +82,26 @@ public:
             void* data,
             SampleInfo_t* info);
 
+    /**
+     * Take next sample from the Subscriber without deserializing it. Only allowed for plain types
+     * (see TopicDataType::is_plain). The sample is a read-only view on the received payload, which is kept
+     * by the subscriber until return_loan is called.
+     * @param[out] sample Pointer to the loaned sample.
+     * @param info Pointer to a SampleInfo_t structure that informs you about your sample.
+     * @return True if a sample was taken. Samples not sent with the native endianness cannot be loaned and must
+     * be taken with takeNextData.
+     */
+    bool take_loan(
+            const void*& sample,
+            SampleInfo_t* info);
+
+    /**
+     * Give back a sample obtained with take_loan.
+     * @param sample Pointer to the loaned sample.
+     * @return True if the sample was loaned by this subscriber.
+     */
+    bool return_loan(const void* sample);
+
     /**
      * Update the Attributes of the subscriber;
      * @param att Reference to a SubscriberAttributes object to update the parameters;
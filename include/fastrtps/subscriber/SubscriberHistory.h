@@ -86,6 +86,23 @@ class SubscriberHistory: public rtps::ReaderHistory
         bool readNextBuffer(rtps::SerializedPayload_t* data, SampleInfo_t* info);
         bool takeNextBuffer(rtps::SerializedPayload_t* data, SampleInfo_t* info);
 
+        /**
+         * Takes the next sample without deserializing it. Only for plain types.
+         * The change leaves the history but its payload is not reused until return_loan is called.
+         * @param[out] sample Read-only view of the sample, inside the payload of the change.
+         * @param[out] info Pointer to a SampleInfo_t object where you want to store the information about the sample.
+         * @return True if a sample was taken. False if there is none, or the next one cannot be loaned because
+         * it was not sent with the native endianness. In that case it must be taken with takeNextData.
+         */
+        bool take_loan(const void*& sample, SampleInfo_t* info);
+
+        /**
+         * Gives back a sample obtained with take_loan.
+         * @param sample Pointer returned by take_loan.
+         * @return True if the sample was loaned by this history.
+         */
+        bool return_loan(const void* sample);
+
 
         /**
          * This method is called to remove a change from the SubscriberHistory.
@@ -143,6 +160,19 @@ class SubscriberHistory: public rtps::ReaderHistory
         //!Type object to deserialize Key
         void * mp_getKeyObject;
 
+        //!Changes whose payload is currently loaned to the user
+        std::vector<rtps::CacheChange_t*> loaned_changes_;
+
+        /**
+         * Removes a change from the SubscriberHistory.
+         * @param change Pointer to the CacheChange_t.
+         * @param release_cache Whether the change is given back to the pool.
+         * @return True if removed.
+         */
+        bool remove_change_sub(
+                rtps::CacheChange_t* change,
+                bool release_cache);
+
         /**
          * @brief Method that finds a key in m_keyedChanges or tries to add it if not found
          * @param a_change The change to get the key from
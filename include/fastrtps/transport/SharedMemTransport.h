@@ -0,0 +1,165 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SHAREDMEM_TRANSPORT_H
+#define SHAREDMEM_TRANSPORT_H
+
+#include "TransportInterface.h"
+#include "SharedMemTransportDescriptor.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace eprosima{
+namespace fastrtps{
+namespace rtps{
+
+class SharedMemPort;
+class SharedMemChannelResource;
+
+/**
+ * Shared memory transport for participants running on the same host.
+ *
+ * Each input channel owns a shared memory segment named after its port. Sending to a
+ * LOCATOR_KIND_SHM locator maps the segment of the destination port and pushes the message
+ * into its lock-free queue, bypassing the network stack.
+ *
+ * Locators of this transport carry an identifier of the host in the last four bytes of the
+ * address, which is what is_local_locator() checks. There is no multicast support, so
+ * builtin multicast discovery still needs a network transport.
+ *
+ * Only available on Linux. On other platforms init() fails and the transport is not used.
+ * @ingroup TRANSPORT_MODULE
+ */
+class SharedMemTransport : public TransportInterface
+{
+public:
+
+    RTPS_DllAPI SharedMemTransport(const SharedMemTransportDescriptor&);
+
+    virtual ~SharedMemTransport() override;
+
+    bool init() override;
+
+    virtual void shutdown() override;
+
+    //! Checks whether there is a listening segment for the given port.
+    virtual bool IsInputChannelOpen(const Locator_t&) const override;
+
+    //! Checks for SHM kind.
+    virtual bool IsLocatorSupported(const Locator_t&) const override;
+
+    //! Only locators of this host are allowed.
+    virtual bool is_locator_allowed(const Locator_t&) const override;
+
+    virtual Locator_t RemoteToMainLocal(const Locator_t&) const override;
+
+    //! Adds the single sender resource used to reach every port on this host.
+    virtual bool OpenOutputChannel(
+            SendResourceList& sender_resource_list,
+            const Locator_t&) override;
+
+    //! Creates the shared memory segment for the given port and starts listening on it.
+    virtual bool OpenInputChannel(
+            const Locator_t&,
+            TransportReceiverInterface*,
+            uint32_t) override;
+
+    //! Removes the listening segment for the specified port.
+    virtual bool CloseInputChannel(const Locator_t&) override;
+
+    //! Reports whether Locators correspond to the same port.
+    virtual bool DoInputLocatorsMatch(const Locator_t&, const Locator_t&) const override;
+
+    virtual LocatorList_t NormalizeLocator(const Locator_t& locator) override;
+
+    //! Keeps the unique locators of this host.
+    virtual LocatorList_t ShrinkLocatorLists(const std::vector<LocatorList_t>& locatorLists) override;
+
+    virtual bool is_local_locator(const Locator_t& locator) const override;
+
+    virtual TransportDescriptorInterface* get_configuration() override { return &configuration_; }
+
+    virtual void AddDefaultOutputLocator(LocatorList_t &defaultList) override;
+
+    virtual bool getDefaultMetatrafficMulticastLocators(
+            LocatorList_t &locators,
+            uint32_t metatraffic_multicast_port) const override;
+
+    virtual bool getDefaultMetatrafficUnicastLocators(
+            LocatorList_t &locators,
+            uint32_t metatraffic_unicast_port) const override;
+
+    virtual bool getDefaultUnicastLocators(
+            LocatorList_t &locators,
+            uint32_t unicast_port) const override;
+
+    virtual bool fillMetatrafficMulticastLocator(
+            Locator_t &locator,
+            uint32_t metatraffic_multicast_port) const override;
+
+    virtual bool fillMetatrafficUnicastLocator(
+            Locator_t &locator,
+            uint32_t metatraffic_unicast_port) const override;
+
+    virtual bool configureInitialPeerLocator(
+            Locator_t &locator,
+            const PortParameters &port_params,
+            uint32_t domainId,
+            LocatorList_t& list) const override;
+
+    virtual bool fillUnicastLocator(
+            Locator_t &locator,
+            uint32_t well_known_port) const override;
+
+    /**
+     * Non-blocking send into the queue of the port referred by remote_locator.
+     * When the queue of the destination is full the message is discarded, as a UDP datagram
+     * would be when the socket buffer is full.
+     * @param send_buffer Slice into the raw data to send.
+     * @param send_buffer_size Size of the raw data.
+     * @param remote_locator Locator describing the remote destination we're sending to.
+     */
+    bool send(
+            const octet* send_buffer,
+            uint32_t send_buffer_size,
+            const Locator_t& remote_locator);
+
+    //! Fills the host identifier of a LOCATOR_KIND_SHM locator.
+    void fill_host_id(Locator_t& locator) const;
+
+protected:
+
+    SharedMemTransportDescriptor configuration_;
+
+    //! Kernel boot id and IPC namespace of this process.
+    octet host_id_[16];
+
+    bool host_id_valid_;
+
+    mutable std::mutex input_mutex_;
+    std::map<uint16_t, SharedMemChannelResource*> input_channels_;
+
+    std::mutex output_mutex_;
+    std::map<uint16_t, std::shared_ptr<SharedMemPort>> output_ports_;
+
+    std::shared_ptr<SharedMemPort> find_output_port(uint16_t port);
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // SHAREDMEM_TRANSPORT_H
@@ -0,0 +1,60 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SHAREDMEM_TRANSPORT_DESCRIPTOR
+#define SHAREDMEM_TRANSPORT_DESCRIPTOR
+
+#include "TransportDescriptorInterface.h"
+#include "../fastrtps_dll.h"
+
+#include <cstdint>
+
+namespace eprosima{
+namespace fastrtps{
+namespace rtps{
+
+class TransportInterface;
+
+/**
+ * Shared memory transport configuration.
+ *
+ * Participants running on the same host exchange RTPS messages through a POSIX shared
+ * memory segment per listening port, avoiding the loopback network stack.
+ *
+ * - port_queue_capacity: number of messages each listening port can hold before new
+ *                        messages are dropped. Rounded up to a power of two.
+ *
+ * - maxMessageSize: size of each message cell inside the segment.
+ * @ingroup TRANSPORT_MODULE
+ */
+typedef struct SharedMemTransportDescriptor : public TransportDescriptorInterface
+{
+    virtual ~SharedMemTransportDescriptor(){}
+
+    virtual TransportInterface* create_transport() const override;
+
+    virtual uint32_t min_send_buffer_size() const override { return maxMessageSize; }
+
+    RTPS_DllAPI SharedMemTransportDescriptor();
+
+    RTPS_DllAPI SharedMemTransportDescriptor(const SharedMemTransportDescriptor& t);
+
+    uint32_t port_queue_capacity;
+} SharedMemTransportDescriptor;
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif
@@ -21,6 +21,12 @@
 #include <fastrtps/transport/tcp/RTCPMessageManager.h>
 #include <fastrtps/rtps/common/Locator.h>
 
+#include <asio.hpp>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <vector>
+
 namespace eprosima{
 namespace fastrtps{
 namespace rtps{
@@ -38,7 +44,7 @@ enum eSocketErrorCodes
     eConnectionAborted = 125
 };
 
-class TCPChannelResource : public ChannelResource
+class TCPChannelResource : public ChannelResource, public std::enable_shared_from_this<TCPChannelResource>
 {
 
 protected:
@@ -72,6 +78,25 @@ protected:
     std::mutex write_mutex_;
     std::recursive_mutex pending_logical_mutex_;
     std::atomic<eConnectionStatus> connection_status_;
+    struct QueuedMessage
+    {
+        std::vector<octet> data;
+        // RTCP control messages are never discarded to make room for other messages
+        bool is_control;
+    };
+    // Messages waiting to be written. The first one is being written when send_in_progress_ is set.
+    std::deque<QueuedMessage> send_queue_;
+    bool send_in_progress_;
+    std::mutex send_queue_mutex_;
+    std::condition_variable send_queue_cv_;
+    // Header of the message being read asynchronously
+    TCPHeader async_header_;
+    // Messages gathered to be written together, with their headers
+    std::vector<octet> coalesce_buffer_;
+    std::mutex coalesce_mutex_;
+    // Runs on the transport's timers thread, as writing may block
+    asio::steady_timer coalesce_timer_;
+    bool coalesce_timer_armed_;
 
 public:
 
@@ -117,6 +142,12 @@ public:
         std::size_t size,
         asio::error_code& ec) = 0;
 
+    //! Starts an asynchronous read of exactly size bytes. The handler is called on an io_service thread.
+    virtual void async_read(
+        octet* buffer,
+        std::size_t size,
+        std::function<void(const asio::error_code&, size_t)> handler) = 0;
+
     virtual size_t send(
         const octet* header,
         size_t header_size,
@@ -124,6 +155,34 @@ public:
         size_t size,
         asio::error_code& ec) = 0;
 
+    /**
+     * Adds a message to the send queue of the channel. It is written later by the transport's io_service.
+     * RTCP control messages don't count for the capacity of the queue and are never discarded, as losing a
+     * bind or keep alive message would break the connection.
+     * @param is_control true for RTCP control messages, false for RTPS messages.
+     * @return false if the message was discarded.
+     */
+    bool enqueue_send(
+        const octet* header,
+        size_t header_size,
+        const octet* buffer,
+        size_t size,
+        bool is_control);
+
+    /**
+     * Gathers a message with the ones sent shortly before. The gathered messages are written together when
+     * they reach coalescing_max_size bytes or when the oldest one has waited coalescing_delay_us.
+     * @return false if the message couldn't be gathered or the write failed.
+     */
+    bool coalesce_send(
+        const octet* header,
+        size_t header_size,
+        const octet* buffer,
+        size_t size);
+
+    //! Writes the gathered messages right away.
+    bool flush_coalesced();
+
     virtual asio::ip::tcp::endpoint remote_endpoint() const = 0;
 
     virtual asio::ip::tcp::endpoint local_endpoint() const = 0;
@@ -169,6 +228,12 @@ protected:
 
     void add_logical_port_response(const TCPTransactionId &id, bool success, RTCPMessageManager* rtcp_manager);
 
+    //! Starts an asynchronous write of the given buffer. The handler is called when all of it is written.
+    virtual void async_send(
+        const octet* data,
+        size_t size,
+        std::function<void(const asio::error_code&)> handler) = 0;
+
     void process_check_logical_ports_response(
             const TCPTransactionId &transactionId,
             const std::vector<uint16_t> &availablePorts,
@@ -189,6 +254,17 @@ private:
 
     void set_all_ports_pending();
 
+    void send_next_queued();
+
+    void queued_send_completed(const asio::error_code& ec);
+
+    void clear_send_queue();
+
+    // Must be called with coalesce_mutex_ locked
+    bool write_coalesced();
+
+    void clear_coalesced();
+
     TCPChannelResource(const TCPChannelResource&) = delete;
 
     TCPChannelResource& operator=(const TCPChannelResource&) = delete;
@@ -53,6 +53,11 @@ public:
         std::size_t size,
         asio::error_code& ec) override;
 
+    void async_read(
+        octet* buffer,
+        std::size_t size,
+        std::function<void(const asio::error_code&, size_t)> handler) override;
+
     size_t send(
         const octet* header,
         size_t header_size,
@@ -60,6 +65,11 @@ public:
         size_t size,
         asio::error_code& ec) override;
 
+    void async_send(
+        const octet* data,
+        size_t size,
+        std::function<void(const asio::error_code&)> handler) override;
+
     asio::ip::tcp::endpoint remote_endpoint() const override;
     asio::ip::tcp::endpoint local_endpoint() const override;
 
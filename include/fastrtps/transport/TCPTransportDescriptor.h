@@ -152,6 +152,14 @@ typedef struct TCPTransportDescriptor : public SocketTransportDescriptor
         }
     };
 
+    //! What to do when a message is sent on a channel whose send queue is full.
+    enum SendQueueOverflowPolicy : uint8_t
+    {
+        BLOCK,          // Wait until the queue has room for the message.
+        DROP_OLDEST,    // Discard the oldest message not being written yet.
+        DISCONNECT      // Close the connection with the remote peer.
+    };
+
     std::vector<uint16_t> listening_ports;
     uint32_t keep_alive_frequency_ms;
     uint32_t keep_alive_timeout_ms;
@@ -164,6 +172,24 @@ typedef struct TCPTransportDescriptor : public SocketTransportDescriptor
     bool calculate_crc;
     bool check_crc;
     bool apply_security;
+    /**
+     * Number of messages that can be waiting to be written on each channel. Messages are written in the
+     * background, so sending doesn't wait for slow peers. Zero writes each message synchronously.
+     */
+    uint32_t send_queue_capacity;
+    SendQueueOverflowPolicy send_queue_overflow_policy;
+    /**
+     * Number of threads running the transport's io_service. When not zero, channels are read asynchronously
+     * by these threads instead of having a receiving thread each. Zero keeps one thread per channel.
+     */
+    uint32_t async_receive_threads;
+    /**
+     * Bytes of messages that can be gathered on each channel to be written together, so bursts of small
+     * messages don't become one TCP segment each. Zero writes every message as soon as it is sent.
+     */
+    uint32_t coalescing_max_size;
+    //! Maximum time, in microseconds, a gathered message waits before being written.
+    uint32_t coalescing_delay_us;
 
     TLSConfig tls_config;
 
@@ -63,7 +63,8 @@ class TCPTransportInterface : public TransportInterface
     {
         public:
 
-            bool in_use = false;
+            //! Number of threads delivering a message to the receiver.
+            uint32_t in_use = 0;
 
             std::condition_variable cv;
     };
@@ -75,10 +76,13 @@ protected:
     std::vector<IPFinder::info_IP> current_interfaces_;
     asio::io_service io_service_;
     asio::io_service io_service_timers_;
+    //! Runs the processing of the messages read asynchronously, which may block sending on io_service_.
+    asio::io_service io_service_processing_;
 #if TLS_FOUND
     asio::ssl::context ssl_context_;
 #endif
-    std::shared_ptr<std::thread> io_service_thread_;
+    std::vector<std::shared_ptr<std::thread>> io_service_threads_;
+    std::vector<std::shared_ptr<std::thread>> io_service_processing_threads_;
     std::shared_ptr<std::thread> io_service_timers_thread_;
     std::shared_ptr<RTCPMessageManager> rtcp_message_manager_;
     std::mutex rtcp_message_manager_mutex_;
@@ -139,11 +143,57 @@ protected:
 
     bool is_input_port_open(uint16_t port) const;
 
+    //! Starts receiving from a connected channel, on its own thread or on the io_service threads.
+    void start_listening(const std::weak_ptr<TCPChannelResource>& channel_weak);
+
+    //! Starts the negotiation of a connected channel. Returns the channel if it still exists.
+    std::shared_ptr<TCPChannelResource> begin_listen(
+            const std::weak_ptr<TCPChannelResource>& channel_weak,
+            const std::weak_ptr<RTCPMessageManager>& rtcp_manager);
+
     //! Functions to be called from new threads, which takes cares of performing a blocking receive
     void perform_listen_operation(
             std::weak_ptr<TCPChannelResource> channel,
             std::weak_ptr<RTCPMessageManager> rtcp_manager);
 
+    //! Asynchronous receive, used when the channels are read by the io_service threads.
+    void async_receive_header(
+            std::shared_ptr<TCPChannelResource> channel,
+            std::weak_ptr<RTCPMessageManager> rtcp_manager);
+
+    void async_receive_body(
+            std::shared_ptr<TCPChannelResource> channel,
+            std::weak_ptr<RTCPMessageManager> rtcp_manager,
+            size_t body_size);
+
+    void async_discard_body(
+            std::shared_ptr<TCPChannelResource> channel,
+            std::weak_ptr<RTCPMessageManager> rtcp_manager,
+            size_t remaining);
+
+    //! Processes and delivers a message read asynchronously, then reads the next one of the channel.
+    void process_async_message(
+            std::shared_ptr<TCPChannelResource> channel,
+            std::weak_ptr<RTCPMessageManager> rtcp_manager);
+
+    /**
+     * Processes a message whose body has been read. RTCP control messages are handled here.
+     * @return true if the message has to be delivered to the receiver of its logical port.
+     */
+    bool process_received_message(
+            std::weak_ptr<RTCPMessageManager>& rtcp_manager,
+            std::shared_ptr<TCPChannelResource>& channel,
+            const TCPHeader& tcp_header,
+            octet* receive_buffer,
+            uint32_t receive_buffer_size,
+            Locator_t& remote_locator);
+
+    //! Delivers a received message to the receiver of its logical port.
+    void deliver_message(
+            std::shared_ptr<TCPChannelResource>& channel,
+            CDRMessage_t& msg,
+            const Locator_t& remote_locator);
+
     bool read_body(
         octet* receive_buffer,
         uint32_t receive_buffer_capacity,
@@ -177,6 +227,7 @@ protected:
 
 public:
     friend class RTCPMessageManager;
+    friend class TCPChannelResource;
 
     virtual ~TCPTransportInterface();
 
@@ -16,6 +16,7 @@
 #define TRANSPORT_RECEIVER_INTERFACE_H
 
 #include "../rtps/common/Locator.h"
+#include "../rtps/common/Time_t.h"
 
 namespace eprosima {
 namespace fastrtps {
@@ -40,6 +41,22 @@ public:
      */
     virtual void OnDataReceived(const octet* data, const uint32_t size,
         const Locator_t& localLocator, const Locator_t& remote_locator) = 0;
+
+    /**
+     * Method to be called by the transport when receiving data, if it knows when the data was received.
+     * By default the timestamp is discarded.
+     * @param data Pointer to the received data.
+     * @param size Number of bytes received.
+     * @param localLocator Locator identifying the local endpoint.
+     * @param remote_locator Locator identifying the remote endpoint.
+     * @param reception_timestamp Time at which the data was received by the host, since the epoch.
+     */
+    virtual void OnDataReceived(const octet* data, const uint32_t size,
+        const Locator_t& localLocator, const Locator_t& remote_locator, const Time_t& reception_timestamp)
+    {
+        (void)reception_timestamp;
+        OnDataReceived(data, size, localLocator, remote_locator);
+    }
 };
 
 } // namespace rtps
@@ -152,6 +152,14 @@ protected:
     void perform_listen_operation(
             Locator_t input_locator);
 
+    /**
+     * Variant of perform_listen_operation that fetches several datagrams per system call
+     * into the pre-allocated batch buffers.
+     * @param input_locator - Locator that triggered the creation of the resource
+    */
+    void perform_batch_listen_operation(
+            Locator_t input_locator);
+
     /**
     * Blocking Receive from the specified channel.
     * @param receive_buffer vector with enough capacity (not size) to accomodate a full receive buffer. That
@@ -166,13 +174,24 @@ protected:
             uint32_t& receive_buffer_size,
             Locator_t& remote_locator);
 
+    /**
+    * Blocking Receive of up to receive_batch_size datagrams from the specified channel.
+    * It returns as soon as at least one datagram is available.
+    * @return Number of datagrams stored in the batch buffers.
+    */
+    uint32_t ReceiveBatch();
+
 private:
 
+    //! Buffers used by the batched receive mode. Only allocated when it is enabled.
+    struct BatchBuffers;
+
     TransportReceiverInterface* message_receiver_; //Associated Readers/Writers inside of MessageReceiver
     eProsimaUDPSocket socket_;
     bool only_multicast_purpose_;
     std::string interface_;
     UDPTransportInterface* transport_;
+    std::unique_ptr<BatchBuffers> batch_;
 
     UDPChannelResource(const UDPChannelResource&) = delete;
     UDPChannelResource& operator=(const UDPChannelResource&) = delete;
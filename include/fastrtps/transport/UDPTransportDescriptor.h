@@ -17,12 +17,34 @@
 
 #include "./SocketTransportDescriptor.h"
 
+#include <string>
+#include <vector>
+
 namespace eprosima{
 namespace fastrtps{
 namespace rtps{
 
 class TransportInterface;
 
+/**
+ * Socket options applied only to the sockets bound to one network interface.
+ * @ingroup TRANSPORT_MODULE
+ */
+typedef struct UDPInterfaceOptions
+{
+   //! IP address of the interface.
+   std::string address;
+
+   //! Send buffer size of the output sockets of this interface. Zero uses the transport sendBufferSize.
+   uint32_t sendBufferSize = 0;
+
+   //! Receive buffer size of the input sockets of this interface. Zero uses the transport receiveBufferSize.
+   uint32_t receiveBufferSize = 0;
+
+   //! Value of the IP_TOS (IPV6_TCLASS on UDPv6) field of the datagrams sent. Negative leaves the system default.
+   int16_t tos = -1;
+} UDPInterfaceOptions;
+
 /**
  * UDP Transport configuration
  *
@@ -55,6 +77,49 @@ typedef struct UDPTransportDescriptor: public SocketTransportDescriptor
     * datagram. This may hinder performance on high-frequency writers.
     */
    bool non_blocking_send = false;
+
+   /**
+    * Maximum number of datagrams read from an input socket per system call.
+    *
+    * When greater than 1, each input channel pre-allocates this number of receive buffers and
+    * fetches all pending datagrams at once using recvmmsg(), processing them in arrival order.
+    * This reduces the number of system calls under high packet rates. Only available on Linux,
+    * other platforms always read one datagram at a time.
+    */
+   uint32_t receive_batch_size = 1;
+
+   /**
+    * Ask the kernel to timestamp the datagrams received on input sockets (SO_TIMESTAMPING).
+    *
+    * The timestamp is handed to the receiver and exposed in SampleInfo_t::receptionTimestamp, so the time
+    * spent between the socket and the listener can be measured. Only available on Linux.
+    */
+   bool enable_receive_timestamps = false;
+
+   /**
+    * Number of sockets opened on each unicast input port, each one read by its own thread.
+    *
+    * When greater than 1, the sockets share the port using SO_REUSEPORT and the kernel spreads the incoming
+    * datagrams among them, so the reception of a port is not limited to one core. To keep another process from
+    * joining the group, the port is checked to be free before opening them. Only available on Linux, other
+    * platforms always open one socket.
+    */
+   uint32_t receive_socket_count = 1;
+
+   /**
+    * When receive_socket_count is greater than 1, attach a classic BPF program to the sockets that chooses the
+    * socket from the GuidPrefix of the RTPS header, instead of letting the kernel hash the source address.
+    * This way all messages of a remote participant are read by the same thread, keeping the order of its writers.
+    */
+   bool steer_by_guid_prefix = false;
+
+   /**
+    * Per interface socket options.
+    *
+    * Combined with interfaceWhiteList, they allow giving each NIC its own socket buffers and DSCP marking,
+    * e.g. a high priority class on a dedicated control network.
+    */
+   std::vector<UDPInterfaceOptions> interface_options;
 } UDPTransportDescriptor;
 
 } // namespace rtps
@@ -80,13 +80,56 @@ public:
    * @param socket channel we're sending from.
    * @param remote_locator Locator describing the remote destination we're sending to.
    * @param only_multicast_purpose
+   * @param interface Whitelisted interface the socket is bound to. When not empty, a unicast destination is only
+   * sent through this socket if the system routes it through this interface. Multicast is always sent.
    */
    virtual bool send(
            const octet* send_buffer,
            uint32_t send_buffer_size,
            eProsimaUDPSocket& socket,
            const Locator_t& remote_locator,
-           bool only_multicast_purpose);
+           bool only_multicast_purpose,
+           const std::string& interface);
+
+   /**
+   * Blocking Send of the same data to several destinations through the specified channel.
+   * On Linux all destinations are handed to the kernel with sendmmsg(), instead of a system call per destination.
+   * @param send_buffer Slice into the raw data to send.
+   * @param send_buffer_size Size of the raw data. It will be used as a bounds check for the previous argument.
+   * It must not exceed the send_buffer_size fed to this class during construction.
+   * @param socket channel we're sending from.
+   * @param remote_locators Locators describing the remote destinations we're sending to.
+   * @param only_multicast_purpose
+   * @param interface Whitelisted interface the socket is bound to. When not empty, unicast destinations are only
+   * sent through this socket if the system routes them through this interface. Multicast is always sent.
+   */
+   virtual bool send(
+           const octet* send_buffer,
+           uint32_t send_buffer_size,
+           eProsimaUDPSocket& socket,
+           const LocatorList_t& remote_locators,
+           bool only_multicast_purpose,
+           const std::string& interface);
+
+   /**
+   * Blocking Send of a message made of several slices to several destinations through the specified channel.
+   * On Linux the slices are handed to the kernel as they are, so they are not copied into a single buffer.
+   * @param buffers Slices of the message, in order.
+   * @param total_bytes Sum of the sizes of the slices. It must not exceed the send_buffer_size fed to this class
+   * during construction.
+   * @param socket channel we're sending from.
+   * @param remote_locators Locators describing the remote destinations we're sending to.
+   * @param only_multicast_purpose
+   * @param interface Whitelisted interface the socket is bound to. When not empty, unicast destinations are only
+   * sent through this socket if the system routes them through this interface. Multicast is always sent.
+   */
+   virtual bool send(
+           const std::vector<NetworkBuffer>& buffers,
+           uint32_t total_bytes,
+           eProsimaUDPSocket& socket,
+           const LocatorList_t& remote_locators,
+           bool only_multicast_purpose,
+           const std::string& interface);
 
    virtual LocatorList_t ShrinkLocatorLists(const std::vector<LocatorList_t>& locatorLists) override;
 
@@ -114,6 +157,20 @@ protected:
     uint32_t mSendBufferSize;
     uint32_t mReceiveBufferSize;
 
+    //! Output interfaces unicast destinations are routed through.
+    struct EgressTable
+    {
+        //! Whitelisted interfaces with an output socket. The first one is used for unknown routes.
+        std::vector<std::string> output_interfaces;
+        //! Output interface the system routes each unicast address through, resolved when it is opened.
+        std::map<Locator_t, std::string> routes;
+    };
+
+    //! Latest egress table. Read with std::atomic_load on the send path, replaced as a whole on changes.
+    std::shared_ptr<const EgressTable> mEgressTable;
+    //! Serializes the replacement of mEgressTable.
+    std::mutex mEgressMutex;
+
     UDPTransportInterface(int32_t transport_kind);
 
     virtual bool compare_locator_ip(const Locator_t& lh, const Locator_t& rh) const = 0;
@@ -149,9 +206,43 @@ protected:
     virtual eProsimaUDPSocket OpenAndBindInputSocket(const std::string& sIp, uint16_t port, bool is_multicast) = 0;
     eProsimaUDPSocket OpenAndBindUnicastOutputSocket(const asio::ip::udp::endpoint& endpoint, uint16_t& port);
 
+    //! Number of sockets to open on each unicast input port.
+    uint32_t GetReceiveSocketCount() const;
+
+    //! Lets several sockets bind the same port. Must be called before binding.
+    void SetSocketReusePort(eProsimaUDPSocket& socket);
+
+    //! Attaches to a SO_REUSEPORT group the program choosing the socket from the GuidPrefix of each message.
+    void AttachGuidPrefixSteering(asio::ip::udp::socket::native_handle_type handle, uint32_t socket_count);
+
+    //! Returns the options configured for the interface with the given address, or nullptr if there are none.
+    const UDPInterfaceOptions* get_interface_options(const std::string& sIp) const;
+
+    //! Applies the socket buffer size and traffic class configured for the interface the socket belongs to.
+    void SetSocketInterfaceOptions(eProsimaUDPSocket& socket, const std::string& sIp, bool is_output);
+
+    //! Asks the system which output interface routes the given locator and stores it in the egress table.
+    void resolve_egress_interface(const Locator_t& remote_locator);
+
+    //! Returns the output interface unicast datagrams to the given locator have to leave through.
+    static const std::string& get_egress_interface(
+            const EgressTable& egress_table,
+            const Locator_t& remote_locator);
+
+    //! Sends the slices of a message to several destinations. Common implementation of both list overloads.
+    bool send_buffers(
+            const NetworkBuffer* buffers,
+            size_t buffer_count,
+            uint32_t total_bytes,
+            eProsimaUDPSocket& socket,
+            const LocatorList_t& remote_locators,
+            bool only_multicast_purpose,
+            const std::string& interface);
+
     virtual void set_receive_buffer_size(uint32_t size) = 0;
     virtual void set_send_buffer_size(uint32_t size) = 0;
     virtual void SetSocketOutboundInterface(eProsimaUDPSocket&, const std::string&) = 0;
+    virtual void SetSocketTrafficClass(eProsimaUDPSocket&, uint8_t) = 0;
 };
 
 } // namespace rtps
@@ -114,6 +114,7 @@ protected:
     virtual void set_receive_buffer_size(uint32_t size) override;
     virtual void set_send_buffer_size(uint32_t size) override;
     virtual void SetSocketOutboundInterface(eProsimaUDPSocket&, const std::string&) override;
+    virtual void SetSocketTrafficClass(eProsimaUDPSocket&, uint8_t) override;
 };
 
 } // namespace rtps
@@ -142,6 +142,18 @@ public:
 
     static uint32_t& addToCRC(uint32_t &crc, octet data);
 
+    /**
+     * Adds a buffer to the CRC. Gives the same result as calling addToCRC for each of its bytes.
+     * @param crc Current value of the CRC.
+     * @param data Pointer to the buffer.
+     * @param size Size of the buffer.
+     * @return The updated CRC.
+     */
+    static uint32_t addToCRC(
+            uint32_t crc,
+            const octet* data,
+            size_t size);
+
     void dispose()
     {
         alive_.store(false);
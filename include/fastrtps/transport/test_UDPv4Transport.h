@@ -18,6 +18,8 @@
 #include <fastrtps/rtps/messages/RTPS_messages.h>
 #include <fastrtps/rtps/common/SequenceNumber.h>
 #include <fastrtps/rtps/messages/CDRMessage.h>
+#include <atomic>
+#include <mutex>
 #include <vector>
 
 #include "test_UDPv4TransportDescriptor.h"
@@ -41,12 +43,34 @@ public:
            uint32_t send_buffer_size,
            eProsimaUDPSocket& socket,
            const Locator_t& remote_locator,
-           bool only_multicast_purpose) override;
+           bool only_multicast_purpose,
+           const std::string& interface) override;
+
+    virtual bool send(
+           const octet* send_buffer,
+           uint32_t send_buffer_size,
+           eProsimaUDPSocket& socket,
+           const LocatorList_t& remote_locators,
+           bool only_multicast_purpose,
+           const std::string& interface) override;
+
+    virtual bool send(
+           const std::vector<NetworkBuffer>& buffers,
+           uint32_t total_bytes,
+           eProsimaUDPSocket& socket,
+           const LocatorList_t& remote_locators,
+           bool only_multicast_purpose,
+           const std::string& interface) override;
 
     RTPS_DllAPI static bool test_UDPv4Transport_ShutdownAllNetwork;
     // Handle to a persistent log of dropped packets. Defaults to length 0 (no logging) to prevent wasted resources.
     RTPS_DllAPI static std::vector<std::vector<octet> > test_UDPv4Transport_DropLog;
     RTPS_DllAPI static uint32_t test_UDPv4Transport_DropLogLength;
+    // Number of datagrams with DATA submessages from user writers handed to the network, per kind of destination.
+    RTPS_DllAPI static std::atomic<uint32_t> test_UDPv4Transport_UnicastUserDataSent;
+    RTPS_DllAPI static std::atomic<uint32_t> test_UDPv4Transport_MulticastUserDataSent;
+    // Number of datagrams with HEARTBEAT submessages from user writers handed to the network.
+    RTPS_DllAPI static std::atomic<uint32_t> test_UDPv4Transport_UserHeartbeatsSent;
 
 private:
 
@@ -71,9 +95,13 @@ private:
     PercentageData drop_ack_nack_messages_percentage_;
     std::vector<SequenceNumber_t> sequence_number_data_messages_to_drop_;
     PercentageData percentage_of_messages_to_drop_;
+    // Gathered messages are joined here, so drop criteria can look into them without allocating on each send.
+    std::vector<octet> gathered_message_;
+    std::mutex gathered_message_mutex_;
 
     bool log_drop(const octet* buffer, uint32_t size);
     bool packet_should_drop(const octet* send_buffer, uint32_t send_buffer_size);
+    bool packet_has_user_submessage(const octet* send_buffer, uint32_t send_buffer_size, octet submessage_id);
     bool random_chance_drop();
     bool should_be_dropped(PercentageData* percentage);
 };
@@ -134,6 +134,48 @@ public:
         return false;
     }
 
+    /**
+     * Removes an element from the range.
+     * Removes an element from the bitmap if it is in the allowed range.
+     *
+     * @param item   Value to be removed.
+     */
+    void remove(const T& item) noexcept
+    {
+        // Check item is inside the range of significant bits.
+        T max_value = max();
+        if ((item >= base_) && !empty() && (max_value >= item))
+        {
+            // Calc distance from base to item, and clear the corresponding bit.
+            Diff d_func;
+            uint32_t diff = d_func(item, base_);
+            uint32_t pos = diff >> 5;
+            diff &= 31UL;
+            bitmap_[pos] &= ~(1UL << (31UL - diff));
+
+            // Recalculate the number of significant bits when the highest one was removed.
+            if (item == max_value)
+            {
+                num_bits_ = 0;
+                for (uint32_t i = pos + 1; i > 0; --i)
+                {
+                    uint32_t bits = bitmap_[i - 1];
+                    if (bits != 0)
+                    {
+                        // The highest item of the word is its least significant bit set.
+                        uint32_t bit = 0;
+                        while ((bits & (1UL << bit)) == 0)
+                        {
+                            ++bit;
+                        }
+                        num_bits_ = ((i - 1) << 5) + (32UL - bit);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
     /**
      * Gets the current value of the bitmap.
      * This method is designed to be used when performing serialization of a bitmap range.
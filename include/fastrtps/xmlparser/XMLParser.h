@@ -189,6 +189,10 @@ class XMLParser
         tinyxml2::XMLElement* p_root,
         sp_transport_t p_transport);
 
+    RTPS_DllAPI static XMLP_ret parseXMLInterfaceOptions(
+        tinyxml2::XMLElement* p_root,
+        sp_transport_t udp_transport);
+
     RTPS_DllAPI static XMLP_ret parse_tls_config(
         tinyxml2::XMLElement* p_root,
         sp_transport_t tcp_transport);
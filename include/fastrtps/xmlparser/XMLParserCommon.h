@@ -56,6 +56,13 @@ extern const char* RECEIVE_BUFFER_SIZE;
 extern const char* SEND_BUFFER_SIZE;
 extern const char* TTL;
 extern const char* NON_BLOCKING_SEND;
+extern const char* RECEIVE_BATCH_SIZE;
+extern const char* ENABLE_RECEIVE_TIMESTAMPS;
+extern const char* RECEIVE_SOCKET_COUNT;
+extern const char* STEER_BY_GUID_PREFIX;
+extern const char* INTERFACE_OPTIONS;
+extern const char* INTERFACE;
+extern const char* TOS;
 extern const char* WHITE_LIST;
 extern const char* MAX_MESSAGE_SIZE;
 extern const char* MAX_INITIAL_PEERS_RANGE;
@@ -69,6 +76,14 @@ extern const char* METADATA_LOGICAL_PORT;
 extern const char* LISTENING_PORTS;
 extern const char* CALCULATE_CRC;
 extern const char* CHECK_CRC;
+extern const char* SEND_QUEUE_CAPACITY;
+extern const char* SEND_QUEUE_OVERFLOW_POLICY;
+extern const char* SEND_QUEUE_BLOCK;
+extern const char* SEND_QUEUE_DROP_OLDEST;
+extern const char* SEND_QUEUE_DISCONNECT;
+extern const char* ASYNC_RECEIVE_THREADS;
+extern const char* COALESCING_MAX_SIZE;
+extern const char* COALESCING_DELAY_US;
 
 extern const char* QOS_PROFILE;
 extern const char* APPLICATION;
@@ -83,6 +98,8 @@ extern const char* DEF_UNI_LOC_LIST;
 extern const char* DEF_MULTI_LOC_LIST;
 extern const char* SEND_SOCK_BUF_SIZE;
 extern const char* LIST_SOCK_BUF_SIZE;
+extern const char* RECV_WORKER_THREADS;
+extern const char* SEND_QUEUE_SIZE;
 extern const char* BUILTIN;
 extern const char* PORT;
 extern const char* PORTS;
@@ -142,6 +159,10 @@ extern const char* INIT_HEARTB_DELAY;
 extern const char* HEARTB_PERIOD;
 extern const char* NACK_RESP_DELAY;
 extern const char* NACK_SUPRESSION;
+extern const char* ADAPTIVE_HEARTB;
+extern const char* HEARTB_PERIOD_MIN;
+extern const char* HEARTB_PERIOD_MAX;
+extern const char* NACK_AGGREGATION;
 extern const char* BY_NAME;
 extern const char* BY_VAL;
 extern const char* DURATION_INFINITY;
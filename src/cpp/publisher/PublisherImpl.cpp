@@ -47,6 +47,9 @@ using namespace std::chrono;
 
 using namespace std::chrono;
 
+//! Size of the CDR encapsulation header preceding loaned samples.
+static const uint32_t s_encapsulation_size = 4;
+
 PublisherImpl::PublisherImpl(
         ParticipantImpl* p,
         TopicDataType* pdatatype,
@@ -92,6 +95,13 @@ PublisherImpl::~PublisherImpl()
         logInfo(PUBLISHER, this->getGuid().entityId << " in topic: " << this->m_att.topic.topicName);
     }
 
+    // Changes still loaned are released while the writer's mutex is alive
+    for(CacheChange_t* ch : loaned_changes_)
+    {
+        m_history.release_Cache(ch);
+    }
+    loaned_changes_.clear();
+
     RTPSDomain::removeRTPSWriter(mp_writer);
     delete(this->mp_userPublisher);
 }
@@ -160,86 +170,200 @@ bool PublisherImpl::create_new_change_with_params(
                 }
             }
 
-            //TODO(Ricardo) This logic in a class. Then a user of rtps layer can use it.
-            if(high_mark_for_frag_ == 0)
+            if(!add_change_to_history(ch, wparams, lock, max_blocking_time))
             {
-                uint32_t max_data_size = mp_writer->getMaxDataSize();
-                uint32_t writer_throughput_controller_bytes =
-                    mp_writer->calculateMaxDataSize(m_att.throughputController.bytesPerPeriod);
-                uint32_t participant_throughput_controller_bytes =
-                    mp_writer->calculateMaxDataSize(
-                            mp_rtpsParticipant->getRTPSParticipantAttributes().throughputController.bytesPerPeriod);
-
-                high_mark_for_frag_ =
-                    max_data_size > writer_throughput_controller_bytes ?
-                    writer_throughput_controller_bytes :
-                    (max_data_size > participant_throughput_controller_bytes ?
-                     participant_throughput_controller_bytes :
-                     max_data_size);
+                m_history.release_Cache(ch);
+                return false;
             }
 
-            uint32_t final_high_mark_for_frag = high_mark_for_frag_;
+            return true;
+        }
+    }
 
-            // If needed inlineqos for related_sample_identity, then remove the inlinqos size from final fragment size.
-            if(wparams.related_sample_identity() != SampleIdentity::unknown())
-            {
-                final_high_mark_for_frag -= 32;
-            }
+    return false;
+}
 
-            // If it is big data, fragment it.
-            if(ch->serializedPayload.length > final_high_mark_for_frag)
-            {
-                // Check ASYNCHRONOUS_PUBLISH_MODE is being used, but it is an error case.
-                if( m_att.qos.m_publishMode.kind != ASYNCHRONOUS_PUBLISH_MODE)
-                {
-                    logError(PUBLISHER, "Data cannot be sent. It's serialized size is " <<
-                            ch->serializedPayload.length << "' which exceeds the maximum payload size of '" <<
-                            final_high_mark_for_frag << "' and therefore ASYNCHRONOUS_PUBLISH_MODE must be used.");
-                    m_history.release_Cache(ch);
-                    return false;
-                }
+void* PublisherImpl::loan_sample()
+{
+    if(!mp_type->is_plain() || mp_type->m_typeSize <= s_encapsulation_size)
+    {
+        logError(PUBLISHER, "Type " << mp_type->getName() << " is not plain, samples cannot be loaned");
+        return nullptr;
+    }
 
-                /// Fragment the data.
-                // Set the fragment size to the cachechange.
-                // Note: high_mark will always be a value that can be casted to uint16_t)
-                ch->setFragmentSize((uint16_t)final_high_mark_for_frag);
-            }
+    auto max_blocking_time = std::chrono::steady_clock::now() +
+        std::chrono::microseconds(::TimeConv::Time_t2MicroSecondsInt64(m_att.qos.m_reliability.max_blocking_time));
+    std::unique_lock<std::recursive_timed_mutex> lock(mp_writer->getMutex(), std::defer_lock);
 
-            if(!this->m_history.add_pub_change(ch, wparams, lock, max_blocking_time))
-            {
-                m_history.release_Cache(ch);
-                return false;
-            }
+    if(!lock.try_lock_until(max_blocking_time))
+    {
+        return nullptr;
+    }
 
-            if (m_att.qos.m_deadline.period != c_TimeInfinite)
-            {
-                if (!m_history.set_next_deadline(
-                            ch->instanceHandle,
-                            steady_clock::now() + duration_cast<system_clock::duration>(deadline_duration_us_)))
-                {
-                    logError(PUBLISHER, "Could not set the next deadline in the history");
-                }
-                else
-                {
-                    if (timer_owner_ == handle || timer_owner_ == InstanceHandle_t())
-                    {
-                        deadline_timer_reschedule();
-                    }
-                }
-            }
+    uint32_t type_size = mp_type->m_typeSize;
+    CacheChange_t* ch = mp_writer->new_change([type_size]() -> uint32_t { return type_size; }, ALIVE);
+    if(ch == nullptr)
+    {
+        return nullptr;
+    }
+
+    // The sample goes right after a CDR encapsulation header with the native endianness. m_typeSize accounts
+    // for both, as it does for every serialized type.
+    SerializedPayload_t& payload = ch->serializedPayload;
+    payload.encapsulation = DEFAULT_ENDIAN == BIGEND ? CDR_BE : CDR_LE;
+    payload.data[0] = 0;
+    payload.data[1] = static_cast<octet>(payload.encapsulation);
+    payload.data[2] = 0;
+    payload.data[3] = 0;
+    payload.length = type_size;
+
+    std::lock_guard<std::mutex> guard(loans_mutex_);
+    loaned_changes_.push_back(ch);
+    return payload.data + s_encapsulation_size;
+}
+
+bool PublisherImpl::write_loaned(
+        void* sample,
+        WriteParams& wparams)
+{
+    CacheChange_t* ch = take_loaned_change(sample);
+    if(ch == nullptr)
+    {
+        logError(PUBLISHER, "Sample was not loaned by this publisher");
+        return false;
+    }
+
+    if(m_att.topic.topicKind == WITH_KEY)
+    {
+        bool is_key_protected = false;
+#if HAVE_SECURITY
+        is_key_protected = mp_writer->getAttributes().security_attributes().is_key_protected;
+#endif
+        mp_type->getKey(sample, &ch->instanceHandle, is_key_protected);
+    }
 
-            if (m_att.qos.m_lifespan.duration != c_TimeInfinite)
+    // Block lowlevel writer
+    auto max_blocking_time = std::chrono::steady_clock::now() +
+        std::chrono::microseconds(::TimeConv::Time_t2MicroSecondsInt64(m_att.qos.m_reliability.max_blocking_time));
+    std::unique_lock<std::recursive_timed_mutex> lock(mp_writer->getMutex(), std::defer_lock);
+
+    if(!lock.try_lock_until(max_blocking_time) || !add_change_to_history(ch, wparams, lock, max_blocking_time))
+    {
+        m_history.release_Cache(ch);
+        return false;
+    }
+
+    return true;
+}
+
+bool PublisherImpl::discard_loan(void* sample)
+{
+    CacheChange_t* ch = take_loaned_change(sample);
+    if(ch == nullptr)
+    {
+        return false;
+    }
+
+    m_history.release_Cache(ch);
+    return true;
+}
+
+CacheChange_t* PublisherImpl::take_loaned_change(void* sample)
+{
+    std::lock_guard<std::mutex> guard(loans_mutex_);
+    for(auto it = loaned_changes_.begin(); it != loaned_changes_.end(); ++it)
+    {
+        if((*it)->serializedPayload.data + s_encapsulation_size == sample)
+        {
+            CacheChange_t* ch = *it;
+            loaned_changes_.erase(it);
+            return ch;
+        }
+    }
+
+    return nullptr;
+}
+
+bool PublisherImpl::add_change_to_history(
+        CacheChange_t* ch,
+        WriteParams& wparams,
+        std::unique_lock<std::recursive_timed_mutex>& lock,
+        const std::chrono::time_point<std::chrono::steady_clock>& max_blocking_time)
+{
+    //TODO(Ricardo) This logic in a class. Then a user of rtps layer can use it.
+    if(high_mark_for_frag_ == 0)
+    {
+        uint32_t max_data_size = mp_writer->getMaxDataSize();
+        uint32_t writer_throughput_controller_bytes =
+            mp_writer->calculateMaxDataSize(m_att.throughputController.bytesPerPeriod);
+        uint32_t participant_throughput_controller_bytes =
+            mp_writer->calculateMaxDataSize(
+                    mp_rtpsParticipant->getRTPSParticipantAttributes().throughputController.bytesPerPeriod);
+
+        high_mark_for_frag_ =
+            max_data_size > writer_throughput_controller_bytes ?
+            writer_throughput_controller_bytes :
+            (max_data_size > participant_throughput_controller_bytes ?
+             participant_throughput_controller_bytes :
+             max_data_size);
+    }
+
+    uint32_t final_high_mark_for_frag = high_mark_for_frag_;
+
+    // If needed inlineqos for related_sample_identity, then remove the inlinqos size from final fragment size.
+    if(wparams.related_sample_identity() != SampleIdentity::unknown())
+    {
+        final_high_mark_for_frag -= 32;
+    }
+
+    // If it is big data, fragment it.
+    if(ch->serializedPayload.length > final_high_mark_for_frag)
+    {
+        // Check ASYNCHRONOUS_PUBLISH_MODE is being used, but it is an error case.
+        if( m_att.qos.m_publishMode.kind != ASYNCHRONOUS_PUBLISH_MODE)
+        {
+            logError(PUBLISHER, "Data cannot be sent. It's serialized size is " <<
+                    ch->serializedPayload.length << "' which exceeds the maximum payload size of '" <<
+                    final_high_mark_for_frag << "' and therefore ASYNCHRONOUS_PUBLISH_MODE must be used.");
+            return false;
+        }
+
+        /// Fragment the data.
+        // Set the fragment size to the cachechange.
+        // Note: high_mark will always be a value that can be casted to uint16_t)
+        ch->setFragmentSize((uint16_t)final_high_mark_for_frag);
+    }
+
+    if(!this->m_history.add_pub_change(ch, wparams, lock, max_blocking_time))
+    {
+        return false;
+    }
+
+    if (m_att.qos.m_deadline.period != c_TimeInfinite)
+    {
+        if (!m_history.set_next_deadline(
+                    ch->instanceHandle,
+                    steady_clock::now() + duration_cast<system_clock::duration>(deadline_duration_us_)))
+        {
+            logError(PUBLISHER, "Could not set the next deadline in the history");
+        }
+        else
+        {
+            if (timer_owner_ == ch->instanceHandle || timer_owner_ == InstanceHandle_t())
             {
-                lifespan_duration_us_ = std::chrono::duration<double, std::ratio<1, 1000000>>(m_att.qos.m_lifespan.duration.to_ns() * 1e-3);
-                lifespan_timer_.update_interval_millisec(m_att.qos.m_lifespan.duration.to_ns() * 1e-6);
-                lifespan_timer_.restart_timer();
+                deadline_timer_reschedule();
             }
-
-            return true;
         }
     }
 
-    return false;
+    if (m_att.qos.m_lifespan.duration != c_TimeInfinite)
+    {
+        lifespan_duration_us_ = std::chrono::duration<double, std::ratio<1, 1000000>>(m_att.qos.m_lifespan.duration.to_ns() * 1e-3);
+        lifespan_timer_.update_interval_millisec(m_att.qos.m_lifespan.duration.to_ns() * 1e-6);
+        lifespan_timer_.restart_timer();
+    }
+
+    return true;
 }
 
 
@@ -33,6 +33,9 @@
 #include <fastrtps/rtps/timedevent/TimedCallback.h>
 #include <fastrtps/qos/DeadlineMissedStatus.h>
 
+#include <mutex>
+#include <vector>
+
 namespace eprosima {
 namespace fastrtps{
 namespace rtps
@@ -90,6 +93,29 @@ class PublisherImpl
         void* Data,
         rtps::WriteParams& wparams);
 
+    /**
+     * Reserves a change and returns a pointer to its payload, past the encapsulation header.
+     * @return Pointer to the loaned sample, nullptr if the type is not plain or no change could be reserved.
+     */
+    void* loan_sample();
+
+    /**
+     * Adds to the history the change holding a loaned sample.
+     * @param sample Pointer returned by loan_sample.
+     * @param wparams
+     * @return True if correct.
+     */
+    bool write_loaned(
+        void* sample,
+        rtps::WriteParams& wparams);
+
+    /**
+     * Releases the change holding a loaned sample without writing it.
+     * @param sample Pointer returned by loan_sample.
+     * @return True if the sample was loaned by this publisher.
+     */
+    bool discard_loan(void* sample);
+
     /**
      * Removes the cache change with the minimum sequence number
      * @return True if correct.
@@ -183,6 +209,11 @@ class PublisherImpl
 
     uint32_t high_mark_for_frag_;
 
+    //! Protects loaned_changes_
+    std::mutex loans_mutex_;
+    //! Changes whose payload is currently loaned to the user
+    std::vector<rtps::CacheChange_t*> loaned_changes_;
+
     //! A timer used to check for deadlines
     rtps::TimedCallback deadline_timer_;
     //! Deadline duration in microseconds
@@ -197,6 +228,27 @@ class PublisherImpl
     //! The lifespan duration, in microseconds
     std::chrono::duration<double, std::ratio<1, 1000000>> lifespan_duration_us_;
 
+    /**
+     * Fragments the change if needed and adds it to the history. Called with the writer mutex taken.
+     * @param ch Change with the serialized payload already filled.
+     * @param wparams
+     * @param lock Lock on the writer mutex.
+     * @param max_blocking_time Maximum time the history may block the call.
+     * @return True if correct. When false the caller still owns the change.
+     */
+    bool add_change_to_history(
+        rtps::CacheChange_t* ch,
+        rtps::WriteParams& wparams,
+        std::unique_lock<std::recursive_timed_mutex>& lock,
+        const std::chrono::time_point<std::chrono::steady_clock>& max_blocking_time);
+
+    /**
+     * Takes out of the list of loans the change holding the given sample.
+     * @param sample Pointer returned by loan_sample.
+     * @return The change, or nullptr if the sample was not loaned by this publisher.
+     */
+    rtps::CacheChange_t* take_loaned_change(void* sample);
+
     /**
      * @brief A method called when an instance misses the deadline
      */
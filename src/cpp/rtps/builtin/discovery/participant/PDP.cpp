@@ -155,6 +155,12 @@ void PDP::initializeParticipantProxyData(ParticipantProxyData* participant_data)
 
     participant_data->m_userData = mp_RTPSParticipant->getAttributes().userData;
 
+    if (mp_RTPSParticipant->compression() != nullptr)
+    {
+        participant_data->m_properties.properties.push_back(std::make_pair(
+            std::string(MessageCompression::accepted_codecs_property), MessageCompression::available_codecs()));
+    }
+
 #if HAVE_SECURITY
     IdentityToken* identity_token = nullptr;
     if(mp_RTPSParticipant->security_manager().get_identity_token(&identity_token) && identity_token != nullptr)
@@ -641,6 +647,7 @@ bool PDP::removeRemoteParticipant(GUID_t& partGUID)
             this->mp_builtin->mp_WLP->removeRemoteEndpoints(pdata);
         this->mp_EDP->removeRemoteEndpoints(pdata);
         this->removeRemoteEndpoints(pdata);
+        update_compression_peer(pdata, false);
 
 #if HAVE_SECURITY
         mp_builtin->mp_participantImpl->security_manager().remove_participant(*pdata);
@@ -665,6 +672,39 @@ bool PDP::removeRemoteParticipant(GUID_t& partGUID)
     return false;
 }
 
+void PDP::update_compression_peer(
+        const ParticipantProxyData* pdata,
+        bool added)
+{
+    MessageCompression* compression = mp_RTPSParticipant->compression();
+    if (compression == nullptr)
+    {
+        return;
+    }
+
+    for (const auto& property : pdata->m_properties.properties)
+    {
+        if (property.first == MessageCompression::accepted_codecs_property)
+        {
+            if (compression->is_accepted_by(property.second))
+            {
+                // Multicast locators are shared with participants that may not accept it
+                if (added)
+                {
+                    compression->add_peer(pdata->m_metatrafficUnicastLocatorList);
+                    compression->add_peer(pdata->m_defaultUnicastLocatorList);
+                }
+                else
+                {
+                    compression->remove_peer(pdata->m_metatrafficUnicastLocatorList);
+                    compression->remove_peer(pdata->m_defaultUnicastLocatorList);
+                }
+            }
+            break;
+        }
+    }
+}
+
 void PDP::assertRemoteParticipantLiveliness(const GuidPrefix_t& guidP)
 {
     std::lock_guard<std::recursive_mutex> guardPDP(*this->mp_mutex);
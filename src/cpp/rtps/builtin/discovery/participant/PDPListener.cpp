@@ -98,6 +98,7 @@ void PDPListener::onNewCacheChangeAdded(
             {
                 //IF WE DIDNT FOUND IT WE MUST CREATE A NEW ONE
                 pdata = mp_PDP->createParticipantProxyData(participant_data, *change);
+                mp_PDP->update_compression_peer(pdata, true);
 
                 lock.unlock();
 
@@ -106,7 +107,9 @@ void PDPListener::onNewCacheChangeAdded(
             }
             else
             {
+                mp_PDP->update_compression_peer(pdata, false);
                 pdata->updateData(participant_data);
+                mp_PDP->update_compression_peer(pdata, true);
                 pdata->isAlive = true;
                 lock.unlock();
 
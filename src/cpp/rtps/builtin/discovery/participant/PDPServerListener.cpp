@@ -110,6 +110,7 @@ void PDPServerListener::onNewCacheChangeAdded(
             {
                 //IF WE DIDNT FOUND IT WE MUST CREATE A NEW ONE
                 pdata = mp_PDP->createParticipantProxyData(participant_data, *change);
+                mp_PDP->update_compression_peer(pdata, true);
 
                 lock.unlock();
 
@@ -124,7 +125,9 @@ void PDPServerListener::onNewCacheChangeAdded(
             }
             else
             {
+                mp_PDP->update_compression_peer(pdata, false);
                 pdata->updateData(participant_data);
+                mp_PDP->update_compression_peer(pdata, true);
                 pdata->isAlive = true;
                 lock.unlock();
 
@@ -162,6 +162,7 @@ void CacheChangePool::release_Cache(CacheChange_t* ch)
             ch->isRead = 0;
             ch->sourceTimestamp.seconds(0);
             ch->sourceTimestamp.fraction(0);
+            ch->receptionTimestamp = c_TimeZero;
             m_freeCaches.push_back(ch);
             break;
         case PREALLOCATED_WITH_REALLOC_MEMORY_MODE:
@@ -176,6 +177,7 @@ void CacheChangePool::release_Cache(CacheChange_t* ch)
             ch->isRead = 0;
             ch->sourceTimestamp.seconds(0);
             ch->sourceTimestamp.fraction(0);
+            ch->receptionTimestamp = c_TimeZero;
             m_freeCaches.push_back(ch);
             break;
         case DYNAMIC_RESERVE_MEMORY_MODE:
@@ -24,12 +24,32 @@
 #include <fastrtps/rtps/reader/RTPSReader.h>
 #include <fastrtps/rtps/reader/ReaderListener.h>
 
+#include <algorithm>
 #include <mutex>
 
 namespace eprosima {
 namespace fastrtps{
 namespace rtps {
 
+/**
+ * Order of the changes in the history: by source timestamp, then by writer and sequence number, so changes with the
+ * same timestamp keep a deterministic order.
+ */
+static bool change_precedes(
+        const CacheChange_t* c1,
+        const CacheChange_t* c2)
+{
+    if (c1->sourceTimestamp != c2->sourceTimestamp)
+    {
+        return c1->sourceTimestamp < c2->sourceTimestamp;
+    }
+    if (c1->writerGUID != c2->writerGUID)
+    {
+        return c1->writerGUID < c2->writerGUID;
+    }
+    return c1->sequenceNumber < c2->sequenceNumber;
+}
+
 ReaderHistory::ReaderHistory(const HistoryAttributes& att)
     : History(att)
     , mp_reader(nullptr)
@@ -70,15 +90,36 @@ bool ReaderHistory::add_change(CacheChange_t* a_change)
         logError(RTPS_HISTORY,"The Writer GUID_t must be defined");
     }
 
-    m_changes.push_back(a_change);
-    sortCacheChanges();
-    updateMaxMinSeqNum();
+    // Changes usually arrive in order, so they are appended. Otherwise they are inserted at their position, which
+    // only moves the pointers after it.
+    if(m_changes.empty() || !change_precedes(a_change, m_changes.back()))
+    {
+        m_changes.push_back(a_change);
+    }
+    else
+    {
+        m_changes.insert(std::upper_bound(m_changes.begin(), m_changes.end(), a_change, change_precedes), a_change);
+    }
+
+    if(mp_minSeqCacheChange == mp_invalidCache || a_change->sequenceNumber < mp_minSeqCacheChange->sequenceNumber)
+    {
+        mp_minSeqCacheChange = a_change;
+    }
+    if(mp_maxSeqCacheChange == mp_invalidCache || mp_maxSeqCacheChange->sequenceNumber < a_change->sequenceNumber)
+    {
+        mp_maxSeqCacheChange = a_change;
+    }
     logInfo(RTPS_HISTORY, "Change " << a_change->sequenceNumber << " added with " << a_change->serializedPayload.length << " bytes");
 
     return true;
 }
 
 bool ReaderHistory::remove_change(CacheChange_t* a_change)
+{
+    return remove_change(a_change, true);
+}
+
+bool ReaderHistory::remove_change(CacheChange_t* a_change, bool release_cache)
 {
     if(mp_reader == nullptr || mp_mutex == nullptr)
     {
@@ -92,20 +133,35 @@ bool ReaderHistory::remove_change(CacheChange_t* a_change)
         logError(RTPS_HISTORY,"Pointer is not valid")
         return false;
     }
-    for(std::vector<CacheChange_t*>::iterator chit = m_changes.begin();
-            chit!=m_changes.end();++chit)
+    auto is_same_change = [a_change](const CacheChange_t* ch)
     {
-        if((*chit)->sequenceNumber == a_change->sequenceNumber &&
-                (*chit)->writerGUID == a_change->writerGUID)
+        return ch->sequenceNumber == a_change->sequenceNumber && ch->writerGUID == a_change->writerGUID;
+    };
+
+    // The change is looked for at its position. A change with the same identity but a different timestamp than
+    // the one stored is still found by the linear search.
+    std::vector<CacheChange_t*>::iterator chit =
+        std::lower_bound(m_changes.begin(), m_changes.end(), a_change, change_precedes);
+    if(chit == m_changes.end() || !is_same_change(*chit))
+    {
+        chit = std::find_if(m_changes.begin(), m_changes.end(), is_same_change);
+    }
+
+    if(chit != m_changes.end())
+    {
+        CacheChange_t* stored = *chit;
+        logInfo(RTPS_HISTORY,"Removing change "<< a_change->sequenceNumber);
+        mp_reader->change_removed_by_history(a_change);
+        if(release_cache)
         {
-            logInfo(RTPS_HISTORY,"Removing change "<< a_change->sequenceNumber);
-            mp_reader->change_removed_by_history(a_change);
             m_changePool.release_Cache(a_change);
-            m_changes.erase(chit);
-            sortCacheChanges();
+        }
+        m_changes.erase(chit);
+        if(stored == mp_minSeqCacheChange || stored == mp_maxSeqCacheChange)
+        {
             updateMaxMinSeqNum();
-            return true;
         }
+        return true;
     }
     logWarning(RTPS_HISTORY,"SequenceNumber "<<a_change->sequenceNumber << " not found");
     return false;
@@ -147,7 +203,7 @@ void ReaderHistory::sortCacheChanges()
 {
     std::sort(m_changes.begin(),
               m_changes.end(),
-              [](CacheChange_t* c1, CacheChange_t* c2){ return c1->sourceTimestamp < c2->sourceTimestamp; });
+              change_precedes);
 }
 
 void ReaderHistory::updateMaxMinSeqNum()
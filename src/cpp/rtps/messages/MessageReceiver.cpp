@@ -33,8 +33,10 @@
 #include "../participant/RTPSParticipantImpl.h"
 
 #include <mutex>
+#include <thread>
 
 #include <limits>
+#include <algorithm>
 #include <cassert>
 
 
@@ -48,11 +50,15 @@ namespace eprosima {
 namespace fastrtps{
 namespace rtps {
 
+//! Maximum number of writers kept in the cache of readers for ENTITYID_UNKNOWN submessages.
+static const size_t s_max_cached_writers = 1024;
 
 MessageReceiver::MessageReceiver(RTPSParticipantImpl* participant, uint32_t rec_buffer_size) :
 #if HAVE_SECURITY
     m_crypto_msg(rec_buffer_size),
 #endif
+    endpoints_(std::make_shared<AssociatedEndpoints>()), processing_count_(0), processing_waiters_(0),
+    readers_by_writer_epoch_(0),
     sourceVendorId(c_VendorId_Unknown), participant_(participant)
 {
     init(rec_buffer_size);
@@ -74,60 +80,160 @@ void MessageReceiver::init(uint32_t rec_buffer_size){
 MessageReceiver::~MessageReceiver()
 {
     logInfo(RTPS_MSG_IN,"");
-    assert(AssociatedWriters.size() == 0);
-    assert(AssociatedReaders.size() == 0);
+    assert(endpoints_->writers.size() == 0);
+    assert(endpoints_->readers.size() == 0);
 }
 
 void MessageReceiver::associateEndpoint(Endpoint *to_add){
-    bool found = false;
     std::lock_guard<std::mutex> guard(mtx);
+    const EntityId_t& entity_id = to_add->getGuid().entityId;
+    std::shared_ptr<AssociatedEndpoints> endpoints = std::make_shared<AssociatedEndpoints>(
+            *std::atomic_load(&endpoints_));
     if(to_add->getAttributes().endpointKind == WRITER)
     {
-        for(auto it = AssociatedWriters.begin(); it != AssociatedWriters.end(); ++it)
+        RTPSWriter* writer = (RTPSWriter*)to_add;
+        auto it = endpoints->writers_by_id.find(entity_id);
+        if(it != endpoints->writers_by_id.end() && it->second == writer)
         {
-            if( (*it) == (RTPSWriter*)to_add )
-            {
-                found = true;
-                break;
-            }
+            return;
         }
-        if(!found) AssociatedWriters.push_back((RTPSWriter*)to_add);
+        endpoints->writers_by_id[entity_id] = writer;
+        endpoints->writers.push_back(writer);
     }
     else
     {
-        for(auto it = AssociatedReaders.begin(); it != AssociatedReaders.end(); ++it)
+        RTPSReader* reader = (RTPSReader*)to_add;
+        auto it = endpoints->readers_by_id.find(entity_id);
+        if(it != endpoints->readers_by_id.end() && it->second == reader)
         {
-            if( (*it) == (RTPSReader*)to_add )
-            {
-                found = true;
-                break;
-            }
+            return;
+        }
+        endpoints->readers_by_id[entity_id] = reader;
+        endpoints->readers.push_back(reader);
+
+        EntityId_t unknown_id = c_EntityId_Unknown;
+        if(reader->acceptMsgDirectedTo(unknown_id))
+        {
+            endpoints->unknown_id_readers.push_back(reader);
         }
-        if(!found) AssociatedReaders.push_back((RTPSReader*)to_add);
     }
-    return;
+    std::atomic_store(&endpoints_, std::shared_ptr<const AssociatedEndpoints>(endpoints));
 }
 void MessageReceiver::removeEndpoint(Endpoint *to_remove){
 
     std::lock_guard<std::mutex> guard(mtx);
+    const EntityId_t& entity_id = to_remove->getGuid().entityId;
+    std::shared_ptr<AssociatedEndpoints> endpoints = std::make_shared<AssociatedEndpoints>(
+            *std::atomic_load(&endpoints_));
     if(to_remove->getAttributes().endpointKind == WRITER){
         RTPSWriter* var = (RTPSWriter *)to_remove;
-        for(auto it=AssociatedWriters.begin(); it !=AssociatedWriters.end(); ++it){
-            if ((*it) == var){
-                AssociatedWriters.erase(it);
-                break;
-            }
+        auto map_it = endpoints->writers_by_id.find(entity_id);
+        if(map_it != endpoints->writers_by_id.end() && map_it->second == var)
+        {
+            endpoints->writers_by_id.erase(map_it);
+        }
+        auto it = std::find(endpoints->writers.begin(), endpoints->writers.end(), var);
+        if(it == endpoints->writers.end())
+        {
+            return;
         }
+        endpoints->writers.erase(it);
     }else{
         RTPSReader *var = (RTPSReader *)to_remove;
-        for(auto it=AssociatedReaders.begin(); it !=AssociatedReaders.end(); ++it){
-            if ((*it) == var){
-                AssociatedReaders.erase(it);
-                break;
+        auto map_it = endpoints->readers_by_id.find(entity_id);
+        if(map_it != endpoints->readers_by_id.end() && map_it->second == var)
+        {
+            endpoints->readers_by_id.erase(map_it);
+        }
+        auto it = std::find(endpoints->readers.begin(), endpoints->readers.end(), var);
+        if(it == endpoints->readers.end())
+        {
+            return;
+        }
+        endpoints->readers.erase(it);
+        it = std::find(endpoints->unknown_id_readers.begin(), endpoints->unknown_id_readers.end(), var);
+        if(it != endpoints->unknown_id_readers.end())
+        {
+            endpoints->unknown_id_readers.erase(it);
+        }
+    }
+    std::atomic_store(&endpoints_, std::shared_ptr<const AssociatedEndpoints>(endpoints));
+
+    // The message being processed may still use the previous snapshot, so wait for it before letting the
+    // caller destroy the endpoint.
+    wait_message_processed();
+}
+
+void MessageReceiver::wait_message_processed()
+{
+    // Only one message is processed at a time, so this does not starve.
+    uint32_t count = processing_count_.load();
+    if(count & 1u)
+    {
+        // Registering before checking the count again pairs with the check of processing_waiters_ done
+        // after increasing it, so either the processing thread notifies or this thread sees the new count.
+        ++processing_waiters_;
+        std::unique_lock<std::mutex> lock(processed_mtx_);
+        processed_cond_.wait(lock, [this, count]() { return processing_count_.load() != count; });
+        --processing_waiters_;
+    }
+}
+
+void MessageReceiver::update_current_endpoints()
+{
+    std::shared_ptr<const AssociatedEndpoints> endpoints = std::atomic_load(&endpoints_);
+    if(endpoints != current_endpoints_)
+    {
+        readers_by_writer_.clear();
+        current_endpoints_ = endpoints;
+    }
+}
+
+template<typename Functor>
+void MessageReceiver::find_all_readers(const EntityId_t& reader_id, const GUID_t& writer_guid,
+        const Functor& callback)
+{
+    if(reader_id != c_EntityId_Unknown)
+    {
+        auto it = current_endpoints_->readers_by_id.find(reader_id);
+        if(it != current_endpoints_->readers_by_id.end())
+        {
+            callback(it->second);
+        }
+        return;
+    }
+
+    for(RTPSReader* reader : readers_for_writer(writer_guid))
+    {
+        callback(reader);
+    }
+}
+
+const std::vector<RTPSReader*>& MessageReceiver::readers_for_writer(const GUID_t& writer_guid)
+{
+    // Readers may have matched or unmatched writers since the cache was filled
+    uint32_t epoch = participant_->reader_matching_epoch();
+    if(epoch != readers_by_writer_epoch_ || readers_by_writer_.size() >= s_max_cached_writers)
+    {
+        readers_by_writer_.clear();
+        readers_by_writer_epoch_ = epoch;
+    }
+
+    auto it = readers_by_writer_.find(writer_guid);
+    if(it == readers_by_writer_.end())
+    {
+        std::vector<RTPSReader*> readers;
+        for(RTPSReader* reader : current_endpoints_->unknown_id_readers)
+        {
+            if(reader->may_accept_messages_from(writer_guid))
+            {
+                readers.push_back(reader);
             }
         }
+        it = readers_by_writer_.emplace(writer_guid, std::move(readers)).first;
     }
-    return;
+
+    return it->second;
 }
 
 
@@ -141,7 +247,7 @@ void MessageReceiver::reset(){
     timestamp = c_TimeInvalid;
 }
 
-void MessageReceiver::processCDRMsg(const Locator_t& loc, CDRMessage_t*msg)
+void MessageReceiver::processCDRMsg(const Locator_t& loc, CDRMessage_t*msg, const Time_t& reception_timestamp)
 {
     (void)loc;
 
@@ -151,7 +257,25 @@ void MessageReceiver::processCDRMsg(const Locator_t& loc, CDRMessage_t*msg)
         return;
     }
 
+    // Tells wait_message_processed that a snapshot is in use until this function returns
+    struct ProcessingGuard
+    {
+        explicit ProcessingGuard(MessageReceiver& receiver) : receiver_(receiver) { ++receiver_.processing_count_; }
+        ~ProcessingGuard()
+        {
+            ++receiver_.processing_count_;
+            if(receiver_.processing_waiters_.load() != 0)
+            {
+                std::lock_guard<std::mutex> lock(receiver_.processed_mtx_);
+                receiver_.processed_cond_.notify_all();
+            }
+        }
+        MessageReceiver& receiver_;
+    } processing_guard(*this);
+
+    update_current_endpoints();
     this->reset();
+    reception_timestamp_ = reception_timestamp;
 
     GuidPrefix_t participantGuidPrefix = participant_->getGuid().guidPrefix;
     destGuidPrefix = participantGuidPrefix;
@@ -413,8 +537,6 @@ bool MessageReceiver::readSubmessageHeader(CDRMessage_t* msg, SubmessageHeader_t
 
 bool MessageReceiver::proc_Submsg_Data(CDRMessage_t* msg,SubmessageHeader_t* smh)
 {
-    std::lock_guard<std::mutex> guard(mtx);
-
     //READ and PROCESS
     if(smh->submessageLength < RTPSMESSAGE_DATA_MIN_LENGTH)
     {
@@ -449,37 +571,30 @@ bool MessageReceiver::proc_Submsg_Data(CDRMessage_t* msg,SubmessageHeader_t* smh
     EntityId_t readerID;
     valid &= CDRMessage::readEntityId(msg,&readerID);
 
-    //WE KNOW THE READER THAT THE MESSAGE IS DIRECTED TO SO WE LOOK FOR IT:
-
-    RTPSReader* firstReader = nullptr;
-    if(AssociatedReaders.empty())
+    if(current_endpoints_->readers.empty())
     {
         logWarning(RTPS_MSG_IN,IDSTRING"Data received when NO readers are listening");
         return false;
     }
 
-    for(std::vector<RTPSReader*>::iterator it=AssociatedReaders.begin();
-            it != AssociatedReaders.end(); ++it)
-    {
-        if((*it)->acceptMsgDirectedTo(readerID)) //add
-        {
-            firstReader = *it;
-            break;
-        }
-    }
-    if(firstReader == nullptr) //Reader not found
-    {
-        logWarning(RTPS_MSG_IN, IDSTRING"No Reader accepts this message (directed to: " <<readerID << ")");
-        return false;
-    }
-    //FOUND THE READER.
-    //We ask the reader for a cachechange to store the information.
     CacheChange_t ch;
     ch.kind = ALIVE;
     ch.serializedPayload.max_size = mMaxPayload_;
     ch.writerGUID.guidPrefix = sourceGuidPrefix;
     valid &= CDRMessage::readEntityId(msg,&ch.writerGUID.entityId);
 
+    //WE KNOW THE READER THAT THE MESSAGE IS DIRECTED TO SO WE LOOK FOR IT:
+    bool reader_found = false;
+    find_all_readers(readerID, ch.writerGUID, [&reader_found](RTPSReader*)
+            {
+                reader_found = true;
+            });
+    if(!reader_found) //Reader not found
+    {
+        logWarning(RTPS_MSG_IN, IDSTRING"No Reader accepts this message (directed to: " <<readerID << ")");
+        return false;
+    }
+
     //Get sequence number
     valid &= CDRMessage::readSequenceNumber(msg,&ch.sequenceNumber);
 
@@ -562,19 +677,16 @@ bool MessageReceiver::proc_Submsg_Data(CDRMessage_t* msg,SubmessageHeader_t* smh
     {
         ch.sourceTimestamp = this->timestamp;
     }
+    ch.receptionTimestamp = reception_timestamp_;
 
 
     //FIXME: DO SOMETHING WITH PARAMETERLIST CREATED.
-    logInfo(RTPS_MSG_IN,IDSTRING"from Writer " << ch.writerGUID << "; possible RTPSReaders: "<<AssociatedReaders.size());
+    logInfo(RTPS_MSG_IN,IDSTRING"from Writer " << ch.writerGUID << "; possible RTPSReaders: "<<current_endpoints_->readers.size());
     //Look for the correct reader to add the change
-    for(std::vector<RTPSReader*>::iterator it = AssociatedReaders.begin();
-            it != AssociatedReaders.end(); ++it)
-    {
-        if((*it)->acceptMsgDirectedTo(readerID))
-        {
-            (*it)->processDataMsg(&ch);
-        }
-    }
+    find_all_readers(readerID, ch.writerGUID, [&ch](RTPSReader* reader)
+            {
+                reader->processDataMsg(&ch);
+            });
 
     //TODO(Ricardo) If a exception is thrown (ex, by fastcdr), this line is not executed -> segmentation fault
     ch.serializedPayload.data = nullptr;
@@ -585,8 +697,6 @@ bool MessageReceiver::proc_Submsg_Data(CDRMessage_t* msg,SubmessageHeader_t* smh
 
 bool MessageReceiver::proc_Submsg_DataFrag(CDRMessage_t* msg, SubmessageHeader_t* smh)
 {
-    std::lock_guard<std::mutex> guard(mtx);
-
     //READ and PROCESS
     if (smh->submessageLength < RTPSMESSAGE_DATA_MIN_LENGTH)
     {
@@ -616,37 +726,29 @@ bool MessageReceiver::proc_Submsg_DataFrag(CDRMessage_t* msg, SubmessageHeader_t
     EntityId_t readerID;
     valid &= CDRMessage::readEntityId(msg, &readerID);
 
-    //WE KNOW THE READER THAT THE MESSAGE IS DIRECTED TO SO WE LOOK FOR IT:
-    if(AssociatedReaders.empty())
+    if(current_endpoints_->readers.empty())
     {
         logWarning(RTPS_MSG_IN, IDSTRING"Data received when NO readers are listening");
         return false;
     }
 
-    RTPSReader* firstReader = nullptr;
-    for (std::vector<RTPSReader*>::iterator it = AssociatedReaders.begin();
-            it != AssociatedReaders.end(); ++it)
-    {
-        if ((*it)->acceptMsgDirectedTo(readerID)) //add
-        {
-            firstReader = *it;
-            break;
-        }
-    }
+    CacheChange_t ch;
+    ch.serializedPayload.max_size = mMaxPayload_;
+    ch.writerGUID.guidPrefix = sourceGuidPrefix;
+    valid &= CDRMessage::readEntityId(msg, &ch.writerGUID.entityId);
 
-    if (firstReader == nullptr) //Reader not found
+    //WE KNOW THE READER THAT THE MESSAGE IS DIRECTED TO SO WE LOOK FOR IT:
+    bool reader_found = false;
+    find_all_readers(readerID, ch.writerGUID, [&reader_found](RTPSReader*)
+            {
+                reader_found = true;
+            });
+    if (!reader_found) //Reader not found
     {
         logWarning(RTPS_MSG_IN, IDSTRING"No Reader accepts this message (directed to: " << readerID << ")");
         return false;
     }
 
-    //FOUND THE READER.
-    //We ask the reader for a cachechange to store the information.
-    CacheChange_t ch;
-    ch.serializedPayload.max_size = mMaxPayload_;
-    ch.writerGUID.guidPrefix = sourceGuidPrefix;
-    valid &= CDRMessage::readEntityId(msg, &ch.writerGUID.entityId);
-
     //Get sequence number
     valid &= CDRMessage::readSequenceNumber(msg, &ch.sequenceNumber);
 
@@ -753,18 +855,15 @@ bool MessageReceiver::proc_Submsg_DataFrag(CDRMessage_t* msg, SubmessageHeader_t
     // Set sourcetimestamp
     if (haveTimestamp)
         ch.sourceTimestamp = this->timestamp;
+    ch.receptionTimestamp = reception_timestamp_;
 
     //FIXME: DO SOMETHING WITH PARAMETERLIST CREATED.
-    logInfo(RTPS_MSG_IN, IDSTRING"from Writer " << ch.writerGUID << "; possible RTPSReaders: " << AssociatedReaders.size());
+    logInfo(RTPS_MSG_IN, IDSTRING"from Writer " << ch.writerGUID << "; possible RTPSReaders: " << current_endpoints_->readers.size());
     //Look for the correct reader to add the change
-    for (std::vector<RTPSReader*>::iterator it = AssociatedReaders.begin();
-            it != AssociatedReaders.end(); ++it)
-    {
-        if ((*it)->acceptMsgDirectedTo(readerID))
-        {
-            (*it)->processDataFragMsg(&ch, sampleSize, fragmentStartingNum);
-        }
-    }
+    find_all_readers(readerID, ch.writerGUID, [&](RTPSReader* reader)
+            {
+                reader->processDataFragMsg(&ch, sampleSize, fragmentStartingNum);
+            });
 
     ch.serializedPayload.data = nullptr;
 
@@ -802,16 +901,11 @@ bool MessageReceiver::proc_Submsg_Heartbeat(CDRMessage_t* msg,SubmessageHeader_t
     uint32_t HBCount;
     CDRMessage::readUInt32(msg,&HBCount);
 
-    std::lock_guard<std::mutex> guard(mtx);
     //Look for the correct reader and writers:
-    for (std::vector<RTPSReader*>::iterator it = AssociatedReaders.begin();
-            it != AssociatedReaders.end(); ++it)
-    {
-        if((*it)->acceptMsgDirectedTo(readerGUID.entityId))
-        {
-            (*it)->processHeartbeatMsg(writerGUID, HBCount, firstSN, lastSN, finalFlag, livelinessFlag);
-        }
-    }
+    find_all_readers(readerGUID.entityId, writerGUID, [&](RTPSReader* reader)
+            {
+                reader->processHeartbeatMsg(writerGUID, HBCount, firstSN, lastSN, finalFlag, livelinessFlag);
+            });
     return true;
 }
 
@@ -836,13 +930,12 @@ bool MessageReceiver::proc_Submsg_Acknack(CDRMessage_t* msg,SubmessageHeader_t*
     uint32_t Ackcount;
     CDRMessage::readUInt32(msg,&Ackcount);
 
-    std::lock_guard<std::mutex> guard(mtx);
     //Look for the correct writer to use the acknack
-    for (std::vector<RTPSWriter*>::iterator it = AssociatedWriters.begin();
-            it != AssociatedWriters.end(); ++it)
+    auto writer_it = current_endpoints_->writers_by_id.find(writerGUID.entityId);
+    if (writer_it != current_endpoints_->writers_by_id.end())
     {
         bool result;
-        if ((*it)->process_acknack(writerGUID, readerGUID, Ackcount, SNSet, finalFlag, result))
+        if (writer_it->second->process_acknack(writerGUID, readerGUID, Ackcount, SNSet, finalFlag, result))
         {
             if (!result)
             {
@@ -851,8 +944,7 @@ bool MessageReceiver::proc_Submsg_Acknack(CDRMessage_t* msg,SubmessageHeader_t*
             return result;
         }
     }
-    logInfo(RTPS_MSG_IN,IDSTRING"Acknack msg to UNKNOWN writer (I loooked through "
-            << AssociatedWriters.size() << " writers in this ListenResource)");
+    logInfo(RTPS_MSG_IN,IDSTRING"Acknack msg to UNKNOWN writer " << writerGUID);
     return false;
 }
 
@@ -878,15 +970,10 @@ bool MessageReceiver::proc_Submsg_Gap(CDRMessage_t* msg,SubmessageHeader_t* smh)
     if(gapStart <= SequenceNumber_t(0, 0))
         return false;
 
-    std::lock_guard<std::mutex> guard(mtx);
-    for (std::vector<RTPSReader*>::iterator it = AssociatedReaders.begin();
-            it != AssociatedReaders.end(); ++it)
-    {
-        if((*it)->acceptMsgDirectedTo(readerGUID.entityId))
-        {
-            (*it)->processGapMsg(writerGUID, gapStart, gapList);
-        }
-    }
+    find_all_readers(readerGUID.entityId, writerGUID, [&](RTPSReader* reader)
+            {
+                reader->processGapMsg(writerGUID, gapStart, gapList);
+            });
 
     return true;
 }
@@ -978,13 +1065,12 @@ bool MessageReceiver::proc_Submsg_NackFrag(CDRMessage_t*msg, SubmessageHeader_t*
     uint32_t Ackcount;
     CDRMessage::readUInt32(msg, &Ackcount);
 
-    std::lock_guard<std::mutex> guard(mtx);
     //Look for the correct writer to use the acknack
-    for (std::vector<RTPSWriter*>::iterator it = AssociatedWriters.begin();
-            it != AssociatedWriters.end(); ++it)
+    auto writer_it = current_endpoints_->writers_by_id.find(writerGUID.entityId);
+    if (writer_it != current_endpoints_->writers_by_id.end())
     {
         bool result;
-        if ((*it)->process_nack_frag(writerGUID, readerGUID, Ackcount, writerSN, fnState, result))
+        if (writer_it->second->process_nack_frag(writerGUID, readerGUID, Ackcount, writerSN, fnState, result))
         {
             if (!result)
             {
@@ -993,8 +1079,7 @@ bool MessageReceiver::proc_Submsg_NackFrag(CDRMessage_t*msg, SubmessageHeader_t*
             return result;
         }
     }
-    logInfo(RTPS_MSG_IN, IDSTRING"Acknack msg to UNKNOWN writer (I looked through "
-            << AssociatedWriters.size() << " writers in this ListenResource)");
+    logInfo(RTPS_MSG_IN, IDSTRING"Acknack msg to UNKNOWN writer " << writerGUID);
     return false;
 }
 
@@ -1024,18 +1109,13 @@ bool MessageReceiver::proc_Submsg_HeartbeatFrag(CDRMessage_t*msg, SubmessageHead
 
     // XXX TODO VALIDATE DATA?
 
-    std::lock_guard<std::mutex> guard(mtx);
     //Look for the correct reader and writers:
-    for (std::vector<RTPSReader*>::iterator it = AssociatedReaders.begin();
-            it != AssociatedReaders.end(); ++it)
-    {
-        /* XXX TODO PROCESS
-           if ((*it)->acceptMsgDirectedTo(readerGUID.entityId))
-           {
-           (*it)->processHeartbeatMsg(writerGUID, HBCount, firstSN, lastSN, finalFlag, livelinessFlag);
-           }
-           */
-    }
+    /* XXX TODO PROCESS
+       find_all_readers(readerGUID.entityId, writerGUID, [&](RTPSReader* reader)
+       {
+       reader->processHeartbeatMsg(writerGUID, HBCount, firstSN, lastSN, finalFlag, livelinessFlag);
+       });
+       */
 
     return true;
 }
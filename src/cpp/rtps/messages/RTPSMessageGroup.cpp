@@ -41,53 +41,8 @@ bool sort_SeqNum(const SequenceNumber_t& s1,const SequenceNumber_t& s2)
     return(s1 < s2);
 }
 
-typedef std::pair<SequenceNumber_t,SequenceNumberSet_t> pair_T;
-
-void prepare_SequenceNumberSet(std::set<SequenceNumber_t>& changesSeqNum,
-        std::vector<pair_T>& sequences)
-{
-    //First compute the number of GAP messages we need:
-    bool new_pair = true;
-    bool seqnumset_init = false;
-    uint32_t count = 0;
-    for(auto it = changesSeqNum.begin();
-            it!=changesSeqNum.end();++it)
-    {
-        if(new_pair)
-        {
-            SequenceNumberSet_t seqset((*it) + 1); // IN CASE IN THIS SEQNUMSET there is only 1 number.
-            pair_T pair(*it,seqset);
-            sequences.push_back(pair);
-            new_pair = false;
-            seqnumset_init = true;
-            count = 1;
-            continue;
-        }
-        if((*it - sequences.back().first).low == count) //CONTINUOUS FROM THE START
-        {
-            ++count;
-            sequences.back().second.base((*it)+1);
-            continue;
-        }
-        else
-        {
-            if(seqnumset_init) //FIRST TIME SINCE it was continuous
-            {
-                sequences.back().second.base((*(std::prev(it)) + 1));
-                seqnumset_init = false;
-            }
-            // Try to add, If it fails the diference between *it and base is greater than 255.
-            if(sequences.back().second.add((*it)))
-                continue;
-            else
-            {
-                // Process again the sequence number in a new pair in next loop.
-                --it;
-                new_pair = true;
-            }
-        }
-    }
-}
+// Smaller payloads are copied, as that is cheaper than handing one more slice to the transport.
+static const uint32_t min_gathered_payload_size = 1024;
 
 bool compare_remote_participants(const std::vector<GUID_t>& remote_participants1,
         const std::vector<GuidPrefix_t>& remote_participants2)
@@ -148,7 +103,12 @@ RTPSMessageGroup::RTPSMessageGroup(
     , endpoint_(endpoint)
     , full_msg_(&msg_group.rtpsmsg_fullmsg_)
     , submessage_msg_(&msg_group.rtpsmsg_submessage_)
+    , gathered_payloads_(&msg_group.gathered_payloads_)
+    , buffers_(&msg_group.buffers_)
+    , gathered_bytes_(0)
+    , gather_payloads_(participant->accepts_gathered_messages())
     , currentBytesSent_(0)
+    , current_locators_(&msg_group.current_locators_)
     , fixed_destination_(false)
     , fixed_destination_locators_(nullptr)
     , fixed_destination_guids_(nullptr)
@@ -162,8 +122,17 @@ RTPSMessageGroup::RTPSMessageGroup(
     assert(endpoint);
     (void)type;
 
+#if HAVE_SECURITY
+    // The whole message is encoded at once
+    if (participant_->security_attributes().is_rtps_protected && endpoint_->supports_rtps_protection())
+    {
+        gather_payloads_ = false;
+    }
+#endif
+
     // Init RTPS message.
     reset_to_header();
+    current_locators_->clear();
 
     CDRMessage::initCDRMsg(submessage_msg_);
 
@@ -236,6 +205,8 @@ void RTPSMessageGroup::reset_to_header()
     CDRMessage::initCDRMsg(full_msg_);
     full_msg_->pos = RTPSMESSAGE_HEADER_SIZE;
     full_msg_->length = RTPSMESSAGE_HEADER_SIZE;
+    gathered_payloads_->clear();
+    gathered_bytes_ = 0;
 }
 
 bool RTPSMessageGroup::check_preconditions(const LocatorList_t& locator_list,
@@ -244,7 +215,7 @@ bool RTPSMessageGroup::check_preconditions(const LocatorList_t& locator_list,
     (void)remote_endpoints;
 
     return fixed_destination_  ||
-        (locator_list == current_locators_
+        (locator_list == *current_locators_
 #if HAVE_SECURITY
         && (!participant_->security_attributes().is_rtps_protected || !endpoint_->supports_rtps_protection() ||
          compare_remote_participants(remote_endpoints, current_remote_participants_))
@@ -265,6 +236,35 @@ void RTPSMessageGroup::send()
 
     if(full_msg_->length > RTPSMESSAGE_HEADER_SIZE)
     {
+        const LocatorList_t & destinations =
+            fixed_destination_ ? *fixed_destination_locators_ : *current_locators_;
+
+        if(!gathered_payloads_->empty())
+        {
+            // Send the message as slices of full_msg_ interleaved with the payloads left out of it.
+            uint32_t total_bytes = full_msg_->length + gathered_bytes_;
+            uint32_t position = 0;
+            buffers_->clear();
+            for(const RTPSMessageGroup_t::GatheredPayload& payload : *gathered_payloads_)
+            {
+                buffers_->emplace_back(full_msg_->buffer + position, payload.position - position);
+                buffers_->emplace_back(payload.data, payload.size);
+                position = payload.position;
+            }
+            if(position < full_msg_->length)
+            {
+                buffers_->emplace_back(full_msg_->buffer + position, full_msg_->length - position);
+            }
+
+            if(!participant_->sendSync(*buffers_, total_bytes, endpoint_, destinations, max_blocking_time_point_))
+            {
+                throw timeout();
+            }
+
+            currentBytesSent_ += total_bytes;
+            return;
+        }
+
 #if HAVE_SECURITY
         // TODO(Ricardo) Control message size if it will be encrypted.
         if(participant_->security_attributes().is_rtps_protected && endpoint_->supports_rtps_protection())
@@ -284,14 +284,9 @@ void RTPSMessageGroup::send()
             msgToSend = encrypt_msg_;
         }
 #endif
-        const LocatorList_t & destinations =
-            fixed_destination_ ? *fixed_destination_locators_ : current_locators_;
-        for(const auto& lit : destinations)
+        if(!participant_->sendSync(msgToSend, endpoint_, destinations, max_blocking_time_point_))
         {
-            if(!participant_->sendSync(msgToSend, endpoint_, lit, max_blocking_time_point_))
-            {
-                throw timeout();
-            }
+            throw timeout();
         }
 
         currentBytesSent_ += msgToSend->length;
@@ -309,7 +304,7 @@ void RTPSMessageGroup::flush_and_reset(const LocatorList_t& locator_list,
     // Reset
     if (!fixed_destination_)
     {
-        current_locators_.assign(locator_list);
+        current_locators_->assign(locator_list);
 #if HAVE_SECURITY
         if (participant_->security_attributes().is_rtps_protected && endpoint_->supports_rtps_protection())
         {
@@ -332,9 +327,10 @@ void RTPSMessageGroup::check_and_maybe_flush(const LocatorList_t& locator_list,
     add_info_dst_in_buffer(submessage_msg_, remote_endpoints);
 }
 
-bool RTPSMessageGroup::insert_submessage(const std::vector<GUID_t>& remote_endpoints)
+bool RTPSMessageGroup::insert_submessage(const std::vector<GUID_t>& remote_endpoints,
+        const NetworkBuffer* payload, uint32_t payload_position)
 {
-    if(!CDRMessage::appendMsg(full_msg_, submessage_msg_))
+    if(!append_submessage(payload, payload_position))
     {
         // Retry
         flush();
@@ -347,7 +343,7 @@ bool RTPSMessageGroup::insert_submessage(const std::vector<GUID_t>& remote_endpo
             return false;
         }
 
-        if(!CDRMessage::appendMsg(full_msg_, submessage_msg_))
+        if(!append_submessage(payload, payload_position))
         {
             logError(RTPS_WRITER,"Cannot add RTPS submesage to the CDRMessage. Buffer too small");
             return false;
@@ -357,6 +353,50 @@ bool RTPSMessageGroup::insert_submessage(const std::vector<GUID_t>& remote_endpo
     return true;
 }
 
+bool RTPSMessageGroup::append_submessage(const NetworkBuffer* payload, uint32_t payload_position)
+{
+    uint32_t payload_size = payload != nullptr ? payload->size : 0;
+    if(full_msg_->length + gathered_bytes_ + submessage_msg_->length + payload_size > full_msg_->max_size)
+    {
+        return false;
+    }
+
+    uint32_t submessage_position = full_msg_->length;
+    if(!CDRMessage::appendMsg(full_msg_, submessage_msg_))
+    {
+        return false;
+    }
+
+    if(payload != nullptr)
+    {
+        gathered_payloads_->push_back({submessage_position + payload_position, payload->buffer, payload->size});
+        gathered_bytes_ += payload_size;
+    }
+
+    return true;
+}
+
+bool RTPSMessageGroup::should_gather_payload(const CacheChange_t& change, uint32_t payload_size) const
+{
+    if(!gather_payloads_ || change.kind != ALIVE || change.serializedPayload.data == nullptr ||
+            payload_size < min_gathered_payload_size ||
+            gathered_payloads_->size() >= RTPSMessageGroup_t::max_gathered_payloads)
+    {
+        return false;
+    }
+
+#if HAVE_SECURITY
+    // Encoding needs the payload inside the submessage
+    const security::EndpointSecurityAttributes& security_attributes = endpoint_->getAttributes().security_attributes();
+    if(security_attributes.is_submessage_protected || security_attributes.is_payload_protected)
+    {
+        return false;
+    }
+#endif
+
+    return true;
+}
+
 bool RTPSMessageGroup::add_info_dst_in_buffer(CDRMessage_t* buffer, const std::vector<GUID_t>& remote_endpoints)
 {
 #if HAVE_SECURITY
@@ -459,10 +499,15 @@ bool RTPSMessageGroup::add_data(
 #endif
     const EntityId_t& readerId = get_entity_id(remote_readers);
 
+    // Large payloads are sent from the change instead of being copied into the message
+    NetworkBuffer payload(change.serializedPayload.data, change.serializedPayload.length);
+    bool gather = should_gather_payload(change, payload.size);
+    uint32_t payload_position = 0;
+
     // TODO (Ricardo). Check to create special wrapper.
 
     if(!RTPSMessageCreator::addSubmessageData(submessage_msg_, &change, endpoint_->getAttributes().topicKind,
-                readerId, expectsInlineQos, inlineQos))
+                readerId, expectsInlineQos, inlineQos, gather ? &payload_position : nullptr))
     {
         logError(RTPS_WRITER, "Cannot add DATA submsg to the CDRMessage. Buffer too small");
         return false;
@@ -494,7 +539,7 @@ bool RTPSMessageGroup::add_data(
     }
 #endif
 
-    return insert_submessage(remote_readers);
+    return insert_submessage(remote_readers, gather ? &payload : nullptr, payload_position);
 }
 
 bool RTPSMessageGroup::add_data_frag(
@@ -558,9 +603,14 @@ bool RTPSMessageGroup::add_data_frag(
     }
 #endif
 
+    // Large fragments are sent from the change instead of being copied into the message
+    NetworkBuffer payload(change_to_add.serializedPayload.data, change_to_add.serializedPayload.length);
+    bool gather = should_gather_payload(change_to_add, payload.size);
+    uint32_t payload_position = 0;
+
     if(!RTPSMessageCreator::addSubmessageDataFrag(submessage_msg_, &change_to_add, fragment_number,
                 change.serializedPayload.length, endpoint_->getAttributes().topicKind, readerId,
-                expectsInlineQos, inlineQos))
+                expectsInlineQos, inlineQos, gather ? &payload_position : nullptr))
     {
         logError(RTPS_WRITER, "Cannot add DATA_FRAG submsg to the CDRMessage. Buffer too small");
         change_to_add.serializedPayload.data = NULL;
@@ -594,7 +644,7 @@ bool RTPSMessageGroup::add_data_frag(
     }
 #endif
 
-    return insert_submessage(remote_readers);
+    return insert_submessage(remote_readers, gather ? &payload : nullptr, payload_position);
 }
 
 bool RTPSMessageGroup::add_heartbeat(const std::vector<GUID_t>& remote_readers, const SequenceNumber_t& firstSN,
@@ -646,67 +696,81 @@ bool RTPSMessageGroup::add_heartbeat(const std::vector<GUID_t>& remote_readers,
 }
 
 // TODO (Ricardo) Check with standard 8.3.7.4.5
-bool RTPSMessageGroup::add_gap(std::set<SequenceNumber_t>& changesSeqNum,
+bool RTPSMessageGroup::add_gap(const std::vector<SequenceNumber_t>& changesSeqNum,
         const std::vector<GUID_t>& remote_readers, const LocatorList_t& locators)
 {
-    std::vector<pair_T> Sequences;
-    prepare_SequenceNumberSet(changesSeqNum, Sequences);
-    std::vector<pair_T>::iterator seqit = Sequences.begin();
-
-    uint16_t gap_n = 1;
+    auto it = changesSeqNum.begin();
 
-    while(gap_n <= Sequences.size()) //There is still a message to add
+    while(it != changesSeqNum.end())
     {
-        // Check preconditions. If fail flush and reset.
-        check_and_maybe_flush(locators, remote_readers);
+        // Sequence numbers consecutive to the first one are covered moving the base of the list,
+        // the following ones are set on the list while they fit on it.
+        SequenceNumber_t gap_start = *it;
+        SequenceNumberSet_t gap_list(gap_start + 1);
+        for(++it; it != changesSeqNum.end() && *it == gap_list.base(); ++it)
+        {
+            gap_list.base(*it + 1);
+        }
+        while(it != changesSeqNum.end() && gap_list.add(*it))
+        {
+            ++it;
+        }
+
+        if(!add_gap(gap_start, gap_list, remote_readers, locators))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool RTPSMessageGroup::add_gap(const SequenceNumber_t& gap_start, const SequenceNumberSet_t& gap_list,
+        const std::vector<GUID_t>& remote_readers, const LocatorList_t& locators)
+{
+    // Check preconditions. If fail flush and reset.
+    check_and_maybe_flush(locators, remote_readers);
 
 #if HAVE_SECURITY
-        uint32_t from_buffer_position = submessage_msg_->pos;
+    uint32_t from_buffer_position = submessage_msg_->pos;
 #endif
 
-        const EntityId_t& readerId = get_entity_id(remote_readers);
+    const EntityId_t& readerId = get_entity_id(remote_readers);
 
-        if(!RTPSMessageCreator::addSubmessageGap(submessage_msg_, seqit->first, seqit->second,
-                readerId, endpoint_->getGuid().entityId))
-        {
-            logError(RTPS_WRITER, "Cannot add GAP submsg to the CDRMessage. Buffer too small");
-            break;
-        }
+    if(!RTPSMessageCreator::addSubmessageGap(submessage_msg_, gap_start, gap_list,
+            readerId, endpoint_->getGuid().entityId))
+    {
+        logError(RTPS_WRITER, "Cannot add GAP submsg to the CDRMessage. Buffer too small");
+        return false;
+    }
 
 #if HAVE_SECURITY
-        if(endpoint_->getAttributes().security_attributes().is_submessage_protected)
+    if(endpoint_->getAttributes().security_attributes().is_submessage_protected)
+    {
+        submessage_msg_->pos = from_buffer_position;
+        CDRMessage::initCDRMsg(encrypt_msg_);
+        if(!participant_->security_manager().encode_writer_submessage(*submessage_msg_, *encrypt_msg_,
+                    endpoint_->getGuid(), fixed_destination_ ? *fixed_destination_guids_ : remote_readers))
         {
-            submessage_msg_->pos = from_buffer_position;
-            CDRMessage::initCDRMsg(encrypt_msg_);
-            if(!participant_->security_manager().encode_writer_submessage(*submessage_msg_, *encrypt_msg_,
-                        endpoint_->getGuid(), fixed_destination_ ? *fixed_destination_guids_ : remote_readers))
-            {
-                logError(RTPS_WRITER, "Cannot encrypt DATA submessage for writer " << endpoint_->getGuid());
-                return false;
-            }
-
-            if((submessage_msg_->max_size - from_buffer_position) >= encrypt_msg_->length)
-            {
-                memcpy(&submessage_msg_->buffer[from_buffer_position], encrypt_msg_->buffer, encrypt_msg_->length);
-                submessage_msg_->length = from_buffer_position + encrypt_msg_->length;
-                submessage_msg_->pos = submessage_msg_->length;
-            }
-            else
-            {
-                logError(RTPS_OUT, "Not enough memory to copy encrypted data for " << endpoint_->getGuid());
-                return false;
-            }
+            logError(RTPS_WRITER, "Cannot encrypt DATA submessage for writer " << endpoint_->getGuid());
+            return false;
         }
-#endif
-
-        if(!insert_submessage(remote_readers))
-            break;
 
-        ++gap_n;
-        ++seqit;
+        if((submessage_msg_->max_size - from_buffer_position) >= encrypt_msg_->length)
+        {
+            memcpy(&submessage_msg_->buffer[from_buffer_position], encrypt_msg_->buffer, encrypt_msg_->length);
+            submessage_msg_->length = from_buffer_position + encrypt_msg_->length;
+            submessage_msg_->pos = submessage_msg_->length;
+        }
+        else
+        {
+            logError(RTPS_OUT, "Not enough memory to copy encrypted data for " << endpoint_->getGuid());
+            return false;
+        }
     }
+#endif
 
-    return true;
+    return insert_submessage(remote_readers);
 }
 
 bool RTPSMessageGroup::add_acknack(const std::vector<GUID_t>& remote_writers, SequenceNumberSet_t& SNSet,
@@ -48,7 +48,8 @@ bool RTPSMessageCreator::addSubmessageData(
         TopicKind_t topicKind,
         const EntityId_t& readerId,
         bool expectsInlineQos,
-        InlineQosWriter* inlineQos)
+        InlineQosWriter* inlineQos,
+        uint32_t* payload_position)
 {
     octet flags = 0x0;
     //Find out flags
@@ -160,8 +161,20 @@ bool RTPSMessageCreator::addSubmessageData(
     }
 
     //Add Serialized Payload
+    uint32_t payload_length = 0;
     if(dataFlag)
-        added_no_error &= CDRMessage::addData(msg, change->serializedPayload.data, change->serializedPayload.length);
+    {
+        if(payload_position != nullptr)
+        {
+            *payload_position = msg->pos;
+            payload_length = change->serializedPayload.length;
+        }
+        else
+        {
+            added_no_error &= CDRMessage::addData(msg, change->serializedPayload.data,
+                    change->serializedPayload.length);
+        }
+    }
 
     if(keyFlag)
     {
@@ -182,7 +195,7 @@ bool RTPSMessageCreator::addSubmessageData(
     }
 
     // Align submessage to rtps alignment (4).
-    uint32_t align = (4 - msg->pos % 4) & 3;
+    uint32_t align = (4 - (msg->pos + payload_length) % 4) & 3;
     for(uint32_t count = 0; count < align; ++count)
         added_no_error &= CDRMessage::addOctet(msg, 0);
 
@@ -194,7 +207,7 @@ bool RTPSMessageCreator::addSubmessageData(
 
 
     //TODO(Ricardo) Improve.
-    submessage_size = uint16_t(msg->pos - position_size_count_size);
+    submessage_size = uint16_t(msg->pos + payload_length - position_size_count_size);
     octet* o= reinterpret_cast<octet*>(&submessage_size);
     if(msg->msg_endian == DEFAULT_ENDIAN)
     {
@@ -252,7 +265,8 @@ bool RTPSMessageCreator::addSubmessageDataFrag(
         TopicKind_t topicKind,
         const EntityId_t& readerId,
         bool expectsInlineQos,
-        InlineQosWriter* inlineQos)
+        InlineQosWriter* inlineQos,
+        uint32_t* payload_position)
 {
     octet flags = 0x0;
     //Find out flags
@@ -374,10 +388,19 @@ bool RTPSMessageCreator::addSubmessageDataFrag(
     }
 
     //Add Serialized Payload XXX TODO
+    uint32_t payload_length = 0;
     if (!keyFlag) // keyflag = 0 means that the serializedPayload SubmessageElement contains the serialized Data 
     {
-        added_no_error &= CDRMessage::addData(msg, change->serializedPayload.data,
-                change->serializedPayload.length);
+        if (payload_position != nullptr)
+        {
+            *payload_position = msg->pos;
+            payload_length = change->serializedPayload.length;
+        }
+        else
+        {
+            added_no_error &= CDRMessage::addData(msg, change->serializedPayload.data,
+                    change->serializedPayload.length);
+        }
     }
     else
     {   // keyflag = 1 means that the serializedPayload SubmessageElement contains the serialized Key 
@@ -399,12 +422,12 @@ bool RTPSMessageCreator::addSubmessageDataFrag(
 
     // TODO(Ricardo) This should be on cachechange.
     // Align submessage to rtps alignment (4).
-    uint32_t align = (4 - msg->pos % 4) & 3;
+    uint32_t align = (4 - (msg->pos + payload_length) % 4) & 3;
     for (uint32_t count = 0; count < align; ++count)
         added_no_error &= CDRMessage::addOctet(msg, 0);
 
     //TODO(Ricardo) Improve.
-    submessage_size = uint16_t(msg->pos - position_size_count_size);
+    submessage_size = uint16_t(msg->pos + payload_length - position_size_count_size);
     octet* o= reinterpret_cast<octet*>(&submessage_size);
     if(msg->msg_endian == DEFAULT_ENDIAN)
     {
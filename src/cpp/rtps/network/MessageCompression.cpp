@@ -0,0 +1,377 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/config.h>
+#include <fastrtps/rtps/network/MessageCompression.h>
+#include <fastrtps/rtps/common/CDRMessage_t.h>
+#include <fastrtps/log/Log.h>
+
+#if HAVE_LZ4
+#include <lz4.h>
+#endif
+#if HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+namespace eprosima{
+namespace fastrtps{
+namespace rtps{
+
+const char* const MessageCompression::codec_property = "fastrtps.compression.codec";
+const char* const MessageCompression::threshold_property = "fastrtps.compression.threshold";
+const char* const MessageCompression::level_property = "fastrtps.compression.level";
+const char* const MessageCompression::accepted_codecs_property = "fastrtps.compression.accepted_codecs";
+
+static const uint32_t s_default_threshold = 512;
+
+// RTPS header, codec, reserved and length of the submessages
+static const uint32_t s_compressed_header_size = RTPSMESSAGE_HEADER_SIZE + 8;
+
+static std::atomic<uint64_t> s_compressed_messages(0);
+static std::atomic<uint64_t> s_uncompressed_bytes(0);
+static std::atomic<uint64_t> s_compressed_bytes(0);
+
+static const char* codec_name(MessageCompression::Codec codec)
+{
+    switch (codec)
+    {
+        case MessageCompression::LZ4:
+            return "lz4";
+        case MessageCompression::ZSTD:
+            return "zstd";
+        default:
+            return "none";
+    }
+}
+
+MessageCompression* MessageCompression::create(const PropertyPolicy& properties)
+{
+    const std::string* codec_value = PropertyPolicyHelper::find_property(properties, codec_property);
+    if (codec_value == nullptr)
+    {
+        return nullptr;
+    }
+
+    Codec codec = NONE;
+    if (*codec_value == codec_name(LZ4))
+    {
+        codec = LZ4;
+    }
+    else if (*codec_value == codec_name(ZSTD))
+    {
+        codec = ZSTD;
+    }
+
+    if (!is_available(codec))
+    {
+        logError(RTPS_PARTICIPANT, "Compression codec '" << *codec_value << "' is not available");
+        return nullptr;
+    }
+
+    uint32_t threshold = s_default_threshold;
+    const std::string* threshold_value = PropertyPolicyHelper::find_property(properties, threshold_property);
+    if (threshold_value != nullptr)
+    {
+        threshold = static_cast<uint32_t>(std::strtoul(threshold_value->c_str(), nullptr, 10));
+    }
+
+    int level = 1;
+    const std::string* level_value = PropertyPolicyHelper::find_property(properties, level_property);
+    if (level_value != nullptr)
+    {
+        level = std::atoi(level_value->c_str());
+    }
+
+    return new MessageCompression(codec, threshold, level);
+}
+
+bool MessageCompression::is_available(Codec codec)
+{
+    switch (codec)
+    {
+        case LZ4:
+            return HAVE_LZ4 != 0;
+        case ZSTD:
+            return HAVE_ZSTD != 0;
+        default:
+            return false;
+    }
+}
+
+std::string MessageCompression::available_codecs()
+{
+    std::string codecs;
+
+    for (Codec codec : { LZ4, ZSTD })
+    {
+        if (is_available(codec))
+        {
+            if (!codecs.empty())
+            {
+                codecs += ",";
+            }
+            codecs += codec_name(codec);
+        }
+    }
+
+    return codecs;
+}
+
+MessageCompression::Statistics MessageCompression::statistics()
+{
+    Statistics stats;
+    stats.messages = s_compressed_messages;
+    stats.uncompressed_bytes = s_uncompressed_bytes;
+    stats.compressed_bytes = s_compressed_bytes;
+    return stats;
+}
+
+bool MessageCompression::is_compressed(
+        const octet* data,
+        uint32_t size)
+{
+    return size >= s_compressed_header_size &&
+        data[0] == 'R' && data[1] == 'T' && data[2] == 'P' && data[3] == 'Z';
+}
+
+bool MessageCompression::decompress(
+        const octet* data,
+        uint32_t size,
+        octet* buffer,
+        uint32_t buffer_capacity,
+        uint32_t& length)
+{
+    if (!is_compressed(data, size) || buffer_capacity < RTPSMESSAGE_HEADER_SIZE)
+    {
+        return false;
+    }
+
+    const octet* info = data + RTPSMESSAGE_HEADER_SIZE;
+    Codec codec = static_cast<Codec>(info[0]);
+    uint32_t submessages_length = (static_cast<uint32_t>(info[4]) << 24) | (static_cast<uint32_t>(info[5]) << 16) |
+        (static_cast<uint32_t>(info[6]) << 8) | static_cast<uint32_t>(info[7]);
+
+    if (submessages_length > buffer_capacity - RTPSMESSAGE_HEADER_SIZE)
+    {
+        logWarning(RTPS_MSG_IN, "Compressed message bigger than the receive buffer, ignoring");
+        return false;
+    }
+
+    const octet* source = data + s_compressed_header_size;
+    size_t source_size = size - s_compressed_header_size;
+    octet* destination = buffer + RTPSMESSAGE_HEADER_SIZE;
+    bool success = false;
+
+    switch (codec)
+    {
+#if HAVE_LZ4
+        case LZ4:
+        {
+            int result = LZ4_decompress_safe(reinterpret_cast<const char*>(source),
+                    reinterpret_cast<char*>(destination), static_cast<int>(source_size),
+                    static_cast<int>(submessages_length));
+            success = result >= 0 && static_cast<uint32_t>(result) == submessages_length;
+            break;
+        }
+#endif
+#if HAVE_ZSTD
+        case ZSTD:
+        {
+            size_t result = ZSTD_decompress(destination, submessages_length, source, source_size);
+            success = !ZSTD_isError(result) && result == submessages_length;
+            break;
+        }
+#endif
+        default:
+            (void)source;
+            (void)source_size;
+            (void)destination;
+            logWarning(RTPS_MSG_IN, "Received message compressed with an unavailable codec: " <<
+                static_cast<int>(codec));
+            return false;
+    }
+
+    if (!success)
+    {
+        logWarning(RTPS_MSG_IN, "Failed to decompress message");
+        return false;
+    }
+
+    memcpy(buffer, data, RTPSMESSAGE_HEADER_SIZE);
+    buffer[3] = 'S';
+    length = RTPSMESSAGE_HEADER_SIZE + submessages_length;
+    return true;
+}
+
+MessageCompression::MessageCompression(
+        Codec codec,
+        uint32_t threshold,
+        int level)
+    : codec_(codec)
+    , threshold_(threshold)
+    , level_(level)
+    , context_(nullptr)
+{
+#if HAVE_ZSTD
+    if (codec_ == ZSTD)
+    {
+        context_ = ZSTD_createCCtx();
+    }
+#endif
+}
+
+MessageCompression::~MessageCompression()
+{
+#if HAVE_ZSTD
+    if (context_ != nullptr)
+    {
+        ZSTD_freeCCtx(static_cast<ZSTD_CCtx*>(context_));
+    }
+#endif
+}
+
+bool MessageCompression::is_accepted_by(const std::string& accepted_codecs) const
+{
+    std::istringstream codecs(accepted_codecs);
+    std::string codec;
+
+    while (std::getline(codecs, codec, ','))
+    {
+        if (codec == codec_name(codec_))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void MessageCompression::add_peer(const LocatorList_t& locators)
+{
+    std::lock_guard<std::mutex> lock(peers_mutex_);
+
+    for (auto it = locators.begin(); it != locators.end(); ++it)
+    {
+        ++peers_[*it];
+    }
+}
+
+void MessageCompression::remove_peer(const LocatorList_t& locators)
+{
+    std::lock_guard<std::mutex> lock(peers_mutex_);
+
+    for (auto it = locators.begin(); it != locators.end(); ++it)
+    {
+        auto peer = peers_.find(*it);
+        if (peer != peers_.end() && --peer->second == 0)
+        {
+            peers_.erase(peer);
+        }
+    }
+}
+
+bool MessageCompression::is_peer(const Locator_t& locator) const
+{
+    std::lock_guard<std::mutex> lock(peers_mutex_);
+    return peers_.find(locator) != peers_.end();
+}
+
+bool MessageCompression::compress(
+        const octet* data,
+        uint32_t size,
+        const octet*& compressed,
+        uint32_t& compressed_size)
+{
+    if (size < threshold_ || size <= s_compressed_header_size || is_compressed(data, size))
+    {
+        return false;
+    }
+
+    const octet* source = data + RTPSMESSAGE_HEADER_SIZE;
+    uint32_t source_size = size - RTPSMESSAGE_HEADER_SIZE;
+    // Only worth it if the message gets smaller
+    size_t capacity = size - s_compressed_header_size;
+
+    if (buffer_.size() < size)
+    {
+        buffer_.resize(size);
+    }
+    octet* destination = buffer_.data() + s_compressed_header_size;
+    size_t result = 0;
+
+    switch (codec_)
+    {
+#if HAVE_LZ4
+        case LZ4:
+        {
+            int lz4_result = LZ4_compress_fast(reinterpret_cast<const char*>(source),
+                    reinterpret_cast<char*>(destination), static_cast<int>(source_size),
+                    static_cast<int>(capacity), level_);
+            result = lz4_result > 0 ? static_cast<size_t>(lz4_result) : 0;
+            break;
+        }
+#endif
+#if HAVE_ZSTD
+        case ZSTD:
+        {
+            result = ZSTD_compressCCtx(static_cast<ZSTD_CCtx*>(context_), destination, capacity,
+                    source, source_size, level_);
+            if (ZSTD_isError(result))
+            {
+                result = 0;
+            }
+            break;
+        }
+#endif
+        default:
+            (void)source;
+            (void)capacity;
+            (void)destination;
+            break;
+    }
+
+    if (result == 0)
+    {
+        return false;
+    }
+
+    octet* header = buffer_.data();
+    memcpy(header, data, RTPSMESSAGE_HEADER_SIZE);
+    header[3] = 'Z';
+    octet* info = header + RTPSMESSAGE_HEADER_SIZE;
+    info[0] = static_cast<octet>(codec_);
+    info[1] = info[2] = info[3] = 0;
+    info[4] = static_cast<octet>(source_size >> 24);
+    info[5] = static_cast<octet>(source_size >> 16);
+    info[6] = static_cast<octet>(source_size >> 8);
+    info[7] = static_cast<octet>(source_size);
+
+    compressed = buffer_.data();
+    compressed_size = s_compressed_header_size + static_cast<uint32_t>(result);
+
+    ++s_compressed_messages;
+    s_uncompressed_bytes += size;
+    s_compressed_bytes += compressed_size;
+
+    return true;
+}
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
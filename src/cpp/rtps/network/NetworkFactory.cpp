@@ -47,7 +47,7 @@ bool NetworkFactory::build_send_resources(
 }
 
 bool NetworkFactory::BuildReceiverResources(Locator_t& local, uint32_t maxMsgSize,
-    std::vector<std::shared_ptr<ReceiverResource>>& returned_resources_list)
+    std::vector<std::shared_ptr<ReceiverResource>>& returned_resources_list, uint32_t receive_worker_threads)
 {
     bool returnedValue = false;
     for (auto& transport : mRegisteredTransports)
@@ -57,7 +57,7 @@ bool NetworkFactory::BuildReceiverResources(Locator_t& local, uint32_t maxMsgSiz
             if (!transport->IsInputChannelOpen(local))
             {
                 std::shared_ptr<ReceiverResource> newReceiverResource = std::shared_ptr<ReceiverResource>(
-                    new ReceiverResource(*transport, local, maxMsgSize));
+                    new ReceiverResource(*transport, local, maxMsgSize, receive_worker_threads));
 
                 if (newReceiverResource->mValid)
                 {
@@ -128,11 +128,29 @@ LocatorList_t NetworkFactory::ShrinkLocatorLists(const std::vector<LocatorList_t
 {
     LocatorList_t returnedList;
 
+    // Remote endpoints running on this host which are reachable through shared memory
+    // don't need their network locators.
+    std::vector<LocatorList_t> preferredLocatorLists;
+    for(auto& locatorList : locatorLists)
+    {
+        LocatorList_t sharedMemList;
+
+        for(auto it = locatorList.begin(); it != locatorList.end(); ++it)
+        {
+            if(it->kind == LOCATOR_KIND_SHM && is_local_locator(*it))
+            {
+                sharedMemList.push_back(*it);
+            }
+        }
+
+        preferredLocatorLists.push_back(sharedMemList.empty() ? locatorList : sharedMemList);
+    }
+
     for(auto& transport : mRegisteredTransports)
     {
         std::vector<LocatorList_t> transportLocatorLists;
 
-        for(auto& locatorList : locatorLists)
+        for(auto& locatorList : preferredLocatorLists)
         {
             LocatorList_t resultList;
 
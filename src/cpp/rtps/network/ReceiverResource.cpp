@@ -14,7 +14,12 @@
 
 #include <fastrtps/rtps/network/ReceiverResource.h>
 #include <fastrtps/rtps/messages/MessageReceiver.h>
+#include <fastrtps/rtps/network/MessageCompression.h>
 #include <cassert>
+#include <cstring>
+#include <condition_variable>
+#include <deque>
+#include <thread>
 #include <fastrtps/log/Log.h>
 
 #define IDSTRING "(ID:" << std::this_thread::get_id() <<") "<<
@@ -25,13 +30,192 @@ namespace eprosima{
 namespace fastrtps{
 namespace rtps{
 
-ReceiverResource::ReceiverResource(TransportInterface& transport, const Locator_t& locator, uint32_t max_size)
+//! Maximum number of messages waiting on a receive worker before the transport thread is blocked.
+static const size_t s_max_pending_messages_per_worker = 64;
+
+/**
+ * Thread processing the messages queued by the transport thread with its own MessageReceiver.
+ * Buffers are allocated the first time they are needed and reused afterwards.
+ */
+class ReceiverResource::ReceiveWorker
+{
+public:
+
+    explicit ReceiveWorker(uint32_t max_size)
+        : max_size_(max_size)
+        , running_(true)
+        , receiver_(nullptr)
+    {
+        thread_ = std::thread(&ReceiveWorker::run, this);
+    }
+
+    ~ReceiveWorker()
+    {
+        stop();
+    }
+
+    void push(const octet* data, uint32_t size, const Locator_t& remote_locator, const Time_t& reception_timestamp)
+    {
+        bool compressed = MessageCompression::is_compressed(data, size);
+        if (!compressed && size > max_size_)
+        {
+            logWarning(RTPS_MSG_IN, "Received message bigger than the receive buffers, ignoring");
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(queue_mtx_);
+
+        if (free_.empty() && buffers_.size() < s_max_pending_messages_per_worker)
+        {
+            buffers_.emplace_back(new Job(max_size_));
+            free_.push_back(buffers_.back().get());
+        }
+
+        // Let the socket buffer absorb the burst while this worker catches up.
+        free_cv_.wait(lock, [&]() { return !free_.empty() || !running_; });
+        if (!running_)
+        {
+            return;
+        }
+
+        Job* job = free_.back();
+        free_.pop_back();
+
+        // The job is owned by this thread now. Filling it without the lock lets the worker keep taking
+        // pending messages while a big one is decompressed.
+        lock.unlock();
+
+        bool filled = true;
+        if (compressed)
+        {
+            uint32_t length = 0;
+            filled = MessageCompression::decompress(data, size, job->msg.buffer, max_size_, length);
+            job->msg.length = length;
+        }
+        else
+        {
+            memcpy(job->msg.buffer, data, size);
+            job->msg.length = size;
+        }
+        job->remote_locator = remote_locator;
+        job->reception_timestamp = reception_timestamp;
+
+        lock.lock();
+
+        if (filled)
+        {
+            pending_.push_back(job);
+            pending_cv_.notify_one();
+        }
+        else
+        {
+            free_.push_back(job);
+            free_cv_.notify_one();
+        }
+    }
+
+    bool register_receiver(MessageReceiver* rcv)
+    {
+        std::lock_guard<std::mutex> lock(process_mtx_);
+        if (receiver_ == nullptr)
+        {
+            receiver_ = rcv;
+            return true;
+        }
+        return false;
+    }
+
+    bool unregister_receiver(MessageReceiver* rcv)
+    {
+        std::lock_guard<std::mutex> lock(process_mtx_);
+        if (receiver_ == rcv)
+        {
+            receiver_ = nullptr;
+            return true;
+        }
+        return false;
+    }
+
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(queue_mtx_);
+            running_ = false;
+        }
+        pending_cv_.notify_all();
+        free_cv_.notify_all();
+
+        if (thread_.joinable())
+        {
+            thread_.join();
+        }
+    }
+
+private:
+
+    struct Job
+    {
+        explicit Job(uint32_t size) : msg(size) {}
+
+        CDRMessage_t msg;
+        Locator_t remote_locator;
+        Time_t reception_timestamp;
+    };
+
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(queue_mtx_);
+
+        while (true)
+        {
+            pending_cv_.wait(lock, [&]() { return !pending_.empty() || !running_; });
+            if (!running_)
+            {
+                return;
+            }
+
+            Job* job = pending_.front();
+            pending_.pop_front();
+            lock.unlock();
+
+            {
+                std::lock_guard<std::mutex> process_lock(process_mtx_);
+                if (receiver_ != nullptr)
+                {
+                    receiver_->processCDRMsg(job->remote_locator, &job->msg, job->reception_timestamp);
+                }
+            }
+
+            lock.lock();
+            free_.push_back(job);
+            free_cv_.notify_one();
+        }
+    }
+
+    uint32_t max_size_;
+    bool running_;
+    std::thread thread_;
+
+    std::mutex queue_mtx_;
+    std::condition_variable pending_cv_;
+    std::condition_variable free_cv_;
+    std::vector<std::unique_ptr<Job>> buffers_;
+    std::vector<Job*> free_;
+    std::deque<Job*> pending_;
+
+    std::mutex process_mtx_;
+    MessageReceiver* receiver_;
+};
+
+ReceiverResource::ReceiverResource(TransportInterface& transport, const Locator_t& locator, uint32_t max_size,
+        uint32_t receive_worker_threads)
         : Cleanup(nullptr)
         , LocatorMapsToManagedChannel(nullptr)
         , mValid(false)
         , mtx()
         , receiver(nullptr)
         , msg(0)
+        , max_message_size_(max_size)
 {
     // Internal channel is opened and assigned to this resource.
     mValid = transport.OpenInputChannel(locator, this, max_size);
@@ -44,6 +228,11 @@ ReceiverResource::ReceiverResource(TransportInterface& transport, const Locator_
     Cleanup = [&transport, locator]() { transport.CloseInputChannel(locator); };
     LocatorMapsToManagedChannel = [&transport, locator](const Locator_t& locatorToCheck) -> bool
     { return transport.DoInputLocatorsMatch(locator, locatorToCheck); };
+
+    for (uint32_t i = 0; i < receive_worker_threads; ++i)
+    {
+        workers_.emplace_back(new ReceiveWorker(max_size));
+    }
 }
 
 ReceiverResource::ReceiverResource(ReceiverResource&& rValueResource)
@@ -55,6 +244,9 @@ ReceiverResource::ReceiverResource(ReceiverResource&& rValueResource)
     mValid = rValueResource.mValid;
     rValueResource.mValid = false;
     msg = std::move(rValueResource.msg);
+    max_message_size_ = rValueResource.max_message_size_;
+    decompressed_msg_ = std::move(rValueResource.decompressed_msg_);
+    workers_.swap(rValueResource.workers_);
 }
 
 bool ReceiverResource::SupportsLocator(const Locator_t& localLocator)
@@ -69,34 +261,101 @@ bool ReceiverResource::SupportsLocator(const Locator_t& localLocator)
 void ReceiverResource::RegisterReceiver(MessageReceiver* rcv)
 {
     std::unique_lock<std::mutex> lock(mtx);
-    if (receiver == nullptr)
+    if (!workers_.empty())
+    {
+        for (auto& worker : workers_)
+        {
+            if (worker->register_receiver(rcv))
+            {
+                break;
+            }
+        }
+    }
+    else if (receiver == nullptr)
         receiver = rcv;
 }
 
 void ReceiverResource::UnregisterReceiver(MessageReceiver* rcv)
 {
     std::unique_lock<std::mutex> lock(mtx);
-    if (receiver == rcv)
+    if (!workers_.empty())
+    {
+        for (auto& worker : workers_)
+        {
+            if (worker->unregister_receiver(rcv))
+            {
+                break;
+            }
+        }
+    }
+    else if (receiver == rcv)
         receiver = nullptr;
 }
 
+uint32_t ReceiverResource::number_of_receivers() const
+{
+    return workers_.empty() ? 1u : static_cast<uint32_t>(workers_.size());
+}
+
 void ReceiverResource::OnDataReceived(const octet * data, const uint32_t size,
     const Locator_t & localLocator, const Locator_t & remoteLocator)
+{
+    OnDataReceived(data, size, localLocator, remoteLocator, c_TimeZero);
+}
+
+void ReceiverResource::OnDataReceived(const octet * data, const uint32_t size,
+    const Locator_t & localLocator, const Locator_t & remoteLocator, const Time_t& reception_timestamp)
 {
     (void)localLocator;
 
+    if (!workers_.empty())
+    {
+        // All messages from a participant go to the same worker, so the changes of each writer keep their order.
+        size_t index = 0;
+        if (size >= RTPSMESSAGE_HEADER_SIZE)
+        {
+            // FNV-1a over the GuidPrefix of the RTPS header
+            uint32_t hash = 2166136261u;
+            for (uint32_t i = 8; i < RTPSMESSAGE_HEADER_SIZE; ++i)
+            {
+                hash ^= data[i];
+                hash *= 16777619u;
+            }
+            index = hash % workers_.size();
+        }
+
+        workers_[index]->push(data, size, remoteLocator, reception_timestamp);
+        return;
+    }
+
     std::unique_lock<std::mutex> lock(mtx);
     MessageReceiver* rcv = receiver;
 
     if (rcv != nullptr)
     {
+        if (MessageCompression::is_compressed(data, size))
+        {
+            if (!decompressed_msg_)
+            {
+                decompressed_msg_.reset(new CDRMessage_t(max_message_size_));
+            }
+
+            uint32_t length = 0;
+            if (MessageCompression::decompress(data, size, decompressed_msg_->buffer, max_message_size_, length))
+            {
+                decompressed_msg_->length = length;
+                rcv->processCDRMsg(remoteLocator, decompressed_msg_.get(), reception_timestamp);
+            }
+            return;
+        }
+
         msg.wraps = true;
         msg.buffer = const_cast<octet*>(data);
         msg.length = size;
         msg.max_size = size;
 
         // TODO: Should we unlock in case UnregisterReceiver is called from callback ?
-        rcv->processCDRMsg(remoteLocator, &msg);
+        rcv->processCDRMsg(remoteLocator, &msg, reception_timestamp);
     }
 
 }
@@ -107,10 +366,22 @@ void ReceiverResource::disable()
     {
         Cleanup();
     }
+
+    // The transport thread has finished, so nothing else will be queued.
+    stop_workers();
+}
+
+void ReceiverResource::stop_workers()
+{
+    for (auto& worker : workers_)
+    {
+        worker->stop();
+    }
 }
 
 ReceiverResource::~ReceiverResource()
 {
+    stop_workers();
 }
 
 } // namespace rtps
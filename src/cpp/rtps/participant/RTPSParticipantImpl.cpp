@@ -56,6 +56,7 @@
 
 #include <mutex>
 #include <algorithm>
+#include <cassert>
 
 #include <fastrtps/log/Log.h>
 
@@ -63,6 +64,9 @@ namespace eprosima {
 namespace fastrtps{
 namespace rtps {
 
+//! Time given to the send queue to send what is still queued when the participant is destroyed.
+static const uint32_t s_send_queue_drain_ms = 500;
+
 static EntityId_t TrustedWriter(const EntityId_t& reader)
 {
     return
@@ -89,9 +93,11 @@ RTPSParticipantImpl::RTPSParticipantImpl(const RTPSParticipantAttributes& PParam
     , mp_builtinProtocols(nullptr)
     , mp_ResourceSemaphore(new Semaphore(0))
     , IdCounter(0)
+    , reader_matching_epoch_(0)
 #if HAVE_SECURITY
     , m_security_manager(this)
 #endif
+    , compression_(MessageCompression::create(PParam.properties))
     , mp_participantListener(plisten)
     , mp_userParticipant(par)
     , mp_mutex(new std::recursive_mutex())
@@ -142,6 +148,21 @@ RTPSParticipantImpl::RTPSParticipantImpl(const RTPSParticipantAttributes& PParam
         m_controllers.push_back(std::move(controller));
     }
 
+    update_send_resources();
+
+    if (m_att.sendQueueSize > 0)
+    {
+        send_queue_.reset(new SendQueue(m_att.sendQueueSize,
+            [this](const octet* data, uint32_t length, const Locator_t& destination_loc)
+            {
+                SendResourcesSnapshot resources;
+                if (get_send_resources(resources, std::chrono::steady_clock::time_point::max()))
+                {
+                    send_to_resources(*resources, data, length, destination_loc);
+                }
+            }));
+    }
+
     /* If metatrafficMulticastLocatorList is empty, add mandatory default Locators
        Else -> Take them */
 
@@ -300,6 +321,14 @@ RTPSParticipantImpl::~RTPSParticipantImpl()
 
     delete(this->mp_ResourceSemaphore);
     delete(this->mp_userParticipant);
+
+    // Sends what is still queued, like the last announcements of the builtin protocols, for a bounded time
+    if (send_queue_)
+    {
+        send_queue_->stop(std::chrono::steady_clock::now() + std::chrono::milliseconds(s_send_queue_drain_ms));
+        send_queue_.reset();
+    }
+    send_resources_.reset();
     send_resource_list_.clear();
 
     delete(this->mp_event_thr);
@@ -791,6 +820,7 @@ bool RTPSParticipantImpl::createSendResources(Endpoint *pend)
                     pend->getGuid() << ", " << (*it) << ")");
         }
     }
+    update_send_resources();
 
     return true;
 }
@@ -802,7 +832,8 @@ void RTPSParticipantImpl::createReceiverResources(LocatorList_t& Locator_list, b
     uint32_t size = m_network_Factory.get_max_message_size_between_transports();
     for (auto it_loc = Locator_list.begin(); it_loc != Locator_list.end(); ++it_loc)
     {
-        bool ret = m_network_Factory.BuildReceiverResources(*it_loc, size, newItemsBuffer);
+        bool ret = m_network_Factory.BuildReceiverResources(*it_loc, size, newItemsBuffer,
+                m_att.receiveWorkerThreads);
         if (!ret && ApplyMutation)
         {
             uint32_t tries = 0;
@@ -810,20 +841,26 @@ void RTPSParticipantImpl::createReceiverResources(LocatorList_t& Locator_list, b
             {
                 tries++;
                 *it_loc = applyLocatorAdaptRule(*it_loc);
-                ret = m_network_Factory.BuildReceiverResources(*it_loc, size, newItemsBuffer);
+                ret = m_network_Factory.BuildReceiverResources(*it_loc, size, newItemsBuffer,
+                        m_att.receiveWorkerThreads);
             }
         }
 
         for (auto it_buffer = newItemsBuffer.begin(); it_buffer != newItemsBuffer.end(); ++it_buffer)
         {
             std::lock_guard<std::mutex> lock(m_receiverResourcelistMutex);
-            //Push the new items into the ReceiverResource buffer
-            m_receiverResourcelist.emplace_back(*it_buffer);
-            //Create and init the MessageReceiver
-            auto mr = new MessageReceiver(this, size);
-            m_receiverResourcelist.back().mp_receiver = mr;
-            //Start reception
-            m_receiverResourcelist.back().Receiver->RegisterReceiver(mr);
+            //Resources with receive workers need one MessageReceiver per worker
+            uint32_t num_receivers = (*it_buffer)->number_of_receivers();
+            for (uint32_t i = 0; i < num_receivers; ++i)
+            {
+                //Push the new items into the ReceiverResource buffer
+                m_receiverResourcelist.emplace_back(*it_buffer);
+                //Create and init the MessageReceiver
+                auto mr = new MessageReceiver(this, size);
+                m_receiverResourcelist.back().mp_receiver = mr;
+                //Start reception
+                m_receiverResourcelist.back().Receiver->RegisterReceiver(mr);
+            }
         }
         newItemsBuffer.clear();
     }
@@ -849,6 +886,36 @@ void RTPSParticipantImpl::createSenderResources(LocatorList_t& Locator_list, boo
             ++tries;
         } while (!were_created && ApplyMutation && (tries <= m_att.builtin.mutation_tries));
     }
+
+    update_send_resources();
+}
+
+void RTPSParticipantImpl::update_send_resources()
+{
+    std::shared_ptr<std::vector<SenderResource*>> resources = std::make_shared<std::vector<SenderResource*>>();
+    resources->reserve(send_resource_list_.size());
+    for (auto& send_resource : send_resource_list_)
+    {
+        resources->push_back(send_resource.get());
+    }
+
+    // Senders still using the previous snapshot are not affected, resources are never removed while running
+    send_resources_ = resources;
+}
+
+bool RTPSParticipantImpl::get_send_resources(
+        SendResourcesSnapshot& resources,
+        const std::chrono::steady_clock::time_point& max_blocking_time_point)
+{
+    std::unique_lock<std::timed_mutex> lock(m_send_resources_mutex_, std::defer_lock);
+
+    if (!lock.try_lock_until(max_blocking_time_point))
+    {
+        return false;
+    }
+
+    resources = send_resources_;
+    return true;
 }
 
 bool RTPSParticipantImpl::deleteUserEndpoint(Endpoint* p_endpoint)
@@ -989,20 +1056,142 @@ bool RTPSParticipantImpl::sendSync(
         const Locator_t& destination_loc,
         std::chrono::steady_clock::time_point& max_blocking_time_point)
 {
-    bool ret_code = false;
-    std::unique_lock<std::timed_mutex> lock(m_send_resources_mutex_, std::defer_lock);
+    if (send_queue_)
+    {
+        LocatorList_t destination_locs;
+        destination_locs.push_back(destination_loc);
+        return send_queue_->push(msg->buffer, msg->length, destination_locs, max_blocking_time_point);
+    }
+
+    SendResourcesSnapshot resources;
+    if (!get_send_resources(resources, max_blocking_time_point))
+    {
+        return false;
+    }
+
+    send_to_resources(*resources, msg->buffer, msg->length, destination_loc);
+    return true;
+}
+
+void RTPSParticipantImpl::send_to_resources(
+        const std::vector<SenderResource*>& resources,
+        const octet* data,
+        uint32_t length,
+        const Locator_t& destination_loc)
+{
+    if (compression_ && compression_->is_peer(destination_loc))
+    {
+        std::lock_guard<std::mutex> lock(compression_mutex_);
+        const octet* buffer = nullptr;
+        uint32_t compressed_length = 0;
+        if (compression_->compress(data, length, buffer, compressed_length))
+        {
+            for (SenderResource* send_resource : resources)
+            {
+                send_resource->send(buffer, compressed_length, destination_loc);
+            }
+            return;
+        }
+    }
+
+    for (SenderResource* send_resource : resources)
+    {
+        send_resource->send(data, length, destination_loc);
+    }
+}
+
+bool RTPSParticipantImpl::sendSync(
+        CDRMessage_t* msg,
+        Endpoint* /*pend*/,
+        const LocatorList_t& destination_locs,
+        std::chrono::steady_clock::time_point& max_blocking_time_point)
+{
+    if (send_queue_)
+    {
+        return send_queue_->push(msg->buffer, msg->length, destination_locs, max_blocking_time_point);
+    }
+
+    SendResourcesSnapshot resources;
+    if (!get_send_resources(resources, max_blocking_time_point))
+    {
+        return false;
+    }
 
-    if(lock.try_lock_until(max_blocking_time_point))
+    if (compression_)
     {
-        ret_code = true;
+        // Only the peers that announced the codec get the compressed message
+        LocatorList_t compressed_locs;
+        LocatorList_t raw_locs;
+        for (auto it = destination_locs.begin(); it != destination_locs.end(); ++it)
+        {
+            if (compression_->is_peer(*it))
+            {
+                compressed_locs.push_back(*it);
+            }
+            else
+            {
+                raw_locs.push_back(*it);
+            }
+        }
 
-        for (auto& send_resource : send_resource_list_)
+        if (!compressed_locs.empty())
         {
-            send_resource->send(msg->buffer, msg->length, destination_loc);
+            std::lock_guard<std::mutex> lock(compression_mutex_);
+            const octet* buffer = nullptr;
+            uint32_t length = 0;
+            if (compression_->compress(msg->buffer, msg->length, buffer, length))
+            {
+                for (SenderResource* send_resource : *resources)
+                {
+                    send_resource->send(buffer, length, compressed_locs);
+                }
+            }
+            else
+            {
+                raw_locs.push_back(compressed_locs);
+            }
+        }
+
+        if (!raw_locs.empty())
+        {
+            for (SenderResource* send_resource : *resources)
+            {
+                send_resource->send(msg->buffer, msg->length, raw_locs);
+            }
         }
     }
+    else
+    {
+        for (SenderResource* send_resource : *resources)
+        {
+            send_resource->send(msg->buffer, msg->length, destination_locs);
+        }
+    }
+
+    return true;
+}
 
-    return ret_code;
+bool RTPSParticipantImpl::sendSync(
+        const std::vector<NetworkBuffer>& buffers,
+        uint32_t total_bytes,
+        Endpoint* /*pend*/,
+        const LocatorList_t& destination_locs,
+        std::chrono::steady_clock::time_point& max_blocking_time_point)
+{
+    assert(accepts_gathered_messages());
+
+    SendResourcesSnapshot resources;
+    if (!get_send_resources(resources, max_blocking_time_point))
+    {
+        return false;
+    }
+
+    for (SenderResource* send_resource : *resources)
+    {
+        send_resource->send(buffers, total_bytes, destination_locs);
+    }
+
+    return true;
 }
 
 void RTPSParticipantImpl::setGuid(GUID_t& guid)
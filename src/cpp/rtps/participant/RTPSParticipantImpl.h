@@ -43,6 +43,8 @@
 #include <fastrtps/rtps/network/NetworkFactory.h>
 #include <fastrtps/rtps/network/ReceiverResource.h>
 #include <fastrtps/rtps/network/SenderResource.h>
+#include <fastrtps/rtps/network/MessageCompression.h>
+#include "SendQueue.h"
 #include <fastrtps/rtps/messages/MessageReceiver.h>
 
 #if HAVE_SECURITY
@@ -188,6 +190,42 @@ public:
             const Locator_t& destination_loc,
             std::chrono::steady_clock::time_point& max_blocking_time_point);
 
+    /**
+     * Send a message to several destinations. Each send resource gets the whole list of destinations at once,
+     * so transports able to do it can deliver all of them with a single operation.
+     * @param msg Message to send.
+     * @param pend Endpoint sending the message.
+     * @param destination_locs Locators of the destinations.
+     * @param max_blocking_time_point Time point until the send resources are waited for.
+     * @return false when the send resources could not be taken before max_blocking_time_point.
+     */
+    bool sendSync(
+            CDRMessage_t* msg,
+            Endpoint *pend,
+            const LocatorList_t& destination_locs,
+            std::chrono::steady_clock::time_point& max_blocking_time_point);
+
+    /**
+     * Send a message made of several slices to several destinations. The slices reach the send resources as they
+     * are, so large payloads can be sent from where they are stored.
+     * Only allowed when accepts_gathered_messages() returns true.
+     * @param buffers Slices of the message, in order.
+     * @param total_bytes Sum of the sizes of the slices.
+     * @param pend Endpoint sending the message.
+     * @param destination_locs Locators of the destinations.
+     * @param max_blocking_time_point Time point until the send resources are waited for.
+     * @return false when the send resources could not be taken before max_blocking_time_point.
+     */
+    bool sendSync(
+            const std::vector<NetworkBuffer>& buffers,
+            uint32_t total_bytes,
+            Endpoint *pend,
+            const LocatorList_t& destination_locs,
+            std::chrono::steady_clock::time_point& max_blocking_time_point);
+
+    //! Whether messages can be sent as several slices. The send queue and compression need them contiguous.
+    bool accepts_gathered_messages() const { return !send_queue_ && !compression_; }
+
     //!Get the participant Mutex
     std::recursive_mutex* getParticipantMutex() const { return mp_mutex; };
 
@@ -207,6 +245,9 @@ public:
 
     std::vector<std::unique_ptr<FlowController>>& getFlowControllers() { return m_controllers; }
 
+    //!Get the message compression filter, nullptr if compression is disabled.
+    MessageCompression* compression() const { return compression_.get(); }
+
     /*!
         * @remarks Non thread-safe.
         */
@@ -252,6 +293,15 @@ public:
 
     uint32_t get_min_network_send_buffer_size() { return m_network_Factory.get_min_send_buffer_size(); }
 
+    /**
+     * Notifies that a local reader may now accept messages from a different set of writers.
+     * Message receivers use it to invalidate their cached dispatch lists.
+     */
+    void reader_matching_changed() { ++reader_matching_epoch_; }
+
+    //! Number of times reader_matching_changed has been called.
+    uint32_t reader_matching_epoch() const { return reader_matching_epoch_.load(); }
+
 private:
     //!Attributes of the RTPSParticipant
     RTPSParticipantAttributes m_att;
@@ -278,6 +328,8 @@ private:
     std::vector<RTPSReader*> m_userReaderList;
     //!Network Factory
     NetworkFactory m_network_Factory;
+    //!Increased each time the writers accepted by a local reader change.
+    std::atomic<uint32_t> reader_matching_epoch_;
 
 #if HAVE_SECURITY
         // Security manager
@@ -293,10 +345,45 @@ private:
     //! Receiver resource list needs its own mutext to avoid a race condition.
     std::mutex m_receiverResourcelistMutex;
 
+    typedef std::shared_ptr<const std::vector<SenderResource*>> SendResourcesSnapshot;
+
     //!SenderResource List
     std::timed_mutex m_send_resources_mutex_;
     SendResourceList send_resource_list_;
 
+    /**
+     * Send resources in use, replaced each time one is added to send_resource_list_.
+     * Writers only hold m_send_resources_mutex_ to get it, so independent writers send their messages in parallel.
+     */
+    SendResourcesSnapshot send_resources_;
+
+    //!Compression applied to the messages sent to the peers accepting it.
+    std::unique_ptr<MessageCompression> compression_;
+
+    //!Protects the buffer the messages are compressed to.
+    std::mutex compression_mutex_;
+
+    //!Sender stage, only created when m_att.sendQueueSize is not zero.
+    std::unique_ptr<SendQueue> send_queue_;
+
+    /**
+     * Gets the send resources in use, waiting until the given time point for the resources being added.
+     * @return false on timeout.
+     */
+    bool get_send_resources(
+            SendResourcesSnapshot& resources,
+            const std::chrono::steady_clock::time_point& max_blocking_time_point);
+
+    //! Replaces send_resources_ after adding to send_resource_list_. m_send_resources_mutex_ should be locked.
+    void update_send_resources();
+
+    //! Sends a message to a single destination through all the given send resources.
+    void send_to_resources(
+            const std::vector<SenderResource*>& resources,
+            const octet* data,
+            uint32_t length,
+            const Locator_t& destination_loc);
+
     //!Participant Listener
     RTPSParticipantListener* mp_participantListener;
     //!Pointer to the user participant
@@ -0,0 +1,206 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file SendQueue.cpp
+ */
+
+#include "SendQueue.h"
+
+#include <fastrtps/rtps/common/CDRMessage_t.h>
+#include <fastrtps/rtps/messages/RTPS_messages.h>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+SendQueue::SendQueue(
+        uint32_t max_bytes_per_destination,
+        SendFunction send)
+    : max_bytes_per_destination_(max_bytes_per_destination)
+    , send_(send)
+    , running_(true)
+    , finished_(false)
+{
+    thread_ = std::thread(&SendQueue::run, this);
+}
+
+SendQueue::~SendQueue()
+{
+    stop(std::chrono::steady_clock::now());
+}
+
+void SendQueue::stop(
+        const std::chrono::steady_clock::time_point& max_drain_time_point)
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        running_ = false;
+        pending_cv_.notify_all();
+        space_cv_.notify_all();
+
+        // A destination which doesn't accept data could keep the send thread busy forever
+        if (!finished_cv_.wait_until(lock, max_drain_time_point, [&]() { return finished_; }))
+        {
+            ready_.clear();
+            destinations_.clear();
+            pending_cv_.notify_all();
+        }
+    }
+
+    if (thread_.joinable())
+    {
+        thread_.join();
+    }
+}
+
+bool SendQueue::push(
+        const octet* data,
+        uint32_t length,
+        const LocatorList_t& destinations,
+        const std::chrono::steady_clock::time_point& max_blocking_time_point)
+{
+    Lane lane = classify(data, length);
+    Message message = std::make_shared<std::vector<octet>>(data, data + length);
+    bool ret_code = true;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    for (auto it = destinations.begin(); it != destinations.end(); ++it)
+    {
+        const Locator_t& locator = *it;
+
+        // A message bigger than the limit is still accepted on an empty destination
+        auto has_space = [&]()
+        {
+            auto destination = destinations_.find(locator);
+            return !running_ || destination == destinations_.end() || destination->second.bytes == 0 ||
+                destination->second.bytes + length <= max_bytes_per_destination_;
+        };
+
+        if (!space_cv_.wait_until(lock, max_blocking_time_point, has_space) || !running_)
+        {
+            ret_code = false;
+            continue;
+        }
+
+        // Looked up again, as the send thread removes the destinations it empties
+        Destination& destination = destinations_[locator];
+        if (destination.bytes == 0)
+        {
+            ready_.push_back(locator);
+            pending_cv_.notify_one();
+        }
+        destination.lanes[lane].push_back(message);
+        destination.bytes += length;
+    }
+
+    return ret_code;
+}
+
+SendQueue::Lane SendQueue::classify(
+        const octet* data,
+        uint32_t length)
+{
+    uint32_t pos = RTPSMESSAGE_HEADER_SIZE;
+    bool control = false;
+
+    while (pos + RTPSMESSAGE_SUBMESSAGEHEADER_SIZE <= length)
+    {
+        octet id = data[pos];
+        octet flags = data[pos + 1];
+        uint16_t octets_to_next_header = (flags & BIT(0)) ?
+            static_cast<uint16_t>(data[pos + 2] | (data[pos + 3] << 8)) :
+            static_cast<uint16_t>((data[pos + 2] << 8) | data[pos + 3]);
+
+        switch (id)
+        {
+            case ACKNACK:
+            case NACK_FRAG:
+            // A GAP only marks sequence numbers as irrelevant, so the reader handles it the same way whether it
+            // arrives before or after the DATA of other sequence numbers queued in the bulk lane.
+            case GAP:
+                control = true;
+                break;
+            case INFO_TS:
+            case INFO_SRC:
+            case INFO_REPLY_IP4:
+            case INFO_DST:
+            case INFO_REPLY:
+            case PAD:
+                break;
+            default:
+                // DATA, DATA_FRAG and protected submessages keep the order of the writer. So do HEARTBEAT and
+                // HEARTBEAT_FRAG: sent ahead of the DATA they announce, they would make readers request repairs
+                // of samples which are still queued.
+                return BULK_LANE;
+        }
+
+        if (octets_to_next_header == 0 && id != PAD && id != INFO_TS)
+        {
+            // Last submessage
+            break;
+        }
+
+        pos += RTPSMESSAGE_SUBMESSAGEHEADER_SIZE + octets_to_next_header;
+    }
+
+    return control ? CONTROL_LANE : BULK_LANE;
+}
+
+void SendQueue::run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (true)
+    {
+        // Once stopped, the messages already queued are still sent
+        pending_cv_.wait(lock, [&]() { return !ready_.empty() || !running_; });
+        if (ready_.empty())
+        {
+            finished_ = true;
+            finished_cv_.notify_all();
+            return;
+        }
+
+        Locator_t locator = ready_.front();
+        ready_.pop_front();
+
+        auto destination = destinations_.find(locator);
+        std::deque<Message>& lane = destination->second.lanes[CONTROL_LANE].empty() ?
+            destination->second.lanes[BULK_LANE] : destination->second.lanes[CONTROL_LANE];
+        Message message = std::move(lane.front());
+        lane.pop_front();
+        destination->second.bytes -= static_cast<uint32_t>(message->size());
+
+        // One message per turn, so a destination with a big backlog doesn't delay the others
+        if (destination->second.bytes > 0)
+        {
+            ready_.push_back(locator);
+        }
+        else
+        {
+            destinations_.erase(destination);
+        }
+        space_cv_.notify_all();
+
+        lock.unlock();
+        send_(message->data(), static_cast<uint32_t>(message->size()), locator);
+        lock.lock();
+    }
+}
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
@@ -0,0 +1,139 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file SendQueue.h
+ */
+
+#ifndef _RTPS_PARTICIPANT_SENDQUEUE_H_
+#define _RTPS_PARTICIPANT_SENDQUEUE_H_
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+
+#include <fastrtps/rtps/common/Locator.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+/**
+ * Sender stage of a participant. Messages are queued per destination locator and sent by a dedicated thread,
+ * visiting the destinations with pending messages in turns.
+ *
+ * Each destination has two lanes. Messages carrying only reader feedback (ACKNACK, NACK_FRAG) or GAP go to the
+ * control lane, which is always emptied before the bulk lane, so repair requests and the answers that need no data
+ * are not delayed behind large fragmented samples. Messages with DATA, DATA_FRAG, HEARTBEAT or HEARTBEAT_FRAG keep
+ * their order in the bulk lane, so a heartbeat never announces samples that have not been sent yet.
+ */
+class SendQueue
+{
+public:
+
+    enum Lane
+    {
+        CONTROL_LANE = 0,
+        BULK_LANE = 1
+    };
+
+    //! Called from the send thread for each message and destination.
+    typedef std::function<void(const octet*, uint32_t, const Locator_t&)> SendFunction;
+
+    /**
+     * @param max_bytes_per_destination Bytes that can wait for each destination before push blocks.
+     * @param send Function actually sending the messages.
+     */
+    SendQueue(
+            uint32_t max_bytes_per_destination,
+            SendFunction send);
+
+    //! Stops the send thread, discarding the messages still queued if stop was not called.
+    ~SendQueue();
+
+    /**
+     * Sends the messages still queued and stops the send thread. New messages are rejected.
+     * @param max_drain_time_point Time point after which the messages still queued are discarded. The call
+     * returns once the message being sent at that time, if any, has been sent.
+     */
+    void stop(
+            const std::chrono::steady_clock::time_point& max_drain_time_point);
+
+    /**
+     * Queues a copy of a message for several destinations.
+     * @param max_blocking_time_point Time point until the space on a full destination is waited for.
+     * @return false when some destination remained full until max_blocking_time_point.
+     */
+    bool push(
+            const octet* data,
+            uint32_t length,
+            const LocatorList_t& destinations,
+            const std::chrono::steady_clock::time_point& max_blocking_time_point);
+
+    //! Lane a message goes to, according to its submessages.
+    static Lane classify(
+            const octet* data,
+            uint32_t length);
+
+private:
+
+    //! Shared by all the destinations the message is sent to.
+    typedef std::shared_ptr<std::vector<octet>> Message;
+
+    struct Destination
+    {
+        Destination()
+            : bytes(0)
+        {
+        }
+
+        std::deque<Message> lanes[2];
+        uint32_t bytes;
+    };
+
+    void run();
+
+    uint32_t max_bytes_per_destination_;
+    SendFunction send_;
+
+    std::mutex mutex_;
+    std::condition_variable pending_cv_;
+    std::condition_variable space_cv_;
+    std::condition_variable finished_cv_;
+    //! Destinations with pending messages. They are removed once emptied.
+    std::map<Locator_t, Destination> destinations_;
+    //! Order in which the destinations are visited.
+    std::deque<Locator_t> ready_;
+    bool running_;
+    //! Set by the send thread when it exits.
+    bool finished_;
+    std::thread thread_;
+
+    SendQueue(const SendQueue&) = delete;
+    SendQueue& operator=(const SendQueue&) = delete;
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif
+#endif // _RTPS_PARTICIPANT_SENDQUEUE_H_
@@ -76,6 +76,31 @@ bool RTPSReader::acceptMsgDirectedTo(EntityId_t& entityId)
         return false;
 }
 
+bool RTPSReader::may_accept_messages_from(const GUID_t& writer_guid)
+{
+    if(m_acceptMessagesFromUnkownWriters || writer_guid.entityId == m_trustedWriterEntityId)
+    {
+        return true;
+    }
+
+    RemoteWriterAttributes watt;
+    watt.guid = writer_guid;
+    return matched_writer_is_matched(watt);
+}
+
+void RTPSReader::enableMessagesFromUnkownWriters(bool enable)
+{
+    m_acceptMessagesFromUnkownWriters = enable;
+    mp_RTPSParticipant->reader_matching_changed();
+}
+
+void RTPSReader::setTrustedWriter(EntityId_t writer)
+{
+    m_acceptMessagesFromUnkownWriters = false;
+    m_trustedWriterEntityId = writer;
+    mp_RTPSParticipant->reader_matching_changed();
+}
+
 bool RTPSReader::reserveCache(CacheChange_t** change, uint32_t dataCdrSerializedSize)
 {
     return mp_history->reserve_Cache(change, dataCdrSerializedSize);
@@ -99,6 +99,7 @@ bool StatefulReader::matched_writer_add(RemoteWriterAttributes& wdata, bool pers
     }
 
     matched_writers.push_back(wp);
+    mp_RTPSParticipant->reader_matching_changed();
 
     if (liveliness_lease_duration_ < c_TimeInfinite)
     {
@@ -152,6 +153,7 @@ bool StatefulReader::matched_writer_remove(const RemoteWriterAttributes& wdata)
             wproxy = *it;
             matched_writers.erase(it);
             remove_persistence_guid(wdata);
+            mp_RTPSParticipant->reader_matching_changed();
             break;
         }
     }
@@ -82,6 +82,7 @@ bool StatelessReader::matched_writer_add(RemoteWriterAttributes& wdata, bool per
     }
 
     m_acceptMessagesFromUnkownWriters = false;
+    mp_RTPSParticipant->reader_matching_changed();
 
     if (liveliness_lease_duration_ < c_TimeInfinite)
     {
@@ -131,6 +132,7 @@ bool StatelessReader::matched_writer_remove(const RemoteWriterAttributes& wdata)
 
             m_matched_writers.erase(it);
             remove_persistence_guid(wdata);
+            mp_RTPSParticipant->reader_matching_changed();
 
             return true;
         }
@@ -23,6 +23,8 @@
 #include <fastrtps/log/Log.h>
 #include <fastrtps/utils/TimeConversion.h>
 
+#include <cassert>
+#include <cstddef>
 #include <mutex>
 
 #include <fastrtps/rtps/reader/timedevent/HeartbeatResponseDelay.h>
@@ -30,65 +32,6 @@
 
 using namespace eprosima::fastrtps::rtps;
 
-/*!
- * @brief Auxiliary function to change status in a range.
- */
-void WriterProxy::for_each_set_status_from(decltype(WriterProxy::m_changesFromW)::iterator first,
-        decltype(WriterProxy::m_changesFromW)::iterator last,
-        ChangeFromWriterStatus_t status,
-        ChangeFromWriterStatus_t new_status)
-{
-    auto it = first;
-    while(it != last)
-    {
-        if(it->getStatus() == status)
-        {
-            ChangeFromWriter_t newch(*it);
-            newch.setStatus(new_status);
-
-            auto hint = m_changesFromW.erase(it);
-
-            it = m_changesFromW.insert(hint, newch);
-        }
-
-        ++it;
-    }
-}
-
-void WriterProxy::for_each_set_status_from_and_maybe_remove(decltype(WriterProxy::m_changesFromW)::iterator first,
-        decltype(WriterProxy::m_changesFromW)::iterator last,
-        ChangeFromWriterStatus_t status,
-        ChangeFromWriterStatus_t orstatus,
-        ChangeFromWriterStatus_t new_status)
-{
-    auto it = first;
-    while(it != last)
-    {
-        if(it->getStatus() == status || it->getStatus() == orstatus)
-        {
-            if(it != m_changesFromW.begin())
-            {
-                ChangeFromWriter_t newch(*it);
-                newch.setStatus(new_status);
-
-                auto hint = m_changesFromW.erase(it);
-
-                it = m_changesFromW.insert(hint, newch);
-                ++it;
-                continue;
-            }
-        }
-
-        // UNKNOWN or MISSING at the beginning or
-        // LOST or RECEIVED at the beginning.
-        if(it == m_changesFromW.begin())
-        {
-            changesFromWLowMark_ = it->getSequenceNumber();
-            it = m_changesFromW.erase(it);
-        }
-    }
-}
-
 WriterProxy::~WriterProxy()
 {
     if(mp_initialAcknack != nullptr)
@@ -108,8 +51,8 @@ WriterProxy::WriterProxy(
     , mp_initialAcknack(nullptr)
     , m_heartbeatFinalFlag(false)
     , mp_mutex(new std::recursive_mutex())
+    , changesFromWBase_(0, 1)
 {
-    m_changesFromW.clear();
     //Create Events
     mp_heartbeatResponse = new HeartbeatResponseDelay(
         this, TimeConv::Duration_t2MilliSecondsDouble(mp_SFR->getTimes().heartbeatResponseDelay));
@@ -124,6 +67,25 @@ void WriterProxy::loaded_from_storage_nts(const SequenceNumber_t& seqNum)
 {
     lastNotified_ = seqNum;
     changesFromWLowMark_ = seqNum;
+    changesFromWHighMark_ = seqNum;
+    compact_window();
+}
+
+WriterProxy::ChangesFromWriterWord& WriterProxy::window_word(const SequenceNumber_t& seqNum, uint32_t& mask)
+{
+    assert(changesFromWBase_ <= seqNum);
+    uint64_t offset = seqNum.to64long() - changesFromWBase_.to64long();
+    mask = 1u << (offset % 32u);
+    return changesFromW_[static_cast<size_t>(offset / 32u)];
+}
+
+const WriterProxy::ChangesFromWriterWord& WriterProxy::window_word(const SequenceNumber_t& seqNum,
+        uint32_t& mask) const
+{
+    assert(changesFromWBase_ <= seqNum);
+    uint64_t offset = seqNum.to64long() - changesFromWBase_.to64long();
+    mask = 1u << (offset % 32u);
+    return changesFromW_[static_cast<size_t>(offset / 32u)];
 }
 
 void WriterProxy::missing_changes_update(const SequenceNumber_t& seqNum)
@@ -131,33 +93,23 @@ void WriterProxy::missing_changes_update(const SequenceNumber_t& seqNum)
     logInfo(RTPS_READER,m_att.guid.entityId<<": changes up to seqNum: " << seqNum <<" missing.");
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
 
-    // Check was not removed from container.
+    // Check was not removed from window.
     if(seqNum > changesFromWLowMark_)
     {
-        if(m_changesFromW.size() == 0 || m_changesFromW.rbegin()->getSequenceNumber() < seqNum)
-        {
-            // Set already values in container.
-            for_each_set_status_from(m_changesFromW.begin(), m_changesFromW.end(),
-                    ChangeFromWriterStatus_t::UNKNOWN, ChangeFromWriterStatus_t::MISSING);
-
-            // Changes only already inserted values.
-            bool will_be_the_last = maybe_add_changes_from_writer_up_to(seqNum, ChangeFromWriterStatus_t::MISSING);
-            (void)will_be_the_last;
-            assert(will_be_the_last);
-
-            // Add requetes sequence number.
-            ChangeFromWriter_t newch(seqNum);
-            newch.setStatus(ChangeFromWriterStatus_t::MISSING);
-            m_changesFromW.insert(m_changesFromW.end(), newch);
-        }
-        else
+        // Set already values in window.
+        SequenceNumber_t last = seqNum < changesFromWHighMark_ ? seqNum : changesFromWHighMark_;
+        for(SequenceNumber_t seq = changesFromWLowMark_ + 1; seq <= last; ++seq)
         {
-            // Find it. Must be there.
-            auto last_it = m_changesFromW.find(ChangeFromWriter_t(seqNum));
-            assert(last_it != m_changesFromW.end());
-            for_each_set_status_from(m_changesFromW.begin(), ++last_it,
-                    ChangeFromWriterStatus_t::UNKNOWN, ChangeFromWriterStatus_t::MISSING);
+            uint32_t mask;
+            ChangesFromWriterWord& word = window_word(seq, mask);
+            if((word.received & mask) == 0)
+            {
+                word.missing |= mask;
+            }
         }
+
+        // Add requested sequence number.
+        maybe_add_changes_from_writer_up_to(seqNum + 1, ChangeFromWriterStatus_t::MISSING);
     }
 
     //print_changes_fromWriter_test2();
@@ -166,28 +118,34 @@ void WriterProxy::missing_changes_update(const SequenceNumber_t& seqNum)
 bool WriterProxy::maybe_add_changes_from_writer_up_to(const SequenceNumber_t& sequence_number,
         const ChangeFromWriterStatus_t default_status)
 {
-    bool returnedValue = false;
-    // Check if CacheChange_t is in the container or not.
-    SequenceNumber_t lastSeqNum = changesFromWLowMark_;
-
-    if(m_changesFromW.size() > 0)
-        lastSeqNum = m_changesFromW.rbegin()->getSequenceNumber();
+    if(sequence_number <= changesFromWHighMark_)
+    {
+        return false;
+    }
 
-    if(sequence_number > lastSeqNum)
+    // If it is not in the window, create info up to its sequence number.
+    SequenceNumber_t last = sequence_number - 1;
+    if(last > changesFromWHighMark_)
     {
-        returnedValue = true;
+        size_t words = static_cast<size_t>((last.to64long() - changesFromWBase_.to64long()) / 32u) + 1u;
+        if(changesFromW_.size() < words)
+        {
+            changesFromW_.resize(words, ChangesFromWriterWord{0u, 0u, 0u});
+        }
 
-        // If it is not in the container, create info up to its sequence number.
-        ++lastSeqNum;
-        for(; lastSeqNum < sequence_number; ++lastSeqNum)
+        if(default_status == ChangeFromWriterStatus_t::MISSING)
         {
-            ChangeFromWriter_t newch(lastSeqNum);
-            newch.setStatus(default_status);
-            m_changesFromW.insert(m_changesFromW.end(), newch);
+            for(SequenceNumber_t seq = changesFromWHighMark_ + 1; seq <= last; ++seq)
+            {
+                uint32_t mask;
+                window_word(seq, mask).missing |= mask;
+            }
         }
+
+        changesFromWHighMark_ = last;
     }
 
-    return returnedValue;
+    return true;
 }
 
 void WriterProxy::lost_changes_update(const SequenceNumber_t& seqNum)
@@ -195,27 +153,13 @@ void WriterProxy::lost_changes_update(const SequenceNumber_t& seqNum)
     logInfo(RTPS_READER,m_att.guid.entityId<<": up to seqNum: "<<seqNum);
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
 
-    // Check was not removed from container.
+    // Check was not removed from window.
     if(seqNum > changesFromWLowMark_)
     {
-        if(m_changesFromW.size() == 0 || m_changesFromW.rbegin()->getSequenceNumber() < seqNum)
-        {
-            // Remove all because lost or received.
-            m_changesFromW.clear();
-            // Any in container, then not insert new lost.
-            changesFromWLowMark_ = seqNum - 1;
-        }
-        else
-        {
-            // Find it. Must be there.
-            auto last_it = m_changesFromW.find(ChangeFromWriter_t(seqNum));
-            assert(last_it != m_changesFromW.end());
-            for_each_set_status_from_and_maybe_remove(m_changesFromW.begin(), last_it,
-                    ChangeFromWriterStatus_t::UNKNOWN, ChangeFromWriterStatus_t::MISSING,
-                    ChangeFromWriterStatus_t::LOST);
-            // Next could need to be removed.
-            cleanup();
-        }
+        // Changes before seqNum are lost or received.
+        advance_low_mark(seqNum - 1);
+        // Next could need to be removed.
+        cleanup();
     }
 
     //print_changes_fromWriter_test2();
@@ -236,86 +180,63 @@ bool WriterProxy::received_change_set(const SequenceNumber_t& seqNum, bool is_re
 {
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
 
-    // Check if CacheChange_t was already and it was already removed from changesFromW container.
+    // Check if CacheChange_t was already and it was already removed from the window.
     if(seqNum <= changesFromWLowMark_)
     {
         logInfo(RTPS_READER, "Change " << seqNum << " <= than max available sequence number " << changesFromWLowMark_);
         return false;
     }
 
-    // Maybe create information because it is not in the m_changesFromW container.
-    bool will_be_the_last = maybe_add_changes_from_writer_up_to(seqNum);
+    // Maybe create information because it is not in the window.
+    maybe_add_changes_from_writer_up_to(seqNum + 1);
 
-    // If will be the last element, insert it at the end.
-    if(will_be_the_last)
+    uint32_t mask;
+    ChangesFromWriterWord& word = window_word(seqNum, mask);
+    if((word.received & mask) != 0)
     {
-        // There are others.
-        if(m_changesFromW.size() > 0)
-        {
-            ChangeFromWriter_t chfw(seqNum);
-            chfw.setStatus(RECEIVED);
-            chfw.setRelevance(is_relevance);
-            m_changesFromW.insert(m_changesFromW.end(), chfw);
-        }
-        // Else not insert
-        else
-            changesFromWLowMark_ = seqNum;
+        return false;
+    }
+
+    word.received |= mask;
+    word.missing &= ~mask;
+    if(is_relevance)
+    {
+        word.irrelevant &= ~mask;
     }
-    // Else it has to be found and change state.
     else
     {
-        auto chit = m_changesFromW.find(ChangeFromWriter_t(seqNum));
-
-        // Has to be in the container.
-        assert(chit != m_changesFromW.end());
-
-        if(chit != m_changesFromW.begin())
-        {
-            if(chit->getStatus() != RECEIVED)
-            {
-                ChangeFromWriter_t newch(*chit);
-                newch.setStatus(RECEIVED);
-                newch.setRelevance(is_relevance);
-
-                auto hint = m_changesFromW.erase(chit);
-
-                m_changesFromW.insert(hint, newch);
-            }
-            else
-                return false;
-        }
-        else
-        {
-            assert(chit->getStatus() != RECEIVED);
-            changesFromWLowMark_ = seqNum;
-            m_changesFromW.erase(chit);
-            cleanup();
-        }
-
+        word.irrelevant |= mask;
     }
 
+    cleanup();
+
     //print_changes_fromWriter_test2();
 
     return true;
 }
 
-
-const std::vector<ChangeFromWriter_t> WriterProxy::missing_changes()
+SequenceNumberSet_t WriterProxy::missing_changes()
 {
-    std::vector<ChangeFromWriter_t> returnedValue;
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+    SequenceNumberSet_t returnedValue(changesFromWLowMark_ + 1);
 
-    for(auto ch : m_changesFromW)
+    for(SequenceNumber_t seq = changesFromWLowMark_ + 1; seq <= changesFromWHighMark_; ++seq)
     {
-        if(ch.getStatus() == MISSING)
+        uint32_t mask;
+        const ChangesFromWriterWord& word = window_word(seq, mask);
+        if((word.missing & mask) != 0)
         {
             // If MISSING, then is relevant.
-            assert(ch.isRelevant());
-            returnedValue.push_back(ch);
+            assert((word.irrelevant & mask) == 0);
+            if(!returnedValue.add(seq))
+            {
+                logInfo(RTPS_READER, "Sequence number " << seq << " exceeded bitmap limit of AckNack. SeqNumSet Base: "
+                        << returnedValue.base());
+                break;
+            }
         }
     }
 
-
     //print_changes_fromWriter_test2();
 
     return returnedValue;
@@ -328,10 +249,11 @@ bool WriterProxy::change_was_received(const SequenceNumber_t& seq_num)
     if(seq_num <= changesFromWLowMark_)
         return true;
 
-    auto chit = m_changesFromW.find(ChangeFromWriter_t(seq_num));
-
-    if(chit != m_changesFromW.end() && chit->getStatus() == RECEIVED)
-        return true;
+    if(seq_num <= changesFromWHighMark_)
+    {
+        uint32_t mask;
+        return (window_word(seq_num, mask).received & mask) != 0;
+    }
 
     return false;
 }
@@ -342,14 +264,36 @@ const SequenceNumber_t WriterProxy::available_changes_max() const
     return changesFromWLowMark_;
 }
 
+ChangeFromWriter_t WriterProxy::change_from_writer(const SequenceNumber_t& seqNum) const
+{
+    assert(seqNum > changesFromWLowMark_ && seqNum <= changesFromWHighMark_);
+
+    uint32_t mask;
+    const ChangesFromWriterWord& word = window_word(seqNum, mask);
+
+    ChangeFromWriter_t change(seqNum);
+    if((word.received & mask) != 0)
+    {
+        change.setStatus(ChangeFromWriterStatus_t::RECEIVED);
+    }
+    else if((word.missing & mask) != 0)
+    {
+        change.setStatus(ChangeFromWriterStatus_t::MISSING);
+    }
+    change.setRelevance((word.irrelevant & mask) == 0);
+
+    return change;
+}
+
 void WriterProxy::print_changes_fromWriter_test2()
 {
     std::stringstream sstream;
     sstream << this->m_att.guid.entityId<<": ";
 
-    for(auto it = m_changesFromW.begin(); it != m_changesFromW.end(); ++it)
+    for(SequenceNumber_t seq = changesFromWLowMark_ + 1; seq <= changesFromWHighMark_; ++seq)
     {
-        sstream << it->getSequenceNumber() <<"("<<it->isRelevant()<<","<<it->getStatus()<<")-";
+        ChangeFromWriter_t change = change_from_writer(seq);
+        sstream << seq <<"("<<change.isRelevant()<<","<<change.getStatus()<<")-";
     }
 
     std::string auxstr = sstream.str();
@@ -360,56 +304,98 @@ void WriterProxy::setNotValid(const SequenceNumber_t& seqNum)
 {
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
 
-    // Check sequence number is in the container, because it was not clean up.
+    // Check sequence number is in the window, because it was not clean up.
     if(seqNum <= changesFromWLowMark_)
         return;
 
-    auto chit = m_changesFromW.find(ChangeFromWriter_t(seqNum));
+    // Element must be in the window. In other case, bug.
+    assert(seqNum <= changesFromWHighMark_);
+
+    uint32_t mask;
+    ChangesFromWriterWord& word = window_word(seqNum, mask);
 
-    // Element must be in the container. In other case, bug.
-    assert(chit != m_changesFromW.end());
     // If the element will be set not valid, element must be received.
     // In other case, bug.
-    assert(chit->getStatus() == RECEIVED);
+    assert((word.received & mask) != 0);
 
-    // Cannot be in the beginning because process of cleanup
-    assert(chit != m_changesFromW.begin());
+    word.irrelevant |= mask;
+}
 
-    ChangeFromWriter_t newch(*chit);
-    newch.notValid();
+void WriterProxy::cleanup()
+{
+    while(changesFromWLowMark_ < changesFromWHighMark_)
+    {
+        SequenceNumber_t next = changesFromWLowMark_ + 1;
+        uint32_t mask;
+        ChangesFromWriterWord& word = window_word(next, mask);
+        if((word.received & mask) == 0)
+        {
+            break;
+        }
 
-    auto hint = m_changesFromW.erase(chit);
+        word.received &= ~mask;
+        word.irrelevant &= ~mask;
+        changesFromWLowMark_ = next;
+    }
 
-    m_changesFromW.insert(hint, newch);
+    compact_window();
 }
 
-void WriterProxy::cleanup()
+void WriterProxy::advance_low_mark(const SequenceNumber_t& seqNum)
 {
-    auto chit = m_changesFromW.begin();
+    if(seqNum >= changesFromWHighMark_)
+    {
+        changesFromWLowMark_ = seqNum;
+        changesFromWHighMark_ = seqNum;
+    }
+    else
+    {
+        for(SequenceNumber_t seq = changesFromWLowMark_ + 1; seq <= seqNum; ++seq)
+        {
+            uint32_t mask;
+            ChangesFromWriterWord& word = window_word(seq, mask);
+            word.received &= ~mask;
+            word.missing &= ~mask;
+            word.irrelevant &= ~mask;
+        }
+        changesFromWLowMark_ = seqNum;
+    }
 
-    while(chit != m_changesFromW.end() &&
-            (chit->getStatus() == RECEIVED || chit->getStatus() == LOST))
+    compact_window();
+}
+
+void WriterProxy::compact_window()
+{
+    if(changesFromWLowMark_ == changesFromWHighMark_)
     {
-        changesFromWLowMark_ = chit->getSequenceNumber();
-        chit = m_changesFromW.erase(chit);
+        changesFromW_.clear();
+        changesFromWBase_ = changesFromWLowMark_ + 1;
+    }
+    else
+    {
+        uint64_t words = ((changesFromWLowMark_ + 1).to64long() - changesFromWBase_.to64long()) / 32u;
+        if(words > 0)
+        {
+            changesFromW_.erase(changesFromW_.begin(), changesFromW_.begin() + static_cast<ptrdiff_t>(words));
+            changesFromWBase_ = changesFromWBase_ + static_cast<uint32_t>(words * 32u);
+        }
     }
 }
 
 bool WriterProxy::areThereMissing()
 {
-    bool returnedValue = false;
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
 
-    for(auto ch : m_changesFromW)
+    // Only the changes of the window have their bits set.
+    for(const ChangesFromWriterWord& word : changesFromW_)
     {
-        if(ch.getStatus() == ChangeFromWriterStatus_t::MISSING)
+        if(word.missing != 0)
         {
-            returnedValue = true;
-            break;
+            return true;
         }
     }
 
-    return returnedValue;
+    return false;
 }
 
 size_t WriterProxy::unknown_missing_changes_up_to(const SequenceNumber_t& seqNum)
@@ -417,14 +403,11 @@ size_t WriterProxy::unknown_missing_changes_up_to(const SequenceNumber_t& seqNum
     size_t returnedValue = 0;
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
 
-    if(seqNum > changesFromWLowMark_)
+    for(SequenceNumber_t seq = changesFromWLowMark_ + 1; seq <= changesFromWHighMark_ && seq < seqNum; ++seq)
     {
-        for(auto ch = m_changesFromW.begin(); ch != m_changesFromW.end() && ch->getSequenceNumber() < seqNum; ++ch)
-        {
-            if(ch->getStatus() == ChangeFromWriterStatus_t::UNKNOWN ||
-                    ch->getStatus() == ChangeFromWriterStatus_t::MISSING)
-                ++returnedValue;
-        }
+        uint32_t mask;
+        if((window_word(seq, mask).received & mask) == 0)
+            ++returnedValue;
     }
 
     return returnedValue;
@@ -433,7 +416,7 @@ size_t WriterProxy::unknown_missing_changes_up_to(const SequenceNumber_t& seqNum
 size_t WriterProxy::numberOfChangeFromWriter() const
 {
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
-    return m_changesFromW.size();
+    return static_cast<size_t>(changesFromWHighMark_.to64long() - changesFromWLowMark_.to64long());
 }
 
 SequenceNumber_t WriterProxy::nextCacheChangeToBeNotified()
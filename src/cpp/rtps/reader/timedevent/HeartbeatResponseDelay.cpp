@@ -73,9 +73,9 @@ void HeartbeatResponseDelay::event(
        // Protect reader
        std::lock_guard<std::recursive_timed_mutex> guard(mp_WP->mp_SFR->getMutex());
 
-        const std::vector<ChangeFromWriter_t> missing_changes = mp_WP->missing_changes();
+        const SequenceNumberSet_t missing_changes = mp_WP->missing_changes();
         // Stores missing changes but there is some fragments received.
-        std::vector<CacheChange_t*> uncompleted_changes;
+        m_uncompleted_changes.clear();
 
         try
         {
@@ -84,26 +84,22 @@ void HeartbeatResponseDelay::event(
 
             if(!missing_changes.empty() || !mp_WP->m_heartbeatFinalFlag)
             {
-                SequenceNumberSet_t sns(mp_WP->available_changes_max() + 1);
+                SequenceNumberSet_t sns(missing_changes.base());
 
-                for(auto ch : missing_changes)
+                missing_changes.for_each([&](const SequenceNumber_t& seq)
                 {
                     // Check if the CacheChange_t is uncompleted.
-                    CacheChange_t* uncomplete_change = mp_WP->mp_SFR->findCacheInFragmentedCachePitStop(ch.getSequenceNumber(), mp_WP->m_att.guid);
+                    CacheChange_t* uncomplete_change = mp_WP->mp_SFR->findCacheInFragmentedCachePitStop(seq, mp_WP->m_att.guid);
 
                     if(uncomplete_change == nullptr)
                     {
-                        if(!sns.add(ch.getSequenceNumber()))
-                        {
-                            logInfo(RTPS_READER,"Sequence number " << ch.getSequenceNumber()
-                                    << " exceeded bitmap limit of AckNack. SeqNumSet Base: " << sns.base());
-                        }
+                        sns.add(seq);
                     }
                     else
                     {
-                        uncompleted_changes.push_back(uncomplete_change);
+                        m_uncompleted_changes.push_back(uncomplete_change);
                     }
-                }
+                });
 
                 // TODO Protect
                 mp_WP->mp_SFR->m_acknackCount++;
@@ -114,9 +110,9 @@ void HeartbeatResponseDelay::event(
             }
 
             // Now generage NACK_FRAGS
-            if(!uncompleted_changes.empty())
+            if(!m_uncompleted_changes.empty())
             {
-                for(auto cit : uncompleted_changes)
+                for(auto cit : m_uncompleted_changes)
                 {
                     FragmentNumberSet_t frag_sns;
 
@@ -22,10 +22,13 @@
 #include <fastrtps/rtps/resources/TimedEvent.h>
 #include <fastrtps/utils/TimeConversion.h>
 
+#include <algorithm>
 #include <cassert>
 #include <functional>
 #include <atomic>
+#include <new>
 #include <system_error>
+#include <type_traits>
 
 namespace eprosima
 {
@@ -47,13 +50,75 @@ namespace eprosima
                     } StateCode;
 
                     TimerState(TimedEvent::AUTODESTRUCTION_MODE autodestruction) : code_(INACTIVE),
-                    autodestruction_(autodestruction), forwardRestart_(false) {}
+                    autodestruction_(autodestruction), forwardRestart_(false), handler_memory_in_use_(false) {}
+
+                    //! Memory for the wait operation of this state, so waiting on the timer does not allocate.
+                    void* allocate_handler(size_t size)
+                    {
+                        if(size <= sizeof(handler_memory_) && !handler_memory_in_use_.exchange(true))
+                        {
+                            return &handler_memory_;
+                        }
+
+                        return ::operator new(size);
+                    }
+
+                    void deallocate_handler(void* pointer)
+                    {
+                        if(pointer == &handler_memory_)
+                        {
+                            handler_memory_in_use_.store(false);
+                        }
+                        else
+                        {
+                            ::operator delete(pointer);
+                        }
+                    }
 
                     std::atomic<StateCode> code_;
 
                     TimedEvent::AUTODESTRUCTION_MODE autodestruction_;
 
                     bool forwardRestart_;
+
+                private:
+
+                    std::aligned_storage<256>::type handler_memory_;
+
+                    std::atomic<bool> handler_memory_in_use_;
+            };
+
+            /*!
+             * Handler of the wait on the timer. Its operation is allocated on the memory of the state it carries,
+             * which the handler keeps alive until the operation is released.
+             */
+            class TimerHandler
+            {
+                public:
+
+                    TimerHandler(TimedEventImpl* event, const std::shared_ptr<TimerState>& state)
+                        : event_(event), state_(state) {}
+
+                    void operator()(const asio::error_code& ec)
+                    {
+                        event_->event(ec, state_);
+                    }
+
+                    friend void* asio_handler_allocate(size_t size, TimerHandler* handler)
+                    {
+                        return handler->state_->allocate_handler(size);
+                    }
+
+                    friend void asio_handler_deallocate(void* pointer, size_t, TimerHandler* handler)
+                    {
+                        handler->state_->deallocate_handler(pointer);
+                    }
+
+                private:
+
+                    TimedEventImpl* event_;
+
+                    std::shared_ptr<TimerState> state_;
             };
         }
     }
@@ -75,6 +140,7 @@ TimedEventImpl::TimedEventImpl(
     , event_thread_id_(event_thread.get_id())
 {
 	//TIME_INFINITE(m_timeInfinite);
+    spare_states_.reserve(2);
 }
 
 TimedEventImpl::~TimedEventImpl()
@@ -118,7 +184,24 @@ void TimedEventImpl::cancel_timer()
     if(ret)
     {
         // Unattach the event state from future event execution.
-        state_.reset(new TimerState(autodestruction_));
+        // A previous state is reused once no pending handler refers to it.
+        auto spare = std::find_if(spare_states_.begin(), spare_states_.end(),
+                [](const std::shared_ptr<TimerState>& state)
+                {
+                    return state.use_count() == 1;
+                });
+
+        if(spare != spare_states_.end())
+        {
+            spare->swap(state_);
+            state_.get()->code_.store(TimerState::INACTIVE, std::memory_order_relaxed);
+            state_.get()->forwardRestart_ = false;
+        }
+        else
+        {
+            spare_states_.push_back(state_);
+            state_ = std::make_shared<TimerState>(autodestruction_);
+        }
         // Cancel the event.
         timer_.cancel();
         // Alert to user.
@@ -154,7 +237,7 @@ void TimedEventImpl::restart_timer()
         if(restartTimer)
         {
             timer_.expires_from_now(m_interval_microsec);
-            timer_.async_wait(std::bind(&TimedEventImpl::event,this,std::placeholders::_1, state_));
+            timer_.async_wait(TimerHandler(this, state_));
         }
     }
 }
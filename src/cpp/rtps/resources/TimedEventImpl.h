@@ -40,6 +40,7 @@
 #include <mutex>
 #include <condition_variable>
 #include <system_error>
+#include <vector>
 
 
 
@@ -140,6 +141,9 @@ namespace eprosima
 
                     std::shared_ptr<TimerState> state_;
 
+                    //! States unattached by cancel_timer(), to be reused when their handlers are done.
+                    std::vector<std::shared_ptr<TimerState>> spare_states_;
+
                     std::thread::id event_thread_id_;
             };
 
@@ -24,12 +24,18 @@
 #include <fastrtps/rtps/common/CacheChange.h>
 
 #include <vector>
+#include <algorithm>
 #include <cassert>
 
 namespace eprosima {
 namespace fastrtps {
 namespace rtps {
 
+/**
+ * Collects the changes and fragments a writer has to send, ordered by sequence and fragment number.
+ * Items are kept in a pool that is reused across clear() calls, so a collector that lives as long as
+ * its writer stops allocating once it has grown to the largest batch of changes sent.
+ */
 template<class T>
 class RTPSWriterCollector
 {
@@ -37,6 +43,10 @@ class RTPSWriterCollector
 
         struct Item
         {
+            Item() : fragmentNumber(0), cacheChange(nullptr)
+            {
+            }
+
             Item(SequenceNumber_t seqNum, FragmentNumber_t fragNum,
                     CacheChange_t* c) : sequenceNumber(seqNum),
                                         fragmentNumber(fragNum),
@@ -72,57 +82,108 @@ class RTPSWriterCollector
             }
         };
 
-        typedef std::set<Item, ItemCmp> ItemSet;
+        typedef typename std::vector<Item>::iterator iterator;
 
-        void add_change(CacheChange_t* change, const T& remoteReader, const FragmentNumberSet_t optionalFragmentsNotSent)
+        RTPSWriterCollector() : mBegin_(0), mEnd_(0)
+        {
+        }
+
+        void add_change(CacheChange_t* change, const T& remoteReader, const FragmentNumberSet_t& optionalFragmentsNotSent)
         {
             if(change->getFragmentSize() > 0)
             {
-                optionalFragmentsNotSent.for_each([this, change, remoteReader](FragmentNumber_t sn)
+                optionalFragmentsNotSent.for_each([this, change, &remoteReader](FragmentNumber_t sn)
                 {
                     assert(sn <= change->getDataFragments()->size());
-                    auto it = mItems_.emplace(change->sequenceNumber, sn, change);
-                    it.first->remoteReaders.push_back(remoteReader);
+                    get_item(change, sn).remoteReaders.push_back(remoteReader);
                 });
             }
             else
             {
-                auto it = mItems_.emplace(change->sequenceNumber, 0, change);
-                it.first->remoteReaders.push_back(remoteReader);
+                get_item(change, 0).remoteReaders.push_back(remoteReader);
             }
         }
 
-        bool empty()
+        bool empty() const
         {
-            return mItems_.empty();
+            return mBegin_ == mEnd_;
         }
 
-        size_t size()
+        size_t size() const
         {
-            return mItems_.size();
+            return mEnd_ - mBegin_;
         }
 
-        Item pop()
+        /*!
+         * Removes the first item.
+         * @return Reference to the removed item, valid until the collector is modified again.
+         */
+        Item& pop()
         {
-            auto it = mItems_.begin();
-            Item ret = *it;
-            mItems_.erase(it);
-            return ret;
+            assert(!empty());
+            return mItems_[mBegin_++];
         }
 
         void clear()
         {
-            return mItems_.clear();
+            mBegin_ = 0;
+            mEnd_ = 0;
+        }
+
+        iterator begin()
+        {
+            return mItems_.begin() + mBegin_;
         }
 
-        ItemSet& items()
+        iterator end()
         {
-            return mItems_;
+            return mItems_.begin() + mEnd_;
+        }
+
+        //! Removes the items from first to the end. Only trailing items can be removed.
+        void erase(iterator first, iterator last)
+        {
+            assert(last == end());
+            (void)last;
+            mEnd_ = static_cast<size_t>(first - mItems_.begin());
         }
 
     private:
 
-        ItemSet mItems_;
+        Item& get_item(CacheChange_t* change, FragmentNumber_t fragmentNumber)
+        {
+            Item key;
+            key.sequenceNumber = change->sequenceNumber;
+            key.fragmentNumber = fragmentNumber;
+
+            size_t pos = static_cast<size_t>(std::lower_bound(begin(), end(), key, ItemCmp()) - mItems_.begin());
+            if(pos < mEnd_ && !ItemCmp()(key, mItems_[pos]))
+            {
+                return mItems_[pos];
+            }
+
+            // Take the first unused item of the pool and move it to its ordered position.
+            if(mEnd_ == mItems_.size())
+            {
+                mItems_.emplace_back();
+            }
+            std::rotate(mItems_.begin() + pos, mItems_.begin() + mEnd_, mItems_.begin() + mEnd_ + 1);
+            ++mEnd_;
+
+            Item& item = mItems_[pos];
+            item.sequenceNumber = change->sequenceNumber;
+            item.fragmentNumber = fragmentNumber;
+            item.cacheChange = change;
+            item.remoteReaders.clear();
+            return item;
+        }
+
+        //! Pool of items. Those in [mBegin_, mEnd_) are pending to be sent, the rest are unused.
+        std::vector<Item> mItems_;
+
+        size_t mBegin_;
+
+        size_t mEnd_;
 };
 
 } // namespace rtps
@@ -35,6 +35,22 @@ namespace eprosima {
 namespace fastrtps {
 namespace rtps {
 
+//! Maximum number of changes with their own state preallocated for a reader when the history is not fixed size.
+static const size_t s_changes_for_reader_reserve = 32u;
+
+static ResourceLimitedContainerConfig changes_for_reader_limits(const HistoryAttributes& history_attributes)
+{
+    // Only changes with their own state are kept, which are usually a few ones. Unless the configuration requires
+    // everything to be preallocated, a bounded amount is reserved so the usual acknack and nackfrag processing
+    // does not allocate.
+    ResourceLimitedContainerConfig limits = resource_limits_from_history(history_attributes, 0);
+    if (limits.initial != limits.maximum)
+    {
+        limits.initial = std::min(limits.initial, s_changes_for_reader_reserve);
+    }
+    return limits;
+}
+
 ReaderProxy::ReaderProxy(
         const WriterTimes& times,
         StatefulWriter* writer)
@@ -42,11 +58,14 @@ ReaderProxy::ReaderProxy(
     , reader_attributes_()
     , writer_(writer)
     , guid_as_vector_(ResourceLimitedContainerConfig::fixed_size_configuration(1u))
-    , changes_for_reader_(resource_limits_from_history(writer->mp_history->m_att, 0))
+    , changes_for_reader_(changes_for_reader_limits(writer->mp_history->m_att))
     , nack_supression_event_(nullptr)
     , timers_enabled_(false)
     , last_acknack_count_(0)
     , last_nackfrag_count_(0)
+    , heartbeat_pending_(false)
+    , unanswered_heartbeats_(0)
+    , acknack_rtt_millisec_(0)
 {
     nack_supression_event_ = std::make_shared <NackSupressionDuration>(writer_,
         TimeConv::Time_t2MilliSecondsDouble(times.nackSupressionDuration));
@@ -82,7 +101,14 @@ void ReaderProxy::stop()
     changes_for_reader_.clear();
     last_acknack_count_ = 0;
     last_nackfrag_count_ = 0;
+    heartbeat_pending_ = false;
+    unanswered_heartbeats_ = 0;
+    acknack_rtt_millisec_ = 0;
     changes_low_mark_ = SequenceNumber_t();
+    irrelevant_changes_mark_ = SequenceNumber_t();
+    unacknowledged_changes_mark_ = SequenceNumber_t();
+    underway_changes_mark_ = SequenceNumber_t();
+    changes_high_mark_ = SequenceNumber_t();
     guid_as_vector_.clear();
 }
 
@@ -99,121 +125,206 @@ void ReaderProxy::update_nack_supression_interval(const Duration_t& interval)
     nack_supression_event_->update_interval(interval);
 }
 
+void ReaderProxy::heartbeat_sent(const std::chrono::steady_clock::time_point& now)
+{
+    if (!is_reliable())
+    {
+        return;
+    }
+
+    if (heartbeat_pending_)
+    {
+        ++unanswered_heartbeats_;
+    }
+
+    // The next answer is taken as the answer to the last heartbeat
+    last_heartbeat_time_ = now;
+    heartbeat_pending_ = true;
+}
+
+void ReaderProxy::acknack_received(const std::chrono::steady_clock::time_point& now)
+{
+    if (heartbeat_pending_)
+    {
+        double sample = std::chrono::duration<double, std::milli>(now - last_heartbeat_time_).count();
+        // Same smoothing as TCP (RFC 6298)
+        acknack_rtt_millisec_ = acknack_rtt_millisec_ > 0 ? 0.875 * acknack_rtt_millisec_ + 0.125 * sample : sample;
+        heartbeat_pending_ = false;
+    }
+
+    unanswered_heartbeats_ = 0;
+}
+
+double ReaderProxy::heartbeat_period_millisec(
+        double min_millisec,
+        double max_millisec) const
+{
+    double period = std::max(2 * acknack_rtt_millisec_, min_millisec);
+
+    // A reader requesting repairs answers every heartbeat, so it keeps the period of its round-trip time.
+    // A single unanswered heartbeat may just be a loss, further ones mean the reader is not listening.
+    for (uint32_t i = 1; i < unanswered_heartbeats_ && period < max_millisec; ++i)
+    {
+        period *= 2;
+    }
+
+    return std::min(period, max_millisec);
+}
+
 void ReaderProxy::add_change(
         const ChangeForReader_t& change,
         bool restart_nack_supression)
 {
-    assert(change.getSequenceNumber() > changes_low_mark_);
-    assert(changes_for_reader_.empty() ? true :
-        change.getSequenceNumber() > changes_for_reader_.back().getSequenceNumber());
+    const SequenceNumber_t& seq_num = change.getSequenceNumber();
+    assert(seq_num > changes_high_mark_ || seq_num <= changes_low_mark_);
 
     if (restart_nack_supression && timers_enabled_.load())
     {
         nack_supression_event_->restart_timer();
     }
 
+    // The remote reader already acknowledged this sequence number before it was written
+    if (seq_num <= changes_low_mark_)
+    {
+        return;
+    }
+
     // For best effort readers, changes are acked when being sent
-    if (changes_for_reader_.empty() && change.getStatus() == ACKNOWLEDGED)
+    if (!has_changes() && change.getStatus() == ACKNOWLEDGED)
     {
-        changes_low_mark_ = change.getSequenceNumber();
+        changes_low_mark_ = seq_num;
+        irrelevant_changes_mark_ = seq_num;
+        unacknowledged_changes_mark_ = seq_num;
+        underway_changes_mark_ = seq_num;
+        changes_high_mark_ = seq_num;
         return;
     }
 
-    // Irrelevant changes are not added to the collection
+    // Irrelevant changes are not added. They become holes when a later change is added.
     if (!change.isRelevant())
     {
         return;
     }
 
-    if (changes_for_reader_.push_back(change) == nullptr)
+    if (!has_changes())
     {
-        // This should never happen
-        assert(false);
-        logError(RTPS_WRITER, "Error adding change " << change.getSequenceNumber() << " to reader proxy " << \
-            reader_attributes_.guid);
+        irrelevant_changes_mark_ = seq_num - 1;
+        unacknowledged_changes_mark_ = irrelevant_changes_mark_;
+        underway_changes_mark_ = irrelevant_changes_mark_;
+    }
+    else
+    {
+        // Changes still in history that were not added are irrelevant
+        for (SequenceNumber_t skipped = changes_high_mark_ + 1; skipped < seq_num; ++skipped)
+        {
+            CacheChange_t* skipped_change = history_change(skipped);
+            if (skipped_change != nullptr)
+            {
+                ChangeForReader_t irrelevant(skipped_change);
+                irrelevant.setRelevance(false);
+                insert_change(irrelevant);
+            }
+        }
+    }
+
+    SequenceNumber_t previous_high_mark = changes_high_mark_;
+    changes_high_mark_ = seq_num;
+
+    switch (change.getStatus())
+    {
+        case UNSENT:
+            break;
+
+        case UNDERWAY:
+            if (underway_changes_mark_ == previous_high_mark)
+            {
+                underway_changes_mark_ = seq_num;
+                break;
+            }
+            insert_change(change);
+            break;
+
+        case UNACKNOWLEDGED:
+            if (unacknowledged_changes_mark_ == previous_high_mark)
+            {
+                unacknowledged_changes_mark_ = seq_num;
+                underway_changes_mark_ = seq_num;
+                break;
+            }
+            insert_change(change);
+            break;
+
+        default:
+            insert_change(change);
+            break;
     }
 }
 
 bool ReaderProxy::has_changes() const
 {
-    return !changes_for_reader_.empty();
+    return changes_high_mark_ > changes_low_mark_;
 }
 
 bool ReaderProxy::change_is_acked(const SequenceNumber_t& seq_num) const
 {
-    if (seq_num <= changes_low_mark_ || changes_for_reader_.empty())
+    if (seq_num <= changes_low_mark_ || seq_num > changes_high_mark_)
     {
         return true;
     }
 
     ChangeConstIterator chit = find_change(seq_num);
-    if (chit == changes_for_reader_.end())
+    if (chit != changes_for_reader_.end())
     {
-        // There is a hole in changes_for_reader_
-        // This means a change was removed.
-        // The case is equivalent to the !chit->isRelevant() code below
-        return true;
+        return !chit->isRelevant() || chit->getStatus() == ACKNOWLEDGED;
     }
 
-    return !chit->isRelevant() || chit->getStatus() == ACKNOWLEDGED;
+    // A hole means the change is irrelevant or was removed, which is equivalent to being acknowledged.
+    return is_hole(seq_num);
 }
 
 void ReaderProxy::acked_changes_set(const SequenceNumber_t& seq_num)
 {
     SequenceNumber_t future_low_mark = seq_num;
 
-    if (seq_num > changes_low_mark_)
-    {
-        ChangeIterator chit = find_change(seq_num, false);
-        changes_for_reader_.erase(changes_for_reader_.begin(), chit);
-    }
-    else
+    if (seq_num <= changes_low_mark_)
     {
         // Special case. Currently only used on Builtin StatefulWriters
         // after losing lease duration.
 
-        SequenceNumber_t current_sequence = seq_num;
         SequenceNumber_t min_sequence = writer_->get_seq_num_min();
         if (seq_num < min_sequence)
         {
-            current_sequence = min_sequence;
+            future_low_mark = min_sequence;
         }
-        future_low_mark = current_sequence;
 
-        bool should_sort = false;
-        for (; current_sequence <= changes_low_mark_; ++current_sequence)
+        if (future_low_mark <= changes_low_mark_)
         {
-            // Skip all consecutive changes already in the collection
-            ChangeConstIterator it = find_change(current_sequence);
-            while( it != changes_for_reader_.end() &&
-                current_sequence <= changes_low_mark_ &&
-                it->getSequenceNumber() == current_sequence)
-            {
-                ++current_sequence;
-                ++it;
-            }
-
-            if (current_sequence <= changes_low_mark_)
+            // Leading irrelevant changes keep being irrelevant
+            for (SequenceNumber_t current_sequence = changes_low_mark_ + 1;
+                    current_sequence <= irrelevant_changes_mark_; ++current_sequence)
             {
-                CacheChange_t* change = nullptr;
-                if (writer_->mp_history->get_change(current_sequence, writer_->getGuid(), &change))
+                CacheChange_t* change = history_change(current_sequence);
+                if (change != nullptr)
                 {
-                    should_sort = true;
-                    ChangeForReader_t cr(change);
-                    cr.setStatus(UNACKNOWLEDGED);
-                    changes_for_reader_.push_back(cr);
+                    ChangeForReader_t irrelevant(change);
+                    irrelevant.setRelevance(false);
+                    insert_change(irrelevant);
                 }
             }
-        }
 
-        // Keep changes sorted by sequence number
-        if (should_sort)
-        {
-            std::sort(changes_for_reader_.begin(), changes_for_reader_.end(), ChangeForReaderCmp());
+            // Changes still in history become unacknowledged again
+            SequenceNumber_t previous_low_mark = changes_low_mark_;
+            changes_low_mark_ = future_low_mark - 1;
+            irrelevant_changes_mark_ = changes_low_mark_;
+            if (changes_high_mark_ == previous_low_mark)
+            {
+                trim_high_mark(SequenceNumber_t::unknown());
+            }
+            return;
         }
     }
 
-    changes_low_mark_ = future_low_mark - 1;
+    advance_low_mark(future_low_mark - 1);
 }
 
 bool ReaderProxy::requested_changes_set(const SequenceNumberSet_t& seq_num_set)
@@ -222,8 +333,26 @@ bool ReaderProxy::requested_changes_set(const SequenceNumberSet_t& seq_num_set)
 
     seq_num_set.for_each([&](SequenceNumber_t sit)
     {
+        if (sit <= irrelevant_changes_mark_ || sit > changes_high_mark_)
+        {
+            return;
+        }
+
         ChangeIterator chit = find_change(sit, true);
-        if (chit != changes_for_reader_.end() && UNACKNOWLEDGED == chit->getStatus())
+        if (chit == changes_for_reader_.end())
+        {
+            CacheChange_t* change = history_change(sit);
+            if (change == nullptr || default_status(sit) != UNACKNOWLEDGED)
+            {
+                return;
+            }
+
+            ChangeForReader_t requested(change);
+            requested.setStatus(UNACKNOWLEDGED);
+            chit = insert_change(requested);
+        }
+
+        if (chit != changes_for_reader_.end() && chit->isRelevant() && UNACKNOWLEDGED == chit->getStatus())
         {
             chit->setStatus(REQUESTED);
             chit->markAllFragmentsAsUnsent();
@@ -239,6 +368,18 @@ bool ReaderProxy::requested_changes_set(const SequenceNumberSet_t& seq_num_set)
     return isSomeoneWasSetRequested;
 }
 
+void ReaderProxy::get_requested_changes(SequenceNumberSet_t& seq_num_set) const
+{
+    // Requested changes always differ from the status of their range, so they are all kept in changes_for_reader_
+    for (const ChangeForReader_t& change : changes_for_reader_)
+    {
+        if (change.isRelevant() && REQUESTED == change.getStatus())
+        {
+            seq_num_set.add(change.getSequenceNumber());
+        }
+    }
+}
+
 bool ReaderProxy::set_change_to_status(
         const SequenceNumber_t& seq_num,
         ChangeForReaderStatus_t status,
@@ -255,9 +396,6 @@ bool ReaderProxy::set_change_to_status(
         return false;
     }
 
-    ChangeIterator it = find_change(seq_num, true);
-    bool change_was_modified = false;
-
     // If the status is UNDERWAY (change was right now sent) and the reader is besteffort,
     // then the status has to be changed to ACKNOWLEDGED.
     if(UNDERWAY == status && !is_reliable())
@@ -270,30 +408,22 @@ bool ReaderProxy::set_change_to_status(
     // first unacknowledged change is irrelevant.
     if (status == ACKNOWLEDGED && seq_num == changes_low_mark_ + 1)
     {
-        changes_low_mark_ = seq_num;
-        change_was_modified = true;
+        advance_low_mark(seq_num);
+        return true;
     }
 
-    if (it != changes_for_reader_.end())
+    if (seq_num > changes_high_mark_)
     {
-        if (status == ACKNOWLEDGED && changes_low_mark_ == seq_num)
-        {
-            // Erase the first change when it is acknowledged
-            assert(it == changes_for_reader_.begin());
-            changes_for_reader_.erase(it);
-        }
-        else
-        {
-            // Otherwise change status
-            if (it->getStatus() != status)
-            {
-                it->setStatus(status);
-                change_was_modified = true;
-            }
-        }
+        return false;
+    }
+
+    ChangeIterator it = find_change(seq_num, true);
+    if (it == changes_for_reader_.end() ? is_hole(seq_num) : !it->isRelevant())
+    {
+        return false;
     }
 
-    return change_was_modified;
+    return change_status(it, seq_num, status);
 }
 
 bool ReaderProxy::mark_fragment_as_sent_for_change(
@@ -303,22 +433,37 @@ bool ReaderProxy::mark_fragment_as_sent_for_change(
 {
     was_last_fragment = false;
 
-    if (seq_num <= changes_low_mark_)
+    if (seq_num <= changes_low_mark_ || seq_num > changes_high_mark_)
     {
         return false;
     }
 
-    bool change_found = false;
     ChangeIterator it = find_change(seq_num, true);
+    if (it == changes_for_reader_.end())
+    {
+        // The change gets its own state to keep track of its fragments
+        CacheChange_t* change = history_change(seq_num);
+        if (change == nullptr || seq_num <= irrelevant_changes_mark_)
+        {
+            return false;
+        }
 
-    if (it != changes_for_reader_.end())
+        ChangeForReader_t fragmented(change);
+        fragmented.setStatus(default_status(seq_num));
+        it = insert_change(fragmented);
+        if (it == changes_for_reader_.end())
+        {
+            return false;
+        }
+    }
+    else if (!it->isRelevant())
     {
-        change_found = true;
-        it->markFragmentsAsSent(frag_num);
-        was_last_fragment = it->getUnsentFragments().empty();
+        return false;
     }
 
-    return change_found;
+    it->markFragmentsAsSent(frag_num);
+    was_last_fragment = it->getUnsentFragments().empty();
+    return true;
 }
 
 bool ReaderProxy::perform_nack_supression()
@@ -341,6 +486,15 @@ bool ReaderProxy::convert_status_on_all_changes(
     //       UNDERWAY=>UNACKNOWLEDGED (nack supression)
 
     bool at_least_one_modified = false;
+
+    // The underway range becomes part of the unacknowledged one
+    if (previous == UNDERWAY && unacknowledged_changes_mark_ < underway_changes_mark_)
+    {
+        assert(next == UNACKNOWLEDGED);
+        at_least_one_modified = true;
+        unacknowledged_changes_mark_ = underway_changes_mark_;
+    }
+
     for(ChangeForReader_t& change : changes_for_reader_)
     {
         if (change.getStatus() == previous)
@@ -350,33 +504,59 @@ bool ReaderProxy::convert_status_on_all_changes(
         }
     }
 
+    // Changes left with the state given by the marks do not need to be kept
+    changes_for_reader_.erase(
+        std::remove_if(changes_for_reader_.begin(), changes_for_reader_.end(),
+            [this](const ChangeForReader_t& change)
+            {
+                return change.isRelevant() && change.getStatus() != UNSENT &&
+                    change.getStatus() == default_status(change.getSequenceNumber());
+            }),
+        changes_for_reader_.end());
+
     return at_least_one_modified;
 }
 
 void ReaderProxy::change_has_been_removed(const SequenceNumber_t& seq_num)
 {
-    // Check sequence number is in the container, because it was not clean up.
-    if (changes_for_reader_.empty() || seq_num < changes_for_reader_.begin()->getSequenceNumber())
+    // Check sequence number is in the tracked range, because it was not clean up.
+    if (seq_num <= changes_low_mark_ || seq_num > changes_high_mark_)
     {
         return;
     }
 
-    // Element may not be in the container when marked as irrelevant.
-    auto chit = find_change(seq_num);
-    changes_for_reader_.erase(chit);
+    // Once removed, the change is a hole given by the history
+    ChangeIterator chit = find_change(seq_num, true);
+    if (chit != changes_for_reader_.end())
+    {
+        changes_for_reader_.erase(chit);
+    }
+
+    if (seq_num == changes_high_mark_)
+    {
+        trim_high_mark(seq_num);
+    }
 }
 
 bool ReaderProxy::has_unacknowledged() const
 {
+    size_t unacknowledged_range_exceptions = 0;
     for (const ChangeForReader_t& it : changes_for_reader_)
     {
         if (it.isRelevant() && it.getStatus() == UNACKNOWLEDGED)
         {
             return true;
         }
+
+        if (it.getSequenceNumber() > irrelevant_changes_mark_ &&
+                it.getSequenceNumber() <= unacknowledged_changes_mark_)
+        {
+            ++unacknowledged_range_exceptions;
+        }
     }
 
-    return false;
+    // Changes on the unacknowledged range without their own state
+    return history_count(irrelevant_changes_mark_, unacknowledged_changes_mark_) > unacknowledged_range_exceptions;
 }
 
 bool ReaderProxy::requested_fragment_set(
@@ -384,8 +564,36 @@ bool ReaderProxy::requested_fragment_set(
         const FragmentNumberSet_t& frag_set)
 {
     // Locate the outbound change referenced by the NACK_FRAG
+    if (seq_num <= irrelevant_changes_mark_ || seq_num > changes_high_mark_)
+    {
+        return false;
+    }
+
     ChangeIterator changeIter = find_change(seq_num, true);
     if (changeIter == changes_for_reader_.end())
+    {
+        CacheChange_t* change = history_change(seq_num);
+        if (change == nullptr)
+        {
+            return false;
+        }
+
+        // All the fragments of an unsent change without its own state are already unsent
+        ChangeForReaderStatus_t status = default_status(seq_num);
+        if (status == UNSENT)
+        {
+            return true;
+        }
+
+        ChangeForReader_t requested(change);
+        requested.setStatus(status);
+        changeIter = insert_change(requested);
+        if (changeIter == changes_for_reader_.end())
+        {
+            return false;
+        }
+    }
+    else if (!changeIter->isRelevant())
     {
         return false;
     }
@@ -455,10 +663,197 @@ ReaderProxy::ChangeConstIterator ReaderProxy::find_change(const SequenceNumber_t
         : it->getSequenceNumber() == seq_num ? it : end;
 }
 
+ReaderProxy::ChangeIterator ReaderProxy::insert_change(const ChangeForReader_t& change)
+{
+    size_t position = std::distance(changes_for_reader_.begin(), find_change(change.getSequenceNumber(), false));
+    if (changes_for_reader_.push_back(change) == nullptr)
+    {
+        // This should never happen
+        assert(false);
+        logError(RTPS_WRITER, "Error adding change " << change.getSequenceNumber() << " to reader proxy " << \
+            reader_attributes_.guid);
+        return changes_for_reader_.end();
+    }
+
+    ChangeIterator it = changes_for_reader_.begin() + position;
+    std::rotate(it, changes_for_reader_.end() - 1, changes_for_reader_.end());
+    return it;
+}
+
+ChangeForReaderStatus_t ReaderProxy::default_status(const SequenceNumber_t& seq_num) const
+{
+    if (seq_num <= unacknowledged_changes_mark_)
+    {
+        return UNACKNOWLEDGED;
+    }
+
+    return seq_num <= underway_changes_mark_ ? UNDERWAY : UNSENT;
+}
+
+bool ReaderProxy::is_hole(const SequenceNumber_t& seq_num) const
+{
+    if (seq_num <= irrelevant_changes_mark_)
+    {
+        return true;
+    }
+
+    ChangeConstIterator chit = find_change(seq_num);
+    if (chit != changes_for_reader_.end())
+    {
+        return !chit->isRelevant();
+    }
+
+    return history_change(seq_num) == nullptr;
+}
+
+bool ReaderProxy::only_holes_between(
+        const SequenceNumber_t& first,
+        const SequenceNumber_t& last) const
+{
+    for (SequenceNumber_t seq_num = first + 1; seq_num < last; ++seq_num)
+    {
+        if (!is_hole(seq_num))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ReaderProxy::change_status(
+        ChangeIterator it,
+        const SequenceNumber_t& seq_num,
+        ChangeForReaderStatus_t status)
+{
+    ChangeForReaderStatus_t current = it != changes_for_reader_.end() ? it->getStatus() : default_status(seq_num);
+    if (current == status)
+    {
+        return false;
+    }
+
+    // A change following the unacknowledged or underway range extends it
+    bool extends_range = false;
+    if (status == UNACKNOWLEDGED && seq_num > unacknowledged_changes_mark_ &&
+            only_holes_between(unacknowledged_changes_mark_, seq_num))
+    {
+        unacknowledged_changes_mark_ = seq_num;
+        underway_changes_mark_ = std::max(underway_changes_mark_, seq_num);
+        extends_range = true;
+    }
+    else if (status == UNDERWAY && seq_num > underway_changes_mark_ &&
+            only_holes_between(underway_changes_mark_, seq_num))
+    {
+        underway_changes_mark_ = seq_num;
+        extends_range = true;
+    }
+
+    // Unsent changes keep their own state, as some of their fragments may have been sent
+    if (extends_range || (status != UNSENT && status == default_status(seq_num)))
+    {
+        if (it != changes_for_reader_.end())
+        {
+            changes_for_reader_.erase(it);
+        }
+        return true;
+    }
+
+    if (it == changes_for_reader_.end())
+    {
+        CacheChange_t* change = history_change(seq_num);
+        it = insert_change(change != nullptr ? ChangeForReader_t(change) : ChangeForReader_t(seq_num));
+        if (it == changes_for_reader_.end())
+        {
+            return false;
+        }
+    }
+
+    it->setStatus(status);
+    return true;
+}
+
+void ReaderProxy::advance_low_mark(const SequenceNumber_t& seq_num)
+{
+    assert(seq_num >= changes_low_mark_);
+
+    changes_low_mark_ = seq_num;
+    changes_for_reader_.erase(changes_for_reader_.begin(), find_change(changes_low_mark_ + 1, false));
+
+    irrelevant_changes_mark_ = std::max(irrelevant_changes_mark_, changes_low_mark_);
+    unacknowledged_changes_mark_ = std::max(unacknowledged_changes_mark_, irrelevant_changes_mark_);
+    underway_changes_mark_ = std::max(underway_changes_mark_, unacknowledged_changes_mark_);
+    changes_high_mark_ = std::max(changes_high_mark_, underway_changes_mark_);
+}
+
+void ReaderProxy::trim_high_mark(const SequenceNumber_t& removed_seq_num)
+{
+    while (has_changes() && (changes_high_mark_ == removed_seq_num || is_hole(changes_high_mark_)))
+    {
+        changes_high_mark_ = changes_high_mark_ - 1;
+    }
+
+    changes_for_reader_.erase(find_change(changes_high_mark_ + 1, false), changes_for_reader_.end());
+
+    irrelevant_changes_mark_ = std::min(irrelevant_changes_mark_, changes_high_mark_);
+    unacknowledged_changes_mark_ = std::min(unacknowledged_changes_mark_, changes_high_mark_);
+    underway_changes_mark_ = std::min(underway_changes_mark_, changes_high_mark_);
+}
+
+std::vector<CacheChange_t*>::const_iterator ReaderProxy::history_lower_bound(const SequenceNumber_t& seq_num) const
+{
+    return std::lower_bound(writer_->mp_history->changesBegin(), writer_->mp_history->changesEnd(), seq_num,
+        [](const CacheChange_t* change, const SequenceNumber_t& seq)
+        {
+            return change->sequenceNumber < seq;
+        });
+}
+
+CacheChange_t* ReaderProxy::history_change(const SequenceNumber_t& seq_num) const
+{
+    std::vector<CacheChange_t*>::const_iterator it = history_lower_bound(seq_num);
+    if (it != writer_->mp_history->changesEnd() && (*it)->sequenceNumber == seq_num)
+    {
+        return *it;
+    }
+
+    return nullptr;
+}
+
+size_t ReaderProxy::history_count(
+        const SequenceNumber_t& first,
+        const SequenceNumber_t& last) const
+{
+    if (last <= first)
+    {
+        return 0;
+    }
+
+    return static_cast<size_t>(std::distance(history_lower_bound(first + 1), history_lower_bound(last + 1)));
+}
+
 bool ReaderProxy::are_there_gaps()
 {
-    return (0 < changes_for_reader_.size() &&
-            changes_low_mark_ + uint32_t(changes_for_reader_.size()) != changes_for_reader_.rbegin()->getSequenceNumber());
+    if (!has_changes())
+    {
+        return false;
+    }
+
+    if (irrelevant_changes_mark_ > changes_low_mark_)
+    {
+        return true;
+    }
+
+    for (const ChangeForReader_t& change : changes_for_reader_)
+    {
+        if (!change.isRelevant())
+        {
+            return true;
+        }
+    }
+
+    // Changes removed from history
+    return history_count(changes_low_mark_, changes_high_mark_) <
+        (changes_high_mark_ - changes_low_mark_).to64long();
 }
 
 }   // namespace rtps
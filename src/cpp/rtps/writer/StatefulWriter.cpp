@@ -44,8 +44,9 @@
 #include <fastrtps/rtps/builtin/liveliness/WLP.h>
 
 #include "RTPSWriterCollector.h"
-#include "StatefulWriterOrganizer.h"
 
+#include <algorithm>
+#include <chrono>
 #include <mutex>
 #include <vector>
 #include <stdexcept>
@@ -54,6 +55,12 @@ using namespace eprosima::fastrtps;
 using namespace eprosima::fastrtps::rtps;
 using namespace std::chrono;
 
+//! Delay of the response to ACKNACK messages. It lasts at least the NACK aggregation window.
+static const Duration_t& nack_response_delay(const WriterTimes& times)
+{
+    return times.nackAggregationWindow > times.nackResponseDelay ? times.nackAggregationWindow : times.nackResponseDelay;
+}
+
 StatefulWriter::StatefulWriter(
         RTPSParticipantImpl* pimpl,
         const GUID_t& guid,
@@ -79,11 +86,12 @@ StatefulWriter::StatefulWriter(
     , sendBufferSize_(pimpl->get_min_network_send_buffer_size())
     , currentUsageSendBufferSize_(static_cast<int32_t>(pimpl->get_min_network_send_buffer_size()))
     , m_controllers()
+    , relevant_changes_(new RTPSWriterCollector<ReaderProxy*>())
 {
     m_heartbeatCount = 0;
 
     mp_periodicHB = new PeriodicHeartbeat(this,TimeConv::Time_t2MilliSecondsDouble(m_times.heartbeatPeriod));
-    nack_response_event_ = new NackResponseDelay(this, TimeConv::Time_t2MilliSecondsDouble(m_times.nackResponseDelay));
+    nack_response_event_ = new NackResponseDelay(this, TimeConv::Time_t2MilliSecondsDouble(nack_response_delay(m_times)));
 
     if (disable_positive_acks_)
     {
@@ -98,6 +106,18 @@ StatefulWriter::StatefulWriter(
     {
         matched_readers_pool_.push_back(new ReaderProxy(m_times, this));
     }
+
+    // Scratch storage used while sending, so the common case does not allocate.
+    size_t initial_readers = att.matched_readers_allocation.initial;
+    size_t initial_changes = hist->m_att.initialReservedCaches > 0 ?
+        static_cast<size_t>(hist->m_att.initialReservedCaches) : 0u;
+    irrelevant_changes_.reserve(initial_changes);
+    gap_readers_.reserve(initial_readers);
+    gap_sequences_.reserve(initial_changes);
+    destination_readers_.reserve(initial_readers);
+    destination_guids_.reserve(initial_readers);
+    locator_lists_.reserve(initial_readers + 1);
+    multicast_readers_.reserve(initial_readers);
 }
 
 
@@ -166,10 +186,9 @@ void StatefulWriter::unsent_change_added_to_history(
             // First step is to add the new CacheChange_t to all reader proxies.
             // It has to be done before sending, because if a timeout is catched, we will not include the
             // CacheChange_t in some reader proxies.
+            ChangeForReader_t changeForReader(change);
             for (ReaderProxy* it : matched_readers_)
             {
-                ChangeForReader_t changeForReader(change);
-
                 if(m_pushMode)
                 {
                     if(it->is_reliable())
@@ -229,7 +248,7 @@ void StatefulWriter::unsent_change_added_to_history(
                     }
                 }
 
-                this->mp_periodicHB->restart_timer();
+                restart_periodic_heartbeat_nts_();
                 if ( (mp_listener != nullptr) && this->is_acked_by_all(change) )
                 {
                     mp_listener->onWriterChangeReceivedByAll(this, change);
@@ -247,19 +266,10 @@ void StatefulWriter::unsent_change_added_to_history(
         }
         else
         {
+            ChangeForReader_t changeForReader(change);
+            changeForReader.setStatus(m_pushMode ? UNSENT : UNACKNOWLEDGED);
             for(ReaderProxy* it : matched_readers_)
             {
-                ChangeForReader_t changeForReader(change);
-
-                if(m_pushMode)
-                {
-                    changeForReader.setStatus(UNSENT);
-                }
-                else
-                {
-                    changeForReader.setStatus(UNACKNOWLEDGED);
-                }
-
                 changeForReader.setRelevance(it->rtps_is_relevant(change));
                 it->add_change(changeForReader, false);
             }
@@ -336,7 +346,7 @@ void StatefulWriter::send_any_unsent_changes()
                 try
                 {
                     // For possible GAP
-                    std::set<SequenceNumber_t> irrelevant;
+                    gap_sequences_.clear();
 
                     // Specific destination message group
                     const std::vector<GUID_t>& guids = remoteReader->guid_as_vector();
@@ -378,16 +388,16 @@ void StatefulWriter::send_any_unsent_changes()
                         {
                             if (is_reliable)
                             {
-                                irrelevant.emplace(seqNum);
+                                gap_sequences_.push_back(seqNum);
                             }
                             remoteReader->set_change_to_status(seqNum, UNDERWAY, true);
                         } // Relevance
                     };
                     remoteReader->for_each_unsent_change(max_sequence, unsent_change_process);
 
-                    if (!irrelevant.empty())
+                    if (!gap_sequences_.empty())
                     {
-                        group.add_gap(irrelevant, guids, locators);
+                        group.add_gap(gap_sequences_, guids, locators);
                     }
                 }
                 catch(const RTPSMessageGroup::timeout&)
@@ -404,8 +414,9 @@ void StatefulWriter::send_any_unsent_changes()
     }
     else
     {
-        RTPSWriterCollector<ReaderProxy*> relevantChanges;
-        StatefulWriterOrganizer notRelevantChanges;
+        RTPSWriterCollector<ReaderProxy*>& relevantChanges = *relevant_changes_;
+        relevantChanges.clear();
+        irrelevant_changes_.clear();
 
         for (ReaderProxy* remoteReader : matched_readers_)
         {
@@ -425,7 +436,7 @@ void StatefulWriter::send_any_unsent_changes()
                 else
                 {
                     remoteReader->set_change_to_status(seq_num, UNDERWAY, true);
-                    notRelevantChanges.add_sequence_number(seq_num, remoteReader);
+                    irrelevant_changes_.emplace_back(remoteReader, seq_num);
                 }
             };
 
@@ -453,15 +464,14 @@ void StatefulWriter::send_any_unsent_changes()
 
                 while (!relevantChanges.empty())
                 {
-                    RTPSWriterCollector<ReaderProxy*>::Item changeToSend = relevantChanges.pop();
-                    std::vector<GUID_t> remote_readers;
-                    std::vector<LocatorList_t> locatorLists;
+                    RTPSWriterCollector<ReaderProxy*>::Item& changeToSend = relevantChanges.pop();
+                    const std::vector<GUID_t>* remote_readers = nullptr;
+                    const LocatorList_t* locators = nullptr;
                     bool expectsInlineQos = false;
 
+                    select_destinations_nts_(changeToSend.remoteReaders, remote_readers, locators);
                     for (const ReaderProxy* remoteReader : changeToSend.remoteReaders)
                     {
-                        remote_readers.push_back(remoteReader->guid());
-                        locatorLists.push_back(remoteReader->remote_locators());
                         expectsInlineQos |= remoteReader->expects_inline_qos();
                     }
 
@@ -471,9 +481,8 @@ void StatefulWriter::send_any_unsent_changes()
 
                     if (changeToSend.fragmentNumber != 0)
                     {
-                        if (group.add_data_frag(*changeToSend.cacheChange, changeToSend.fragmentNumber, remote_readers,
-                                    mp_RTPSParticipant->network_factory().ShrinkLocatorLists(locatorLists),
-                                    expectsInlineQos))
+                        if (group.add_data_frag(*changeToSend.cacheChange, changeToSend.fragmentNumber, *remote_readers,
+                                    *locators, expectsInlineQos))
                         {
                             bool must_wake_up_async_thread = false;
                             for (ReaderProxy* remoteReader : changeToSend.remoteReaders)
@@ -516,9 +525,7 @@ void StatefulWriter::send_any_unsent_changes()
                     }
                     else
                     {
-                    if (group.add_data(*changeToSend.cacheChange, remote_readers,
-                                    mp_RTPSParticipant->network_factory().ShrinkLocatorLists(locatorLists),
-                                    expectsInlineQos))
+                    if (group.add_data(*changeToSend.cacheChange, *remote_readers, *locators, expectsInlineQos))
                     {
                         for (ReaderProxy* remoteReader : changeToSend.remoteReaders)
                         {
@@ -540,20 +547,7 @@ void StatefulWriter::send_any_unsent_changes()
                     send_heartbeat_piggyback_nts_(group, lastBytesProcessed);
                 }
 
-                for (std::pair<std::vector<ReaderProxy*>, std::set<SequenceNumber_t>> pair : notRelevantChanges.elements())
-                {
-                    std::vector<GUID_t> remote_readers;
-                    std::vector<LocatorList_t> locatorLists;
-
-                    for (const ReaderProxy* remoteReader : pair.first)
-                    {
-                        remote_readers.push_back(remoteReader->guid());
-                        locatorLists.push_back(remoteReader->remote_locators());
-                    }
-                    group.add_gap(
-                                pair.second, remote_readers,
-                                mp_RTPSParticipant->network_factory().ShrinkLocatorLists(locatorLists));
-                }
+                send_irrelevant_changes_nts_(group);
             }
             catch(const RTPSMessageGroup::timeout&)
             {
@@ -583,7 +577,7 @@ void StatefulWriter::send_any_unsent_changes()
 
     if (activateHeartbeatPeriod)
     {
-        this->mp_periodicHB->restart_timer();
+        restart_periodic_heartbeat_nts_();
     }
 
     // On VOLATILE writers, remove auto-acked (best effort readers) changes
@@ -592,6 +586,111 @@ void StatefulWriter::send_any_unsent_changes()
     logInfo(RTPS_WRITER, "Finish sending unsent changes");
 }
 
+void StatefulWriter::select_destinations_nts_(
+        const std::vector<ReaderProxy*>& readers,
+        const std::vector<GUID_t>*& guids,
+        const LocatorList_t*& locators)
+{
+    // A reader appears only once on the list, so having all of them means the list is addressed to everyone.
+    if (readers.size() == matched_readers_.size())
+    {
+        guids = &static_cast<const std::vector<GUID_t>&>(all_remote_readers_);
+        locators = &mAllShrinkedLocatorList;
+    }
+    else if (readers.size() == 1)
+    {
+        guids = &readers.front()->guid_as_vector();
+        locators = &readers.front()->remote_locators_shrinked();
+    }
+    else
+    {
+        // Consecutive submessages usually go to the same readers, so the last destinations are kept and only
+        // computed again when the readers change.
+        if (readers != destination_readers_)
+        {
+            locator_lists_.clear();
+            destination_readers_.assign(readers.begin(), readers.end());
+            destination_guids_.clear();
+
+            for (const ReaderProxy* remoteReader : readers)
+            {
+                destination_guids_.push_back(remoteReader->guid());
+                locator_lists_.push_back(remoteReader->remote_locators());
+            }
+
+            destination_locators_ = mp_RTPSParticipant->network_factory().ShrinkLocatorLists(locator_lists_);
+        }
+
+        guids = &destination_guids_;
+        locators = &destination_locators_;
+    }
+}
+
+void StatefulWriter::send_irrelevant_changes_nts_(RTPSMessageGroup& group)
+{
+    // Changes of each reader are consecutive on the list and ordered by sequence number.
+    auto reader_end = [this](size_t begin)
+    {
+        size_t end = begin + 1;
+        while (end < irrelevant_changes_.size() && irrelevant_changes_[end].first == irrelevant_changes_[begin].first)
+        {
+            ++end;
+        }
+        return end;
+    };
+
+    auto same_changes = [this](size_t begin, size_t end, size_t other_begin, size_t other_end)
+    {
+        return (end - begin) == (other_end - other_begin) &&
+            std::equal(irrelevant_changes_.begin() + begin, irrelevant_changes_.begin() + end,
+                    irrelevant_changes_.begin() + other_begin,
+                    [](const std::pair<ReaderProxy*, SequenceNumber_t>& a,
+                        const std::pair<ReaderProxy*, SequenceNumber_t>& b)
+                    {
+                        return a.second == b.second;
+                    });
+    };
+
+    for (size_t begin = 0, end = 0; begin < irrelevant_changes_.size(); begin = end)
+    {
+        end = reader_end(begin);
+
+        // Readers with the same changes as a previous one already received its GAP.
+        bool already_sent = false;
+        for (size_t other = 0, other_end = 0; !already_sent && other < begin; other = other_end)
+        {
+            other_end = reader_end(other);
+            already_sent = same_changes(begin, end, other, other_end);
+        }
+
+        if (already_sent)
+        {
+            continue;
+        }
+
+        gap_readers_.clear();
+        for (size_t other = begin, other_end = 0; other < irrelevant_changes_.size(); other = other_end)
+        {
+            other_end = reader_end(other);
+            if (same_changes(begin, end, other, other_end))
+            {
+                gap_readers_.push_back(irrelevant_changes_[other].first);
+            }
+        }
+
+        gap_sequences_.clear();
+        for (size_t n = begin; n < end; ++n)
+        {
+            gap_sequences_.push_back(irrelevant_changes_[n].second);
+        }
+
+        const std::vector<GUID_t>* guids = nullptr;
+        const LocatorList_t* locators = nullptr;
+        select_destinations_nts_(gap_readers_, guids, locators);
+        group.add_gap(gap_sequences_, *guids, *locators);
+    }
+}
+
 /*
  * MATCHED_READER-RELATED METHODS
  */
@@ -605,7 +704,7 @@ bool StatefulWriter::matched_reader_add(RemoteReaderAttributes& rdata)
 
     std::lock_guard<std::recursive_timed_mutex> guard(mp_mutex);
 
-    std::vector<LocatorList_t> allLocatorLists;
+    locator_lists_.clear();
 
     // Check if it is already matched.
     for(ReaderProxy* it : matched_readers_)
@@ -616,7 +715,7 @@ bool StatefulWriter::matched_reader_add(RemoteReaderAttributes& rdata)
             return false;
         }
 
-        allLocatorLists.push_back(it->remote_locators());
+        locator_lists_.push_back(it->remote_locators());
     }
 
     // Get a reader proxy from the inactive pool (or create a new one if necessary and allowed)
@@ -645,9 +744,10 @@ bool StatefulWriter::matched_reader_add(RemoteReaderAttributes& rdata)
     all_remote_readers_.push_back(rdata.guid);
     LocatorList_t locators(rdata.endpoint.unicastLocatorList);
     locators.push_back(rdata.endpoint.multicastLocatorList);
-    allLocatorLists.push_back(locators);
+    locator_lists_.push_back(locators);
 
-    update_cached_info_nts(allLocatorLists);
+    update_cached_info_nts(locator_lists_);
+    destination_readers_.clear();
 
     getRTPSParticipant()->createSenderResources(mAllShrinkedLocatorList, false);
 
@@ -655,7 +755,7 @@ bool StatefulWriter::matched_reader_add(RemoteReaderAttributes& rdata)
         mp_RTPSParticipant->network_factory().ShrinkLocatorLists({rdata.endpoint.unicastLocatorList});
 
     rp->start(rdata);
-    std::set<SequenceNumber_t> not_relevant_changes;
+    gap_sequences_.clear();
 
     SequenceNumber_t current_seq = get_seq_num_min();
     SequenceNumber_t last_seq = get_seq_num_max();
@@ -672,7 +772,7 @@ bool StatefulWriter::matched_reader_add(RemoteReaderAttributes& rdata)
             // This is to cover the case when there are holes in the history
             while (current_seq != (*cit)->sequenceNumber)
             {
-                not_relevant_changes.insert(current_seq);
+                gap_sequences_.push_back(current_seq);
                 ++current_seq;
             }
 
@@ -683,13 +783,13 @@ bool StatefulWriter::matched_reader_add(RemoteReaderAttributes& rdata)
                 changeForReader.setRelevance(rp->rtps_is_relevant(*cit));
                 if(!rp->rtps_is_relevant(*cit))
                 {
-                    not_relevant_changes.insert(changeForReader.getSequenceNumber());
+                    gap_sequences_.push_back(changeForReader.getSequenceNumber());
                 }
             }
             else
             {
                 changeForReader.setRelevance(false);
-                not_relevant_changes.insert(changeForReader.getSequenceNumber());
+                gap_sequences_.push_back(changeForReader.getSequenceNumber());
             }
 
             // The ChangeForReader_t status has to be UNACKNOWLEDGED
@@ -701,7 +801,7 @@ bool StatefulWriter::matched_reader_add(RemoteReaderAttributes& rdata)
         // This is to cover the case where the last changes have been removed from the history
         while (current_seq < next_sequence_number())
         {
-            not_relevant_changes.insert(current_seq);
+            gap_sequences_.push_back(current_seq);
             ++current_seq;
         }
 
@@ -725,9 +825,9 @@ bool StatefulWriter::matched_reader_add(RemoteReaderAttributes& rdata)
                         disable_positive_acks_);
 
             // Send Gap
-            if(!not_relevant_changes.empty())
+            if(!gap_sequences_.empty())
             {
-                group.add_gap(not_relevant_changes, guids, locatorsList);
+                group.add_gap(gap_sequences_, guids, locatorsList);
             }
         }
         catch(const RTPSMessageGroup::timeout&)
@@ -737,7 +837,7 @@ bool StatefulWriter::matched_reader_add(RemoteReaderAttributes& rdata)
 
         // Always activate heartbeat period. We need a confirmation of the reader.
         // The state has to be updated.
-        this->mp_periodicHB->restart_timer();
+        restart_periodic_heartbeat_nts_();
     }
     else
     {
@@ -758,7 +858,7 @@ bool StatefulWriter::matched_reader_remove(const RemoteReaderAttributes& rdata)
     ReaderProxy *rproxy = nullptr;
     std::unique_lock<std::recursive_timed_mutex> lock(mp_mutex);
 
-    std::vector<LocatorList_t> allLocatorLists;
+    locator_lists_.clear();
 
     ReaderProxyIterator it = matched_readers_.begin();
     while(it != matched_readers_.end())
@@ -772,12 +872,13 @@ bool StatefulWriter::matched_reader_remove(const RemoteReaderAttributes& rdata)
             continue;
         }
 
-        allLocatorLists.push_back((*it)->remote_locators());
+        locator_lists_.push_back((*it)->remote_locators());
         ++it;
     }
 
     all_remote_readers_.remove(rdata.guid);
-    update_cached_info_nts(allLocatorLists);
+    update_cached_info_nts(locator_lists_);
+    destination_readers_.clear();
 
     if(matched_readers_.size()==0)
         this->mp_periodicHB->cancel_timer();
@@ -997,11 +1098,11 @@ void StatefulWriter::updateTimes(const WriterTimes& times)
     {
         this->mp_periodicHB->update_interval(times.heartbeatPeriod);
     }
-    if(m_times.nackResponseDelay != times.nackResponseDelay)
+    if(nack_response_delay(m_times) != nack_response_delay(times))
     {
         if(nack_response_event_ != nullptr)
         {
-            nack_response_event_->update_interval(times.nackResponseDelay);
+            nack_response_event_->update_interval(nack_response_delay(times));
         }
     }
     if(m_times.nackSupressionDuration != times.nackSupressionDuration)
@@ -1015,6 +1116,10 @@ void StatefulWriter::updateTimes(const WriterTimes& times)
             it->update_nack_supression_interval(times.nackSupressionDuration);
         }
     }
+    if(m_times.adaptiveHeartbeat && !times.adaptiveHeartbeat)
+    {
+        this->mp_periodicHB->update_interval(times.heartbeatPeriod);
+    }
     m_times = times;
 }
 
@@ -1042,6 +1147,10 @@ bool StatefulWriter::send_periodic_heartbeat(
             if (it->has_unacknowledged())
             {
                 send_heartbeat_to_nts(*it, liveliness);
+                if (!disable_positive_acks_)
+                {
+                    it->heartbeat_sent(std::chrono::steady_clock::now());
+                }
                 unacked_changes = true;
             }
         }
@@ -1084,6 +1193,16 @@ bool StatefulWriter::send_periodic_heartbeat(
                                 group,
                                 disable_positive_acks_,
                                 liveliness);
+
+                    if (!disable_positive_acks_)
+                    {
+                        // Readers are expected to answer, which measures their round-trip time
+                        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+                        for (ReaderProxy* it : matched_readers_)
+                        {
+                            it->heartbeat_sent(now);
+                        }
+                    }
                 }
                 catch(const RTPSMessageGroup::timeout&)
                 {
@@ -1117,9 +1236,45 @@ bool StatefulWriter::send_periodic_heartbeat(
         }
     }
 
+    if (unacked_changes && m_times.adaptiveHeartbeat)
+    {
+        mp_periodicHB->update_interval_millisec(adaptive_heartbeat_period_nts_());
+    }
+
     return unacked_changes;
 }
 
+void StatefulWriter::restart_periodic_heartbeat_nts_()
+{
+    if (m_times.adaptiveHeartbeat)
+    {
+        mp_periodicHB->update_interval_millisec(adaptive_heartbeat_period_nts_());
+    }
+
+    mp_periodicHB->restart_timer();
+}
+
+double StatefulWriter::adaptive_heartbeat_period_nts_() const
+{
+    double min_period = TimeConv::Time_t2MilliSecondsDouble(m_times.heartbeatPeriodMin);
+    double max_period = std::max(TimeConv::Time_t2MilliSecondsDouble(m_times.heartbeatPeriodMax), min_period);
+
+    // The reader needing it most sets the pace
+    double period = max_period;
+    bool pending = false;
+    for (const ReaderProxy* it : matched_readers_)
+    {
+        if (it->has_unacknowledged())
+        {
+            period = std::min(period, it->heartbeat_period_millisec(min_period, max_period));
+            pending = true;
+        }
+    }
+
+    // Readers just matched are not in the list yet and have not been measured
+    return pending ? period : min_period;
+}
+
 void StatefulWriter::send_heartbeat_to_nts(
         ReaderProxy& remoteReaderProxy,
         bool liveliness)
@@ -1183,6 +1338,7 @@ void StatefulWriter::send_heartbeat_nts_(
                 final,
                 liveliness,
                 locators);
+
     // Update calculate of heartbeat piggyback.
     currentUsageSendBufferSize_ = static_cast<int32_t>(sendBufferSize_);
 
@@ -1234,6 +1390,11 @@ void StatefulWriter::perform_nack_response()
     std::unique_lock<std::recursive_timed_mutex> lock(mp_mutex);
     bool must_wake_up_async_thread = false;
 
+    if (m_times.nackAggregationWindow != c_TimeZero)
+    {
+        merge_multicast_requests_nts_();
+    }
+
     for (ReaderProxy* remote_reader : matched_readers_)
     {
         if (remote_reader->perform_acknack_response() || remote_reader->are_there_gaps())
@@ -1248,6 +1409,69 @@ void StatefulWriter::perform_nack_response()
     }
 }
 
+void StatefulWriter::merge_multicast_requests_nts_()
+{
+    // Repairs are sent to each reader separately, so they could not be shared anyway.
+    if (m_separateSendingEnabled)
+    {
+        return;
+    }
+
+    multicast_locators_.clear();
+    for (const ReaderProxy* remote_reader : matched_readers_)
+    {
+        for (const Locator_t& locator : remote_reader->reader_attributes().endpoint.multicastLocatorList)
+        {
+            if (std::find(multicast_locators_.begin(), multicast_locators_.end(), locator) == multicast_locators_.end())
+            {
+                multicast_locators_.push_back(locator);
+            }
+        }
+    }
+
+    for (const Locator_t& locator : multicast_locators_)
+    {
+        multicast_readers_.clear();
+        for (ReaderProxy* remote_reader : matched_readers_)
+        {
+            if (remote_reader->reader_attributes().endpoint.multicastLocatorList.contains(locator))
+            {
+                multicast_readers_.push_back(remote_reader);
+            }
+        }
+
+        if (multicast_readers_.size() < 2)
+        {
+            continue;
+        }
+
+        // The bitmap starts on the lowest change not acknowledged by the readers listening on the locator
+        SequenceNumber_t base = multicast_readers_.front()->changes_low_mark() + 1;
+        for (const ReaderProxy* remote_reader : multicast_readers_)
+        {
+            base = std::min(base, remote_reader->changes_low_mark() + 1);
+        }
+
+        SequenceNumberSet_t requested(base);
+        for (const ReaderProxy* remote_reader : multicast_readers_)
+        {
+            remote_reader->get_requested_changes(requested);
+        }
+
+        if (requested.empty())
+        {
+            continue;
+        }
+
+        // Readers that did not request a change yet, but have not acknowledged it, receive it too.
+        // The repair is then shared by all of them, and sent once through the multicast locator.
+        for (ReaderProxy* remote_reader : multicast_readers_)
+        {
+            remote_reader->requested_changes_set(requested);
+        }
+    }
+}
+
 void StatefulWriter::perform_nack_supression(const GUID_t& reader_guid)
 {
     std::unique_lock<std::recursive_timed_mutex> lock(mp_mutex);
@@ -1257,7 +1481,7 @@ void StatefulWriter::perform_nack_supression(const GUID_t& reader_guid)
         if (remote_reader->guid() == reader_guid)
         {
             remote_reader->perform_nack_supression();
-            mp_periodicHB->restart_timer();
+            restart_periodic_heartbeat_nts_();
             return;
         }
     }
@@ -1281,6 +1505,8 @@ bool StatefulWriter::process_acknack(
             {
                 if (remote_reader->check_and_set_acknack_count(ack_count))
                 {
+                    remote_reader->acknack_received(std::chrono::steady_clock::now());
+
                     // Sequence numbers before Base are set as Acknowledged.
                     remote_reader->acked_changes_set(sn_set.base());
                     if (sn_set.base() > SequenceNumber_t(0, 0))
@@ -1291,7 +1517,7 @@ bool StatefulWriter::process_acknack(
                         }
                         else if (!final_flag)
                         {
-                            mp_periodicHB->restart_timer();
+                            restart_periodic_heartbeat_nts_();
                         }
                     }
                     else if (sn_set.empty() && !final_flag)
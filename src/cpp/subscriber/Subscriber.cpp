@@ -44,6 +44,16 @@ bool Subscriber::takeNextData(void* data,SampleInfo_t* info)
     return mp_impl->takeNextData(data,info);
 }
 
+bool Subscriber::take_loan(const void*& sample, SampleInfo_t* info)
+{
+    return mp_impl->take_loan(sample, info);
+}
+
+bool Subscriber::return_loan(const void* sample)
+{
+    return mp_impl->return_loan(sample);
+}
+
 bool Subscriber::updateAttributes(const SubscriberAttributes& att)
 {
     return mp_impl->updateAttributes(att);
@@ -26,6 +26,7 @@
 #include <fastrtps/TopicDataType.h>
 #include <fastrtps/log/Log.h>
 
+#include <algorithm>
 #include <mutex>
 
 using namespace eprosima::fastrtps;
@@ -65,8 +66,16 @@ SubscriberHistory::SubscriberHistory(
     }
 }
 
+//! Size of the CDR encapsulation header preceding loaned samples.
+static const uint32_t s_encapsulation_size = 4;
+
 SubscriberHistory::~SubscriberHistory()
 {
+    for (CacheChange_t* change : loaned_changes_)
+    {
+        m_changePool.release_Cache(change);
+    }
+
     if (mp_subImpl->getType()->m_isGetKeyDefined)
     {
         mp_subImpl->getType()->deleteData(mp_getKeyObject);
@@ -260,10 +269,12 @@ bool SubscriberHistory::received_change(
                     }
                     else
                     {
-                        vit->second.cache_changes.push_back(a_change);
-                        std::sort(vit->second.cache_changes.begin(),
-                                  vit->second.cache_changes.end(),
-                                  sort_ReaderHistoryCache);
+                        vit->second.cache_changes.insert(
+                            std::upper_bound(vit->second.cache_changes.begin(),
+                                             vit->second.cache_changes.end(),
+                                             a_change,
+                                             sort_ReaderHistoryCache),
+                            a_change);
                     }
 
                     logInfo(SUBSCRIBER, this->mp_reader->getGuid().entityId
@@ -306,6 +317,7 @@ bool SubscriberHistory::readNextBuffer(SerializedPayload_t* data, SampleInfo_t*
             info->sample_identity.writer_guid(change->writerGUID);
             info->sample_identity.sequence_number(change->sequenceNumber);
             info->sourceTimestamp = change->sourceTimestamp;
+            info->receptionTimestamp = change->receptionTimestamp;
             if (this->mp_subImpl->getAttributes().qos.m_ownership.kind == EXCLUSIVE_OWNERSHIP_QOS)
             {
                 info->ownershipStrength = wp->m_att.ownershipStrength;
@@ -353,6 +365,7 @@ bool SubscriberHistory::takeNextBuffer(SerializedPayload_t* data, SampleInfo_t*
             info->sample_identity.writer_guid(change->writerGUID);
             info->sample_identity.sequence_number(change->sequenceNumber);
             info->sourceTimestamp = change->sourceTimestamp;
+            info->receptionTimestamp = change->receptionTimestamp;
             if (this->mp_subImpl->getAttributes().qos.m_ownership.kind == EXCLUSIVE_OWNERSHIP_QOS)
             {
                 info->ownershipStrength = wp->m_att.ownershipStrength;
@@ -399,6 +412,7 @@ bool SubscriberHistory::readNextData(void* data, SampleInfo_t* info)
             info->sample_identity.writer_guid(change->writerGUID);
             info->sample_identity.sequence_number(change->sequenceNumber);
             info->sourceTimestamp = change->sourceTimestamp;
+            info->receptionTimestamp = change->receptionTimestamp;
             if (this->mp_subImpl->getAttributes().qos.m_ownership.kind == EXCLUSIVE_OWNERSHIP_QOS)
             {
                 info->ownershipStrength = wp->m_att.ownershipStrength;
@@ -451,6 +465,7 @@ bool SubscriberHistory::takeNextData(void* data, SampleInfo_t* info)
             info->sample_identity.writer_guid(change->writerGUID);
             info->sample_identity.sequence_number(change->sequenceNumber);
             info->sourceTimestamp = change->sourceTimestamp;
+            info->receptionTimestamp = change->receptionTimestamp;
             if (this->mp_subImpl->getAttributes().qos.m_ownership.kind == EXCLUSIVE_OWNERSHIP_QOS)
             {
                 info->ownershipStrength = wp->m_att.ownershipStrength;
@@ -474,6 +489,105 @@ bool SubscriberHistory::takeNextData(void* data, SampleInfo_t* info)
     return false;
 }
 
+bool SubscriberHistory::take_loan(const void*& sample, SampleInfo_t* info)
+{
+    if (mp_reader == nullptr || mp_mutex == nullptr)
+    {
+        logError(RTPS_HISTORY, "You need to create a Reader with this History before using it");
+        return false;
+    }
+
+    TopicDataType* type = this->mp_subImpl->getType();
+    if (!type->is_plain())
+    {
+        logError(SUBSCRIBER, "Type " << type->getName() << " is not plain, samples cannot be loaned");
+        return false;
+    }
+
+    std::lock_guard<std::recursive_timed_mutex> guard(*mp_mutex);
+    CacheChange_t* change;
+    WriterProxy * wp;
+    if (this->mp_reader->nextUntakenCache(&change, &wp))
+    {
+        if (change->kind == ALIVE)
+        {
+            const uint16_t native_encapsulation = DEFAULT_ENDIAN == BIGEND ? CDR_BE : CDR_LE;
+            const SerializedPayload_t& payload = change->serializedPayload;
+            if (payload.length < type->m_typeSize || payload.data[1] != native_encapsulation)
+            {
+                logWarning(SUBSCRIBER, "Change " << change->sequenceNumber << " from " << change->writerGUID <<
+                    " cannot be loaned, it was not serialized with the native endianness");
+                return false;
+            }
+        }
+
+        if (!change->isRead)
+        {
+            this->decreaseUnreadCount();
+        }
+        change->isRead = true;
+        logInfo(SUBSCRIBER, this->mp_reader->getGuid().entityId << ": loaning seqNum" << change->sequenceNumber <<
+            " from writer: " << change->writerGUID);
+        sample = change->serializedPayload.data + s_encapsulation_size;
+        if (info != nullptr)
+        {
+            info->sampleKind = change->kind;
+            info->sample_identity.writer_guid(change->writerGUID);
+            info->sample_identity.sequence_number(change->sequenceNumber);
+            info->sourceTimestamp = change->sourceTimestamp;
+            info->receptionTimestamp = change->receptionTimestamp;
+            if (this->mp_subImpl->getAttributes().qos.m_ownership.kind == EXCLUSIVE_OWNERSHIP_QOS)
+            {
+                info->ownershipStrength = wp->m_att.ownershipStrength;
+            }
+            if (this->mp_subImpl->getAttributes().topic.topicKind == WITH_KEY &&
+                change->instanceHandle == c_InstanceHandle_Unknown && change->kind == ALIVE)
+            {
+                bool is_key_protected = false;
+#if HAVE_SECURITY
+                is_key_protected = mp_reader->getAttributes().security_attributes().is_key_protected;
+#endif
+                type->getKey(const_cast<void*>(sample), &change->instanceHandle, is_key_protected);
+            }
+            info->iHandle = change->instanceHandle;
+            info->related_sample_identity = change->write_params.sample_identity();
+        }
+
+        if (!this->remove_change_sub(change, false))
+        {
+            return false;
+        }
+
+        loaned_changes_.push_back(change);
+        return true;
+    }
+
+    return false;
+}
+
+bool SubscriberHistory::return_loan(const void* sample)
+{
+    if (mp_reader == nullptr || mp_mutex == nullptr)
+    {
+        logError(RTPS_HISTORY, "You need to create a Reader with this History before using it");
+        return false;
+    }
+
+    std::lock_guard<std::recursive_timed_mutex> guard(*mp_mutex);
+    for (auto it = loaned_changes_.begin(); it != loaned_changes_.end(); ++it)
+    {
+        if ((*it)->serializedPayload.data + s_encapsulation_size == sample)
+        {
+            m_changePool.release_Cache(*it);
+            loaned_changes_.erase(it);
+            return true;
+        }
+    }
+
+    logError(SUBSCRIBER, "Sample was not loaned by this subscriber");
+    return false;
+}
+
 bool SubscriberHistory::find_key(
         CacheChange_t* a_change,
         t_m_Inst_Caches::iterator* vit_out)
@@ -509,6 +623,13 @@ bool SubscriberHistory::find_key(
 
 
 bool SubscriberHistory::remove_change_sub(CacheChange_t* change)
+{
+    return remove_change_sub(change, true);
+}
+
+bool SubscriberHistory::remove_change_sub(
+        CacheChange_t* change,
+        bool release_cache)
 {
     if (mp_reader == nullptr || mp_mutex == nullptr)
     {
@@ -519,7 +640,7 @@ bool SubscriberHistory::remove_change_sub(CacheChange_t* change)
     std::lock_guard<std::recursive_timed_mutex> guard(*mp_mutex);
     if (mp_subImpl->getAttributes().topic.getTopicKind() == NO_KEY)
     {
-        if (this->remove_change(change))
+        if (this->remove_change(change, release_cache))
         {
             m_isHistoryFull = false;
             return true;
@@ -538,7 +659,7 @@ bool SubscriberHistory::remove_change_sub(CacheChange_t* change)
         {
             if ((*chit)->sequenceNumber == change->sequenceNumber && (*chit)->writerGUID == change->writerGUID)
             {
-                if (remove_change(change))
+                if (remove_change(change, release_cache))
                 {
                     vit->second.cache_changes.erase(chit);
                     m_isHistoryFull = false;
@@ -80,6 +80,9 @@ public:
 	bool readNextData(void* data,SampleInfo_t* info);
 	bool takeNextData(void* data,SampleInfo_t* info);
 
+	bool take_loan(const void*& sample, SampleInfo_t* info);
+	bool return_loan(const void* sample);
+
 	///@}
 
 	/**
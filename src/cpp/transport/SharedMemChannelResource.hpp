@@ -0,0 +1,113 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __TRANSPORT_SHAREDMEMCHANNELRESOURCE_HPP__
+#define __TRANSPORT_SHAREDMEMCHANNELRESOURCE_HPP__
+
+#include <fastrtps/transport/ChannelResource.h>
+#include <fastrtps/transport/TransportReceiverInterface.h>
+#include <fastrtps/rtps/common/Locator.h>
+
+#include "SharedMemPort.hpp"
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+class SharedMemChannelResource : public ChannelResource
+{
+    public:
+
+        SharedMemChannelResource(
+                std::shared_ptr<SharedMemPort> port,
+                uint32_t maxMsgSize,
+                const Locator_t& locator,
+                const Locator_t& remote_locator,
+                TransportReceiverInterface* receiver)
+            : ChannelResource(maxMsgSize)
+            , message_receiver_(receiver)
+            , port_(port)
+        {
+            thread(std::thread(&SharedMemChannelResource::perform_listen_operation, this, locator, remote_locator));
+        }
+
+        virtual ~SharedMemChannelResource() override
+        {
+            message_receiver_ = nullptr;
+        }
+
+        inline virtual void disable() override
+        {
+            ChannelResource::disable();
+            port_->wake_up();
+        }
+
+        //! Stops the listening thread and destroys the segment.
+        void release()
+        {
+            disable();
+            clear();
+            port_.reset();
+        }
+
+    private:
+
+        //! Period at which the listening thread checks whether it has been disabled.
+        static const uint32_t s_listen_timeout_ms = 100;
+
+        /**
+         * Function to be called from a new thread, which takes care of waiting for messages
+         * on the shared memory segment.
+         * @param input_locator - Locator that triggered the creation of the resource
+         * @param remote_locator - Locator reported as the origin of the messages
+         */
+        void perform_listen_operation(
+                Locator_t input_locator,
+                Locator_t remote_locator)
+        {
+            while (alive())
+            {
+                uint32_t size = 0;
+                if (!port_->pop(message_buffer_.buffer, message_buffer_.max_size, size, s_listen_timeout_ms))
+                {
+                    continue;
+                }
+
+                if (message_receiver_ != nullptr)
+                {
+                    message_receiver_->OnDataReceived(message_buffer_.buffer, size, input_locator, remote_locator);
+                }
+                else if (alive())
+                {
+                    logWarning(RTPS_MSG_IN, "Received Message, but no receiver attached");
+                }
+            }
+
+            message_receiver_ = nullptr;
+        }
+
+        TransportReceiverInterface* message_receiver_;
+
+        std::shared_ptr<SharedMemPort> port_;
+
+        SharedMemChannelResource(const SharedMemChannelResource&) = delete;
+
+        SharedMemChannelResource& operator=(const SharedMemChannelResource&) = delete;
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // __TRANSPORT_SHAREDMEMCHANNELRESOURCE_HPP__
@@ -0,0 +1,521 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "SharedMemPort.hpp"
+
+#include <fastrtps/log/Log.h>
+
+#include <atomic>
+#include <thread>
+#include <cstring>
+#include <cstddef>
+
+#if defined(__linux__) && !defined(__ANDROID__)
+#include <fcntl.h>
+#include <semaphore.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <ctime>
+#include <cerrno>
+#endif
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+std::string SharedMemPort::segment_name(uint16_t port)
+{
+    return "/fastrtps_shm_port" + std::to_string(port);
+}
+
+#if defined(__linux__) && !defined(__ANDROID__)
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "Shared memory queue requires lock-free 64 bit atomics");
+
+static const uint32_t s_segment_magic = 0x5348524d; // "SHRM"
+static const uint32_t s_segment_version = 3;
+//! Minimum time between two checks of the listener lock from the same sender.
+static const int64_t s_liveness_check_period_ns = 100000000;
+static const size_t s_cache_line = 64;
+
+struct SharedMemPort::SegmentHeader
+{
+    std::atomic<uint32_t> magic;
+    uint32_t version;
+    uint32_t capacity;
+    uint32_t cell_size;
+    uint32_t cell_stride;
+    std::atomic<uint32_t> listener_alive;
+    sem_t data_available;
+    alignas(s_cache_line) std::atomic<uint64_t> enqueue_pos;
+    alignas(s_cache_line) std::atomic<uint64_t> dequeue_pos;
+};
+
+struct SharedMemPort::Cell
+{
+    std::atomic<uint64_t> sequence;
+    //! Process copying into the cell, 0 when unknown.
+    std::atomic<int32_t> writer_pid;
+    uint32_t size;
+    octet data[1];
+};
+
+static struct flock listener_lock(short type)
+{
+    struct flock lock;
+    memset(&lock, 0, sizeof(lock));
+    lock.l_type = type;
+    lock.l_whence = SEEK_SET;
+    return lock;
+}
+
+static size_t align_up(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+static bool deadline_expired(const struct timespec& deadline)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    return now.tv_sec > deadline.tv_sec || (now.tv_sec == deadline.tv_sec && now.tv_nsec >= deadline.tv_nsec);
+}
+
+static bool process_dead(int32_t pid)
+{
+    return pid != 0 && kill(pid, 0) != 0 && errno == ESRCH;
+}
+
+static uint32_t next_power_of_two(uint32_t value)
+{
+    uint32_t result = 1;
+    while (result < value && result < 0x80000000u)
+    {
+        result <<= 1;
+    }
+    return result;
+}
+
+SharedMemPort::SharedMemPort(
+        uint16_t port,
+        int fd,
+        void* segment,
+        size_t segment_size,
+        bool is_listener)
+    : port_(port)
+    , fd_(fd)
+    , segment_(segment)
+    , segment_size_(segment_size)
+    , is_listener_(is_listener)
+    , header_(static_cast<SegmentHeader*>(segment))
+    , cells_(static_cast<octet*>(segment) + align_up(sizeof(SegmentHeader), s_cache_line))
+    , next_liveness_check_(0)
+{
+}
+
+SharedMemPort::~SharedMemPort()
+{
+    if (is_listener_)
+    {
+        header_->listener_alive.store(0, std::memory_order_release);
+        shm_unlink(segment_name(port_).c_str());
+    }
+
+    munmap(segment_, segment_size_);
+
+    // Closing the descriptor releases the listener lock.
+    close(fd_);
+}
+
+std::shared_ptr<SharedMemPort> SharedMemPort::open_listener(
+        uint16_t port,
+        uint32_t capacity,
+        uint32_t cell_size)
+{
+    std::string name = segment_name(port);
+    int fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0666);
+    if (fd < 0)
+    {
+        logWarning(RTPS_MSG_OUT, "Cannot open shared memory segment " << name << ": " << strerror(errno));
+        return nullptr;
+    }
+
+    // The lock is held while the port is open. Senders query it without taking it (see listener_alive),
+    // which is why an open file description lock is used.
+    struct flock lock = listener_lock(F_WRLCK);
+    if (fcntl(fd, F_OFD_SETLK, &lock) != 0)
+    {
+        close(fd);
+        return nullptr;
+    }
+
+    // A stale segment left behind by a crashed process has no lock. Senders may still have it mapped, so
+    // it is not reinitialized in place: its name is given to a fresh segment, and those senders find the
+    // new one once they notice the old listener is gone.
+    struct stat segment_stat;
+    if (fstat(fd, &segment_stat) != 0 || segment_stat.st_nlink == 0)
+    {
+        // Another process replaced the stale segment meanwhile, so it is the one listening.
+        close(fd);
+        return nullptr;
+    }
+
+    if (segment_stat.st_size != 0)
+    {
+        // The stale segment stays locked until the fresh one is, so no other process replaces it too.
+        shm_unlink(name.c_str());
+        int fresh_fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0666);
+
+        // Another process may have created the fresh segment first, then it is the one listening.
+        if (fresh_fd >= 0 && fcntl(fresh_fd, F_OFD_SETLK, &lock) != 0)
+        {
+            close(fresh_fd);
+            fresh_fd = -1;
+        }
+
+        close(fd);
+        if (fresh_fd < 0)
+        {
+            return nullptr;
+        }
+
+        fd = fresh_fd;
+    }
+
+    // shm_open honours the umask. Let participants from other users send to this port.
+    fchmod(fd, 0666);
+
+    capacity = next_power_of_two(capacity < 2 ? 2 : capacity);
+    size_t cell_stride = align_up(offsetof(Cell, data) + cell_size, s_cache_line);
+    size_t segment_size = align_up(sizeof(SegmentHeader), s_cache_line) + cell_stride * capacity;
+
+    if (ftruncate(fd, static_cast<off_t>(segment_size)) != 0)
+    {
+        logWarning(RTPS_MSG_OUT, "Cannot resize shared memory segment " << name << ": " << strerror(errno));
+        close(fd);
+        return nullptr;
+    }
+
+    void* segment = mmap(nullptr, segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (segment == MAP_FAILED)
+    {
+        logWarning(RTPS_MSG_OUT, "Cannot map shared memory segment " << name << ": " << strerror(errno));
+        close(fd);
+        return nullptr;
+    }
+
+    std::shared_ptr<SharedMemPort> shm_port(new SharedMemPort(port, fd, segment, segment_size, true));
+
+    SegmentHeader* header = shm_port->header_;
+    header->magic.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    header->version = s_segment_version;
+    header->capacity = capacity;
+    header->cell_size = cell_size;
+    header->cell_stride = static_cast<uint32_t>(cell_stride);
+    sem_init(&header->data_available, 1, 0);
+    header->enqueue_pos.store(0, std::memory_order_relaxed);
+    header->dequeue_pos.store(0, std::memory_order_relaxed);
+    for (uint32_t i = 0; i < capacity; ++i)
+    {
+        shm_port->cell_at(i)->sequence.store(i, std::memory_order_relaxed);
+        shm_port->cell_at(i)->writer_pid.store(0, std::memory_order_relaxed);
+    }
+    header->listener_alive.store(1, std::memory_order_relaxed);
+    header->magic.store(s_segment_magic, std::memory_order_release);
+
+    return shm_port;
+}
+
+std::shared_ptr<SharedMemPort> SharedMemPort::open_sender(
+        uint16_t port)
+{
+    std::string name = segment_name(port);
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0)
+    {
+        return nullptr;
+    }
+
+    struct stat segment_stat;
+    if (fstat(fd, &segment_stat) != 0 ||
+            static_cast<size_t>(segment_stat.st_size) < align_up(sizeof(SegmentHeader), s_cache_line))
+    {
+        close(fd);
+        return nullptr;
+    }
+
+    size_t segment_size = static_cast<size_t>(segment_stat.st_size);
+    void* segment = mmap(nullptr, segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (segment == MAP_FAILED)
+    {
+        close(fd);
+        return nullptr;
+    }
+
+    std::shared_ptr<SharedMemPort> shm_port(new SharedMemPort(port, fd, segment, segment_size, false));
+
+    const SegmentHeader* header = shm_port->header_;
+    if (header->magic.load(std::memory_order_acquire) != s_segment_magic || header->version != s_segment_version ||
+            align_up(sizeof(SegmentHeader), s_cache_line) +
+            static_cast<size_t>(header->cell_stride) * header->capacity > segment_size ||
+            !shm_port->listener_alive())
+    {
+        return nullptr;
+    }
+
+    return shm_port;
+}
+
+SharedMemPort::Cell* SharedMemPort::cell_at(uint64_t position) const
+{
+    uint64_t index = position & (header_->capacity - 1);
+    return reinterpret_cast<Cell*>(cells_ + index * header_->cell_stride);
+}
+
+bool SharedMemPort::push(
+        const octet* data,
+        uint32_t size)
+{
+    if (size > header_->cell_size)
+    {
+        return false;
+    }
+
+    Cell* cell = nullptr;
+    uint64_t pos = header_->enqueue_pos.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        cell = cell_at(pos);
+        uint64_t seq = cell->sequence.load(std::memory_order_acquire);
+        int64_t diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+        if (diff == 0)
+        {
+            if (header_->enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            // Queue full
+            return false;
+        }
+        else
+        {
+            pos = header_->enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->writer_pid.store(static_cast<int32_t>(getpid()), std::memory_order_relaxed);
+    memcpy(cell->data, data, size);
+    cell->size = size;
+
+    // The listener only gives up on the cell if this process looks dead to it.
+    uint64_t reserved = pos;
+    if (!cell->sequence.compare_exchange_strong(reserved, pos + 1, std::memory_order_release,
+            std::memory_order_relaxed))
+    {
+        return false;
+    }
+
+    sem_post(&header_->data_available);
+    return true;
+}
+
+bool SharedMemPort::pop(
+        octet* buffer,
+        uint32_t buffer_capacity,
+        uint32_t& size,
+        uint32_t timeout_ms)
+{
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += timeout_ms / 1000;
+    deadline.tv_nsec += static_cast<long>(timeout_ms % 1000) * 1000000;
+    if (deadline.tv_nsec >= 1000000000)
+    {
+        deadline.tv_sec += 1;
+        deadline.tv_nsec -= 1000000000;
+    }
+
+    while (sem_timedwait(&header_->data_available, &deadline) != 0)
+    {
+        if (errno != EINTR)
+        {
+            return false;
+        }
+    }
+
+    Cell* cell = nullptr;
+    uint64_t pos = header_->dequeue_pos.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        cell = cell_at(pos);
+        uint64_t seq = cell->sequence.load(std::memory_order_acquire);
+        int64_t diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos + 1);
+        if (diff == 0)
+        {
+            if (header_->dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            if (header_->enqueue_pos.load(std::memory_order_relaxed) == pos)
+            {
+                // Woken up without data (see wake_up)
+                return false;
+            }
+
+            // A producer reserved this cell but has not finished copying into it.
+            if (!deadline_expired(deadline))
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            // A producer that died after reserving the cell would block the queue forever, so its cell is skipped.
+            uint64_t reserved = pos;
+            if (process_dead(cell->writer_pid.load(std::memory_order_relaxed)) &&
+                    cell->sequence.compare_exchange_strong(reserved, pos + header_->capacity,
+                    std::memory_order_acq_rel, std::memory_order_relaxed))
+            {
+                logWarning(RTPS_MSG_IN, "Skipping message of a dead process on shared memory port " << port_);
+                cell->writer_pid.store(0, std::memory_order_relaxed);
+                header_->dequeue_pos.compare_exchange_strong(pos, pos + 1, std::memory_order_relaxed);
+                pos = header_->dequeue_pos.load(std::memory_order_relaxed);
+                continue;
+            }
+
+            if (reserved != pos)
+            {
+                // Finished meanwhile
+                continue;
+            }
+
+            // The producer is still alive. The wake up belongs to a later message, so it is given back to be
+            // taken by the call that finds this one finished.
+            sem_post(&header_->data_available);
+            return false;
+        }
+        else
+        {
+            pos = header_->dequeue_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    bool ret = cell->size <= buffer_capacity;
+    if (ret)
+    {
+        size = cell->size;
+        memcpy(buffer, cell->data, size);
+    }
+    cell->writer_pid.store(0, std::memory_order_relaxed);
+    cell->sequence.store(pos + header_->capacity, std::memory_order_release);
+
+    return ret;
+}
+
+void SharedMemPort::wake_up()
+{
+    sem_post(&header_->data_available);
+}
+
+bool SharedMemPort::listener_alive() const
+{
+    if (header_->listener_alive.load(std::memory_order_acquire) == 0)
+    {
+        return false;
+    }
+
+    if (is_listener_)
+    {
+        return true;
+    }
+
+    // A crashed listener never clears listener_alive, but the kernel releases its lock. Probing
+    // the lock costs a system call, so it is done at most once per period.
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    int64_t now_ns = static_cast<int64_t>(now.tv_sec) * 1000000000 + now.tv_nsec;
+    int64_t next_check = next_liveness_check_.load(std::memory_order_relaxed);
+    if (now_ns < next_check ||
+            !next_liveness_check_.compare_exchange_strong(next_check, now_ns + s_liveness_check_period_ns,
+            std::memory_order_relaxed))
+    {
+        return true;
+    }
+
+    struct flock lock = listener_lock(F_WRLCK);
+    if (fcntl(fd_, F_OFD_GETLK, &lock) != 0)
+    {
+        return true;
+    }
+
+    return lock.l_type != F_UNLCK;
+}
+
+uint32_t SharedMemPort::cell_size() const
+{
+    return header_->cell_size;
+}
+
+#else
+
+struct SharedMemPort::SegmentHeader {};
+struct SharedMemPort::Cell {};
+
+SharedMemPort::~SharedMemPort() {}
+
+std::shared_ptr<SharedMemPort> SharedMemPort::open_listener(uint16_t, uint32_t, uint32_t)
+{
+    return nullptr;
+}
+
+std::shared_ptr<SharedMemPort> SharedMemPort::open_sender(uint16_t)
+{
+    return nullptr;
+}
+
+bool SharedMemPort::push(const octet*, uint32_t)
+{
+    return false;
+}
+
+bool SharedMemPort::pop(octet*, uint32_t, uint32_t&, uint32_t)
+{
+    return false;
+}
+
+void SharedMemPort::wake_up() {}
+
+bool SharedMemPort::listener_alive() const
+{
+    return false;
+}
+
+uint32_t SharedMemPort::cell_size() const
+{
+    return 0;
+}
+
+#endif
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
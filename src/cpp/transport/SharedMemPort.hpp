@@ -0,0 +1,127 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __TRANSPORT_SHAREDMEMPORT_HPP__
+#define __TRANSPORT_SHAREDMEMPORT_HPP__
+
+#include <fastrtps/rtps/common/Types.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <cstdint>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+/**
+ * Shared memory segment backing a listening port of the SharedMemTransport.
+ *
+ * The segment holds a bounded multi-producer queue of fixed size cells. Any process on the
+ * host may push messages into it without taking locks; only the process owning the port
+ * (the listener) pops them. A process-shared semaphore wakes the listener when data arrives.
+ * @ingroup TRANSPORT_MODULE
+ */
+class SharedMemPort
+{
+    public:
+
+        /**
+         * Creates a segment for the given port. A stale one left by a crashed listener is replaced by a fresh one.
+         * @return nullptr when another process is already listening on the port.
+         */
+        static std::shared_ptr<SharedMemPort> open_listener(
+                uint16_t port,
+                uint32_t capacity,
+                uint32_t cell_size);
+
+        /**
+         * Maps the segment of a port whose listener is alive.
+         * @return nullptr when nobody is listening on the port.
+         */
+        static std::shared_ptr<SharedMemPort> open_sender(
+                uint16_t port);
+
+        ~SharedMemPort();
+
+        /**
+         * Copies a message into the queue. Never blocks.
+         * @return false if the message does not fit in a cell or the queue is full.
+         */
+        bool push(
+                const octet* data,
+                uint32_t size);
+
+        /**
+         * Waits for a message and copies it into the given buffer.
+         * Messages left half written by a process that died are skipped.
+         * @param timeout_ms Maximum time to wait for a message, including the time its sender takes to copy it.
+         * @return false if no message was received before the timeout expired.
+         */
+        bool pop(
+                octet* buffer,
+                uint32_t buffer_capacity,
+                uint32_t& size,
+                uint32_t timeout_ms);
+
+        //! Unblocks a listener waiting on pop().
+        void wake_up();
+
+        /**
+         * Whether the process owning the port is still listening on this segment.
+         * On the sender side this also detects listeners which crashed without closing the port,
+         * by probing the lock they hold on the segment.
+         */
+        bool listener_alive() const;
+
+        uint32_t cell_size() const;
+
+        uint16_t port() const { return port_; }
+
+        static std::string segment_name(uint16_t port);
+
+    private:
+
+        struct SegmentHeader;
+        struct Cell;
+
+        SharedMemPort(
+                uint16_t port,
+                int fd,
+                void* segment,
+                size_t segment_size,
+                bool is_listener);
+
+        SharedMemPort(const SharedMemPort&) = delete;
+
+        SharedMemPort& operator=(const SharedMemPort&) = delete;
+
+        Cell* cell_at(uint64_t position) const;
+
+        uint16_t port_;
+        int fd_;
+        void* segment_;
+        size_t segment_size_;
+        bool is_listener_;
+        SegmentHeader* header_;
+        octet* cells_;
+        mutable std::atomic<int64_t> next_liveness_check_;
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // __TRANSPORT_SHAREDMEMPORT_HPP__
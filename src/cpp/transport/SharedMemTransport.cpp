@@ -0,0 +1,457 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/transport/SharedMemTransport.h>
+#include <fastrtps/rtps/common/PortParameters.h>
+#include <fastrtps/log/Log.h>
+
+#include "SharedMemPort.hpp"
+#include "SharedMemChannelResource.hpp"
+#include "SharedMemSenderResource.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <cassert>
+
+#if defined(__linux__) && !defined(__ANDROID__)
+#include <sys/stat.h>
+#include <cctype>
+#include <fstream>
+#include <string>
+#endif
+
+namespace eprosima{
+namespace fastrtps{
+namespace rtps{
+
+static const uint32_t s_default_port_queue_capacity = 256;
+
+/**
+ * Identifies the shared memory domain of this process, used to tell whether a SHM locator was
+ * announced by a process which can map our segments: the first 12 bytes come from the kernel
+ * boot id and the last 4 bytes from the inode of the IPC namespace.
+ * @return false when the identity cannot be determined. SHM locators are then never considered
+ * local and remote endpoints are reached through their network locators.
+ */
+static bool get_host_id(octet (&host_id)[16])
+{
+    memset(host_id, 0, sizeof(host_id));
+
+#if defined(__linux__) && !defined(__ANDROID__)
+    std::ifstream boot_id_file("/proc/sys/kernel/random/boot_id");
+    std::string boot_id;
+    if (!std::getline(boot_id_file, boot_id))
+    {
+        return false;
+    }
+
+    size_t digits = 0;
+    for (char c : boot_id)
+    {
+        if (!isxdigit(static_cast<unsigned char>(c)))
+        {
+            continue;
+        }
+
+        octet nibble = static_cast<octet>(isdigit(static_cast<unsigned char>(c)) ? c - '0' :
+                tolower(static_cast<unsigned char>(c)) - 'a' + 10);
+        host_id[digits / 2] = static_cast<octet>((host_id[digits / 2] << 4) | nibble);
+        if (++digits == 24)
+        {
+            break;
+        }
+    }
+
+    struct stat ipc_namespace;
+    if (digits != 24 || stat("/proc/self/ns/ipc", &ipc_namespace) != 0)
+    {
+        memset(host_id, 0, sizeof(host_id));
+        return false;
+    }
+
+    uint32_t ipc_inode = static_cast<uint32_t>(ipc_namespace.st_ino);
+    host_id[12] = static_cast<octet>(ipc_inode >> 24);
+    host_id[13] = static_cast<octet>(ipc_inode >> 16);
+    host_id[14] = static_cast<octet>(ipc_inode >> 8);
+    host_id[15] = static_cast<octet>(ipc_inode);
+    return true;
+#else
+    return false;
+#endif
+}
+
+SharedMemTransportDescriptor::SharedMemTransportDescriptor()
+    : TransportDescriptorInterface(s_maximumMessageSize, s_maximumInitialPeersRange)
+    , port_queue_capacity(s_default_port_queue_capacity)
+{
+}
+
+SharedMemTransportDescriptor::SharedMemTransportDescriptor(const SharedMemTransportDescriptor& t)
+    : TransportDescriptorInterface(t)
+    , port_queue_capacity(t.port_queue_capacity)
+{
+}
+
+TransportInterface* SharedMemTransportDescriptor::create_transport() const
+{
+    return new SharedMemTransport(*this);
+}
+
+SharedMemTransport::SharedMemTransport(const SharedMemTransportDescriptor& descriptor)
+    : TransportInterface(LOCATOR_KIND_SHM)
+    , configuration_(descriptor)
+    , host_id_valid_(get_host_id(host_id_))
+{
+}
+
+SharedMemTransport::~SharedMemTransport()
+{
+    shutdown();
+}
+
+bool SharedMemTransport::init()
+{
+#if defined(__linux__) && !defined(__ANDROID__)
+    if (configuration_.maxMessageSize > s_maximumMessageSize)
+    {
+        logError(RTPS_MSG_OUT, "maxMessageSize cannot be greater than 65000");
+        return false;
+    }
+
+    return true;
+#else
+    logError(RTPS_MSG_OUT, "Shared memory transport is not supported on this platform");
+    return false;
+#endif
+}
+
+void SharedMemTransport::shutdown()
+{
+    std::map<uint16_t, SharedMemChannelResource*> channels;
+    {
+        std::unique_lock<std::mutex> scopedLock(input_mutex_);
+        channels.swap(input_channels_);
+    }
+
+    for (auto& channel : channels)
+    {
+        channel.second->release();
+        delete channel.second;
+    }
+
+    std::unique_lock<std::mutex> scopedLock(output_mutex_);
+    output_ports_.clear();
+}
+
+void SharedMemTransport::fill_host_id(Locator_t& locator) const
+{
+    memcpy(locator.address, host_id_, sizeof(locator.address));
+}
+
+bool SharedMemTransport::IsInputChannelOpen(const Locator_t& locator) const
+{
+    std::unique_lock<std::mutex> scopedLock(input_mutex_);
+    return IsLocatorSupported(locator) && (input_channels_.find(static_cast<uint16_t>(locator.port)) !=
+        input_channels_.end());
+}
+
+bool SharedMemTransport::IsLocatorSupported(const Locator_t& locator) const
+{
+    return locator.kind == LOCATOR_KIND_SHM;
+}
+
+bool SharedMemTransport::is_locator_allowed(const Locator_t& locator) const
+{
+    return is_local_locator(locator);
+}
+
+bool SharedMemTransport::is_local_locator(const Locator_t& locator) const
+{
+    assert(locator.kind == LOCATOR_KIND_SHM);
+
+    return host_id_valid_ && memcmp(locator.address, host_id_, sizeof(host_id_)) == 0;
+}
+
+Locator_t SharedMemTransport::RemoteToMainLocal(const Locator_t& remote) const
+{
+    if (!IsLocatorSupported(remote))
+    {
+        return false;
+    }
+
+    Locator_t mainLocal(remote);
+    fill_host_id(mainLocal);
+    return mainLocal;
+}
+
+bool SharedMemTransport::DoInputLocatorsMatch(const Locator_t& left, const Locator_t& right) const
+{
+    return IsLocatorSupported(left) && IsLocatorSupported(right) && left.port == right.port;
+}
+
+LocatorList_t SharedMemTransport::NormalizeLocator(const Locator_t& locator)
+{
+    LocatorList_t list;
+
+    Locator_t normalized(locator);
+    fill_host_id(normalized);
+    list.push_back(normalized);
+
+    return list;
+}
+
+LocatorList_t SharedMemTransport::ShrinkLocatorLists(const std::vector<LocatorList_t>& locatorLists)
+{
+    LocatorList_t result;
+
+    for (const LocatorList_t& locatorList : locatorLists)
+    {
+        for (auto it = locatorList.begin(); it != locatorList.end(); ++it)
+        {
+            if (is_local_locator(*it) && !result.contains(*it))
+            {
+                result.push_back(*it);
+            }
+        }
+    }
+
+    return result;
+}
+
+bool SharedMemTransport::OpenOutputChannel(
+        SendResourceList& sender_resource_list,
+        const Locator_t& locator)
+{
+    if (!IsLocatorSupported(locator) || !is_local_locator(locator))
+    {
+        return false;
+    }
+
+    // A single sender resource reaches every port on the host
+    for (auto& sender_resource : sender_resource_list)
+    {
+        if (SharedMemSenderResource::cast(*this, sender_resource.get()) != nullptr)
+        {
+            return true;
+        }
+    }
+
+    sender_resource_list.emplace_back(static_cast<SenderResource*>(new SharedMemSenderResource(*this)));
+    return true;
+}
+
+bool SharedMemTransport::OpenInputChannel(
+        const Locator_t& locator,
+        TransportReceiverInterface* receiver,
+        uint32_t maxMsgSize)
+{
+    if (!IsLocatorSupported(locator))
+    {
+        return false;
+    }
+
+    std::unique_lock<std::mutex> scopedLock(input_mutex_);
+
+    uint16_t port = static_cast<uint16_t>(locator.port);
+    if (input_channels_.find(port) != input_channels_.end())
+    {
+        return true;
+    }
+
+    std::shared_ptr<SharedMemPort> shm_port = SharedMemPort::open_listener(port,
+            configuration_.port_queue_capacity, configuration_.maxMessageSize);
+    if (!shm_port)
+    {
+        logInfo(RTPS_MSG_OUT, "SharedMemTransport Error binding at port: (" << port << ")");
+        return false;
+    }
+
+    Locator_t local_locator(locator);
+    fill_host_id(local_locator);
+    Locator_t remote_locator(LOCATOR_KIND_SHM, 0);
+    fill_host_id(remote_locator);
+
+    input_channels_[port] = new SharedMemChannelResource(shm_port, maxMsgSize, local_locator, remote_locator,
+            receiver);
+    return true;
+}
+
+bool SharedMemTransport::CloseInputChannel(const Locator_t& locator)
+{
+    SharedMemChannelResource* channel = nullptr;
+
+    {
+        std::unique_lock<std::mutex> scopedLock(input_mutex_);
+
+        auto it = input_channels_.find(static_cast<uint16_t>(locator.port));
+        if (!IsLocatorSupported(locator) || it == input_channels_.end())
+        {
+            return false;
+        }
+
+        channel = it->second;
+        input_channels_.erase(it);
+    }
+
+    channel->release();
+    delete channel;
+    return true;
+}
+
+std::shared_ptr<SharedMemPort> SharedMemTransport::find_output_port(uint16_t port)
+{
+    std::unique_lock<std::mutex> scopedLock(output_mutex_);
+
+    auto it = output_ports_.find(port);
+    if (it != output_ports_.end())
+    {
+        if (it->second->listener_alive())
+        {
+            return it->second;
+        }
+
+        // The listener went away. It may have been replaced by a new one.
+        output_ports_.erase(it);
+    }
+
+    std::shared_ptr<SharedMemPort> shm_port = SharedMemPort::open_sender(port);
+    if (shm_port)
+    {
+        output_ports_[port] = shm_port;
+    }
+
+    return shm_port;
+}
+
+bool SharedMemTransport::send(
+        const octet* send_buffer,
+        uint32_t send_buffer_size,
+        const Locator_t& remote_locator)
+{
+    if (!IsLocatorSupported(remote_locator) || !is_local_locator(remote_locator) ||
+            send_buffer_size > configuration_.maxMessageSize)
+    {
+        return false;
+    }
+
+    std::shared_ptr<SharedMemPort> shm_port = find_output_port(static_cast<uint16_t>(remote_locator.port));
+    if (!shm_port)
+    {
+        return false;
+    }
+
+    if (!shm_port->push(send_buffer, send_buffer_size))
+    {
+        logWarning(RTPS_MSG_OUT, "Shared memory queue of port " << remote_locator.port <<
+            " is full, discarding message");
+    }
+
+    return true;
+}
+
+void SharedMemTransport::AddDefaultOutputLocator(LocatorList_t&)
+{
+    // Output resources are opened on demand for each remote shared memory locator
+}
+
+bool SharedMemTransport::getDefaultMetatrafficMulticastLocators(
+        LocatorList_t&,
+        uint32_t) const
+{
+    // Multicast is not supported
+    return false;
+}
+
+bool SharedMemTransport::getDefaultMetatrafficUnicastLocators(
+        LocatorList_t &locators,
+        uint32_t metatraffic_unicast_port) const
+{
+    Locator_t locator(LOCATOR_KIND_SHM, metatraffic_unicast_port);
+    fill_host_id(locator);
+    locators.push_back(locator);
+
+    return true;
+}
+
+bool SharedMemTransport::getDefaultUnicastLocators(
+        LocatorList_t &locators,
+        uint32_t unicast_port) const
+{
+    Locator_t locator(LOCATOR_KIND_SHM, unicast_port);
+    fill_host_id(locator);
+    locators.push_back(locator);
+
+    return true;
+}
+
+bool SharedMemTransport::fillMetatrafficMulticastLocator(
+        Locator_t&,
+        uint32_t) const
+{
+    return false;
+}
+
+bool SharedMemTransport::fillMetatrafficUnicastLocator(
+        Locator_t &locator,
+        uint32_t metatraffic_unicast_port) const
+{
+    if (locator.port == 0)
+    {
+        locator.port = metatraffic_unicast_port;
+    }
+    fill_host_id(locator);
+    return true;
+}
+
+bool SharedMemTransport::configureInitialPeerLocator(
+        Locator_t &locator,
+        const PortParameters &port_params,
+        uint32_t domainId,
+        LocatorList_t& list) const
+{
+    fill_host_id(locator);
+
+    if (locator.port == 0)
+    {
+        for (uint32_t i = 0; i < configuration_.maxInitialPeersRange; ++i)
+        {
+            Locator_t auxloc(locator);
+            auxloc.port = port_params.getUnicastPort(domainId, i);
+
+            list.push_back(auxloc);
+        }
+    }
+    else
+    {
+        list.push_back(locator);
+    }
+
+    return true;
+}
+
+bool SharedMemTransport::fillUnicastLocator(
+        Locator_t &locator,
+        uint32_t well_known_port) const
+{
+    if (locator.port == 0)
+    {
+        locator.port = well_known_port;
+    }
+    fill_host_id(locator);
+    return true;
+}
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
@@ -17,6 +17,9 @@
 #include <fastrtps/utils/IPLocator.h>
 #include <fastrtps/utils/eClock.h>
 
+#include <algorithm>
+#include <cstring>
+
 namespace eprosima {
 namespace fastrtps {
 namespace rtps {
@@ -47,6 +50,9 @@ TCPChannelResource::TCPChannelResource(
     , locator_(locator)
     , waiting_for_keep_alive_(false)
     , connection_status_(eConnectionStatus::eDisconnected)
+    , send_in_progress_(false)
+    , coalesce_timer_(parent->io_service_timers_)
+    , coalesce_timer_armed_(false)
     , tcp_connection_type_(TCPConnectionType::TCP_CONNECT_TYPE)
 {
 }
@@ -59,6 +65,9 @@ TCPChannelResource::TCPChannelResource(
     , locator_()
     , waiting_for_keep_alive_(false)
     , connection_status_(eConnectionStatus::eConnected)
+    , send_in_progress_(false)
+    , coalesce_timer_(parent->io_service_timers_)
+    , coalesce_timer_armed_(false)
     , tcp_connection_type_(TCPConnectionType::TCP_ACCEPT_TYPE)
 {
 }
@@ -69,6 +78,251 @@ void TCPChannelResource::disable()
     ChannelResource::disable(); // prevent asio callback workings on this channel.
 
     disconnect();
+    clear_send_queue();
+    clear_coalesced();
+}
+
+bool TCPChannelResource::enqueue_send(
+        const octet* header,
+        size_t header_size,
+        const octet* buffer,
+        size_t size,
+        bool is_control)
+{
+    const TCPTransportDescriptor* options = parent_->configuration();
+    std::unique_lock<std::mutex> lock(send_queue_mutex_);
+
+    // Neither the message being written nor the control messages count for the capacity of the queue
+    auto first_pending = [&]()
+    {
+        return send_queue_.begin() + (send_in_progress_ ? 1 : 0);
+    };
+    auto pending = [&]()
+    {
+        return static_cast<size_t>(std::count_if(first_pending(), send_queue_.end(),
+            [](const QueuedMessage& queued)
+            {
+                return !queued.is_control;
+            }));
+    };
+
+    if (!is_control && pending() >= options->send_queue_capacity)
+    {
+        switch (options->send_queue_overflow_policy)
+        {
+            case TCPTransportDescriptor::BLOCK:
+                send_queue_cv_.wait(lock, [&]()
+                {
+                    return pending() < options->send_queue_capacity || !alive() ||
+                        eConnecting >= connection_status_;
+                });
+                break;
+            case TCPTransportDescriptor::DROP_OLDEST:
+            {
+                // The queue is full of RTPS messages, so there is always one to discard
+                auto oldest = std::find_if(first_pending(), send_queue_.end(),
+                    [](const QueuedMessage& queued)
+                    {
+                        return !queued.is_control;
+                    });
+                logWarning(RTCP_MSG_OUT, "Send queue of " << IPLocator::to_string(locator_) <<
+                    " is full, discarding oldest message");
+                send_queue_.erase(oldest);
+                break;
+            }
+            case TCPTransportDescriptor::DISCONNECT:
+                lock.unlock();
+                logWarning(RTCP_MSG_OUT, "Send queue of " << IPLocator::to_string(locator_) <<
+                    " is full, closing connection");
+                disconnect();
+                return false;
+        }
+    }
+
+    if (!alive() || eConnecting >= connection_status_)
+    {
+        return false;
+    }
+
+    send_queue_.emplace_back();
+    send_queue_.back().is_control = is_control;
+    std::vector<octet>& message = send_queue_.back().data;
+    message.resize(header_size + size);
+    if (header_size > 0)
+    {
+        memcpy(message.data(), header, header_size);
+    }
+    memcpy(message.data() + header_size, buffer, size);
+
+    if (!send_in_progress_)
+    {
+        send_in_progress_ = true;
+        lock.unlock();
+        send_next_queued();
+    }
+
+    return true;
+}
+
+void TCPChannelResource::send_next_queued()
+{
+    const octet* data = nullptr;
+    size_t size = 0;
+
+    {
+        // Only the completion of the write removes the first message, so it stays valid meanwhile.
+        std::unique_lock<std::mutex> lock(send_queue_mutex_);
+        data = send_queue_.front().data.data();
+        size = send_queue_.front().data.size();
+    }
+
+    std::shared_ptr<TCPChannelResource> myself = shared_from_this();
+    async_send(data, size, [myself](const asio::error_code& ec)
+    {
+        myself->queued_send_completed(ec);
+    });
+}
+
+void TCPChannelResource::queued_send_completed(const asio::error_code& ec)
+{
+    std::unique_lock<std::mutex> lock(send_queue_mutex_);
+    send_queue_.pop_front();
+
+    if (ec)
+    {
+        logWarning(RTCP_MSG_OUT, "Failed to send queued message: " << ec.message());
+        send_queue_.clear();
+    }
+    else if (!alive())
+    {
+        send_queue_.clear();
+    }
+
+    send_queue_cv_.notify_all();
+
+    if (send_queue_.empty())
+    {
+        send_in_progress_ = false;
+        return;
+    }
+
+    lock.unlock();
+    send_next_queued();
+}
+
+void TCPChannelResource::clear_send_queue()
+{
+    std::unique_lock<std::mutex> lock(send_queue_mutex_);
+
+    // The message being written is released when the write finishes
+    send_queue_.erase(send_queue_.begin() + (send_in_progress_ ? 1 : 0), send_queue_.end());
+    send_queue_cv_.notify_all();
+}
+
+bool TCPChannelResource::coalesce_send(
+        const octet* header,
+        size_t header_size,
+        const octet* buffer,
+        size_t size)
+{
+    const TCPTransportDescriptor* options = parent_->configuration();
+    std::unique_lock<std::mutex> lock(coalesce_mutex_);
+
+    if (!alive() || eConnecting >= connection_status_)
+    {
+        return false;
+    }
+
+    size_t offset = coalesce_buffer_.size();
+    coalesce_buffer_.resize(offset + header_size + size);
+    if (header_size > 0)
+    {
+        memcpy(coalesce_buffer_.data() + offset, header, header_size);
+    }
+    memcpy(coalesce_buffer_.data() + offset + header_size, buffer, size);
+
+    if (coalesce_buffer_.size() >= options->coalescing_max_size)
+    {
+        if (coalesce_timer_armed_)
+        {
+            asio::error_code ec;
+            coalesce_timer_.cancel(ec);
+            coalesce_timer_armed_ = false;
+        }
+
+        return write_coalesced();
+    }
+
+    if (!coalesce_timer_armed_)
+    {
+        coalesce_timer_armed_ = true;
+        std::weak_ptr<TCPChannelResource> channel_weak = shared_from_this();
+        coalesce_timer_.expires_from_now(std::chrono::microseconds(options->coalescing_delay_us));
+        coalesce_timer_.async_wait([channel_weak](const asio::error_code& ec)
+        {
+            std::shared_ptr<TCPChannelResource> channel = channel_weak.lock();
+            if (ec != asio::error::operation_aborted && channel)
+            {
+                channel->flush_coalesced();
+            }
+        });
+    }
+
+    return true;
+}
+
+bool TCPChannelResource::flush_coalesced()
+{
+    std::unique_lock<std::mutex> lock(coalesce_mutex_);
+    coalesce_timer_armed_ = false;
+    return write_coalesced();
+}
+
+bool TCPChannelResource::write_coalesced()
+{
+    if (coalesce_buffer_.empty())
+    {
+        return true;
+    }
+
+    bool success = false;
+
+    // Messages keep their own headers, so they are written as they are
+    if (parent_->configuration()->send_queue_capacity > 0)
+    {
+        success = enqueue_send(nullptr, 0, coalesce_buffer_.data(), coalesce_buffer_.size(), false);
+    }
+    else
+    {
+        asio::error_code ec;
+        size_t sent = send(nullptr, 0, coalesce_buffer_.data(), coalesce_buffer_.size(), ec);
+
+        if (sent != coalesce_buffer_.size() || ec)
+        {
+            logWarning(RTCP_MSG_OUT, "Failed to send gathered messages (" << sent << " of " <<
+                coalesce_buffer_.size() << " b): " << ec.message());
+        }
+        else
+        {
+            success = true;
+        }
+    }
+
+    coalesce_buffer_.clear();
+    return success;
+}
+
+void TCPChannelResource::clear_coalesced()
+{
+    std::unique_lock<std::mutex> lock(coalesce_mutex_);
+    coalesce_buffer_.clear();
+
+    if (coalesce_timer_armed_)
+    {
+        asio::error_code ec;
+        coalesce_timer_.cancel(ec);
+        coalesce_timer_armed_ = false;
+    }
 }
 
 ResponseCode TCPChannelResource::process_bind_request(const Locator_t& locator)
@@ -138,6 +138,20 @@ uint32_t TCPChannelResourceBasic::read(
     return 0;
 }
 
+void TCPChannelResourceBasic::async_read(
+        octet* buffer,
+        std::size_t size,
+        std::function<void(const asio::error_code&, size_t)> handler)
+{
+    auto socket = socket_;
+
+    asio::async_read(*socket, asio::buffer(buffer, size), transfer_exactly(size),
+        [socket, handler](const asio::error_code& ec, size_t bytes_transferred)
+        {
+            handler(ec, bytes_transferred);
+        });
+}
+
 size_t TCPChannelResourceBasic::send(
         const octet* header,
         size_t header_size,
@@ -151,21 +165,34 @@ size_t TCPChannelResourceBasic::send(
     {
         std::unique_lock<std::mutex> write_lock(write_mutex_);
 
-
+        // Header and data in a single gathering write
+        std::vector<asio::const_buffer> buffers;
         if (header_size > 0)
         {
-            bytes_sent = socket_->send(asio::buffer(header, header_size), 0, ec);
+            buffers.push_back(asio::buffer(header, header_size));
         }
+        buffers.push_back(asio::buffer(data, size));
 
-        if (!ec)
-        {
-            bytes_sent += socket_->send(asio::buffer(data, size), 0, ec);
-        }
+        bytes_sent = asio::write(*socket_, buffers, ec);
     }
 
     return  bytes_sent;
 }
 
+void TCPChannelResourceBasic::async_send(
+        const octet* data,
+        size_t size,
+        std::function<void(const asio::error_code&)> handler)
+{
+    auto socket = socket_;
+
+    asio::async_write(*socket, asio::buffer(data, size),
+        [socket, handler](const asio::error_code& ec, size_t)
+        {
+            handler(ec);
+        });
+}
+
 asio::ip::tcp::endpoint TCPChannelResourceBasic::remote_endpoint() const
 {
     return socket_->remote_endpoint();
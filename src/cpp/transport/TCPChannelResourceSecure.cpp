@@ -189,6 +189,30 @@ uint32_t TCPChannelResourceSecure::read(
     return static_cast<uint32_t>(bytes_read);
 }
 
+void TCPChannelResourceSecure::async_read(
+        octet* buffer,
+        std::size_t size,
+        std::function<void(const asio::error_code&, size_t)> handler)
+{
+    auto socket = secure_socket_;
+
+    strand_read_.post([socket, buffer, size, handler]()
+    {
+        if (socket->lowest_layer().is_open())
+        {
+            asio::async_read(*socket, asio::buffer(buffer, size), asio::transfer_exactly(size),
+                [socket, handler](const std::error_code& error, const size_t bytes_transferred)
+                {
+                    handler(error, bytes_transferred);
+                });
+        }
+        else
+        {
+            handler(asio::error::not_connected, 0);
+        }
+    });
+}
+
 size_t TCPChannelResourceSecure::send(
         const octet* header,
         size_t header_size,
@@ -243,6 +267,30 @@ size_t TCPChannelResourceSecure::send(
     return bytes_sent;
 }
 
+void TCPChannelResourceSecure::async_send(
+        const octet* data,
+        size_t size,
+        std::function<void(const asio::error_code&)> handler)
+{
+    auto socket = secure_socket_;
+
+    strand_write_.post([socket, data, size, handler]()
+    {
+        if (socket->lowest_layer().is_open())
+        {
+            asio::async_write(*socket, asio::buffer(data, size),
+                [socket, handler](const std::error_code& error, const size_t&)
+                {
+                    handler(error);
+                });
+        }
+        else
+        {
+            handler(asio::error::not_connected);
+        }
+    });
+}
+
 asio::ip::tcp::endpoint TCPChannelResourceSecure::remote_endpoint() const
 {
     return secure_socket_->lowest_layer().remote_endpoint();
@@ -42,6 +42,7 @@ static const int s_default_keep_alive_frequency = 5000; // 5 SECONDS
 static const int s_default_keep_alive_timeout = 15000; // 15 SECONDS
 //static const int s_clean_deleted_sockets_pool_timeout = 100; // 100 MILLISECONDS
 static const int s_default_tcp_negotitation_timeout = 5000; // 5 Seconds
+static const uint32_t s_default_coalescing_delay_us = 100;
 
 TCPTransportDescriptor::TCPTransportDescriptor()
     : SocketTransportDescriptor(s_maximumMessageSize, s_maximumInitialPeersRange)
@@ -56,6 +57,11 @@ TCPTransportDescriptor::TCPTransportDescriptor()
     , calculate_crc(true)
     , check_crc(true)
     , apply_security(false)
+    , send_queue_capacity(0)
+    , send_queue_overflow_policy(DROP_OLDEST)
+    , async_receive_threads(0)
+    , coalescing_max_size(0)
+    , coalescing_delay_us(s_default_coalescing_delay_us)
 {
 }
 
@@ -73,6 +79,11 @@ TCPTransportDescriptor::TCPTransportDescriptor(const TCPTransportDescriptor& t)
     , calculate_crc(t.calculate_crc)
     , check_crc(t.check_crc)
     , apply_security(t.apply_security)
+    , send_queue_capacity(t.send_queue_capacity)
+    , send_queue_overflow_policy(t.send_queue_overflow_policy)
+    , async_receive_threads(t.async_receive_threads)
+    , coalescing_max_size(t.coalescing_max_size)
+    , coalescing_delay_us(t.coalescing_delay_us)
     , tls_config(t.tls_config)
 {
 }
@@ -97,6 +108,11 @@ TCPTransportDescriptor& TCPTransportDescriptor::operator=(const TCPTransportDesc
     calculate_crc = t.calculate_crc;
     check_crc = t.check_crc;
     apply_security = t.apply_security;
+    send_queue_capacity = t.send_queue_capacity;
+    send_queue_overflow_policy = t.send_queue_overflow_policy;
+    async_receive_threads = t.async_receive_threads;
+    coalescing_max_size = t.coalescing_max_size;
+    coalescing_delay_us = t.coalescing_delay_us;
     tls_config = t.tls_config;
     return *this;
 }
@@ -123,6 +139,11 @@ void TCPTransportInterface::clean()
     if(keep_alive_event_ != nullptr)
     {
         delete keep_alive_event_;
+        keep_alive_event_ = nullptr;
+    }
+
+    if (io_service_timers_thread_)
+    {
         io_service_timers_.stop();
         io_service_timers_thread_->join();
         io_service_timers_thread_ = nullptr;
@@ -147,6 +168,7 @@ void TCPTransportInterface::clean()
         {
             if (channel->connection_established())
             {
+                channel->flush_coalesced();
                 rtcp_message_manager_->sendUnbindConnectionRequest(channel);
             }
 
@@ -167,11 +189,25 @@ void TCPTransportInterface::clean()
         }
     }
 
-    if (io_service_thread_)
+    // Messages being processed may be waiting for a send on io_service_, so it is stopped afterwards.
+    if (!io_service_processing_threads_.empty())
+    {
+        io_service_processing_.stop();
+        for (auto& io_service_processing_thread : io_service_processing_threads_)
+        {
+            io_service_processing_thread->join();
+        }
+        io_service_processing_threads_.clear();
+    }
+
+    if (!io_service_threads_.empty())
     {
         io_service_.stop();
-        io_service_thread_->join();
-        io_service_thread_ = nullptr;
+        for (auto& io_service_thread : io_service_threads_)
+        {
+            io_service_thread->join();
+        }
+        io_service_threads_.clear();
     }
 }
 
@@ -193,12 +229,7 @@ bool TCPTransportInterface::check_crc(
         const octet *data,
         uint32_t size) const
 {
-    uint32_t crc(0);
-    for (uint32_t i = 0; i < size; ++i)
-    {
-        crc = RTCPMessageManager::addToCRC(crc, data[i]);
-    }
-    return crc == header.crc;
+    return RTCPMessageManager::addToCRC(0, data, size) == header.crc;
 }
 
 void TCPTransportInterface::calculate_crc(
@@ -206,12 +237,7 @@ void TCPTransportInterface::calculate_crc(
         const octet *data,
         uint32_t size) const
 {
-    uint32_t crc(0);
-    for (uint32_t i = 0; i < size; ++i)
-    {
-        crc = RTCPMessageManager::addToCRC(crc, data[i]);
-    }
-    header.crc = crc;
+    header.crc = RTCPMessageManager::addToCRC(0, data, size);
 }
 
 
@@ -377,9 +403,33 @@ bool TCPTransportInterface::init()
 #endif
         io_service_.run();
     };
-    io_service_thread_ = std::make_shared<std::thread>(ioServiceFunction);
+    uint32_t io_service_threads = std::max(1u, configuration()->async_receive_threads);
+    for (uint32_t i = 0; i < io_service_threads; ++i)
+    {
+        io_service_threads_.push_back(std::make_shared<std::thread>(ioServiceFunction));
+    }
 
-    if (0 < configuration()->keep_alive_frequency_ms)
+    // The io_service threads only read. Handling RTCP and delivering to the receivers may send, and sending
+    // through a secure channel waits for io_service_, so that is done by another pool.
+    if (0 < configuration()->async_receive_threads)
+    {
+        auto ioServiceProcessingFunction = [&]()
+        {
+#if ASIO_VERSION >= 101200
+            asio::executor_work_guard<asio::io_service::executor_type> work(io_service_processing_.get_executor());
+#else
+            io_service::work work(io_service_processing_);
+#endif
+            io_service_processing_.run();
+        };
+        for (uint32_t i = 0; i < configuration()->async_receive_threads; ++i)
+        {
+            io_service_processing_threads_.push_back(std::make_shared<std::thread>(ioServiceProcessingFunction));
+        }
+    }
+
+    // Also used to write the messages gathered on the channels
+    if (0 < configuration()->keep_alive_frequency_ms || 0 < configuration()->coalescing_max_size)
     {
         io_service_timers_thread_ = std::make_shared<std::thread>([&]()
         {
@@ -391,6 +441,10 @@ bool TCPTransportInterface::init()
 #endif
             io_service_timers_.run();
         });
+    }
+
+    if (0 < configuration()->keep_alive_frequency_ms)
+    {
         keep_alive_event_ = new TCPKeepAliveEvent(*this, io_service_timers_, *io_service_timers_thread_.get(),
             configuration()->keep_alive_frequency_ms);
         keep_alive_event_->restart_timer();
@@ -480,7 +534,7 @@ bool TCPTransportInterface::CloseInputChannel(const Locator_t& locator)
                 }
             }
 
-            receiver_in_use->cv.wait(scopedLock, [&]() { return receiver_in_use->in_use == false; });
+            receiver_in_use->cv.wait(scopedLock, [&]() { return receiver_in_use->in_use == 0; });
             delete receiver_in_use;
         }
     }
@@ -678,15 +732,12 @@ void TCPTransportInterface::keep_alive()
     */
 }
 
-void TCPTransportInterface::perform_listen_operation(
-        std::weak_ptr<TCPChannelResource> channel_weak,
-        std::weak_ptr<RTCPMessageManager> rtcp_manager)
+std::shared_ptr<TCPChannelResource> TCPTransportInterface::begin_listen(
+        const std::weak_ptr<TCPChannelResource>& channel_weak,
+        const std::weak_ptr<RTCPMessageManager>& rtcp_manager)
 {
-    Locator_t remote_locator;
-    uint16_t logicalPort(0);
-    std::shared_ptr<RTCPMessageManager> rtcp_message_manager;
     std::shared_ptr<TCPChannelResource> channel;
-    rtcp_message_manager = rtcp_manager.lock();
+    std::shared_ptr<RTCPMessageManager> rtcp_message_manager = rtcp_manager.lock();
 
     // RTCP Control Message
     if(rtcp_message_manager)
@@ -709,12 +760,50 @@ void TCPTransportInterface::perform_listen_operation(
         rtcp_message_manager.reset();
         rtcp_message_manager_cv_.notify_one();
     }
+
+    return channel;
+}
+
+void TCPTransportInterface::start_listening(
+        const std::weak_ptr<TCPChannelResource>& channel_weak)
+{
+    std::weak_ptr<RTCPMessageManager> rtcp_manager_weak(rtcp_message_manager_);
+
+    if (0 < configuration()->async_receive_threads)
+    {
+        io_service_processing_.post([this, channel_weak, rtcp_manager_weak]()
+        {
+            std::shared_ptr<TCPChannelResource> channel = begin_listen(channel_weak, rtcp_manager_weak);
+            if (channel)
+            {
+                async_receive_header(channel, rtcp_manager_weak);
+            }
+        });
+    }
     else
+    {
+        std::shared_ptr<TCPChannelResource> channel = channel_weak.lock();
+        if (channel)
+        {
+            channel->thread(std::thread(&TCPTransportInterface::perform_listen_operation, this,
+                channel_weak, rtcp_manager_weak));
+        }
+    }
+}
+
+void TCPTransportInterface::perform_listen_operation(
+        std::weak_ptr<TCPChannelResource> channel_weak,
+        std::weak_ptr<RTCPMessageManager> rtcp_manager)
+{
+    Locator_t remote_locator;
+    std::shared_ptr<TCPChannelResource> channel = begin_listen(channel_weak, rtcp_manager);
+
+    if (!channel)
     {
         return;
     }
 
-    while (channel && TCPChannelResource::eConnectionStatus::eConnecting < channel->connection_status())
+    while (TCPChannelResource::eConnectionStatus::eConnecting < channel->connection_status())
     {
         // Blocking receive.
         CDRMessage_t& msg = channel->message_buffer();
@@ -724,32 +813,176 @@ void TCPTransportInterface::perform_listen_operation(
             continue;
         }
 
-        if(TCPChannelResource::eConnectionStatus::eConnecting < channel->connection_status())
+        deliver_message(channel, msg, remote_locator);
+    }
+
+    logInfo(RTCP, "End PerformListenOperation " << channel->locator());
+}
+
+void TCPTransportInterface::async_receive_header(
+        std::shared_ptr<TCPChannelResource> channel,
+        std::weak_ptr<RTCPMessageManager> rtcp_manager)
+{
+    if (TCPChannelResource::eConnectionStatus::eConnecting >= channel->connection_status())
+    {
+        logInfo(RTCP, "End asynchronous receive " << channel->locator());
+        return;
+    }
+
+    channel->async_read(reinterpret_cast<octet*>(&channel->async_header_), TCPHeader::size(),
+        [this, channel, rtcp_manager](const asio::error_code& ec, size_t bytes_received) mutable
         {
-            // Processes the data through the CDR Message interface.
-            logicalPort = IPLocator::getLogicalPort(remote_locator);
-            std::unique_lock<std::mutex> scopedLock(sockets_map_mutex_);
-            auto it = receiver_resources_.find(logicalPort);
-            //TransportReceiverInterface* receiver = channel->GetMessageReceiver(logicalPort);
-            if (it != receiver_resources_.end())
+            if (ec || bytes_received != TCPHeader::size())
             {
-                TransportReceiverInterface* receiver = it->second.first;
-                ReceiverInUseCV* receiver_in_use = it->second.second;
-                receiver_in_use->in_use = true;
-                scopedLock.unlock();
-                receiver->OnDataReceived(msg.buffer, msg.length, channel->locator(), remote_locator);
-                scopedLock.lock();
-                receiver_in_use->in_use = false;
-                receiver_in_use->cv.notify_one();
+                if (ec != asio::error::operation_aborted &&
+                        TCPChannelResource::eConnectionStatus::eConnecting < channel->connection_status())
+                {
+                    logWarning(DEBUG, "Error reading TCP header: " << ec.message());
+                    close_tcp_socket(channel);
+                }
+                return;
+            }
+
+            const TCPHeader& tcp_header = channel->async_header_;
+
+            // Check RTPC Header
+            if (tcp_header.rtcp[0] != 'R'
+                    || tcp_header.rtcp[1] != 'T'
+                    || tcp_header.rtcp[2] != 'C'
+                    || tcp_header.rtcp[3] != 'P')
+            {
+                logError(RTCP_MSG_IN, "Bad RTCP header identifier, closing connection.");
+                close_tcp_socket(channel);
+                return;
+            }
+
+            size_t body_size = tcp_header.length - static_cast<uint32_t>(TCPHeader::size());
+            CDRMessage_t& msg = channel->message_buffer();
+            CDRMessage::initCDRMsg(&msg);
+
+            if (body_size > msg.max_size)
+            {
+                logError(RTCP_MSG_IN, "Size of incoming TCP message is bigger than buffer capacity: "
+                        << static_cast<uint32_t>(body_size) << " vs. " << msg.max_size << ". "
+                        << "The full message will be dropped.");
+                async_discard_body(channel, rtcp_manager, body_size);
             }
             else
             {
-                logWarning(RTCP, "Received Message, but no TransportReceiverInterface attached: " << logicalPort);
+                logInfo(RTCP_MSG_IN, "Received RTCP MSG. Logical Port " << tcp_header.logical_port);
+                async_receive_body(channel, rtcp_manager, body_size);
             }
-        }
+        });
+}
+
+void TCPTransportInterface::async_receive_body(
+        std::shared_ptr<TCPChannelResource> channel,
+        std::weak_ptr<RTCPMessageManager> rtcp_manager,
+        size_t body_size)
+{
+    CDRMessage_t& msg = channel->message_buffer();
+
+    channel->async_read(msg.buffer, body_size,
+        [this, channel, rtcp_manager, body_size](const asio::error_code& ec, size_t bytes_received) mutable
+        {
+            if (ec || bytes_received != body_size)
+            {
+                if (ec != asio::error::operation_aborted &&
+                        TCPChannelResource::eConnectionStatus::eConnecting < channel->connection_status())
+                {
+                    logWarning(RTCP, "Error reading RTCP body: " << ec.message());
+                    close_tcp_socket(channel);
+                }
+                return;
+            }
+
+            channel->message_buffer().length = static_cast<uint32_t>(bytes_received);
+
+            // The next read of the channel is started once the message is processed, which keeps the order.
+            io_service_processing_.post([this, channel, rtcp_manager]()
+            {
+                process_async_message(channel, rtcp_manager);
+            });
+        });
+}
+
+void TCPTransportInterface::process_async_message(
+        std::shared_ptr<TCPChannelResource> channel,
+        std::weak_ptr<RTCPMessageManager> rtcp_manager)
+{
+    CDRMessage_t& msg = channel->message_buffer();
+    Locator_t remote_locator = channel->locator();
+
+    if (process_received_message(rtcp_manager, channel, channel->async_header_, msg.buffer, msg.length,
+            remote_locator))
+    {
+        deliver_message(channel, msg, remote_locator);
     }
 
-    logInfo(RTCP, "End PerformListenOperation " << channel->locator());
+    async_receive_header(channel, rtcp_manager);
+}
+
+void TCPTransportInterface::async_discard_body(
+        std::shared_ptr<TCPChannelResource> channel,
+        std::weak_ptr<RTCPMessageManager> rtcp_manager,
+        size_t remaining)
+{
+    if (remaining == 0)
+    {
+        async_receive_header(channel, rtcp_manager);
+        return;
+    }
+
+    CDRMessage_t& msg = channel->message_buffer();
+    size_t read_block = std::min(remaining, static_cast<size_t>(msg.max_size));
+
+    channel->async_read(msg.buffer, read_block,
+        [this, channel, rtcp_manager, remaining](const asio::error_code& ec, size_t bytes_received) mutable
+        {
+            if (ec)
+            {
+                if (ec != asio::error::operation_aborted &&
+                        TCPChannelResource::eConnectionStatus::eConnecting < channel->connection_status())
+                {
+                    logWarning(RTCP, "Error reading RTCP body: " << ec.message());
+                    close_tcp_socket(channel);
+                }
+                return;
+            }
+
+            async_discard_body(channel, rtcp_manager, remaining - bytes_received);
+        });
+}
+
+void TCPTransportInterface::deliver_message(
+        std::shared_ptr<TCPChannelResource>& channel,
+        CDRMessage_t& msg,
+        const Locator_t& remote_locator)
+{
+    if(msg.length == 0 || TCPChannelResource::eConnectionStatus::eConnecting >= channel->connection_status())
+    {
+        return;
+    }
+
+    // Processes the data through the CDR Message interface.
+    uint16_t logicalPort = IPLocator::getLogicalPort(remote_locator);
+    std::unique_lock<std::mutex> scopedLock(sockets_map_mutex_);
+    auto it = receiver_resources_.find(logicalPort);
+    if (it != receiver_resources_.end())
+    {
+        TransportReceiverInterface* receiver = it->second.first;
+        ReceiverInUseCV* receiver_in_use = it->second.second;
+        ++receiver_in_use->in_use;
+        scopedLock.unlock();
+        receiver->OnDataReceived(msg.buffer, msg.length, channel->locator(), remote_locator);
+        scopedLock.lock();
+        --receiver_in_use->in_use;
+        receiver_in_use->cv.notify_all();
+    }
+    else
+    {
+        logWarning(RTCP, "Received Message, but no TransportReceiverInterface attached: " << logicalPort);
+    }
 }
 
 bool TCPTransportInterface::read_body(
@@ -863,54 +1096,8 @@ bool TCPTransportInterface::Receive(
                     success = read_body(receive_buffer, receive_buffer_capacity, &receive_buffer_size,
                             channel, body_size);
 
-                    if (success)
-                    {
-                        if (configuration()->check_crc
-                                && !check_crc(tcp_header, receive_buffer, receive_buffer_size))
-                        {
-                            logWarning(RTCP_MSG_IN, "Bad TCP header CRC");
-                        }
-
-                        if (tcp_header.logical_port == 0)
-                        {
-                            std::shared_ptr<RTCPMessageManager> rtcp_message_manager;
-                            if(TCPChannelResource::eConnectionStatus::eDisconnected != channel->connection_status())
-
-                            {
-                                std::unique_lock<std::mutex> lock(rtcp_message_manager_mutex_);
-                                rtcp_message_manager = rtcp_manager.lock();
-                            }
-
-                            if (rtcp_message_manager)
-                            {
-                                // The channel is not going to be deleted because we lock it for reading.
-                                ResponseCode responseCode = rtcp_message_manager->processRTCPMessage(
-                                        channel, receive_buffer, body_size);
-
-                                if (responseCode != RETCODE_OK)
-                                {
-                                    close_tcp_socket(channel);
-                                }
-                                success = false;
-
-                                std::unique_lock<std::mutex> lock(rtcp_message_manager_mutex_);
-                                rtcp_message_manager.reset();
-                                rtcp_message_manager_cv_.notify_one();
-                            }
-                            else
-                            {
-                                success = false;
-                                close_tcp_socket(channel);
-                            }
-
-                        }
-                        else
-                        {
-                            IPLocator::setLogicalPort(remote_locator, tcp_header.logical_port);
-                            logInfo(RTCP_MSG_IN, "[RECEIVE] From: " << remote_locator \
-                                    << " - " << receive_buffer_size << " bytes.");
-                        }
-                    }
+                    success = success && process_received_message(rtcp_manager, channel, tcp_header,
+                            receive_buffer, receive_buffer_size, remote_locator);
                     // Error message already shown by read_body method.
                 }
             }
@@ -942,6 +1129,58 @@ bool TCPTransportInterface::Receive(
     return success;
 }
 
+bool TCPTransportInterface::process_received_message(
+        std::weak_ptr<RTCPMessageManager>& rtcp_manager,
+        std::shared_ptr<TCPChannelResource>& channel,
+        const TCPHeader& tcp_header,
+        octet* receive_buffer,
+        uint32_t receive_buffer_size,
+        Locator_t& remote_locator)
+{
+    if (configuration()->check_crc
+            && !check_crc(tcp_header, receive_buffer, receive_buffer_size))
+    {
+        logWarning(RTCP_MSG_IN, "Bad TCP header CRC");
+    }
+
+    if (tcp_header.logical_port == 0)
+    {
+        std::shared_ptr<RTCPMessageManager> rtcp_message_manager;
+        if(TCPChannelResource::eConnectionStatus::eDisconnected != channel->connection_status())
+        {
+            std::unique_lock<std::mutex> lock(rtcp_message_manager_mutex_);
+            rtcp_message_manager = rtcp_manager.lock();
+        }
+
+        if (rtcp_message_manager)
+        {
+            // The channel is not going to be deleted because we lock it for reading.
+            ResponseCode responseCode = rtcp_message_manager->processRTCPMessage(
+                    channel, receive_buffer, receive_buffer_size);
+
+            if (responseCode != RETCODE_OK)
+            {
+                close_tcp_socket(channel);
+            }
+
+            std::unique_lock<std::mutex> lock(rtcp_message_manager_mutex_);
+            rtcp_message_manager.reset();
+            rtcp_message_manager_cv_.notify_one();
+        }
+        else
+        {
+            close_tcp_socket(channel);
+        }
+
+        return false;
+    }
+
+    IPLocator::setLogicalPort(remote_locator, tcp_header.logical_port);
+    logInfo(RTCP_MSG_IN, "[RECEIVE] From: " << remote_locator \
+            << " - " << receive_buffer_size << " bytes.");
+    return true;
+}
+
 bool TCPTransportInterface::send(
         const octet* send_buffer,
         uint32_t send_buffer_size,
@@ -1004,6 +1243,24 @@ bool TCPTransportInterface::send(
                 TCPHeader tcp_header;
                 fill_rtcp_header(tcp_header, send_buffer, send_buffer_size, logical_port);
 
+                if (configuration()->coalescing_max_size > 0)
+                {
+                    success = channel->coalesce_send(
+                        (octet*)&tcp_header,
+                        static_cast<uint32_t>(TCPHeader::size()),
+                        send_buffer,
+                        send_buffer_size);
+                }
+                else if (configuration()->send_queue_capacity > 0)
+                {
+                    success = channel->enqueue_send(
+                        (octet*)&tcp_header,
+                        static_cast<uint32_t>(TCPHeader::size()),
+                        send_buffer,
+                        send_buffer_size,
+                        false);
+                }
+                else
                 {
                     asio::error_code ec;
                     size_t sent = channel->send(
@@ -1102,10 +1359,7 @@ void TCPTransportInterface::SocketAccepted(
             }
 
             channel->set_options(configuration());
-            std::weak_ptr<TCPChannelResource> channel_weak_ptr = channel;
-            std::weak_ptr<RTCPMessageManager> rtcp_manager_weak_ptr = rtcp_message_manager_;
-            channel->thread(std::thread(&TCPTransportInterface::perform_listen_operation, this,
-                        channel_weak_ptr, rtcp_manager_weak_ptr));
+            start_listening(channel);
 
             logInfo(RTCP, " Accepted connection (local: " << IPLocator::to_string(locator)
                     << ", remote: " << channel->remote_endpoint().address()
@@ -1148,10 +1402,7 @@ void TCPTransportInterface::SecureSocketAccepted(
             }
 
             secure_channel->set_options(configuration());
-            std::weak_ptr<TCPChannelResource> channel_weak_ptr = secure_channel;
-            std::weak_ptr<RTCPMessageManager> rtcp_manager_weak_ptr = rtcp_message_manager_;
-            secure_channel->thread(std::thread(&TCPTransportInterface::perform_listen_operation, this,
-                        channel_weak_ptr, rtcp_manager_weak_ptr));
+            start_listening(secure_channel);
 
             logInfo(RTCP, " Accepted connection (local: " << IPLocator::to_string(locator)
                     << ", remote: " << socket->lowest_layer().remote_endpoint().address()
@@ -1192,9 +1443,7 @@ void TCPTransportInterface::SocketConnected(
                     channel->change_status(TCPChannelResource::eConnectionStatus::eConnected);
                     channel->set_options(configuration());
 
-                    std::weak_ptr<RTCPMessageManager> rtcp_manager_weak_ptr = rtcp_message_manager_;
-                    channel->thread(std::thread(&TCPTransportInterface::perform_listen_operation, this,
-                                channel_weak_ptr, rtcp_manager_weak_ptr));
+                    start_listening(channel_weak_ptr);
                 }
             }
             else
@@ -18,10 +18,71 @@
 #include <fastrtps/rtps/messages/MessageReceiver.h>
 #include <fastrtps/utils/eClock.h>
 
+#if defined(__linux__)
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
 namespace eprosima {
 namespace fastrtps {
 namespace rtps {
 
+struct UDPChannelResource::BatchBuffers
+{
+    BatchBuffers(
+            uint32_t batch_size,
+            uint32_t max_msg_size,
+            bool with_timestamps)
+        : endpoints(batch_size)
+#if defined(__linux__)
+        , iovecs(batch_size)
+        , headers(batch_size)
+#endif
+    {
+        messages.reserve(batch_size);
+        for (uint32_t i = 0; i < batch_size; ++i)
+        {
+            messages.emplace_back(max_msg_size);
+        }
+
+#if defined(__linux__)
+        if (with_timestamps)
+        {
+            timestamps.resize(batch_size);
+            controls.resize(batch_size * s_control_size);
+        }
+#else
+        (void)with_timestamps;
+#endif
+    }
+
+    std::vector<CDRMessage_t> messages;
+    std::vector<asio::ip::udp::endpoint> endpoints;
+    //! Reception time of each message. Empty when timestamps are disabled.
+    std::vector<Time_t> timestamps;
+#if defined(__linux__)
+    //! Room for the SCM_TIMESTAMPING control message of each datagram.
+    static const size_t s_control_size = CMSG_SPACE(sizeof(struct scm_timestamping));
+
+    std::vector<struct iovec> iovecs;
+    std::vector<struct mmsghdr> headers;
+    std::vector<char> controls;
+#endif
+};
+
+#if defined(__linux__)
+//! Asks the kernel to timestamp the datagrams received on a socket.
+static bool enable_socket_timestamps(int socket)
+{
+    int flags = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+    return setsockopt(socket, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags)) == 0;
+}
+#endif
+
 UDPChannelResource::UDPChannelResource(
         UDPTransportInterface* transport,
         eProsimaUDPSocket& socket,
@@ -36,6 +97,24 @@ UDPChannelResource::UDPChannelResource(
     , interface_(sInterface)
     , transport_(transport)
 {
+#if defined(__linux__)
+    uint32_t batch_size = transport->configuration()->receive_batch_size;
+    bool with_timestamps = transport->configuration()->enable_receive_timestamps;
+    if (with_timestamps && !enable_socket_timestamps(this->socket()->native_handle()))
+    {
+        logWarning(RTPS_MSG_IN, "Cannot enable receive timestamps: " << strerror(errno));
+        with_timestamps = false;
+    }
+
+    // Timestamps come as ancillary data, which is only read by the batched receive.
+    if (batch_size > 1 || with_timestamps)
+    {
+        batch_.reset(new BatchBuffers(batch_size > 0 ? batch_size : 1, maxMsgSize, with_timestamps));
+        thread(std::thread(&UDPChannelResource::perform_batch_listen_operation, this, locator));
+        return;
+    }
+#endif
+
     thread(std::thread(&UDPChannelResource::perform_listen_operation, this, locator));
 }
 
@@ -71,6 +150,119 @@ void UDPChannelResource::perform_listen_operation(Locator_t input_locator)
     message_receiver(nullptr);
 }
 
+void UDPChannelResource::perform_batch_listen_operation(Locator_t input_locator)
+{
+    Locator_t remote_locator;
+
+    while (alive())
+    {
+        // Blocking receive of all the pending datagrams.
+        uint32_t received = ReceiveBatch();
+
+        // Datagrams are processed in arrival order.
+        for (uint32_t i = 0; i < received; ++i)
+        {
+            CDRMessage_t& msg = batch_->messages[i];
+
+            // This is not necessary anymore but it's left here for back compatibility with versions older than 1.8.1
+            if (msg.length == 0 || (msg.length == 13 && memcmp(msg.buffer, "EPRORTPSCLOSE", 13) == 0))
+            {
+                continue;
+            }
+
+            transport_->endpoint_to_locator(batch_->endpoints[i], remote_locator);
+
+            // Processes the data through the CDR Message interface.
+            if (message_receiver() == nullptr)
+            {
+                if (alive())
+                {
+                    logWarning(RTPS_MSG_IN, "Received Message, but no receiver attached");
+                }
+            }
+            else if (!batch_->timestamps.empty())
+            {
+                message_receiver()->OnDataReceived(msg.buffer, msg.length, input_locator, remote_locator,
+                    batch_->timestamps[i]);
+            }
+            else
+            {
+                message_receiver()->OnDataReceived(msg.buffer, msg.length, input_locator, remote_locator);
+            }
+        }
+    }
+
+    message_receiver(nullptr);
+}
+
+uint32_t UDPChannelResource::ReceiveBatch()
+{
+#if defined(__linux__)
+    uint32_t batch_size = static_cast<uint32_t>(batch_->messages.size());
+
+    for (uint32_t i = 0; i < batch_size; ++i)
+    {
+        CDRMessage_t& msg = batch_->messages[i];
+        batch_->iovecs[i].iov_base = msg.buffer;
+        batch_->iovecs[i].iov_len = msg.max_size;
+
+        struct msghdr& header = batch_->headers[i].msg_hdr;
+        memset(&header, 0, sizeof(header));
+        header.msg_name = batch_->endpoints[i].data();
+        header.msg_namelen = static_cast<socklen_t>(batch_->endpoints[i].capacity());
+        header.msg_iov = &batch_->iovecs[i];
+        header.msg_iovlen = 1;
+        if (!batch_->controls.empty())
+        {
+            header.msg_control = &batch_->controls[i * BatchBuffers::s_control_size];
+            header.msg_controllen = BatchBuffers::s_control_size;
+        }
+        batch_->headers[i].msg_len = 0;
+    }
+
+    // Blocks until one datagram arrives, then takes the ones already queued without blocking.
+    int received = recvmmsg(socket()->native_handle(), batch_->headers.data(), batch_size, MSG_WAITFORONE,
+        nullptr);
+    if (received < 0)
+    {
+        if (errno != EINTR && alive())
+        {
+            logWarning(RTPS_MSG_OUT, "Error receiving data: " << strerror(errno) << " - " << message_receiver()
+                << " (" << this << ")");
+        }
+        return 0;
+    }
+
+    for (int i = 0; i < received; ++i)
+    {
+        batch_->messages[i].length = batch_->headers[i].msg_len;
+        batch_->endpoints[i].resize(batch_->headers[i].msg_hdr.msg_namelen);
+
+        if (!batch_->timestamps.empty())
+        {
+            // The software timestamp is the first one of SCM_TIMESTAMPING
+            struct msghdr& header = batch_->headers[i].msg_hdr;
+            batch_->timestamps[i] = c_TimeZero;
+            for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&header); cmsg != nullptr; cmsg = CMSG_NXTHDR(&header, cmsg))
+            {
+                if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPING)
+                {
+                    struct scm_timestamping stamps;
+                    memcpy(&stamps, CMSG_DATA(cmsg), sizeof(stamps));
+                    batch_->timestamps[i].seconds(static_cast<int32_t>(stamps.ts[0].tv_sec));
+                    batch_->timestamps[i].nanosec(static_cast<uint32_t>(stamps.ts[0].tv_nsec));
+                    break;
+                }
+            }
+        }
+    }
+
+    return static_cast<uint32_t>(received);
+#else
+    return 0;
+#endif
+}
+
 bool UDPChannelResource::Receive(
         octet* receive_buffer,
         uint32_t receive_buffer_capacity,
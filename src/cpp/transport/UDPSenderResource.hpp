@@ -29,10 +29,12 @@ class UDPSenderResource : public SenderResource
         UDPSenderResource(
                 UDPTransportInterface& transport,
                 eProsimaUDPSocket& socket,
-                bool only_multicast_purpose = false)
+                bool only_multicast_purpose = false,
+                const std::string& interface = std::string())
             : SenderResource(transport.kind())
             , socket_(moveSocket(socket))
             , only_multicast_purpose_(only_multicast_purpose)
+            , interface_(interface)
         {
             // Implementation functions are bound to the right transport parameters
             clean_up = [this, &transport]()
@@ -45,7 +47,26 @@ class UDPSenderResource : public SenderResource
                     uint32_t dataSize,
                     const Locator_t& destination)-> bool
                 {
-                    return transport.send(data, dataSize, socket_, destination, only_multicast_purpose_);
+                    return transport.send(data, dataSize, socket_, destination, only_multicast_purpose_,
+                            interface_);
+                };
+
+            send_multiple_lambda_ = [this, &transport] (
+                    const octet* data,
+                    uint32_t dataSize,
+                    const LocatorList_t& destinations)-> bool
+                {
+                    return transport.send(data, dataSize, socket_, destinations, only_multicast_purpose_,
+                            interface_);
+                };
+
+            send_gather_lambda_ = [this, &transport] (
+                    const std::vector<NetworkBuffer>& buffers,
+                    uint32_t total_bytes,
+                    const LocatorList_t& destinations)-> bool
+                {
+                    return transport.send(buffers, total_bytes, socket_, destinations, only_multicast_purpose_,
+                            interface_);
                 };
         }
 
@@ -80,6 +101,9 @@ class UDPSenderResource : public SenderResource
         eProsimaUDPSocket socket_;
 
         bool only_multicast_purpose_;
+
+        //! Whitelisted interface the socket is bound to. Empty when it sends unicast to every destination.
+        std::string interface_;
 };
 
 } // namespace rtps
@@ -24,6 +24,14 @@
 #include <fastrtps/utils/IPLocator.h>
 #include <fastrtps/utils/eClock.h>
 
+#if defined(__linux__)
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <poll.h>
+#include <linux/filter.h>
+#include <cerrno>
+#endif
+
 using namespace std;
 using namespace asio;
 
@@ -52,6 +60,12 @@ UDPTransportDescriptor::UDPTransportDescriptor()
 UDPTransportDescriptor::UDPTransportDescriptor(const UDPTransportDescriptor& t)
     : SocketTransportDescriptor(t)
     , m_output_udp_socket(t.m_output_udp_socket)
+    , non_blocking_send(t.non_blocking_send)
+    , receive_batch_size(t.receive_batch_size)
+    , enable_receive_timestamps(t.enable_receive_timestamps)
+    , receive_socket_count(t.receive_socket_count)
+    , steer_by_guid_prefix(t.steer_by_guid_prefix)
+    , interface_options(t.interface_options)
 {
 }
 
@@ -59,6 +73,7 @@ UDPTransportInterface::UDPTransportInterface(int32_t transport_kind)
     : TransportInterface(transport_kind)
     , mSendBufferSize(0)
     , mReceiveBufferSize(0)
+    , mEgressTable(std::make_shared<EgressTable>())
 {
 }
 
@@ -160,6 +175,36 @@ bool UDPTransportInterface::init()
         return false;
     }
 
+    if (configuration()->receive_socket_count == 0)
+    {
+        logError(RTPS_MSG_OUT, "receive_socket_count cannot be zero");
+        return false;
+    }
+
+#if !defined(__linux__)
+    if (configuration()->receive_socket_count > 1)
+    {
+        logWarning(RTPS_MSG_OUT, "receive_socket_count is only supported on Linux, one socket will be used");
+    }
+#endif
+
+    for (const UDPInterfaceOptions& options : configuration()->interface_options)
+    {
+        if ((options.sendBufferSize != 0 && configuration()->maxMessageSize > options.sendBufferSize) ||
+            (options.receiveBufferSize != 0 && configuration()->maxMessageSize > options.receiveBufferSize))
+        {
+            logError(RTPS_MSG_OUT, "maxMessageSize cannot be greater than the buffer sizes of interface "
+                << options.address);
+            return false;
+        }
+
+        if (options.tos > 255)
+        {
+            logError(RTPS_MSG_OUT, "Invalid traffic class for interface " << options.address);
+            return false;
+        }
+    }
+
     // TODO(Ricardo) Create an event that update this list.
     get_ips(currentInterfaces);
 
@@ -184,12 +229,31 @@ bool UDPTransportInterface::OpenAndBindInputSockets(const Locator_t& locator, Tr
 
     try
     {
+        uint32_t socket_count = is_multicast ? 1u : GetReceiveSocketCount();
         std::vector<std::string> vInterfaces = get_binding_interfaces_list();
         for (std::string sInterface : vInterfaces)
         {
-            UDPChannelResource* p_channel_resource;
-            p_channel_resource = CreateInputChannelResource(sInterface, locator, is_multicast, maxMsgSize, receiver);
-            mInputSockets[IPLocator::getPhysicalPort(locator)].push_back(p_channel_resource);
+            if (socket_count > 1)
+            {
+                // Any socket with SO_REUSEPORT could join the group, so check first nobody else owns the port.
+                ip::udp::socket probe(io_service_);
+                probe.open(generate_protocol());
+                probe.bind(generate_endpoint(sInterface, IPLocator::getPhysicalPort(locator)));
+                probe.close();
+            }
+
+            for (uint32_t i = 0; i < socket_count; ++i)
+            {
+                UDPChannelResource* p_channel_resource;
+                p_channel_resource = CreateInputChannelResource(sInterface, locator, is_multicast, maxMsgSize,
+                        receiver);
+                mInputSockets[IPLocator::getPhysicalPort(locator)].push_back(p_channel_resource);
+
+                if (i == 0 && socket_count > 1 && configuration()->steer_by_guid_prefix)
+                {
+                    AttachGuidPrefixSteering(p_channel_resource->socket()->native_handle(), socket_count);
+                }
+            }
         }
     }
     catch (asio::system_error const& e)
@@ -240,6 +304,190 @@ eProsimaUDPSocket UDPTransportInterface::OpenAndBindUnicastOutputSocket(
     return socket;
 }
 
+uint32_t UDPTransportInterface::GetReceiveSocketCount() const
+{
+#if defined(__linux__)
+    return configuration()->receive_socket_count;
+#else
+    return 1;
+#endif
+}
+
+void UDPTransportInterface::SetSocketReusePort(eProsimaUDPSocket& socket)
+{
+#if defined(SO_REUSEPORT)
+    getSocketPtr(socket)->set_option(asio::detail::socket_option::boolean<
+        ASIO_OS_DEF(SOL_SOCKET), SO_REUSEPORT>(true));
+#else
+    (void)socket;
+#endif
+}
+
+void UDPTransportInterface::AttachGuidPrefixSteering(
+        asio::ip::udp::socket::native_handle_type handle,
+        uint32_t socket_count)
+{
+#if defined(__linux__) && defined(SO_ATTACH_REUSEPORT_CBPF)
+    // The program sees the UDP payload. It folds the twelve bytes of the GuidPrefix (offsets 8 to 20 of the RTPS
+    // header) into one and returns it modulo the number of sockets. All bytes take part, as the ones changing
+    // between participants of a host (process and participant ids) are not aligned. Messages too short to carry
+    // a GuidPrefix abort with 0.
+    struct sock_filter code[] =
+    {
+        BPF_STMT(BPF_LD | BPF_W | BPF_ABS, 8),
+        BPF_STMT(BPF_MISC | BPF_TAX, 0),
+        BPF_STMT(BPF_LD | BPF_W | BPF_ABS, 12),
+        BPF_STMT(BPF_ALU | BPF_XOR | BPF_X, 0),
+        BPF_STMT(BPF_MISC | BPF_TAX, 0),
+        BPF_STMT(BPF_LD | BPF_W | BPF_ABS, 16),
+        BPF_STMT(BPF_ALU | BPF_XOR | BPF_X, 0),
+        BPF_STMT(BPF_MISC | BPF_TAX, 0),
+        BPF_STMT(BPF_ALU | BPF_RSH | BPF_K, 16),
+        BPF_STMT(BPF_ALU | BPF_XOR | BPF_X, 0),
+        BPF_STMT(BPF_MISC | BPF_TAX, 0),
+        BPF_STMT(BPF_ALU | BPF_RSH | BPF_K, 8),
+        BPF_STMT(BPF_ALU | BPF_XOR | BPF_X, 0),
+        BPF_STMT(BPF_ALU | BPF_AND | BPF_K, 0xFF),
+        BPF_STMT(BPF_ALU | BPF_MOD | BPF_K, socket_count),
+        BPF_STMT(BPF_RET | BPF_A, 0),
+    };
+    struct sock_fprog program;
+    program.len = static_cast<unsigned short>(sizeof(code) / sizeof(code[0]));
+    program.filter = code;
+
+    if (setsockopt(handle, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &program, sizeof(program)) != 0)
+    {
+        // Not fatal, the kernel falls back to hashing the source address.
+        logWarning(RTPS_MSG_IN, "Cannot attach the GuidPrefix steering program: " << strerror(errno));
+    }
+#else
+    (void)handle;
+    (void)socket_count;
+    logWarning(RTPS_MSG_IN, "GuidPrefix steering is not supported on this platform");
+#endif
+}
+
+const UDPInterfaceOptions* UDPTransportInterface::get_interface_options(const std::string& sIp) const
+{
+    for (const UDPInterfaceOptions& options : configuration()->interface_options)
+    {
+        if (options.address == sIp)
+        {
+            return &options;
+        }
+    }
+
+    return nullptr;
+}
+
+void UDPTransportInterface::SetSocketInterfaceOptions(
+        eProsimaUDPSocket& socket,
+        const std::string& sIp,
+        bool is_output)
+{
+    const UDPInterfaceOptions* options = get_interface_options(sIp);
+    if (options == nullptr)
+    {
+        return;
+    }
+
+    if (is_output && options->sendBufferSize != 0)
+    {
+        getSocketPtr(socket)->set_option(socket_base::send_buffer_size(static_cast<int32_t>(options->sendBufferSize)));
+    }
+    else if (!is_output && options->receiveBufferSize != 0)
+    {
+        getSocketPtr(socket)->set_option(
+            socket_base::receive_buffer_size(static_cast<int32_t>(options->receiveBufferSize)));
+    }
+
+    if (is_output && options->tos >= 0)
+    {
+        SetSocketTrafficClass(socket, static_cast<uint8_t>(options->tos));
+    }
+}
+
+void UDPTransportInterface::resolve_egress_interface(const Locator_t& remote_locator)
+{
+    if (IPLocator::isMulticast(remote_locator))
+    {
+        return;
+    }
+
+    Locator_t address(remote_locator);
+    address.port = 0;
+
+    std::lock_guard<std::mutex> lock(mEgressMutex);
+
+    std::shared_ptr<const EgressTable> current = std::atomic_load(&mEgressTable);
+    if (current->output_interfaces.size() <= 1)
+    {
+        return;
+    }
+
+    // Ask the routing table: connecting a datagram socket sends nothing, but binds it to the egress address.
+    std::string egress;
+    asio::error_code ec;
+    ip::udp::socket probe(io_service_);
+    probe.open(generate_protocol(), ec);
+    if (!ec)
+    {
+        probe.connect(generate_endpoint(remote_locator, IPLocator::getPhysicalPort(remote_locator)), ec);
+    }
+    if (!ec)
+    {
+        ip::udp::endpoint local = probe.local_endpoint(ec);
+        if (!ec)
+        {
+            egress = local.address().to_string();
+        }
+    }
+
+    const std::vector<std::string>& output_interfaces = current->output_interfaces;
+    if (std::find(output_interfaces.begin(), output_interfaces.end(), egress) == output_interfaces.end())
+    {
+        // Not routed through a whitelisted interface. Use the primary one, as only one copy has to leave.
+        egress = output_interfaces.front();
+    }
+
+    auto route = current->routes.find(address);
+    if (route != current->routes.end() && route->second == egress)
+    {
+        return;
+    }
+
+    // Opening the locator again refreshes its route
+    std::shared_ptr<EgressTable> updated = std::make_shared<EgressTable>(*current);
+    updated->routes[address] = egress;
+    std::atomic_store(&mEgressTable, std::shared_ptr<const EgressTable>(updated));
+}
+
+const std::string& UDPTransportInterface::get_egress_interface(
+        const EgressTable& egress_table,
+        const Locator_t& remote_locator)
+{
+    static const std::string no_interface;
+
+    if (egress_table.output_interfaces.empty())
+    {
+        return no_interface;
+    }
+
+    if (egress_table.output_interfaces.size() > 1)
+    {
+        Locator_t address(remote_locator);
+        address.port = 0;
+
+        auto it = egress_table.routes.find(address);
+        if (it != egress_table.routes.end())
+        {
+            return it->second;
+        }
+    }
+
+    return egress_table.output_interfaces.front();
+}
+
 bool UDPTransportInterface::OpenOutputChannel(
         SendResourceList& sender_resource_list,
         const Locator_t& locator)
@@ -258,6 +506,7 @@ bool UDPTransportInterface::OpenOutputChannel(
 
         if(udp_sender_resource)
         {
+            resolve_egress_interface(locator);
             return true;
         }
     }
@@ -278,6 +527,7 @@ bool UDPTransportInterface::OpenOutputChannel(
             if(!locNames.empty())
             {
                 SetSocketOutboundInterface(unicastSocket, (*locNames.begin()).name);
+                SetSocketInterfaceOptions(unicastSocket, (*locNames.begin()).name, true);
             }
 
             // If more than one interface, then create sockets for outbounding multicast.
@@ -296,6 +546,7 @@ bool UDPTransportInterface::OpenOutputChannel(
                         eProsimaUDPSocket multicastSocket =
                             OpenAndBindUnicastOutputSocket(generate_endpoint((*locIt).name, new_port), new_port);
                         SetSocketOutboundInterface(multicastSocket, (*locIt).name);
+                        SetSocketInterfaceOptions(multicastSocket, (*locIt).name, true);
 
                         sender_resource_list.emplace_back(
                                 static_cast<SenderResource*>(new UDPSenderResource(*this, multicastSocket, true)));
@@ -320,6 +571,9 @@ bool UDPTransportInterface::OpenOutputChannel(
             locNames.clear();
             get_ips(locNames, true);
 
+            // One socket per whitelisted interface. All of them send multicast, so it leaves once through each
+            // interface, but each unicast destination is only sent by the socket of the interface routing it.
+            std::shared_ptr<EgressTable> egress_table = std::make_shared<EgressTable>();
             bool firstInterface = false;
             for (const auto& infoIP : locNames)
             {
@@ -328,15 +582,22 @@ bool UDPTransportInterface::OpenOutputChannel(
                     eProsimaUDPSocket unicastSocket =
                         OpenAndBindUnicastOutputSocket(generate_endpoint(infoIP.name, port), port);
                     SetSocketOutboundInterface(unicastSocket, infoIP.name);
+                    SetSocketInterfaceOptions(unicastSocket, infoIP.name, true);
                     if (!firstInterface)
                     {
                         getSocketPtr(unicastSocket)->set_option(ip::multicast::enable_loopback(true));
                         firstInterface = true;
                     }
                     sender_resource_list.emplace_back(
-                            static_cast<SenderResource*>(new UDPSenderResource(*this, unicastSocket)));
+                            static_cast<SenderResource*>(new UDPSenderResource(*this, unicastSocket, false,
+                            infoIP.name)));
+
+                    egress_table->output_interfaces.push_back(infoIP.name);
                 }
             }
+
+            std::lock_guard<std::mutex> lock(mEgressMutex);
+            std::atomic_store(&mEgressTable, std::shared_ptr<const EgressTable>(egress_table));
         }
     }
     catch (asio::system_error const& e)
@@ -354,6 +615,7 @@ bool UDPTransportInterface::OpenOutputChannel(
         return false;
     }
 
+    resolve_egress_interface(locator);
     return true;
 }
 
@@ -375,7 +637,8 @@ bool UDPTransportInterface::send(
         uint32_t send_buffer_size,
         eProsimaUDPSocket& socket,
         const Locator_t& remote_locator,
-        bool only_multicast_purpose)
+        bool only_multicast_purpose,
+        const std::string& interface)
 {
     if (!IsLocatorSupported(remote_locator) || send_buffer_size > configuration()->sendBufferSize)
     {
@@ -385,7 +648,9 @@ bool UDPTransportInterface::send(
     bool success = false;
     bool is_multicast_remote_address = IPLocator::isMulticast(remote_locator);
 
-    if (is_multicast_remote_address || !only_multicast_purpose)
+    if (is_multicast_remote_address ||
+        (!only_multicast_purpose && (interface.empty() ||
+        interface == get_egress_interface(*std::atomic_load(&mEgressTable), remote_locator))))
     {
         auto destinationEndpoint = generate_endpoint(remote_locator, IPLocator::getPhysicalPort(remote_locator));
 
@@ -423,6 +688,185 @@ bool UDPTransportInterface::send(
     return success;
 }
 
+bool UDPTransportInterface::send(
+        const octet* send_buffer,
+        uint32_t send_buffer_size,
+        eProsimaUDPSocket& socket,
+        const LocatorList_t& remote_locators,
+        bool only_multicast_purpose,
+        const std::string& interface)
+{
+    NetworkBuffer buffer(send_buffer, send_buffer_size);
+    return send_buffers(&buffer, 1, send_buffer_size, socket, remote_locators, only_multicast_purpose, interface);
+}
+
+bool UDPTransportInterface::send(
+        const std::vector<NetworkBuffer>& buffers,
+        uint32_t total_bytes,
+        eProsimaUDPSocket& socket,
+        const LocatorList_t& remote_locators,
+        bool only_multicast_purpose,
+        const std::string& interface)
+{
+    return send_buffers(buffers.data(), buffers.size(), total_bytes, socket, remote_locators,
+            only_multicast_purpose, interface);
+}
+
+bool UDPTransportInterface::send_buffers(
+        const NetworkBuffer* buffers,
+        size_t buffer_count,
+        uint32_t total_bytes,
+        eProsimaUDPSocket& socket,
+        const LocatorList_t& remote_locators,
+        bool only_multicast_purpose,
+        const std::string& interface)
+{
+    if (total_bytes > configuration()->sendBufferSize)
+    {
+        return false;
+    }
+
+    // Slices are expected to be few (headers around some large payloads). Otherwise they are joined first.
+    static const size_t max_buffer_count = 32;
+    if (buffer_count > max_buffer_count || buffer_count == 0)
+    {
+        std::vector<octet> message(total_bytes);
+        uint32_t position = 0;
+        for (size_t i = 0; i < buffer_count; ++i)
+        {
+            memcpy(message.data() + position, buffers[i].buffer, buffers[i].size);
+            position += buffers[i].size;
+        }
+
+        NetworkBuffer buffer(message.data(), total_bytes);
+        return send_buffers(&buffer, 1, total_bytes, socket, remote_locators, only_multicast_purpose, interface);
+    }
+
+#if defined(__linux__)
+    // Destinations are handed to the kernel in chunks, so no memory is allocated on this path.
+    static const unsigned int max_batch_size = 64;
+    // Longest wait for a full non-blocking socket to drain before the remaining destinations are given up.
+    static const int would_block_wait_ms = 10;
+    asio::ip::udp::endpoint endpoints[max_batch_size];
+    struct mmsghdr headers[max_batch_size];
+    struct iovec iov[max_buffer_count];
+    for (size_t i = 0; i < buffer_count; ++i)
+    {
+        iov[i].iov_base = const_cast<octet*>(buffers[i].buffer);
+        iov[i].iov_len = buffers[i].size;
+    }
+
+    bool success = true;
+    std::shared_ptr<const EgressTable> egress_table = std::atomic_load(&mEgressTable);
+    auto locator_it = remote_locators.begin();
+    while (locator_it != remote_locators.end())
+    {
+        unsigned int count = 0;
+        for (; locator_it != remote_locators.end() && count < max_batch_size; ++locator_it)
+        {
+            if (!IsLocatorSupported(*locator_it))
+            {
+                success = false;
+                continue;
+            }
+
+            if (!IPLocator::isMulticast(*locator_it) &&
+                (only_multicast_purpose || (!interface.empty() &&
+                interface != get_egress_interface(*egress_table, *locator_it))))
+            {
+                continue;
+            }
+
+            endpoints[count] = generate_endpoint(*locator_it, IPLocator::getPhysicalPort(*locator_it));
+            memset(&headers[count], 0, sizeof(struct mmsghdr));
+            headers[count].msg_hdr.msg_name = endpoints[count].data();
+            headers[count].msg_hdr.msg_namelen = static_cast<socklen_t>(endpoints[count].size());
+            headers[count].msg_hdr.msg_iov = iov;
+            headers[count].msg_hdr.msg_iovlen = buffer_count;
+            ++count;
+        }
+
+        unsigned int sent = 0;
+        bool waited = false;
+        while (sent < count)
+        {
+            int ret = sendmmsg(getSocketPtr(socket)->native_handle(), &headers[sent], count - sent, 0);
+            if (ret < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+
+                if (errno == EAGAIN || errno == EWOULDBLOCK)
+                {
+                    // Wait once for room in the socket buffer. Another wait is only allowed after progress.
+                    struct pollfd writable;
+                    writable.fd = getSocketPtr(socket)->native_handle();
+                    writable.events = POLLOUT;
+                    writable.revents = 0;
+                    if (!waited && poll(&writable, 1, would_block_wait_ms) > 0)
+                    {
+                        waited = true;
+                        continue;
+                    }
+
+                    logWarning(RTPS_MSG_OUT, "UDP send would have blocked. Packet is dropped for "
+                        << count - sent << " destinations.");
+                    success = false;
+                    break;
+                }
+
+                // Skip the destination that failed and go on with the rest.
+                logWarning(RTPS_MSG_OUT, "UDPTransport error sending to " << endpoints[sent] << ": "
+                    << strerror(errno));
+                success = false;
+                ++sent;
+            }
+            else
+            {
+                sent += static_cast<unsigned int>(ret);
+                waited = false;
+            }
+        }
+
+        logInfo(RTPS_MSG_OUT, "UDPTransport: " << total_bytes << " bytes TO " << sent << " endpoints FROM "
+            << getSocketPtr(socket)->local_endpoint());
+    }
+
+    return success;
+#else
+    std::vector<octet> message;
+    const octet* send_buffer = buffers[0].buffer;
+    if (buffer_count > 1)
+    {
+        message.resize(total_bytes);
+        uint32_t position = 0;
+        for (size_t i = 0; i < buffer_count; ++i)
+        {
+            memcpy(message.data() + position, buffers[i].buffer, buffers[i].size);
+            position += buffers[i].size;
+        }
+        send_buffer = message.data();
+    }
+
+    bool success = true;
+    std::shared_ptr<const EgressTable> egress_table = std::atomic_load(&mEgressTable);
+
+    for (const Locator_t& remote_locator : remote_locators)
+    {
+        if (IPLocator::isMulticast(remote_locator) ||
+            (!only_multicast_purpose && (interface.empty() ||
+            interface == get_egress_interface(*egress_table, remote_locator))))
+        {
+            success &= send(send_buffer, total_bytes, socket, remote_locator, only_multicast_purpose, interface);
+        }
+    }
+
+    return success;
+#endif
+}
+
 LocatorList_t UDPTransportInterface::ShrinkLocatorLists(const std::vector<LocatorList_t>& locatorLists)
 {
     LocatorList_t multicastResult, unicastResult;
@@ -267,6 +267,7 @@ eProsimaUDPSocket UDPv4Transport::OpenAndBindInputSocket(
     {
         getSocketPtr(socket)->set_option(socket_base::receive_buffer_size(mReceiveBufferSize));
     }
+    SetSocketInterfaceOptions(socket, sIp, false);
 
     if (is_multicast)
     {
@@ -276,6 +277,10 @@ eProsimaUDPSocket UDPv4Transport::OpenAndBindInputSocket(
             ASIO_OS_DEF(SOL_SOCKET), SO_REUSEPORT>(true));
 #endif
     }
+    else if (GetReceiveSocketCount() > 1)
+    {
+        SetSocketReusePort(socket);
+    }
 
     getSocketPtr(socket)->bind(generate_endpoint(sIp, port));
     return socket;
@@ -505,6 +510,14 @@ void UDPv4Transport::SetSocketOutboundInterface(
     getSocketPtr(socket)->set_option(ip::multicast::outbound_interface(asio::ip::address_v4::from_string(sIp)));
 }
 
+void UDPv4Transport::SetSocketTrafficClass(
+        eProsimaUDPSocket& socket,
+        uint8_t tos)
+{
+    getSocketPtr(socket)->set_option(asio::detail::socket_option::integer<
+        ASIO_OS_DEF(IPPROTO_IP), IP_TOS>(tos));
+}
+
 } // namespace rtps
 } // namespace fastrtps
 } // namespace eprosima
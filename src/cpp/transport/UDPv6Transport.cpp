@@ -276,6 +276,7 @@ eProsimaUDPSocket UDPv6Transport::OpenAndBindInputSocket(
     {
         getSocketPtr(socket)->set_option(socket_base::receive_buffer_size(mReceiveBufferSize));
     }
+    SetSocketInterfaceOptions(socket, sIp, false);
 
     if (is_multicast)
     {
@@ -285,6 +286,10 @@ eProsimaUDPSocket UDPv6Transport::OpenAndBindInputSocket(
             ASIO_OS_DEF(SOL_SOCKET), SO_REUSEPORT>(true));
 #endif
     }
+    else if (GetReceiveSocketCount() > 1)
+    {
+        SetSocketReusePort(socket);
+    }
 
     getSocketPtr(socket)->bind(generate_endpoint(sIp, port));
 
@@ -468,6 +473,14 @@ void UDPv6Transport::SetSocketOutboundInterface(
         asio::ip::address_v6::from_string(sIp).scope_id()));
 }
 
+void UDPv6Transport::SetSocketTrafficClass(
+        eProsimaUDPSocket& socket,
+        uint8_t tos)
+{
+    getSocketPtr(socket)->set_option(asio::detail::socket_option::integer<
+        ASIO_OS_DEF(IPPROTO_IPV6), IPV6_TCLASS>(tos));
+}
+
 } // namespace rtps
 } // namespace fastrtps
 } // namespace eprosima
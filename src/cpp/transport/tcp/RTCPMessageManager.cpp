@@ -26,6 +26,9 @@
 #include <fastrtps/transport/TCPv4TransportDescriptor.h>
 #include <fastrtps/transport/TCPv6TransportDescriptor.h>
 
+#include <algorithm>
+#include <cstring>
+
 
 #define IDSTRING "(ID:" << std::this_thread::get_id() <<") "<<
 
@@ -80,6 +83,12 @@ size_t RTCPMessageManager::sendMessage(
         return 0;
     }
 
+    // Control messages must not be interleaved with the ones waiting in the send queue
+    if (mTransport->configuration()->send_queue_capacity > 0)
+    {
+        return channel->enqueue_send(nullptr, 0, msg.buffer, msg.length, true) ? msg.length : 0;
+    }
+
     asio::error_code ec;
     size_t send = channel->send(nullptr, 0, msg.buffer, msg.length, ec);
     if (send != msg.length || ec)
@@ -166,6 +175,52 @@ uint32_t& RTCPMessageManager::addToCRC(
     return crc;
 }
 
+uint32_t RTCPMessageManager::addToCRC(
+        uint32_t crc,
+        const octet* data,
+        size_t size)
+{
+    // The CRC is an end-around carry sum of the bytes, so its value only depends on their total modulo 2^32 - 1.
+    // Bytes are added eight at a time, two of them in each 16 bits lane of a word.
+    const uint64_t byte_mask = 0x00FF00FF00FF00FFull;
+    const uint64_t lane_mask = 0x0000FFFF0000FFFFull;
+    // Lanes grow at most 2 * 255 per word
+    const size_t max_words_per_fold = 128;
+
+    uint64_t total = 0;
+    size_t pos = 0;
+
+    while (size - pos >= sizeof(uint64_t))
+    {
+        size_t words = std::min((size - pos) / sizeof(uint64_t), max_words_per_fold);
+        uint64_t lanes = 0;
+
+        for (size_t i = 0; i < words; ++i, pos += sizeof(uint64_t))
+        {
+            uint64_t word;
+            memcpy(&word, &data[pos], sizeof(uint64_t));
+            lanes += (word & byte_mask) + ((word >> 8) & byte_mask);
+        }
+
+        lanes = (lanes & lane_mask) + ((lanes >> 16) & lane_mask);
+        total += (lanes & 0xFFFFFFFFull) + (lanes >> 32);
+    }
+
+    for (; pos < size; ++pos)
+    {
+        total += data[pos];
+    }
+
+    if (total == 0)
+    {
+        return crc;
+    }
+
+    // Once it is not zero, the per byte sum always stays between 1 and 2^32 - 1
+    total += crc;
+    return static_cast<uint32_t>((total - 1) % 0xFFFFFFFFull + 1);
+}
+
 void RTCPMessageManager::fillHeaders(
         TCPCPMKind kind,
         const TCPTransactionId &transaction_id,
@@ -210,35 +265,16 @@ void RTCPMessageManager::fillHeaders(
     uint32_t crc = 0;
     if (alive() && mTransport->configuration()->calculate_crc)
     {
-        octet* it = (octet*)&retCtrlHeader;
-        for (size_t i = 0; i < TCPControlMsgHeader::size(); ++i)
-        {
-            crc = addToCRC(crc, it[i]);
-        }
+        crc = addToCRC(crc, (octet*)&retCtrlHeader, TCPControlMsgHeader::size());
         if (respCode != nullptr)
         {
-            it = (octet*)respCode;
-            for (int i = 0; i < 4; ++i)
-            {
-                crc = addToCRC(crc, it[i]);
-            }
+            crc = addToCRC(crc, (octet*)respCode, 4);
         }
         if (payload != nullptr)
         {
-            octet* pay = (octet*)&(payload->encapsulation);
-            for (uint32_t i = 0; i < 2; ++i)
-            {
-                crc = addToCRC(crc, pay[i]);
-            }
-            pay = (octet*)&(payload->length);
-            for (uint32_t i = 0; i < 4; ++i)
-            {
-                crc = addToCRC(crc, pay[i]);
-            }
-            for (uint32_t i = 0; i < payload->length; ++i)
-            {
-                crc = addToCRC(crc, payload->data[i]);
-            }
+            crc = addToCRC(crc, (octet*)&(payload->encapsulation), 2);
+            crc = addToCRC(crc, (octet*)&(payload->length), 4);
+            crc = addToCRC(crc, payload->data, payload->length);
         }
     }
     header.crc = crc;
@@ -13,7 +13,10 @@
 // limitations under the License.
 
 #include <fastrtps/transport/test_UDPv4Transport.h>
+#include <fastrtps/utils/IPLocator.h>
 #include <cstdlib>
+#include <cstring>
+#include <mutex>
 
 using namespace std;
 
@@ -24,6 +27,12 @@ namespace rtps{
 std::vector<std::vector<octet> > test_UDPv4Transport::test_UDPv4Transport_DropLog;
 uint32_t test_UDPv4Transport::test_UDPv4Transport_DropLogLength = 0;
 bool test_UDPv4Transport::test_UDPv4Transport_ShutdownAllNetwork = false;
+std::atomic<uint32_t> test_UDPv4Transport::test_UDPv4Transport_UnicastUserDataSent(0u);
+std::atomic<uint32_t> test_UDPv4Transport::test_UDPv4Transport_MulticastUserDataSent(0u);
+std::atomic<uint32_t> test_UDPv4Transport::test_UDPv4Transport_UserHeartbeatsSent(0u);
+
+// Writers of a participant may send at the same time
+static std::mutex s_drop_log_mutex;
 
 test_UDPv4Transport::test_UDPv4Transport(const test_UDPv4TransportDescriptor& descriptor):
     drop_data_messages_percentage_(descriptor.dropDataMessagesPercentage),
@@ -69,7 +78,8 @@ bool test_UDPv4Transport::send(
         uint32_t send_buffer_size,
         eProsimaUDPSocket& socket,
         const Locator_t& remote_locator,
-        bool only_multicast_purpose)
+        bool only_multicast_purpose,
+        const std::string& interface)
 {
     if (packet_should_drop(send_buffer, send_buffer_size))
     {
@@ -78,8 +88,75 @@ bool test_UDPv4Transport::send(
     }
     else
     {
-        return UDPv4Transport::send(send_buffer, send_buffer_size, socket, remote_locator, only_multicast_purpose);
+        if (packet_has_user_submessage(send_buffer, send_buffer_size, HEARTBEAT))
+        {
+            ++test_UDPv4Transport_UserHeartbeatsSent;
+        }
+
+        if (packet_has_user_submessage(send_buffer, send_buffer_size, DATA))
+        {
+            if (IPLocator::isMulticast(remote_locator))
+            {
+                ++test_UDPv4Transport_MulticastUserDataSent;
+            }
+            else
+            {
+                ++test_UDPv4Transport_UnicastUserDataSent;
+            }
+        }
+
+        return UDPv4Transport::send(send_buffer, send_buffer_size, socket, remote_locator, only_multicast_purpose,
+                interface);
+    }
+}
+
+bool test_UDPv4Transport::send(
+        const octet* send_buffer,
+        uint32_t send_buffer_size,
+        eProsimaUDPSocket& socket,
+        const LocatorList_t& remote_locators,
+        bool only_multicast_purpose,
+        const std::string& interface)
+{
+    bool success = true;
+
+    // Each destination gets its own chance of losing the packet
+    for (const Locator_t& remote_locator : remote_locators)
+    {
+        success &= send(send_buffer, send_buffer_size, socket, remote_locator, only_multicast_purpose, interface);
     }
+
+    return success;
+}
+
+bool test_UDPv4Transport::send(
+        const std::vector<NetworkBuffer>& buffers,
+        uint32_t total_bytes,
+        eProsimaUDPSocket& socket,
+        const LocatorList_t& remote_locators,
+        bool only_multicast_purpose,
+        const std::string& interface)
+{
+    // Drop criteria look into the whole message
+    std::lock_guard<std::mutex> lock(gathered_message_mutex_);
+    gathered_message_.resize(total_bytes);
+    uint32_t position = 0;
+    for (const NetworkBuffer& buffer : buffers)
+    {
+        memcpy(gathered_message_.data() + position, buffer.buffer, buffer.size);
+        position += buffer.size;
+    }
+
+    return send(gathered_message_.data(), total_bytes, socket, remote_locators, only_multicast_purpose, interface);
+}
+
+// Drop criteria only read the message, so it is wrapped instead of copied.
+static void WrapMessage(CDRMessage_t& msg, const octet* buffer, uint32_t size)
+{
+    msg.wraps = true;
+    msg.buffer = const_cast<octet*>(buffer);
+    msg.max_size = size;
+    msg.length = size;
 }
 
 static bool ReadSubmessageHeader(CDRMessage_t& msg, SubmessageHeader_t& smh)
@@ -119,9 +196,8 @@ bool test_UDPv4Transport::packet_should_drop(const octet* send_buffer, uint32_t
         return true;
     }
 
-    CDRMessage_t cdrMessage(send_buffer_size);;
-    memcpy(cdrMessage.buffer, send_buffer, send_buffer_size);
-    cdrMessage.length = send_buffer_size;
+    CDRMessage_t cdrMessage(0);
+    WrapMessage(cdrMessage, send_buffer, send_buffer_size);
 
     if(cdrMessage.length < RTPSMESSAGE_HEADER_SIZE)
         return false;
@@ -211,8 +287,50 @@ bool test_UDPv4Transport::packet_should_drop(const octet* send_buffer, uint32_t
     return false;
 }
 
+bool test_UDPv4Transport::packet_has_user_submessage(
+        const octet* send_buffer,
+        uint32_t send_buffer_size,
+        octet submessage_id)
+{
+    CDRMessage_t cdrMessage(0);
+    WrapMessage(cdrMessage, send_buffer, send_buffer_size);
+
+    if(cdrMessage.length < RTPSMESSAGE_HEADER_SIZE)
+        return false;
+
+    cdrMessage.pos += 4 + 4 + 12; // RTPS + RTPS version + GUID
+
+    SubmessageHeader_t cdrSubMessageHeader;
+    while (cdrMessage.pos < cdrMessage.length)
+    {
+        if (!ReadSubmessageHeader(cdrMessage, cdrSubMessageHeader) ||
+                cdrMessage.pos + cdrSubMessageHeader.submessageLength > cdrMessage.length)
+            return false;
+
+        if (cdrSubMessageHeader.submessageId == submessage_id)
+        {
+            // Get WriterID. Builtin entities have the two most significant bits of their kind set.
+            EntityId_t writer_id;
+            auto old_pos = cdrMessage.pos;
+            // DATA has extra flags and the offset to inline QoS before the reader id
+            cdrMessage.pos += submessage_id == DATA ? 8 : 4;
+            CDRMessage::readEntityId(&cdrMessage, &writer_id);
+            cdrMessage.pos = old_pos;
+
+            if ((writer_id.value[3] & 0xC0) == 0)
+                return true;
+        }
+
+        cdrMessage.pos += cdrSubMessageHeader.submessageLength;
+    }
+
+    return false;
+}
+
 bool test_UDPv4Transport::log_drop(const octet* buffer, uint32_t size)
 {
+    std::lock_guard<std::mutex> lock(s_drop_log_mutex);
+
     if (test_UDPv4Transport_DropLog.size() < test_UDPv4Transport_DropLogLength)
     {
         vector<octet> message;
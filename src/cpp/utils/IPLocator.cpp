@@ -663,7 +663,8 @@ std::string IPLocator::to_string(const Locator_t& loc)
 bool IPLocator::isMulticast(const Locator_t& locator)
 {
     if (locator.kind == LOCATOR_KIND_TCPv4
-            || locator.kind == LOCATOR_KIND_TCPv6)
+            || locator.kind == LOCATOR_KIND_TCPv6
+            || locator.kind == LOCATOR_KIND_SHM)
     {
         return false;
     }
@@ -1777,6 +1777,10 @@ XMLP_ret XMLParser::getXMLWriterTimes(tinyxml2::XMLElement *elem, WriterTimes &t
                 <xs:element name="heartbeatPeriod" type="durationType" minOccurs="0"/>
                 <xs:element name="nackResponseDelay" type="durationType" minOccurs="0"/>
                 <xs:element name="nackSupressionDuration" type="durationType" minOccurs="0"/>
+                <xs:element name="adaptiveHeartbeat" type="boolType" minOccurs="0"/>
+                <xs:element name="heartbeatPeriodMin" type="durationType" minOccurs="0"/>
+                <xs:element name="heartbeatPeriodMax" type="durationType" minOccurs="0"/>
+                <xs:element name="nackAggregationWindow" type="durationType" minOccurs="0"/>
             </xs:all>
         </xs:complexType>
     */
@@ -1809,6 +1813,30 @@ XMLP_ret XMLParser::getXMLWriterTimes(tinyxml2::XMLElement *elem, WriterTimes &t
             if (XMLP_ret::XML_OK != getXMLDuration(p_aux0, times.nackSupressionDuration, ident))
                 return XMLP_ret::XML_ERROR;
         }
+        else if (strcmp(name, ADAPTIVE_HEARTB) == 0)
+        {
+            // adaptiveHeartbeat
+            if (XMLP_ret::XML_OK != getXMLBool(p_aux0, &times.adaptiveHeartbeat, ident))
+                return XMLP_ret::XML_ERROR;
+        }
+        else if (strcmp(name, HEARTB_PERIOD_MIN) == 0)
+        {
+            // heartbeatPeriodMin
+            if (XMLP_ret::XML_OK != getXMLDuration(p_aux0, times.heartbeatPeriodMin, ident))
+                return XMLP_ret::XML_ERROR;
+        }
+        else if (strcmp(name, HEARTB_PERIOD_MAX) == 0)
+        {
+            // heartbeatPeriodMax
+            if (XMLP_ret::XML_OK != getXMLDuration(p_aux0, times.heartbeatPeriodMax, ident))
+                return XMLP_ret::XML_ERROR;
+        }
+        else if (strcmp(name, NACK_AGGREGATION) == 0)
+        {
+            // nackAggregationWindow
+            if (XMLP_ret::XML_OK != getXMLDuration(p_aux0, times.nackAggregationWindow, ident))
+                return XMLP_ret::XML_ERROR;
+        }
         else
         {
             logError(XMLPARSER, "Invalid element found into 'writerTimesType'. Name: " << name);
@@ -248,6 +248,11 @@ XMLP_ret XMLParser::parseXMLTransportData(tinyxml2::XMLElement* p_root)
                 <xs:element name="receiveBufferSize" type="int32Type" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="TTL" type="uint8Type" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="non_blocking_send" type="boolType" minOccurs="0" maxOccurs="1"/>
+                <xs:element name="receive_batch_size" type="uint32Type" minOccurs="0" maxOccurs="1"/>
+                <xs:element name="enable_receive_timestamps" type="boolType" minOccurs="0" maxOccurs="1"/>
+                <xs:element name="receive_socket_count" type="uint32Type" minOccurs="0" maxOccurs="1"/>
+                <xs:element name="steer_by_guid_prefix" type="boolType" minOccurs="0" maxOccurs="1"/>
+                <xs:element name="interface_options" type="interfaceOptionsListType" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="maxMessageSize" type="uint32Type" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="maxInitialPeersRange" type="uint32Type" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="interfaceWhiteList" type="stringListType" minOccurs="0" maxOccurs="1"/>
@@ -263,6 +268,11 @@ XMLP_ret XMLParser::parseXMLTransportData(tinyxml2::XMLElement* p_root)
                 <xs:element name="calculate_crc" type="boolType" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="check_crc" type="boolType" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="enable_tcp_nodelay" type="boolType" minOccurs="0" maxOccurs="1"/>
+                <xs:element name="send_queue_capacity" type="uint32Type" minOccurs="0" maxOccurs="1"/>
+                <xs:element name="send_queue_overflow_policy" type="sendQueueOverflowPolicyType" minOccurs="0" maxOccurs="1"/>
+                <xs:element name="async_receive_threads" type="uint32Type" minOccurs="0" maxOccurs="1"/>
+                <xs:element name="coalescing_max_size" type="uint32Type" minOccurs="0" maxOccurs="1"/>
+                <xs:element name="coalescing_delay_us" type="uint32Type" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="tls" type="tlsConfigType" minOccurs="0" maxOccurs="1"/>
             </xs:all>
         </xs:complexType>
@@ -322,6 +332,50 @@ XMLP_ret XMLParser::parseXMLTransportData(tinyxml2::XMLElement* p_root)
                     return XMLP_ret::XML_ERROR;
                 }
             }
+            // Receive batch size
+            if (nullptr != (p_aux0 = p_root->FirstChildElement(RECEIVE_BATCH_SIZE)))
+            {
+                unsigned int batch_size = 0;
+                if (XMLP_ret::XML_OK != getXMLUint(p_aux0, &batch_size, 0) || batch_size == 0)
+                {
+                    return XMLP_ret::XML_ERROR;
+                }
+                pUDPDesc->receive_batch_size = static_cast<uint32_t>(batch_size);
+            }
+            // Receive timestamps
+            if (nullptr != (p_aux0 = p_root->FirstChildElement(ENABLE_RECEIVE_TIMESTAMPS)))
+            {
+                if (XMLP_ret::XML_OK != getXMLBool(p_aux0, &pUDPDesc->enable_receive_timestamps, 0))
+                {
+                    return XMLP_ret::XML_ERROR;
+                }
+            }
+            // Receive sockets per port
+            if (nullptr != (p_aux0 = p_root->FirstChildElement(RECEIVE_SOCKET_COUNT)))
+            {
+                unsigned int socket_count = 0;
+                if (XMLP_ret::XML_OK != getXMLUint(p_aux0, &socket_count, 0) || socket_count == 0)
+                {
+                    return XMLP_ret::XML_ERROR;
+                }
+                pUDPDesc->receive_socket_count = static_cast<uint32_t>(socket_count);
+            }
+            // GuidPrefix steering
+            if (nullptr != (p_aux0 = p_root->FirstChildElement(STEER_BY_GUID_PREFIX)))
+            {
+                if (XMLP_ret::XML_OK != getXMLBool(p_aux0, &pUDPDesc->steer_by_guid_prefix, 0))
+                {
+                    return XMLP_ret::XML_ERROR;
+                }
+            }
+            // Per interface options
+            if (nullptr != (p_aux0 = p_root->FirstChildElement(INTERFACE_OPTIONS)))
+            {
+                if (XMLP_ret::XML_OK != parseXMLInterfaceOptions(p_aux0, pUDPDesc))
+                {
+                    return XMLP_ret::XML_ERROR;
+                }
+            }
         }
         else if (sType == TCPv4)
         {
@@ -371,6 +425,90 @@ XMLP_ret XMLParser::parseXMLTransportData(tinyxml2::XMLElement* p_root)
     return ret;
 }
 
+XMLP_ret XMLParser::parseXMLInterfaceOptions(
+    tinyxml2::XMLElement* p_root,
+    sp_transport_t udp_transport)
+{
+    /*
+        <xs:complexType name="interfaceOptionsType">
+            <xs:all minOccurs="0">
+                <xs:element name="address" type="stringType"/>
+                <xs:element name="sendBufferSize" type="uint32Type" minOccurs="0" maxOccurs="1"/>
+                <xs:element name="receiveBufferSize" type="uint32Type" minOccurs="0" maxOccurs="1"/>
+                <xs:element name="tos" type="uint8Type" minOccurs="0" maxOccurs="1"/>
+            </xs:all>
+        </xs:complexType>
+
+        <xs:complexType name="interfaceOptionsListType">
+            <xs:sequence>
+                <xs:element name="interface" type="interfaceOptionsType" minOccurs="0" maxOccurs="unbounded"/>
+            </xs:sequence>
+        </xs:complexType>
+    */
+
+    std::shared_ptr<rtps::UDPTransportDescriptor> pUDPDesc =
+        std::dynamic_pointer_cast<rtps::UDPTransportDescriptor>(udp_transport);
+
+    for (tinyxml2::XMLElement* p_aux0 = p_root->FirstChildElement();
+         p_aux0 != nullptr; p_aux0 = p_aux0->NextSiblingElement())
+    {
+        if (strcmp(p_aux0->Name(), INTERFACE) != 0)
+        {
+            logError(XMLPARSER, "Invalid element found into 'interface_options'. Name: " << p_aux0->Name());
+            return XMLP_ret::XML_ERROR;
+        }
+
+        rtps::UDPInterfaceOptions options;
+        const char* name = nullptr;
+        for (tinyxml2::XMLElement* p_aux1 = p_aux0->FirstChildElement();
+             p_aux1 != nullptr; p_aux1 = p_aux1->NextSiblingElement())
+        {
+            name = p_aux1->Name();
+            if (strcmp(name, ADDRESS) == 0)
+            {
+                // address - stringType
+                if (XMLP_ret::XML_OK != getXMLString(p_aux1, &options.address, 0))
+                    return XMLP_ret::XML_ERROR;
+            }
+            else if (strcmp(name, SEND_BUFFER_SIZE) == 0)
+            {
+                // sendBufferSize - uint32Type
+                if (XMLP_ret::XML_OK != getXMLUint(p_aux1, &options.sendBufferSize, 0))
+                    return XMLP_ret::XML_ERROR;
+            }
+            else if (strcmp(name, RECEIVE_BUFFER_SIZE) == 0)
+            {
+                // receiveBufferSize - uint32Type
+                if (XMLP_ret::XML_OK != getXMLUint(p_aux1, &options.receiveBufferSize, 0))
+                    return XMLP_ret::XML_ERROR;
+            }
+            else if (strcmp(name, TOS) == 0)
+            {
+                // tos - uint8Type
+                int iTos = 0;
+                if (XMLP_ret::XML_OK != getXMLInt(p_aux1, &iTos, 0) || iTos < 0 || iTos > 255)
+                    return XMLP_ret::XML_ERROR;
+                options.tos = static_cast<int16_t>(iTos);
+            }
+            else
+            {
+                logError(XMLPARSER, "Invalid element found into 'interface'. Name: " << name);
+                return XMLP_ret::XML_ERROR;
+            }
+        }
+
+        if (options.address.empty())
+        {
+            logError(XMLPARSER, "Not found '" << ADDRESS << "' in 'interface'");
+            return XMLP_ret::XML_ERROR;
+        }
+
+        pUDPDesc->interface_options.push_back(options);
+    }
+
+    return XMLP_ret::XML_OK;
+}
+
 XMLP_ret XMLParser::parseXMLCommonTransportData(tinyxml2::XMLElement* p_root, sp_transport_t p_transport)
 {
     /*
@@ -475,7 +613,12 @@ XMLP_ret XMLParser::parseXMLCommonTransportData(tinyxml2::XMLElement* p_root, sp
             strcmp(name, LOGICAL_PORT_INCREMENT) == 0 || strcmp(name, LISTENING_PORTS) == 0 ||
             strcmp(name, CALCULATE_CRC) == 0 || strcmp(name, CHECK_CRC) == 0 ||
             strcmp(name, ENABLE_TCP_NODELAY) == 0 || strcmp(name, TLS) == 0 ||
-            strcmp(name, NON_BLOCKING_SEND) == 0 )
+            strcmp(name, SEND_QUEUE_CAPACITY) == 0 || strcmp(name, SEND_QUEUE_OVERFLOW_POLICY) == 0 ||
+            strcmp(name, ASYNC_RECEIVE_THREADS) == 0 || strcmp(name, COALESCING_MAX_SIZE) == 0 ||
+            strcmp(name, COALESCING_DELAY_US) == 0 ||
+            strcmp(name, NON_BLOCKING_SEND) == 0 || strcmp(name, RECEIVE_BATCH_SIZE) == 0 ||
+            strcmp(name, ENABLE_RECEIVE_TIMESTAMPS) == 0 || strcmp(name, RECEIVE_SOCKET_COUNT) == 0 ||
+            strcmp(name, STEER_BY_GUID_PREFIX) == 0 || strcmp(name, INTERFACE_OPTIONS) == 0)
         {
             // Parsed outside of this method
         }
@@ -506,6 +649,11 @@ XMLP_ret XMLParser::parseXMLCommonTCPTransportData(tinyxml2::XMLElement* p_root,
                 <xs:element name="calculate_crc" type="boolType" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="check_crc" type="boolType" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="enable_tcp_nodelay" type="boolType" minOccurs="0" maxOccurs="1"/>
+                <xs:element name="send_queue_capacity" type="uint32Type" minOccurs="0" maxOccurs="1"/>
+                <xs:element name="send_queue_overflow_policy" type="sendQueueOverflowPolicyType" minOccurs="0" maxOccurs="1"/>
+                <xs:element name="async_receive_threads" type="uint32Type" minOccurs="0" maxOccurs="1"/>
+                <xs:element name="coalescing_max_size" type="uint32Type" minOccurs="0" maxOccurs="1"/>
+                <xs:element name="coalescing_delay_us" type="uint32Type" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="tls" type="tlsConfigType" minOccurs="0" maxOccurs="1"/>
             </xs:all>
         </xs:complexType>
@@ -597,6 +745,65 @@ XMLP_ret XMLParser::parseXMLCommonTCPTransportData(tinyxml2::XMLElement* p_root,
                     return XMLP_ret::XML_ERROR;
                 }
             }
+            else if (strcmp(name, SEND_QUEUE_CAPACITY) == 0)
+            {
+                // send_queue_capacity - uint32Type
+                if (XMLP_ret::XML_OK != getXMLUint(p_aux0, &pTCPDesc->send_queue_capacity, 0))
+                {
+                    return XMLP_ret::XML_ERROR;
+                }
+            }
+            else if (strcmp(name, SEND_QUEUE_OVERFLOW_POLICY) == 0)
+            {
+                // send_queue_overflow_policy - sendQueueOverflowPolicyType
+                std::string policy;
+                if (XMLP_ret::XML_OK != getXMLString(p_aux0, &policy, 0))
+                {
+                    return XMLP_ret::XML_ERROR;
+                }
+
+                if (policy.compare(SEND_QUEUE_BLOCK) == 0)
+                {
+                    pTCPDesc->send_queue_overflow_policy = rtps::TCPTransportDescriptor::BLOCK;
+                }
+                else if (policy.compare(SEND_QUEUE_DROP_OLDEST) == 0)
+                {
+                    pTCPDesc->send_queue_overflow_policy = rtps::TCPTransportDescriptor::DROP_OLDEST;
+                }
+                else if (policy.compare(SEND_QUEUE_DISCONNECT) == 0)
+                {
+                    pTCPDesc->send_queue_overflow_policy = rtps::TCPTransportDescriptor::DISCONNECT;
+                }
+                else
+                {
+                    logError(XMLPARSER, "Invalid send_queue_overflow_policy: " << policy);
+                    return XMLP_ret::XML_ERROR;
+                }
+            }
+            else if (strcmp(name, ASYNC_RECEIVE_THREADS) == 0)
+            {
+                // async_receive_threads - uint32Type
+                if (XMLP_ret::XML_OK != getXMLUint(p_aux0, &pTCPDesc->async_receive_threads, 0))
+                {
+                    return XMLP_ret::XML_ERROR;
+                }
+            }
+            else if (strcmp(name, COALESCING_MAX_SIZE) == 0)
+            {
+                // coalescing_max_size - uint32Type
+                if (XMLP_ret::XML_OK != getXMLUint(p_aux0, &pTCPDesc->coalescing_max_size, 0))
+                {
+                    return XMLP_ret::XML_ERROR;
+                }
+            }
+            else if (strcmp(name, COALESCING_DELAY_US) == 0)
+            {
+                // coalescing_delay_us - uint32Type
+                if (XMLP_ret::XML_OK != getXMLUint(p_aux0, &pTCPDesc->coalescing_delay_us, 0))
+                {
+                    return XMLP_ret::XML_ERROR;
+                }
+            }
             else if (strcmp(name, TLS) == 0)
             {
                 if (XMLP_ret::XML_OK != parse_tls_config(p_aux0, p_transport))
@@ -2618,6 +2825,8 @@ XMLP_ret XMLParser::fillDataNode(tinyxml2::XMLElement* p_profile, DataNode<Parti
                 <xs:element name="defaultMulticastLocatorList" type="locatorListType" minOccurs="0"/>
                 <xs:element name="sendSocketBufferSize" type="uint32Type" minOccurs="0"/>
                 <xs:element name="listenSocketBufferSize" type="uint32Type" minOccurs="0"/>
+                <xs:element name="receiveWorkerThreads" type="uint32Type" minOccurs="0"/>
+                <xs:element name="sendQueueSize" type="uint32Type" minOccurs="0"/>
                 <xs:element name="builtin" type="builtinAttributesType" minOccurs="0"/>
                 <xs:element name="port" type="portType" minOccurs="0"/>
                 <xs:element name="userData" type="octetVectorType" minOccurs="0"/>
@@ -2686,6 +2895,18 @@ XMLP_ret XMLParser::fillDataNode(tinyxml2::XMLElement* p_profile, DataNode<Parti
             if (XMLP_ret::XML_OK != getXMLUint(p_aux0, &participant_node.get()->rtps.listenSocketBufferSize, ident))
                 return XMLP_ret::XML_ERROR;
         }
+        else if (strcmp(name, RECV_WORKER_THREADS) == 0)
+        {
+            // receiveWorkerThreads - uint32Type
+            if (XMLP_ret::XML_OK != getXMLUint(p_aux0, &participant_node.get()->rtps.receiveWorkerThreads, ident))
+                return XMLP_ret::XML_ERROR;
+        }
+        else if (strcmp(name, SEND_QUEUE_SIZE) == 0)
+        {
+            // sendQueueSize - uint32Type
+            if (XMLP_ret::XML_OK != getXMLUint(p_aux0, &participant_node.get()->rtps.sendQueueSize, ident))
+                return XMLP_ret::XML_ERROR;
+        }
         else if (strcmp(name, BUILTIN) == 0)
         {
             // builtin
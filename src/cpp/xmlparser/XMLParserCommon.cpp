@@ -41,6 +41,13 @@ const char* RECEIVE_BUFFER_SIZE = "receiveBufferSize";
 const char* SEND_BUFFER_SIZE = "sendBufferSize";
 const char* TTL = "TTL";
 const char* NON_BLOCKING_SEND = "non_blocking_send";
+const char* RECEIVE_BATCH_SIZE = "receive_batch_size";
+const char* ENABLE_RECEIVE_TIMESTAMPS = "enable_receive_timestamps";
+const char* RECEIVE_SOCKET_COUNT = "receive_socket_count";
+const char* STEER_BY_GUID_PREFIX = "steer_by_guid_prefix";
+const char* INTERFACE_OPTIONS = "interface_options";
+const char* INTERFACE = "interface";
+const char* TOS = "tos";
 const char* WHITE_LIST = "interfaceWhiteList";
 const char* MAX_MESSAGE_SIZE = "maxMessageSize";
 const char* MAX_INITIAL_PEERS_RANGE = "maxInitialPeersRange";
@@ -54,6 +61,14 @@ const char* METADATA_LOGICAL_PORT = "metadata_logical_port";
 const char* LISTENING_PORTS = "listening_ports";
 const char* CALCULATE_CRC = "calculate_crc";
 const char* CHECK_CRC = "check_crc";
+const char* SEND_QUEUE_CAPACITY = "send_queue_capacity";
+const char* SEND_QUEUE_OVERFLOW_POLICY = "send_queue_overflow_policy";
+const char* SEND_QUEUE_BLOCK = "BLOCK";
+const char* SEND_QUEUE_DROP_OLDEST = "DROP_OLDEST";
+const char* SEND_QUEUE_DISCONNECT = "DISCONNECT";
+const char* ASYNC_RECEIVE_THREADS = "async_receive_threads";
+const char* COALESCING_MAX_SIZE = "coalescing_max_size";
+const char* COALESCING_DELAY_US = "coalescing_delay_us";
 
 const char* QOS_PROFILE = "qos_profile";
 const char* APPLICATION = "application";
@@ -68,6 +83,8 @@ const char* DEF_UNI_LOC_LIST = "defaultUnicastLocatorList";
 const char* DEF_MULTI_LOC_LIST = "defaultMulticastLocatorList";
 const char* SEND_SOCK_BUF_SIZE = "sendSocketBufferSize";
 const char* LIST_SOCK_BUF_SIZE = "listenSocketBufferSize";
+const char* RECV_WORKER_THREADS = "receiveWorkerThreads";
+const char* SEND_QUEUE_SIZE = "sendQueueSize";
 const char* BUILTIN = "builtin";
 const char* PORT = "port";
 const char* PORTS = "ports_";
@@ -125,6 +142,10 @@ const char* INIT_HEARTB_DELAY = "initialHeartbeatDelay";
 const char* HEARTB_PERIOD = "heartbeatPeriod";
 const char* NACK_RESP_DELAY = "nackResponseDelay";
 const char* NACK_SUPRESSION = "nackSupressionDuration";
+const char* ADAPTIVE_HEARTB = "adaptiveHeartbeat";
+const char* HEARTB_PERIOD_MIN = "heartbeatPeriodMin";
+const char* HEARTB_PERIOD_MAX = "heartbeatPeriodMax";
+const char* NACK_AGGREGATION = "nackAggregationWindow";
 const char* BY_NAME = "durationbyname";
 const char* BY_VAL = "durationbyval";
 const char* DURATION_INFINITY = "DURATION_INFINITY";
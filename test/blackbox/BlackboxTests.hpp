@@ -132,4 +132,11 @@ void print_non_received_messages(const std::list<T>& data, const std::function<v
 }
 /***** End auxiliary lambda function *****/
 
+/****** Heap allocations counting ******/
+//! Starts counting the heap allocations made by any thread of the process.
+void start_counting_allocations();
+
+//! Stops counting heap allocations and returns the number made since start_counting_allocations().
+size_t stop_counting_allocations();
+
 #endif // __BLACKBOX_BLACKBOXTESTS_HPP__
@@ -156,3 +156,84 @@ TEST(AcknackQos, NotRecoverAfterLosingCommunicationWithDisablePositiveAck)
     // Block reader until reception finished or timeout.
     ASSERT_EQ(reader.block_for_all(std::chrono::seconds(1)), 0u);
 }
+
+TEST(AcknackQos, AdaptiveHeartbeatBacksOffWhenReaderDoesNotAnswer)
+{
+    PubSubReader<HelloWorldType> reader(TEST_TOPIC_NAME);
+    PubSubWriter<HelloWorldType> writer(TEST_TOPIC_NAME);
+
+    // The reader receives the data but its acknacks never reach the writer
+    auto readerTransport = std::make_shared<test_UDPv4TransportDescriptor>();
+    readerTransport->dropAckNackMessagesPercentage = 100;
+
+    reader.reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS);
+    reader.disable_builtin_transport();
+    reader.add_user_transport_to_pparams(readerTransport);
+    reader.init();
+
+    auto writerTransport = std::make_shared<test_UDPv4TransportDescriptor>();
+
+    writer.adaptive_heartbeat({0, 10 * 1000 * 1000}, {0, 500 * 1000 * 1000});
+    writer.disable_builtin_transport();
+    writer.add_user_transport_to_pparams(writerTransport);
+    writer.init();
+
+    ASSERT_TRUE(reader.isInitialized());
+    ASSERT_TRUE(writer.isInitialized());
+
+    // Wait for discovery.
+    writer.wait_discovery();
+    reader.wait_discovery();
+
+    std::list<HelloWorld> data = default_helloworld_data_generator(1);
+    reader.startReception(data);
+    writer.send(data);
+    ASSERT_TRUE(data.empty());
+    reader.block_for_all();
+
+    // Let the period reach its upper bound
+    std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+
+    test_UDPv4Transport::test_UDPv4Transport_UserHeartbeatsSent = 0u;
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+
+    // At the lower bound there would be around 200 heartbeats
+    EXPECT_LE(test_UDPv4Transport::test_UDPv4Transport_UserHeartbeatsSent.load(), 10u);
+}
+
+TEST(AcknackQos, AdaptiveHeartbeatStaysShortWhileReaderRequestsRepairs)
+{
+    PubSubReader<HelloWorldType> reader(TEST_TOPIC_NAME);
+    PubSubWriter<HelloWorldType> writer(TEST_TOPIC_NAME);
+
+    reader.reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS);
+    reader.init();
+
+    // User data never reaches the reader, which keeps requesting it
+    auto writerTransport = std::make_shared<test_UDPv4TransportDescriptor>();
+    writerTransport->dropDataMessagesPercentage = 100;
+
+    writer.adaptive_heartbeat({0, 10 * 1000 * 1000}, {0, 500 * 1000 * 1000});
+    writer.disable_builtin_transport();
+    writer.add_user_transport_to_pparams(writerTransport);
+    writer.init();
+
+    ASSERT_TRUE(reader.isInitialized());
+    ASSERT_TRUE(writer.isInitialized());
+
+    // Wait for discovery.
+    writer.wait_discovery();
+    reader.wait_discovery();
+
+    std::list<HelloWorld> data = default_helloworld_data_generator(1);
+    writer.send(data);
+    ASSERT_TRUE(data.empty());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+
+    test_UDPv4Transport::test_UDPv4Transport_UserHeartbeatsSent = 0u;
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+
+    // Backing off would send around 4 heartbeats
+    EXPECT_GE(test_UDPv4Transport::test_UDPv4Transport_UserHeartbeatsSent.load(), 20u);
+}
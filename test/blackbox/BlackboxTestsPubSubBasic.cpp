@@ -111,6 +111,85 @@ TEST(BlackBox, PubSubAsReliableHelloworld)
     reader.block_for_all();
 }
 
+TEST(BlackBox, PubSubAsReliableHelloworldReceiveWorkers)
+{
+    PubSubReader<HelloWorldType> reader(TEST_TOPIC_NAME);
+    PubSubWriter<HelloWorldType> writer(TEST_TOPIC_NAME);
+
+    reader.history_depth(100).
+        receive_worker_threads(4).
+        reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS).init();
+
+    ASSERT_TRUE(reader.isInitialized());
+
+    writer.history_depth(100).init();
+
+    ASSERT_TRUE(writer.isInitialized());
+
+    // Wait for discovery.
+    writer.wait_discovery();
+    reader.wait_discovery();
+
+    auto data = default_helloworld_data_generator();
+
+    reader.startReception(data);
+
+    // Send data
+    writer.send(data);
+    // In this test all data should be sent.
+    ASSERT_TRUE(data.empty());
+    // Block reader until reception finished or timeout. Samples are checked to arrive in order.
+    reader.block_for_all();
+}
+
+TEST(BlackBox, PubSubAsReliableLoanedSamples)
+{
+    PubSubReader<FixedSizedType> reader(TEST_TOPIC_NAME);
+    PubSubWriter<FixedSizedType> writer(TEST_TOPIC_NAME);
+
+    reader.history_depth(100).
+        take_loans(true).
+        reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS).init();
+
+    ASSERT_TRUE(reader.isInitialized());
+
+    writer.history_depth(100).init();
+
+    ASSERT_TRUE(writer.isInitialized());
+
+    // Wait for discovery.
+    writer.wait_discovery();
+    reader.wait_discovery();
+
+    // A discarded loan is not sent.
+    void* sample = writer.loan_sample();
+    ASSERT_NE(sample, nullptr);
+    ASSERT_TRUE(writer.discard_loan(sample));
+    ASSERT_FALSE(writer.discard_loan(sample));
+
+    auto data = default_fixed_sized_data_generator();
+
+    reader.startReception(data);
+
+    // Send data
+    writer.send_loaned(data);
+    // In this test all data should be sent.
+    ASSERT_TRUE(data.empty());
+    // Block reader until reception finished or timeout.
+    reader.block_for_all();
+}
+
+TEST(BlackBox, PubSubLoanNotAllowedForNonPlainTypes)
+{
+    PubSubWriter<HelloWorldType> writer(TEST_TOPIC_NAME);
+
+    writer.init();
+
+    ASSERT_TRUE(writer.isInitialized());
+
+    ASSERT_EQ(writer.loan_sample(), nullptr);
+}
+
 TEST(BlackBox, AsyncPubSubAsReliableHelloworld)
 {
     PubSubReader<HelloWorldType> reader(TEST_TOPIC_NAME);
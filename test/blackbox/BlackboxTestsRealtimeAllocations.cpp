@@ -17,6 +17,8 @@
 #include "PubSubReader.hpp"
 #include "PubSubWriter.hpp"
 
+#include <fastrtps/transport/test_UDPv4Transport.h>
+
 using namespace eprosima::fastrtps;
 using namespace eprosima::fastrtps::rtps;
 
@@ -227,3 +229,58 @@ TEST(BlackBox, AsyncPubSubBestEffortWithLimitedSubscribers)
     // Second reader should not receive data
     ASSERT_EQ(reader2.getReceivedCount(), 0u);
 }
+
+TEST(BlackBox, PubSubReliableWithLossyTransport)
+{
+    PubSubReader<FixedSizedType> reader(TEST_TOPIC_NAME);
+    PubSubWriter<FixedSizedType> writer(TEST_TOPIC_NAME);
+
+    // Lost samples are recovered through acknacks
+    auto testTransport = std::make_shared<test_UDPv4TransportDescriptor>();
+    testTransport->dropDataMessagesPercentage = 30;
+
+    reader
+        .history_depth(10)
+        .resource_limits_max_samples(10).resource_limits_allocated_samples(10)
+        .reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS)
+        .init();
+
+    ASSERT_TRUE(reader.isInitialized());
+
+    writer
+        .history_depth(10)
+        .resource_limits_max_samples(10).resource_limits_allocated_samples(10)
+        .matched_readers_allocation(1u, 1u)
+        .disable_builtin_transport()
+        .add_user_transport_to_pparams(testTransport)
+        .expect_no_allocs()
+        .init();
+
+    ASSERT_TRUE(writer.isInitialized());
+
+    // Wait for discovery.
+    writer.wait_discovery();
+    reader.wait_discovery();
+
+    // First samples and their repairs reserve what the steady state needs.
+    auto data = default_fixed_sized_data_generator();
+    reader.startReception(data);
+
+    // Send data
+    writer.send(data);
+    // In this test all data should be sent.
+    ASSERT_TRUE(data.empty());
+    // Block reader until reception finished or timeout.
+    reader.block_for_all();
+
+    // Lost samples are repaired without allocating.
+    data = default_fixed_sized_data_generator();
+    reader.startReception(data);
+
+    writer.start_no_allocs_period();
+    writer.send(data);
+    reader.block_for_all();
+    writer.end_no_allocs_period();
+
+    ASSERT_TRUE(data.empty());
+}
@@ -18,6 +18,7 @@
 #include "PubSubWriter.hpp"
 
 #include <fastrtps/transport/UDPv4Transport.h>
+#include <fastrtps/transport/test_UDPv4Transport.h>
 
 using namespace eprosima::fastrtps;
 using namespace eprosima::fastrtps::rtps;
@@ -270,3 +271,69 @@ TEST(BlackBox, whitelisting_udp_localhost_alone)
     }
 }
 
+
+// Repairs for readers sharing a multicast locator are sent once through it, even when their ACKNACKs arrive apart.
+TEST(BlackBox, UDPNackAggregationRepairsThroughMulticast)
+{
+    PubSubWriter<HelloWorldType> writer(TEST_TOPIC_NAME);
+    PubSubReader<HelloWorldType> reader1(TEST_TOPIC_NAME);
+    PubSubReader<HelloWorldType> reader2(TEST_TOPIC_NAME);
+    std::string ip("239.255.1.4");
+
+    auto testTransport = std::make_shared<test_UDPv4TransportDescriptor>();
+
+    writer.history_kind(eprosima::fastrtps::KEEP_ALL_HISTORY_QOS).
+        reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS).
+        heartbeat_period_seconds(0).heartbeat_period_nanosec(100000000).
+        nack_aggregation_window({0, 300000000}).
+        disable_builtin_transport().add_user_transport_to_pparams(testTransport).init();
+
+    ASSERT_TRUE(writer.isInitialized());
+
+    reader1.history_kind(eprosima::fastrtps::KEEP_ALL_HISTORY_QOS).
+        reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS).
+        add_to_multicast_locator_list(ip, global_port).init();
+
+    ASSERT_TRUE(reader1.isInitialized());
+
+    // Second reader answers heartbeats ~100ms later
+    reader2.history_kind(eprosima::fastrtps::KEEP_ALL_HISTORY_QOS).
+        reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS).
+        heartbeatResponseDelay(0, 429496730).
+        add_to_multicast_locator_list(ip, global_port).init();
+
+    ASSERT_TRUE(reader2.isInitialized());
+
+    reader1.wait_discovery();
+    reader2.wait_discovery();
+
+    // Both readers receiving a first batch means the writer matched both
+    auto data = default_helloworld_data_generator(10);
+    reader1.startReception(data);
+    reader2.startReception(data);
+    writer.send(data);
+    ASSERT_TRUE(data.empty());
+    reader1.block_for_all();
+    reader2.block_for_all();
+
+    // Second batch is lost by both readers
+    test_UDPv4Transport::test_UDPv4Transport_ShutdownAllNetwork = true;
+
+    data = default_helloworld_data_generator(10);
+    reader1.startReception(data);
+    reader2.startReception(data);
+    writer.send(data);
+    ASSERT_TRUE(data.empty());
+
+    test_UDPv4Transport::test_UDPv4Transport_UnicastUserDataSent = 0u;
+    test_UDPv4Transport::test_UDPv4Transport_MulticastUserDataSent = 0u;
+    test_UDPv4Transport::test_UDPv4Transport_ShutdownAllNetwork = false;
+
+    reader1.block_for_all();
+    reader2.block_for_all();
+
+    // Repairs only went through the multicast locator, and each lost sample was sent at most once
+    EXPECT_EQ(test_UDPv4Transport::test_UDPv4Transport_UnicastUserDataSent.load(), 0u);
+    EXPECT_GT(test_UDPv4Transport::test_UDPv4Transport_MulticastUserDataSent.load(), 0u);
+    EXPECT_LE(test_UDPv4Transport::test_UDPv4Transport_MulticastUserDataSent.load(), 10u);
+}
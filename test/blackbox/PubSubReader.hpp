@@ -203,6 +203,7 @@ public:
         , matched_(0)
         , participant_matched_(0)
         , receiving_(false)
+        , take_loans_(false)
         , current_received_count_(0)
         , number_samples_expected_(0)
         , discovery_result_(false)
@@ -659,6 +660,24 @@ public:
         return *this;
     }
 
+    PubSubReader& take_loans(bool take_loans)
+    {
+        take_loans_ = take_loans;
+        return *this;
+    }
+
+    PubSubReader& send_queue_size(uint32_t bytes)
+    {
+        participant_attr_.rtps.sendQueueSize = bytes;
+        return *this;
+    }
+
+    PubSubReader& receive_worker_threads(uint32_t threads)
+    {
+        participant_attr_.rtps.receiveWorkerThreads = threads;
+        return *this;
+    }
+
     PubSubReader& lease_duration(
             eprosima::fastrtps::Duration_t lease_duration,
             eprosima::fastrtps::Duration_t announce_period)
@@ -816,8 +835,27 @@ private:
         returnedValue = false;
         type data;
         eprosima::fastrtps::SampleInfo_t info;
+        bool taken = false;
+
+        if(take_loans_)
+        {
+            const void* sample = nullptr;
+            if(subscriber->take_loan(sample, &info))
+            {
+                if(info.sampleKind == eprosima::fastrtps::rtps::ALIVE)
+                {
+                    data = *static_cast<const type*>(sample);
+                }
+                ASSERT_TRUE(subscriber->return_loan(sample));
+                taken = true;
+            }
+        }
+        else
+        {
+            taken = subscriber->takeNextData((void*)&data, &info);
+        }
 
-        if(subscriber->takeNextData((void*)&data, &info))
+        if(taken)
         {
             returnedValue = true;
 
@@ -902,6 +940,7 @@ private:
     std::atomic<unsigned int> matched_;
     unsigned int participant_matched_;
     std::atomic<bool> receiving_;
+    bool take_loans_;
     type_support type_;
     eprosima::fastrtps::rtps::SequenceNumber_t last_seq;
     size_t current_received_count_;
@@ -212,6 +212,7 @@ class PubSubWriter
         , participant_matched_(0)
         , discovery_result_(false)
         , onDiscovery_(nullptr)
+        , expect_no_allocs_(false)
 #if HAVE_SECURITY
     , authorized_(0), unauthorized_(0)
 #endif
@@ -308,6 +309,37 @@ class PubSubWriter
         return publisher_->write((void*)&msg);
     }
 
+    void send_loaned(std::list<type>& msgs)
+    {
+        auto it = msgs.begin();
+
+        while(it != msgs.end())
+        {
+            void* sample = publisher_->loan_sample();
+            if(sample == nullptr)
+                break;
+
+            new (sample) type(*it);
+            if(publisher_->write_loaned(sample))
+            {
+                default_send_print<type>(*it);
+                it = msgs.erase(it);
+            }
+            else
+                break;
+        }
+    }
+
+    void* loan_sample()
+    {
+        return publisher_->loan_sample();
+    }
+
+    bool discard_loan(void* sample)
+    {
+        return publisher_->discard_loan(sample);
+    }
+
     void assert_liveliness()
     {
         publisher_->assert_liveliness();
@@ -385,6 +417,24 @@ class PubSubWriter
                 return publisher_->wait_for_all_acked(eprosima::fastrtps::Time_t((int32_t)max_wait.count(), 0));
             }
 
+    //! Starts a period in which the process should not allocate, if expect_no_allocs() was requested.
+    void start_no_allocs_period()
+    {
+        if (expect_no_allocs_)
+        {
+            start_counting_allocations();
+        }
+    }
+
+    //! Ends the period started by start_no_allocs_period(), failing if there were allocations during it.
+    void end_no_allocs_period()
+    {
+        if (expect_no_allocs_)
+        {
+            EXPECT_EQ(0u, stop_counting_allocations());
+        }
+    }
+
     void block_until_discover_topic(const std::string& topicName, int repeatedTimes)
     {
         std::unique_lock<std::mutex> lock(mutexEntitiesInfoList_);
@@ -466,6 +516,12 @@ class PubSubWriter
         return *this;
     }
 
+    PubSubWriter& send_queue_size(uint32_t bytes)
+    {
+        participant_attr_.rtps.sendQueueSize = bytes;
+        return *this;
+    }
+
     PubSubWriter& add_throughput_controller_descriptor_to_pparams(uint32_t bytesPerPeriod, uint32_t periodInMs)
     {
         eprosima::fastrtps::rtps::ThroughputControllerDescriptor descriptor {bytesPerPeriod, periodInMs};
@@ -537,7 +593,7 @@ class PubSubWriter
 
     PubSubWriter& expect_no_allocs()
     {
-        // TODO(Mcc): Add no allocations check code when feature is completely ready
+        expect_no_allocs_ = true;
         return *this;
     }
 
@@ -553,6 +609,22 @@ class PubSubWriter
         return *this;
     }
 
+    PubSubWriter& adaptive_heartbeat(
+            const eprosima::fastrtps::Duration_t min_period,
+            const eprosima::fastrtps::Duration_t max_period)
+    {
+        publisher_attr_.times.adaptiveHeartbeat = true;
+        publisher_attr_.times.heartbeatPeriodMin = min_period;
+        publisher_attr_.times.heartbeatPeriodMax = max_period;
+        return *this;
+    }
+
+    PubSubWriter& nack_aggregation_window(const eprosima::fastrtps::Duration_t window)
+    {
+        publisher_attr_.times.nackAggregationWindow = window;
+        return *this;
+    }
+
     PubSubWriter& unicastLocatorList(eprosima::fastrtps::rtps::LocatorList_t unicastLocators)
     {
         publisher_attr_.unicastLocatorList = unicastLocators;
@@ -1035,6 +1107,8 @@ void change_reader_info(const eprosima::fastrtps::rtps::ReaderProxyData& reader_
 
     std::function<bool(const eprosima::fastrtps::rtps::ParticipantDiscoveryInfo& info)> onDiscovery_;
 
+    bool expect_no_allocs_;
+
 #if HAVE_SECURITY
     std::mutex mutexAuthentication_;
     std::condition_variable cvAuthentication_;
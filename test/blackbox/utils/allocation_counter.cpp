@@ -0,0 +1,65 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../BlackboxTests.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Counts the heap allocations made by any thread while counting is enabled
+static std::atomic<bool> g_count_allocations(false);
+static std::atomic<size_t> g_allocations(0);
+
+void* operator new(size_t size)
+{
+    if (g_count_allocations)
+    {
+        ++g_allocations;
+    }
+
+    void* ptr = std::malloc(size != 0 ? size : 1);
+    if (ptr == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    operator delete(ptr);
+}
+
+void start_counting_allocations()
+{
+    g_allocations = 0;
+    g_count_allocations = true;
+}
+
+size_t stop_counting_allocations()
+{
+    g_count_allocations = false;
+    return g_allocations;
+}
@@ -66,7 +66,7 @@ public:
     bool checkReaders(EntityId_t) { return false; }
 protected:
     ReceiverResource(TransportInterface& transport,
-        const Locator_t& locator, uint32_t maxMsgSize)
+        const Locator_t& locator, uint32_t maxMsgSize, uint32_t = 0)
         : mValid(false)
         , m_maxMsgSize(maxMsgSize)
     {
@@ -50,6 +50,8 @@ class StatefulWriter : public RTPSWriter
 
         SequenceNumber_t get_seq_num_min() { return SequenceNumber_t(0, 0); }
 
+        WriterHistory* history() { return mp_history; }
+
     private:
 
         friend class ReaderProxy;
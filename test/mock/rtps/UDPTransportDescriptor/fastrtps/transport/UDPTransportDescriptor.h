@@ -17,12 +17,26 @@
 
 #include <fastrtps/transport/SocketTransportDescriptor.h>
 
+#include <string>
+#include <vector>
+
 namespace eprosima{
 namespace fastrtps{
 namespace rtps{
 
 class TransportInterface;
 
+typedef struct UDPInterfaceOptions
+{
+   std::string address;
+
+   uint32_t sendBufferSize = 0;
+
+   uint32_t receiveBufferSize = 0;
+
+   int16_t tos = -1;
+} UDPInterfaceOptions;
+
 /**
  * Transport configuration
  *
@@ -54,6 +68,16 @@ typedef struct UDPTransportDescriptor: public SocketTransportDescriptor
    uint16_t m_output_udp_socket;
    
    bool non_blocking_send = false;
+
+   uint32_t receive_batch_size = 1;
+
+   bool enable_receive_timestamps = false;
+
+   uint32_t receive_socket_count = 1;
+
+   bool steer_by_guid_prefix = false;
+
+   std::vector<UDPInterfaceOptions> interface_options;
 } UDPTransportDescriptor;
 
 } // namespace rtps
@@ -77,8 +77,14 @@ class WriterHistory
             }
         }
 
+        std::vector<CacheChange_t*>::iterator changesBegin() { return m_changes.begin(); }
+
+        std::vector<CacheChange_t*>::iterator changesEnd() { return m_changes.end(); }
+
         HistoryAttributes m_att;
 
+        std::vector<CacheChange_t*> m_changes;
+
     private:
 
         std::condition_variable samples_number_cond_;
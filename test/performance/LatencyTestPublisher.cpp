@@ -530,6 +530,7 @@ void LatencyTestPublisher::DataSubListener::onNewDataMessage(Subscriber* subscri
         {
             mp_up->t_end_ = std::chrono::steady_clock::now();
             mp_up->times_.push_back(std::chrono::duration<double, std::micro>(mp_up->t_end_ - mp_up->t_start_) - mp_up->t_overhead_);
+            mp_up->addWireTime(mp_up->m_sampleinfo);
             mp_up->n_received++;
 
             // Reset seqnum from out data
@@ -551,6 +552,7 @@ void LatencyTestPublisher::DataSubListener::onNewDataMessage(Subscriber* subscri
         {
             mp_up->t_end_ = std::chrono::steady_clock::now();
             mp_up->times_.push_back(std::chrono::duration<double, std::micro>(mp_up->t_end_ - mp_up->t_start_) - mp_up->t_overhead_);
+            mp_up->addWireTime(mp_up->m_sampleinfo);
             mp_up->n_received++;
 
             // Reset seqnum from out data
@@ -580,8 +582,11 @@ void LatencyTestPublisher::run()
 
     cout << C_B_MAGENTA << "DISCOVERY COMPLETE "<<C_DEF<<endl;
     printf("Printing round-trip times in us, statistics for %d samples\n",n_samples);
-    printf("   Bytes, Samples,   stdev,    mean,     min,     50%%,     90%%,     99%%,  99.99%%,     max\n");
-    printf("--------,--------,--------,--------,--------,--------,--------,--------,--------,--------,\n");
+    printf("Wire times go from the socket to the listener and need UDP receive timestamps enabled\n");
+    printf("   Bytes, Samples,   stdev,    mean,     min,     50%%,     90%%,     99%%,  99.99%%,     max,"
+        " wiremean, wiremax\n");
+    printf("--------,--------,--------,--------,--------,--------,--------,--------,--------,--------,"
+        "---------,--------,\n");
 
     for(std::vector<uint32_t>::iterator ndata = data_size_pub.begin(); ndata != data_size_pub.end(); ++ndata)
     {
@@ -689,6 +694,7 @@ bool LatencyTestPublisher::test(uint32_t datasize)
     }
 
     times_.clear();
+    wire_times_.clear();
     TestCommandType command;
     command.m_command = READY;
     mp_commandpub->write(&command);
@@ -754,6 +760,19 @@ bool LatencyTestPublisher::test(uint32_t datasize)
     return true;
 }
 
+void LatencyTestPublisher::addWireTime(const SampleInfo_t& info)
+{
+    // Only available when the transport timestamps the received datagrams
+    if (info.receptionTimestamp == c_TimeZero)
+    {
+        return;
+    }
+
+    int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    wire_times_.push_back(std::chrono::nanoseconds(now - info.receptionTimestamp.to_ns()));
+}
+
 void LatencyTestPublisher::analyzeTimes(uint32_t datasize)
 {
     TimeStats TS;
@@ -814,6 +833,13 @@ void LatencyTestPublisher::analyzeTimes(uint32_t datasize)
         TS.p9999 = NAN;
     }
 
+    if (!wire_times_.empty())
+    {
+        TS.wire_mean = std::accumulate(wire_times_.begin(), wire_times_.end(),
+            std::chrono::duration<double, std::micro>(0)).count() / wire_times_.size();
+        TS.wire_max = std::max_element(wire_times_.begin(), wire_times_.end())->count();
+    }
+
     m_stats.push_back(TS);
 }
 
@@ -868,16 +894,16 @@ void LatencyTestPublisher::printStat(TimeStats& TS)
     }
 
 #ifdef _WIN32
-    printf("%8I64u,%8u,%8.2f,%8.2f,%8.2f,%8.2f,%8.2f,%8.2f,%8.2f,%8.2f \n",
+    printf("%8I64u,%8u,%8.2f,%8.2f,%8.2f,%8.2f,%8.2f,%8.2f,%8.2f,%8.2f,%9.2f,%8.2f \n",
         TS.nbytes, TS.received, TS.stdev, TS.mean,
         TS.m_min.count(),
         TS.p50, TS.p90, TS.p99, TS.p9999,
-        TS.m_max.count());
+        TS.m_max.count(), TS.wire_mean, TS.wire_max);
 #else
-    printf("%8" PRIu64 ",%8u,%8.2f,%8.2f,%8.2f,%8.2f,%8.2f,%8.2f,%8.2f,%8.2f \n",
+    printf("%8" PRIu64 ",%8u,%8.2f,%8.2f,%8.2f,%8.2f,%8.2f,%8.2f,%8.2f,%8.2f,%9.2f,%8.2f \n",
         TS.nbytes, TS.received, TS.stdev, TS.mean,
         TS.m_min.count(),
         TS.p50, TS.p90, TS.p99, TS.p9999,
-        TS.m_max.count());
+        TS.m_max.count(), TS.wire_mean, TS.wire_max);
 #endif
 }
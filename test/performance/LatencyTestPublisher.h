@@ -39,12 +39,15 @@
 
 class TimeStats{
 public:
-    TimeStats() :nbytes(0), received(0), m_min(0), m_max(0), p50(0), p90(0), p99(0), p9999(0), mean(0), stdev(0){}
+    TimeStats() :nbytes(0), received(0), m_min(0), m_max(0), p50(0), p90(0), p99(0), p9999(0), mean(0), stdev(0),
+        wire_mean(0), wire_max(0){}
     ~TimeStats(){}
     uint64_t nbytes;
     unsigned int received;
     std::chrono::duration<double, std::micro>  m_min, m_max;
     double p50, p90, p99, p9999, mean, stdev;
+    //! Time from the reception of the echo on the socket to the listener.
+    double wire_mean, wire_max;
 };
 
 class LatencyTestPublisher {
@@ -64,6 +67,7 @@ public:
     unsigned int n_samples;
     eprosima::fastrtps::SampleInfo_t m_sampleinfo;
     std::vector<std::chrono::duration<double, std::micro>> times_;
+    std::vector<std::chrono::duration<double, std::micro>> wire_times_;
     std::vector<TimeStats> m_stats;
     std::mutex mutex_;
     int disc_count_;
@@ -83,6 +87,7 @@ public:
         const std::string& sXMLConfigFile, bool dynamic_types, int forced_domain);
     void run();
     void analyzeTimes(uint32_t datasize);
+    void addWireTime(const eprosima::fastrtps::SampleInfo_t& info);
     bool test(uint32_t datasize);
     void printStat(TimeStats& TS);
 
@@ -30,9 +30,11 @@
 #include <fastrtps/subscriber/SampleInfo.h>
 
 #include <fastrtps/Domain.h>
+#include <fastrtps/rtps/network/MessageCompression.h>
 
 #include <map>
 #include <fstream>
+#include <ctime>
 
 using namespace eprosima::fastrtps;
 using namespace eprosima::fastrtps::rtps;
@@ -113,6 +115,7 @@ ThroughputPublisher::ThroughputPublisher(bool reliable, uint32_t pid, bool hostn
     m_CommandSubListener(*this),
     m_CommandPubListener(*this),
     ready(true),
+    m_report_compression(false),
     m_export_csv(export_csv),
     reliable_(reliable),
     m_sXMLConfigFile(sXMLConfigFile),
@@ -444,6 +447,8 @@ bool ThroughputPublisher::test(uint32_t test_time, uint32_t recovery_time_ms, ui
     data_disc_lock.unlock();
     //std::cout << "Discovery data complete" << std::endl;
 
+    MessageCompression::Statistics compression_start = MessageCompression::statistics();
+    std::clock_t cpu_start = std::clock();
     t_start_ = std::chrono::steady_clock::now();
     while (std::chrono::duration<double, std::micro>(t_end_ - t_start_) < test_time_us)
     {
@@ -467,6 +472,8 @@ bool ThroughputPublisher::test(uint32_t test_time, uint32_t recovery_time_ms, ui
         eClock::my_sleep(recovery_time_ms);
         timewait_us += t_overhead_;
     }
+    std::clock_t cpu_end = std::clock();
+    MessageCompression::Statistics compression_end = MessageCompression::statistics();
     command.m_command = TEST_ENDS;
 
     //cout << "SEND COMMAND "<< command.m_command << endl;
@@ -540,6 +547,16 @@ bool ThroughputPublisher::test(uint32_t test_time, uint32_t recovery_time_ms, ui
             }
 
             printResults(result);
+            if (m_report_compression)
+            {
+                uint64_t uncompressed_bytes = compression_end.uncompressed_bytes - compression_start.uncompressed_bytes;
+                uint64_t compressed_bytes = compression_end.compressed_bytes - compression_start.compressed_bytes;
+                double cpu_us = 1e6 * static_cast<double>(cpu_end - cpu_start) / CLOCKS_PER_SEC;
+                std::cout << "Compressed messages: " <<
+                    compression_end.messages - compression_start.messages << ", wire/payload ratio: " <<
+                    (uncompressed_bytes > 0 ? static_cast<double>(compressed_bytes) / uncompressed_bytes : 1.0) <<
+                    ", CPU time per sample: " << (samples > 0 ? cpu_us / samples : 0.0) << " us" << std::endl;
+            }
             mp_commandpub->removeAllChange(&aux);
             return true;
         }
@@ -122,6 +122,8 @@ class ThroughputPublisher
         std::map<uint32_t,std::vector<uint32_t>> m_demand_payload;
 
         std::string m_file_name;
+        //! Print the size of the compressed messages and the CPU time spent per sample.
+        bool m_report_compression;
         bool m_export_csv;
         std::stringstream output_file;
         uint32_t payload;
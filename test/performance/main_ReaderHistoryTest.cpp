@@ -0,0 +1,225 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * Measures the cost of adding changes to a ReaderHistory and of removing them, in the order they would be taken,
+ * for increasing history depths. Changes from several writers are added with their timestamps interleaved, and
+ * optionally out of order inside a window, so the cost per change should stay flat as the depth grows.
+ */
+
+#include "optionparser.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include <fastrtps/log/Log.h>
+#include <fastrtps/rtps/RTPSDomain.h>
+#include <fastrtps/rtps/attributes/HistoryAttributes.h>
+#include <fastrtps/rtps/attributes/ReaderAttributes.h>
+#include <fastrtps/rtps/attributes/RTPSParticipantAttributes.h>
+#include <fastrtps/rtps/history/ReaderHistory.h>
+#include <fastrtps/rtps/participant/RTPSParticipant.h>
+#include <fastrtps/rtps/reader/RTPSReader.h>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+struct Arg: public option::Arg
+{
+    static void printError(const char* msg1, const option::Option& opt, const char* msg2)
+    {
+        fprintf(stderr, "%s", msg1);
+        fwrite(opt.name, opt.namelen, 1, stderr);
+        fprintf(stderr, "%s", msg2);
+    }
+
+    static option::ArgStatus Numeric(const option::Option& option, bool msg)
+    {
+        char* endptr = 0;
+        if (option.arg != 0 && strtol(option.arg, &endptr, 10))
+        {
+        }
+        if (endptr != option.arg && *endptr == 0)
+        {
+            return option::ARG_OK;
+        }
+
+        if (msg)
+        {
+            printError("Option '", option, "' requires a numeric argument\n");
+        }
+        return option::ARG_ILLEGAL;
+    }
+};
+
+enum  optionIndex {
+    UNKNOWN_OPT,
+    HELP,
+    DEPTH,
+    WRITERS,
+    WINDOW,
+    FORCED_DOMAIN
+};
+
+const option::Descriptor usage[] = {
+    { UNKNOWN_OPT, 0,"", "",                Arg::None,      "Usage: ReaderHistoryTest [options]\n\nOptions:" },
+    { HELP,    0,"h", "help",               Arg::None,      "  -h \t--help  \tProduce help message." },
+    { DEPTH,0,"d","depth",                  Arg::Numeric,   "  -d <num>, \t--depth=<num>  \tMaximum history depth. Depths from 1024 are doubled up to it." },
+    { WRITERS,0,"w","writers",              Arg::Numeric,   "  -w <num>, \t--writers=<num>  \tNumber of writers the changes come from." },
+    { WINDOW,0,"","window",                 Arg::Numeric,   "\t--window=<num>  \tChanges are added in reverse order inside groups of this size (1 adds them in order)." },
+    { FORCED_DOMAIN, 0, "", "domain",       Arg::Numeric,   "\t--domain=<num>  \tRTPS Domain." },
+    { 0, 0, 0, 0, 0, 0 }
+};
+
+int main(int argc, char** argv)
+{
+    int columns = getenv("COLUMNS") ? atoi(getenv("COLUMNS")) : 80;
+
+    uint32_t max_depth = 65536;
+    uint32_t n_writers = 4;
+    uint32_t window = 8;
+    uint32_t domain = 82;
+
+    argc -= (argc > 0);
+    argv += (argc > 0); // skip program name argv[0] if present
+    option::Stats stats(usage, argc, argv);
+    std::vector<option::Option> options(stats.options_max);
+    std::vector<option::Option> buffer(stats.buffer_max);
+    option::Parser parse(usage, argc, argv, &options[0], &buffer[0]);
+
+    if (parse.error())
+    {
+        return 1;
+    }
+
+    if (options[HELP])
+    {
+        option::printUsage(fwrite, stdout, usage, columns);
+        return 0;
+    }
+
+    for (int i = 0; i < parse.optionsCount(); ++i)
+    {
+        option::Option& opt = buffer[i];
+        switch (opt.index())
+        {
+            case DEPTH:
+                max_depth = strtol(opt.arg, nullptr, 10);
+                break;
+            case WRITERS:
+                n_writers = strtol(opt.arg, nullptr, 10);
+                break;
+            case WINDOW:
+                window = strtol(opt.arg, nullptr, 10);
+                break;
+            case FORCED_DOMAIN:
+                domain = strtol(opt.arg, nullptr, 10);
+                break;
+            default:
+                option::printUsage(fwrite, stdout, usage, columns);
+                return 0;
+        }
+    }
+
+    if (n_writers == 0 || window == 0)
+    {
+        std::cout << "At least one writer and a window of one change are needed" << std::endl;
+        return 1;
+    }
+
+    Log::SetVerbosity(Log::Error);
+
+    RTPSParticipantAttributes part_attr;
+    part_attr.builtin.discovery_config.discoveryProtocol = DiscoveryProtocol::NONE;
+    part_attr.builtin.use_WriterLivelinessProtocol = false;
+    part_attr.builtin.domainId = domain;
+    part_attr.setName("ReaderHistoryTest");
+    RTPSParticipant* participant = RTPSDomain::createParticipant(part_attr);
+    if (participant == nullptr)
+    {
+        return 1;
+    }
+
+    HistoryAttributes hist_attr;
+    hist_attr.payloadMaxSize = 64;
+    hist_attr.initialReservedCaches = static_cast<int32_t>(max_depth);
+    hist_attr.maximumReservedCaches = 0;
+    ReaderHistory* history = new ReaderHistory(hist_attr);
+
+    ReaderAttributes reader_attr;
+    reader_attr.endpoint.reliabilityKind = BEST_EFFORT;
+    RTPSReader* reader = RTPSDomain::createRTPSReader(participant, reader_attr, history);
+    if (reader == nullptr)
+    {
+        RTPSDomain::removeRTPSParticipant(participant);
+        delete history;
+        return 1;
+    }
+
+    std::cout << "Writers: " << n_writers << ", out of order window: " << window << std::endl;
+    std::cout << std::setw(10) << "Depth" << std::setw(16) << "Add (ns)" << std::setw(16) << "Remove (ns)" << std::endl;
+
+    for (uint32_t depth = std::min<uint32_t>(1024, max_depth); depth <= max_depth; depth *= 2)
+    {
+        // Changes in timestamp order, every writer taking turns
+        std::vector<CacheChange_t*> changes;
+        changes.reserve(depth);
+        for (uint32_t i = 0; i < depth; ++i)
+        {
+            CacheChange_t* change = nullptr;
+            if (!history->reserve_Cache(&change, hist_attr.payloadMaxSize))
+            {
+                std::cout << "Cannot reserve " << depth << " changes" << std::endl;
+                return 1;
+            }
+            change->kind = ALIVE;
+            change->writerGUID = GUID_t(GuidPrefix_t::unknown(), (i % n_writers) + 1);
+            change->sequenceNumber = SequenceNumber_t(0, (i / n_writers) + 1);
+            change->sourceTimestamp = rtps::Time_t(static_cast<int32_t>(i / 1000000), (i % 1000000) * 1000);
+            changes.push_back(change);
+        }
+
+        for (auto it = changes.begin(); it != changes.end(); it += std::min<size_t>(window, changes.end() - it))
+        {
+            std::reverse(it, it + std::min<size_t>(window, changes.end() - it));
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (CacheChange_t* change : changes)
+        {
+            history->add_change(change);
+        }
+        auto added = std::chrono::steady_clock::now();
+        while (history->getHistorySize() > 0)
+        {
+            history->remove_change(*history->changesBegin());
+        }
+        auto removed = std::chrono::steady_clock::now();
+
+        std::cout << std::setw(10) << depth <<
+            std::setw(16) << std::chrono::duration_cast<std::chrono::nanoseconds>(added - start).count() / depth <<
+            std::setw(16) << std::chrono::duration_cast<std::chrono::nanoseconds>(removed - added).count() / depth <<
+            std::endl;
+    }
+
+    RTPSDomain::removeRTPSParticipant(participant);
+    delete history;
+    RTPSDomain::stopAll();
+
+    return 0;
+}
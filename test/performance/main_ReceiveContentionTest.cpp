@@ -0,0 +1,385 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * Measures how fast a participant with many readers processes the messages of several remote participants,
+ * optionally while another thread keeps creating and removing subscribers on it.
+ * Each remote participant is assigned to a receive worker, so the messages are processed by up to
+ * --threads threads at the same time.
+ */
+
+#include "LatencyTestTypes.h"
+
+#include "optionparser.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fastrtps/log/Log.h>
+#include <fastrtps/Domain.h>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+struct Arg: public option::Arg
+{
+    static void printError(const char* msg1, const option::Option& opt, const char* msg2)
+    {
+        fprintf(stderr, "%s", msg1);
+        fwrite(opt.name, opt.namelen, 1, stderr);
+        fprintf(stderr, "%s", msg2);
+    }
+
+    static option::ArgStatus Numeric(const option::Option& option, bool msg)
+    {
+        char* endptr = 0;
+        if (option.arg != 0 && strtol(option.arg, &endptr, 10))
+        {
+        }
+        if (endptr != option.arg && *endptr == 0)
+        {
+            return option::ARG_OK;
+        }
+
+        if (msg)
+        {
+            printError("Option '", option, "' requires a numeric argument\n");
+        }
+        return option::ARG_ILLEGAL;
+    }
+};
+
+enum  optionIndex {
+    UNKNOWN_OPT,
+    HELP,
+    READERS,
+    THREADS,
+    PUBLISHERS,
+    SAMPLES,
+    CHURN,
+    FORCED_DOMAIN
+};
+
+const option::Descriptor usage[] = {
+    { UNKNOWN_OPT, 0,"", "",                Arg::None,      "Usage: ReceiveContentionTest [options]\n\nOptions:" },
+    { HELP,    0,"h", "help",               Arg::None,      "  -h \t--help  \tProduce help message." },
+    { READERS,0,"r","readers",              Arg::Numeric,   "  -r <num>, \t--readers=<num>  \tNumber of subscribers on the receiving participant." },
+    { THREADS,0,"t","threads",              Arg::Numeric,   "  -t <num>, \t--threads=<num>  \tNumber of receive worker threads (0 to use the transport threads)." },
+    { PUBLISHERS,0,"p","publishers",        Arg::Numeric,   "  -p <num>, \t--publishers=<num>  \tNumber of publishing participants." },
+    { SAMPLES,0,"s","samples",              Arg::Numeric,   "  -s <num>, \t--samples=<num>  \tNumber of samples sent by each publisher." },
+    { CHURN,0,"c","churn",                  Arg::None,      "  -c \t--churn  \tCreate and remove subscribers while receiving." },
+    { FORCED_DOMAIN, 0, "", "domain",       Arg::Numeric,   "\t--domain=<num>  \tRTPS Domain." },
+    { 0, 0, 0, 0, 0, 0 }
+};
+
+//! Size of the payload of the samples.
+const uint32_t c_sample_size = 64;
+
+class ReceivingListener : public SubscriberListener
+{
+    public:
+
+        ReceivingListener()
+            : received(0)
+            , matched(0)
+        {
+        }
+
+        void onNewDataMessage(Subscriber* sub) override
+        {
+            LatencyType sample(c_sample_size);
+            SampleInfo_t info;
+            while (sub->takeNextData(&sample, &info))
+            {
+                ++received;
+            }
+        }
+
+        void onSubscriptionMatched(Subscriber*, MatchingInfo& info) override
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (info.status == MATCHED_MATCHING)
+            {
+                ++matched;
+            }
+            else
+            {
+                --matched;
+            }
+            cv.notify_all();
+        }
+
+        std::atomic<uint64_t> received;
+        int matched;
+        std::mutex mutex;
+        std::condition_variable cv;
+};
+
+class SendingListener : public PublisherListener
+{
+    public:
+
+        SendingListener()
+            : matched(0)
+        {
+        }
+
+        void onPublicationMatched(Publisher*, MatchingInfo& info) override
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (info.status == MATCHED_MATCHING)
+            {
+                ++matched;
+            }
+            else
+            {
+                --matched;
+            }
+            cv.notify_all();
+        }
+
+        int matched;
+        std::mutex mutex;
+        std::condition_variable cv;
+};
+
+static std::string topic_name(uint32_t index)
+{
+    std::ostringstream name;
+    name << "ReceiveContentionTest_" << index;
+    return name.str();
+}
+
+static Subscriber* create_subscriber(Participant* participant, uint32_t topic, SubscriberListener* listener)
+{
+    SubscriberAttributes attr;
+    attr.topic.topicDataType = "LatencyType";
+    attr.topic.topicName = topic_name(topic);
+    attr.topic.historyQos.kind = KEEP_ALL_HISTORY_QOS;
+    attr.qos.m_reliability.kind = RELIABLE_RELIABILITY_QOS;
+    return Domain::createSubscriber(participant, attr, listener);
+}
+
+int main(int argc, char** argv)
+{
+    int columns = getenv("COLUMNS") ? atoi(getenv("COLUMNS")) : 80;
+
+    uint32_t n_readers = 100;
+    uint32_t n_threads = 4;
+    uint32_t n_publishers = 4;
+    uint32_t n_samples = 10000;
+    bool churn = false;
+    uint32_t domain = 80;
+
+    argc -= (argc > 0);
+    argv += (argc > 0); // skip program name argv[0] if present
+    option::Stats stats(usage, argc, argv);
+    std::vector<option::Option> options(stats.options_max);
+    std::vector<option::Option> buffer(stats.buffer_max);
+    option::Parser parse(usage, argc, argv, &options[0], &buffer[0]);
+
+    if (parse.error())
+    {
+        return 1;
+    }
+
+    if (options[HELP])
+    {
+        option::printUsage(fwrite, stdout, usage, columns);
+        return 0;
+    }
+
+    for (int i = 0; i < parse.optionsCount(); ++i)
+    {
+        option::Option& opt = buffer[i];
+        switch (opt.index())
+        {
+            case READERS:
+                n_readers = strtol(opt.arg, nullptr, 10);
+                break;
+            case THREADS:
+                n_threads = strtol(opt.arg, nullptr, 10);
+                break;
+            case PUBLISHERS:
+                n_publishers = strtol(opt.arg, nullptr, 10);
+                break;
+            case SAMPLES:
+                n_samples = strtol(opt.arg, nullptr, 10);
+                break;
+            case CHURN:
+                churn = true;
+                break;
+            case FORCED_DOMAIN:
+                domain = strtol(opt.arg, nullptr, 10);
+                break;
+            default:
+                option::printUsage(fwrite, stdout, usage, columns);
+                return 0;
+        }
+    }
+
+    if (n_readers == 0 || n_publishers == 0)
+    {
+        std::cout << "At least one reader and one publisher are needed" << std::endl;
+        return 1;
+    }
+
+    Log::SetVerbosity(Log::Error);
+
+    LatencyDataType type;
+
+    // Receiving participant, with all the readers
+    ParticipantAttributes recv_attr;
+    recv_attr.rtps.builtin.domainId = domain;
+    recv_attr.rtps.setName("ReceiveContention_receiver");
+    recv_attr.rtps.receiveWorkerThreads = n_threads;
+    Participant* receiver = Domain::createParticipant(recv_attr);
+    if (receiver == nullptr)
+    {
+        return 1;
+    }
+    Domain::registerType(receiver, &type);
+
+    ReceivingListener recv_listener;
+    for (uint32_t i = 0; i < n_readers; ++i)
+    {
+        if (create_subscriber(receiver, i, &recv_listener) == nullptr)
+        {
+            Domain::removeParticipant(receiver);
+            return 1;
+        }
+    }
+
+    // Each publisher is on its own participant, so they can be processed by different receive threads.
+    // Publisher i writes on topic i.
+    std::vector<Participant*> senders;
+    std::vector<Publisher*> publishers;
+    SendingListener send_listener;
+    for (uint32_t i = 0; i < n_publishers; ++i)
+    {
+        ParticipantAttributes send_attr;
+        send_attr.rtps.builtin.domainId = domain;
+        send_attr.rtps.setName("ReceiveContention_sender");
+        Participant* sender = Domain::createParticipant(send_attr);
+        if (sender == nullptr)
+        {
+            return 1;
+        }
+        Domain::registerType(sender, &type);
+        senders.push_back(sender);
+
+        PublisherAttributes pub_attr;
+        pub_attr.topic.topicDataType = "LatencyType";
+        pub_attr.topic.topicName = topic_name(i % n_readers);
+        pub_attr.topic.historyQos.kind = KEEP_ALL_HISTORY_QOS;
+        pub_attr.qos.m_reliability.kind = RELIABLE_RELIABILITY_QOS;
+        Publisher* publisher = Domain::createPublisher(sender, pub_attr, &send_listener);
+        if (publisher == nullptr)
+        {
+            return 1;
+        }
+        publishers.push_back(publisher);
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(send_listener.mutex);
+        send_listener.cv.wait(lock, [&]() { return send_listener.matched >= static_cast<int>(n_publishers); });
+    }
+
+    // Creates and removes subscribers on the receiving participant while the samples are received
+    std::atomic<bool> running(true);
+    uint32_t churn_iterations = 0;
+    std::thread churn_thread;
+    if (churn)
+    {
+        churn_thread = std::thread([&]()
+        {
+            ReceivingListener churn_listener;
+            while (running)
+            {
+                Subscriber* sub = create_subscriber(receiver, n_readers + (churn_iterations % n_readers),
+                        &churn_listener);
+                if (sub != nullptr)
+                {
+                    Domain::removeSubscriber(sub);
+                }
+                ++churn_iterations;
+            }
+        });
+    }
+
+    uint64_t expected = static_cast<uint64_t>(n_publishers) * n_samples;
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> send_threads;
+    for (Publisher* publisher : publishers)
+    {
+        send_threads.emplace_back([publisher, n_samples]()
+        {
+            LatencyType sample(c_sample_size);
+            for (uint32_t i = 0; i < n_samples; ++i)
+            {
+                sample.seqnum = i;
+                publisher->write(&sample);
+            }
+        });
+    }
+
+    for (std::thread& t : send_threads)
+    {
+        t.join();
+    }
+
+    // Give the readers some time to get the repairs
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (recv_listener.received < expected && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    running = false;
+    if (churn_thread.joinable())
+    {
+        churn_thread.join();
+    }
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    uint64_t received = recv_listener.received;
+    std::cout << "Readers: " << n_readers << ", receive threads: " << n_threads << ", publishers: " <<
+        n_publishers << (churn ? ", with churn" : "") << std::endl;
+    std::cout << "Received " << received << "/" << expected << " samples in " << seconds << " s (" <<
+        static_cast<uint64_t>(received / seconds) << " samples/s)" << std::endl;
+    if (churn)
+    {
+        std::cout << "Subscribers created and removed meanwhile: " << churn_iterations << std::endl;
+    }
+
+    for (Participant* sender : senders)
+    {
+        Domain::removeParticipant(sender);
+    }
+    Domain::removeParticipant(receiver);
+    Domain::stopAll();
+
+    return received == expected ? 0 : 1;
+}
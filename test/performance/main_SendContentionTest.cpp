@@ -0,0 +1,317 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * Measures how fast several publishers of the same participant, each on its own topic and thread, write their
+ * samples. Every publisher builds and sends its messages with its own buffers, so the aggregated rate should grow
+ * with the number of publishers until the network or the cores are saturated.
+ */
+
+#include "LatencyTestTypes.h"
+
+#include "optionparser.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fastrtps/log/Log.h>
+#include <fastrtps/Domain.h>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+struct Arg: public option::Arg
+{
+    static void printError(const char* msg1, const option::Option& opt, const char* msg2)
+    {
+        fprintf(stderr, "%s", msg1);
+        fwrite(opt.name, opt.namelen, 1, stderr);
+        fprintf(stderr, "%s", msg2);
+    }
+
+    static option::ArgStatus Numeric(const option::Option& option, bool msg)
+    {
+        char* endptr = 0;
+        if (option.arg != 0 && strtol(option.arg, &endptr, 10))
+        {
+        }
+        if (endptr != option.arg && *endptr == 0)
+        {
+            return option::ARG_OK;
+        }
+
+        if (msg)
+        {
+            printError("Option '", option, "' requires a numeric argument\n");
+        }
+        return option::ARG_ILLEGAL;
+    }
+};
+
+enum  optionIndex {
+    UNKNOWN_OPT,
+    HELP,
+    WRITERS,
+    SAMPLES,
+    SIZE,
+    RELIABLE_OPT,
+    FORCED_DOMAIN
+};
+
+const option::Descriptor usage[] = {
+    { UNKNOWN_OPT, 0,"", "",                Arg::None,      "Usage: SendContentionTest [options]\n\nOptions:" },
+    { HELP,    0,"h", "help",               Arg::None,      "  -h \t--help  \tProduce help message." },
+    { WRITERS,0,"w","writers",              Arg::Numeric,   "  -w <num>, \t--writers=<num>  \tNumber of publishers on the sending participant, each one on its own thread." },
+    { SAMPLES,0,"s","samples",              Arg::Numeric,   "  -s <num>, \t--samples=<num>  \tNumber of samples written by each publisher." },
+    { SIZE,0,"","size",                     Arg::Numeric,   "\t--size=<num>  \tSize of the payload of the samples." },
+    { RELIABLE_OPT,0,"r","reliable",            Arg::None,      "  -r \t--reliable  \tUse reliable publishers and subscribers." },
+    { FORCED_DOMAIN, 0, "", "domain",       Arg::Numeric,   "\t--domain=<num>  \tRTPS Domain." },
+    { 0, 0, 0, 0, 0, 0 }
+};
+
+class ReceivingListener : public SubscriberListener
+{
+    public:
+
+        explicit ReceivingListener(uint32_t sample_size)
+            : received(0)
+            , sample_size_(sample_size)
+        {
+        }
+
+        void onNewDataMessage(Subscriber* sub) override
+        {
+            LatencyType sample(sample_size_);
+            SampleInfo_t info;
+            while (sub->takeNextData(&sample, &info))
+            {
+                ++received;
+            }
+        }
+
+        std::atomic<uint64_t> received;
+
+    private:
+
+        uint32_t sample_size_;
+};
+
+class SendingListener : public PublisherListener
+{
+    public:
+
+        SendingListener()
+            : matched(0)
+        {
+        }
+
+        void onPublicationMatched(Publisher*, MatchingInfo& info) override
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (info.status == MATCHED_MATCHING)
+            {
+                ++matched;
+            }
+            else
+            {
+                --matched;
+            }
+            cv.notify_all();
+        }
+
+        int matched;
+        std::mutex mutex;
+        std::condition_variable cv;
+};
+
+static std::string topic_name(uint32_t index)
+{
+    std::ostringstream name;
+    name << "SendContentionTest_" << index;
+    return name.str();
+}
+
+int main(int argc, char** argv)
+{
+    int columns = getenv("COLUMNS") ? atoi(getenv("COLUMNS")) : 80;
+
+    uint32_t n_writers = 4;
+    uint32_t n_samples = 100000;
+    uint32_t sample_size = 64;
+    bool reliable = false;
+    uint32_t domain = 81;
+
+    argc -= (argc > 0);
+    argv += (argc > 0); // skip program name argv[0] if present
+    option::Stats stats(usage, argc, argv);
+    std::vector<option::Option> options(stats.options_max);
+    std::vector<option::Option> buffer(stats.buffer_max);
+    option::Parser parse(usage, argc, argv, &options[0], &buffer[0]);
+
+    if (parse.error())
+    {
+        return 1;
+    }
+
+    if (options[HELP])
+    {
+        option::printUsage(fwrite, stdout, usage, columns);
+        return 0;
+    }
+
+    for (int i = 0; i < parse.optionsCount(); ++i)
+    {
+        option::Option& opt = buffer[i];
+        switch (opt.index())
+        {
+            case WRITERS:
+                n_writers = strtol(opt.arg, nullptr, 10);
+                break;
+            case SAMPLES:
+                n_samples = strtol(opt.arg, nullptr, 10);
+                break;
+            case SIZE:
+                sample_size = strtol(opt.arg, nullptr, 10);
+                break;
+            case RELIABLE_OPT:
+                reliable = true;
+                break;
+            case FORCED_DOMAIN:
+                domain = strtol(opt.arg, nullptr, 10);
+                break;
+            default:
+                option::printUsage(fwrite, stdout, usage, columns);
+                return 0;
+        }
+    }
+
+    if (n_writers == 0)
+    {
+        std::cout << "At least one writer is needed" << std::endl;
+        return 1;
+    }
+
+    Log::SetVerbosity(Log::Error);
+
+    LatencyDataType type;
+
+    ParticipantAttributes recv_attr;
+    recv_attr.rtps.builtin.domainId = domain;
+    recv_attr.rtps.setName("SendContention_receiver");
+    Participant* receiver = Domain::createParticipant(recv_attr);
+    if (receiver == nullptr)
+    {
+        return 1;
+    }
+    Domain::registerType(receiver, &type);
+
+    ParticipantAttributes send_attr;
+    send_attr.rtps.builtin.domainId = domain;
+    send_attr.rtps.setName("SendContention_sender");
+    Participant* sender = Domain::createParticipant(send_attr);
+    if (sender == nullptr)
+    {
+        Domain::removeParticipant(receiver);
+        return 1;
+    }
+    Domain::registerType(sender, &type);
+
+    ReliabilityQosPolicyKind reliability = reliable ? RELIABLE_RELIABILITY_QOS : BEST_EFFORT_RELIABILITY_QOS;
+    ReceivingListener recv_listener(sample_size);
+    SendingListener send_listener;
+    std::vector<Publisher*> publishers;
+    for (uint32_t i = 0; i < n_writers; ++i)
+    {
+        SubscriberAttributes sub_attr;
+        sub_attr.topic.topicDataType = "LatencyType";
+        sub_attr.topic.topicName = topic_name(i);
+        sub_attr.topic.historyQos.kind = KEEP_ALL_HISTORY_QOS;
+        sub_attr.qos.m_reliability.kind = reliability;
+        if (Domain::createSubscriber(receiver, sub_attr, &recv_listener) == nullptr)
+        {
+            return 1;
+        }
+
+        PublisherAttributes pub_attr;
+        pub_attr.topic.topicDataType = "LatencyType";
+        pub_attr.topic.topicName = topic_name(i);
+        pub_attr.topic.historyQos.kind = KEEP_ALL_HISTORY_QOS;
+        pub_attr.qos.m_reliability.kind = reliability;
+        Publisher* publisher = Domain::createPublisher(sender, pub_attr, &send_listener);
+        if (publisher == nullptr)
+        {
+            return 1;
+        }
+        publishers.push_back(publisher);
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(send_listener.mutex);
+        send_listener.cv.wait(lock, [&]() { return send_listener.matched >= static_cast<int>(n_writers); });
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> send_threads;
+    for (Publisher* publisher : publishers)
+    {
+        send_threads.emplace_back([publisher, n_samples, sample_size]()
+        {
+            LatencyType sample(sample_size);
+            for (uint32_t i = 0; i < n_samples; ++i)
+            {
+                sample.seqnum = i;
+                publisher->write(&sample);
+            }
+        });
+    }
+
+    for (std::thread& t : send_threads)
+    {
+        t.join();
+    }
+
+    auto end = std::chrono::steady_clock::now();
+
+    // Let the last samples arrive before reporting them
+    uint64_t expected = static_cast<uint64_t>(n_writers) * n_samples;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(reliable ? 10 : 1);
+    while (recv_listener.received < expected && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    uint64_t received = recv_listener.received;
+    std::cout << "Writers: " << n_writers << ", sample size: " << sample_size << ", " <<
+        (reliable ? "reliable" : "best effort") << std::endl;
+    std::cout << "Written " << expected << " samples in " << seconds << " s (" <<
+        static_cast<uint64_t>(expected / seconds) << " samples/s, " <<
+        static_cast<uint64_t>(expected / seconds / n_writers) << " per writer)" << std::endl;
+    std::cout << "Received " << received << "/" << expected << " samples" << std::endl;
+
+    Domain::removeParticipant(sender);
+    Domain::removeParticipant(receiver);
+    Domain::stopAll();
+
+    return (!reliable || received == expected) ? 0 : 1;
+}
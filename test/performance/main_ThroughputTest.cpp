@@ -27,6 +27,7 @@
 
 #include <fastrtps/log/Log.h>
 #include <fastrtps/Domain.h>
+#include <fastrtps/rtps/network/MessageCompression.h>
 #include <fastrtps/xmlparser/XMLProfileManager.h>
 
 #if defined(_MSC_VER)
@@ -133,7 +134,8 @@ enum  optionIndex {
     CERTS_PATH,
     XML_FILE,
     DYNAMIC_TYPES,
-    FORCED_DOMAIN
+    FORCED_DOMAIN,
+    COMPRESSION
 };
 
 const option::Descriptor usage[] = {
@@ -145,6 +147,7 @@ const option::Descriptor usage[] = {
     { XML_FILE, 0, "", "xml",               Arg::String,    "\t--xml \tXML Configuration file." },
     { DYNAMIC_TYPES, 0, "", "dynamic_types",Arg::None,      "\t--dynamic_types \tUse dynamic types." },
     { FORCED_DOMAIN, 0, "", "domain",       Arg::Numeric,   "\t--domain \tSet the domain to connect." },
+    { COMPRESSION, 0, "", "compression",    Arg::Required,  "\t--compression=<arg> \tCompress the messages (\"lz4\"/\"zstd\")." },
 #if HAVE_SECURITY
     { USE_SECURITY, 0, "", "security",      Arg::Required,  "  --security <arg>  \tEcho mode (\"true\"/\"false\")." },
     { CERTS_PATH, 0, "", "certs",           Arg::Required,  "  --certs <arg>  \tPath where located certificates." },
@@ -195,6 +198,7 @@ int main(int argc, char** argv)
     std::string sXMLConfigFile = "";
     bool dynamic_types = false;
     int forced_domain = -1;
+    std::string compression;
 #if HAVE_SECURITY
     bool use_security = false;
     std::string certs_path;
@@ -328,6 +332,10 @@ int main(int argc, char** argv)
                 forced_domain = strtol(opt.arg, nullptr, 10);
                 break;
 
+            case COMPRESSION:
+                compression = opt.arg;
+                break;
+
 #if HAVE_SECURITY
             case USE_SECURITY:
                 if (strcmp(opt.arg, "true") == 0)
@@ -360,6 +368,12 @@ int main(int argc, char** argv)
     PropertyPolicy pub_part_property_policy, sub_part_property_policy,
         pub_property_policy, sub_property_policy;
 
+    if (!compression.empty())
+    {
+        pub_part_property_policy.properties().emplace_back(MessageCompression::codec_property, compression);
+        sub_part_property_policy.properties().emplace_back(MessageCompression::codec_property, compression);
+    }
+
 #if HAVE_SECURITY
     if (use_security)
     {
@@ -412,6 +426,7 @@ int main(int argc, char** argv)
         ThroughputPublisher tpub(reliable, seed, hostname, export_csv, export_prefix, pub_part_property_policy,
             pub_property_policy, sXMLConfigFile, dynamic_types, forced_domain);
         tpub.m_file_name = file_name;
+        tpub.m_report_compression = !compression.empty();
         tpub.run(test_time_sec, recovery_time_ms, demand, msg_size);
     }
     else
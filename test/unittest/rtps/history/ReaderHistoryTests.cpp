@@ -207,6 +207,61 @@ TEST_F(ReaderHistoryTests, remove_changes_with_guid)
     ASSERT_EQ(history->getHistorySize(), num_changes - num_sequence_numbers);
 }
 
+TEST_F(ReaderHistoryTests, changes_kept_in_timestamp_order)
+{
+    // Added from the last to the first timestamp, interleaving both writers
+    for (uint32_t i=num_changes; i>0; i--)
+    {
+        history->add_change(changes_list[i-1]);
+    }
+
+    ASSERT_EQ(history->getHistorySize(), num_changes);
+
+    uint32_t i = 0;
+    for (auto it = history->changesBegin(); it != history->changesEnd(); ++it, ++i)
+    {
+        ASSERT_EQ(*it, changes_list[i]);
+    }
+
+    CacheChange_t* ch = nullptr;
+    ASSERT_TRUE(history->get_min_change(&ch));
+    ASSERT_EQ(ch->sequenceNumber, SequenceNumber_t(0,1U));
+    ASSERT_TRUE(history->get_max_change(&ch));
+    ASSERT_EQ(ch->sequenceNumber, SequenceNumber_t(0,num_sequence_numbers));
+
+    EXPECT_CALL(*readerMock, change_removed_by_history(_)).Times(num_changes).
+            WillRepeatedly(Return(true));
+
+    // Removing the changes with the highest sequence number leaves the lowest one as maximum
+    vector<CacheChange_t*> highest;
+    vector<CacheChange_t*> others;
+    for (uint32_t i=0; i<num_changes; i++)
+    {
+        if (changes_list[i]->sequenceNumber == SequenceNumber_t(0,num_sequence_numbers))
+        {
+            highest.push_back(changes_list[i]);
+        }
+        else
+        {
+            others.push_back(changes_list[i]);
+        }
+    }
+
+    for (CacheChange_t* change : highest)
+    {
+        ASSERT_TRUE(history->remove_change(change));
+    }
+    ASSERT_TRUE(history->get_max_change(&ch));
+    ASSERT_EQ(ch->sequenceNumber, SequenceNumber_t(0,1U));
+
+    for (CacheChange_t* change : others)
+    {
+        ASSERT_TRUE(history->remove_change(change));
+    }
+    ASSERT_FALSE(history->get_min_change(&ch));
+    ASSERT_FALSE(history->get_max_change(&ch));
+}
+
 int main(int argc, char **argv)
 {
     testing::InitGoogleMock(&argc, argv);
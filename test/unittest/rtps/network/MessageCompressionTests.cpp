@@ -0,0 +1,214 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/rtps/network/MessageCompression.h>
+#include <fastrtps/rtps/common/CDRMessage_t.h>
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+static const MessageCompression::Codec s_codecs[] = { MessageCompression::LZ4, MessageCompression::ZSTD };
+
+//! RTPS message whose submessages repeat a short pattern, so they compress well.
+static std::vector<octet> compressible_message(uint32_t size)
+{
+    std::vector<octet> message(size);
+    const char header[] = "RTPS\x02\x03\x01\x0f" "abcdefghijkl";
+    memcpy(message.data(), header, RTPSMESSAGE_HEADER_SIZE);
+    for (uint32_t i = RTPSMESSAGE_HEADER_SIZE; i < size; ++i)
+    {
+        message[i] = static_cast<octet>(i % 16);
+    }
+    return message;
+}
+
+TEST(MessageCompressionTests, round_trip)
+{
+    for (MessageCompression::Codec codec : s_codecs)
+    {
+        if (!MessageCompression::is_available(codec))
+        {
+            continue;
+        }
+
+        MessageCompression compression(codec, 0, 1);
+        std::vector<octet> message = compressible_message(8192);
+
+        const octet* compressed = nullptr;
+        uint32_t compressed_size = 0;
+        ASSERT_TRUE(compression.compress(message.data(), static_cast<uint32_t>(message.size()),
+            compressed, compressed_size));
+        EXPECT_LT(compressed_size, message.size());
+        EXPECT_TRUE(MessageCompression::is_compressed(compressed, compressed_size));
+        // The GuidPrefix is kept, so the receive workers still hash on it
+        EXPECT_EQ(0, memcmp(compressed + 4, message.data() + 4, RTPSMESSAGE_HEADER_SIZE - 4));
+
+        std::vector<octet> restored(message.size());
+        uint32_t length = 0;
+        ASSERT_TRUE(MessageCompression::decompress(compressed, compressed_size, restored.data(),
+            static_cast<uint32_t>(restored.size()), length));
+        ASSERT_EQ(message.size(), length);
+        EXPECT_EQ(message, restored);
+    }
+}
+
+TEST(MessageCompressionTests, small_and_incompressible_messages_are_not_compressed)
+{
+    std::mt19937 generator(2019);
+
+    for (MessageCompression::Codec codec : s_codecs)
+    {
+        if (!MessageCompression::is_available(codec))
+        {
+            continue;
+        }
+
+        MessageCompression compression(codec, 512, 1);
+        const octet* compressed = nullptr;
+        uint32_t compressed_size = 0;
+
+        std::vector<octet> small = compressible_message(511);
+        EXPECT_FALSE(compression.compress(small.data(), static_cast<uint32_t>(small.size()),
+            compressed, compressed_size));
+
+        std::vector<octet> random = compressible_message(4096);
+        for (size_t i = RTPSMESSAGE_HEADER_SIZE; i < random.size(); ++i)
+        {
+            random[i] = static_cast<octet>(generator());
+        }
+        EXPECT_FALSE(compression.compress(random.data(), static_cast<uint32_t>(random.size()),
+            compressed, compressed_size));
+    }
+}
+
+TEST(MessageCompressionTests, corrupted_messages_are_rejected)
+{
+    for (MessageCompression::Codec codec : s_codecs)
+    {
+        if (!MessageCompression::is_available(codec))
+        {
+            continue;
+        }
+
+        MessageCompression compression(codec, 0, 1);
+        std::vector<octet> message = compressible_message(8192);
+
+        const octet* compressed = nullptr;
+        uint32_t compressed_size = 0;
+        ASSERT_TRUE(compression.compress(message.data(), static_cast<uint32_t>(message.size()),
+            compressed, compressed_size));
+        std::vector<octet> received(compressed, compressed + compressed_size);
+
+        std::vector<octet> restored(message.size());
+        uint32_t length = 0;
+
+        // Doesn't fit in the receive buffer
+        EXPECT_FALSE(MessageCompression::decompress(received.data(), static_cast<uint32_t>(received.size()),
+            restored.data(), static_cast<uint32_t>(restored.size() - 1), length));
+
+        // Truncated
+        EXPECT_FALSE(MessageCompression::decompress(received.data(), static_cast<uint32_t>(received.size() / 2),
+            restored.data(), static_cast<uint32_t>(restored.size()), length));
+
+        // Wrong length of the submessages
+        std::vector<octet> wrong_length = received;
+        wrong_length[RTPSMESSAGE_HEADER_SIZE + 7] ^= 0x01;
+        EXPECT_FALSE(MessageCompression::decompress(wrong_length.data(), static_cast<uint32_t>(wrong_length.size()),
+            restored.data(), static_cast<uint32_t>(restored.size()), length));
+
+        // Unknown codec
+        std::vector<octet> wrong_codec = received;
+        wrong_codec[RTPSMESSAGE_HEADER_SIZE] = 0x7F;
+        EXPECT_FALSE(MessageCompression::decompress(wrong_codec.data(), static_cast<uint32_t>(wrong_codec.size()),
+            restored.data(), static_cast<uint32_t>(restored.size()), length));
+    }
+
+    // Plain RTPS messages are not taken as compressed ones
+    std::vector<octet> message = compressible_message(1024);
+    EXPECT_FALSE(MessageCompression::is_compressed(message.data(), static_cast<uint32_t>(message.size())));
+}
+
+TEST(MessageCompressionTests, create_from_properties)
+{
+    PropertyPolicy properties;
+    EXPECT_EQ(nullptr, MessageCompression::create(properties));
+
+    properties.properties().emplace_back(MessageCompression::codec_property, "unknown");
+    EXPECT_EQ(nullptr, MessageCompression::create(properties));
+
+    for (MessageCompression::Codec codec : s_codecs)
+    {
+        PropertyPolicy codec_properties;
+        codec_properties.properties().emplace_back(MessageCompression::codec_property,
+            codec == MessageCompression::LZ4 ? "lz4" : "zstd");
+        std::unique_ptr<MessageCompression> compression(MessageCompression::create(codec_properties));
+
+        if (MessageCompression::is_available(codec))
+        {
+            ASSERT_NE(nullptr, compression.get());
+            EXPECT_EQ(codec, compression->codec());
+            EXPECT_TRUE(compression->is_accepted_by(MessageCompression::available_codecs()));
+        }
+        else
+        {
+            EXPECT_EQ(nullptr, compression.get());
+        }
+    }
+}
+
+TEST(MessageCompressionTests, peers)
+{
+    MessageCompression compression(MessageCompression::LZ4, 0, 1);
+
+    EXPECT_TRUE(compression.is_accepted_by("lz4"));
+    EXPECT_TRUE(compression.is_accepted_by("zstd,lz4"));
+    EXPECT_FALSE(compression.is_accepted_by("zstd"));
+    EXPECT_FALSE(compression.is_accepted_by(""));
+
+    Locator_t first(7400);
+    first.address[15] = 1;
+    Locator_t second(7410);
+    second.address[15] = 1;
+
+    LocatorList_t participant_a;
+    participant_a.push_back(first);
+    LocatorList_t participant_b;
+    participant_b.push_back(first);
+    participant_b.push_back(second);
+
+    compression.add_peer(participant_a);
+    compression.add_peer(participant_b);
+    EXPECT_TRUE(compression.is_peer(first));
+    EXPECT_TRUE(compression.is_peer(second));
+
+    // The locator is still announced by participant a
+    compression.remove_peer(participant_b);
+    EXPECT_TRUE(compression.is_peer(first));
+    EXPECT_FALSE(compression.is_peer(second));
+
+    compression.remove_peer(participant_a);
+    EXPECT_FALSE(compression.is_peer(first));
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,258 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <rtps/participant/SendQueue.h>
+#include <fastrtps/rtps/common/CDRMessage_t.h>
+#include <fastrtps/rtps/messages/RTPS_messages.h>
+
+#include <gtest/gtest.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+using namespace eprosima::fastrtps::rtps;
+
+//! Builds a little endian RTPS message with empty submessages of the given kinds, plus a tag to tell it apart.
+static std::vector<octet> build_message(
+        const std::vector<SubmessageId>& submessages,
+        octet tag = 0)
+{
+    std::vector<octet> message(RTPSMESSAGE_HEADER_SIZE, 0);
+    message[0] = 'R';
+    message[1] = 'T';
+    message[2] = 'P';
+    message[3] = 'S';
+
+    for (size_t i = 0; i < submessages.size(); ++i)
+    {
+        bool last = i + 1 == submessages.size();
+        message.push_back(submessages[i]);
+        message.push_back(0x01); // Little endian
+        message.push_back(last ? 0 : 4);
+        message.push_back(0);
+        if (!last)
+        {
+            message.insert(message.end(), 4, 0);
+        }
+    }
+
+    message.push_back(tag);
+    return message;
+}
+
+static Locator_t destination(uint32_t port)
+{
+    Locator_t locator;
+    locator.kind = LOCATOR_KIND_UDPv4;
+    locator.port = port;
+    return locator;
+}
+
+/**
+ * Records the order in which messages are sent. The first message sent is held until release() is called, so the
+ * following ones can be queued meanwhile.
+ */
+class SendQueueTests : public ::testing::Test
+{
+public:
+
+    SendQueueTests()
+        : held_(false)
+        , released_(false)
+    {
+    }
+
+    SendQueue::SendFunction send_function()
+    {
+        return [this](const octet* data, uint32_t length, const Locator_t& locator)
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (!held_)
+            {
+                held_ = true;
+                cv_.notify_all();
+                cv_.wait(lock, [this]() { return released_; });
+            }
+            sent_.push_back(std::make_pair(data[length - 1], locator.port));
+            cv_.notify_all();
+        };
+    }
+
+    void wait_held()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this]() { return held_; });
+    }
+
+    void release()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        released_ = true;
+        cv_.notify_all();
+    }
+
+    void wait_sent(size_t count)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this, count]() { return sent_.size() >= count; });
+    }
+
+    bool push(
+            SendQueue& queue,
+            const std::vector<octet>& message,
+            const Locator_t& locator)
+    {
+        LocatorList_t destinations;
+        destinations.push_back(locator);
+        return queue.push(message.data(), static_cast<uint32_t>(message.size()), destinations,
+                std::chrono::steady_clock::now() + std::chrono::seconds(1));
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool held_;
+    bool released_;
+    //! Tag and destination port of the messages sent.
+    std::vector<std::pair<octet, uint32_t>> sent_;
+};
+
+TEST(SendQueueClassifyTests, reader_feedback_and_gap_go_to_control_lane)
+{
+    std::vector<octet> acknack = build_message({ACKNACK});
+    EXPECT_EQ(SendQueue::CONTROL_LANE, SendQueue::classify(acknack.data(), static_cast<uint32_t>(acknack.size())));
+
+    std::vector<octet> nack_frag = build_message({INFO_DST, NACK_FRAG});
+    EXPECT_EQ(SendQueue::CONTROL_LANE, SendQueue::classify(nack_frag.data(),
+            static_cast<uint32_t>(nack_frag.size())));
+
+    std::vector<octet> both = build_message({INFO_DST, ACKNACK, INFO_DST, NACK_FRAG});
+    EXPECT_EQ(SendQueue::CONTROL_LANE, SendQueue::classify(both.data(), static_cast<uint32_t>(both.size())));
+
+    std::vector<octet> gap = build_message({INFO_DST, GAP});
+    EXPECT_EQ(SendQueue::CONTROL_LANE, SendQueue::classify(gap.data(), static_cast<uint32_t>(gap.size())));
+}
+
+TEST(SendQueueClassifyTests, writer_submessages_go_to_bulk_lane)
+{
+    std::vector<std::vector<SubmessageId>> cases = {
+        {HEARTBEAT},
+        {INFO_DST, HEARTBEAT},
+        {GAP, HEARTBEAT},
+        {GAP, DATA},
+        {HEARTBEAT_FRAG},
+        {INFO_TS, DATA},
+        {INFO_TS, DATA, HEARTBEAT},
+        {DATA_FRAG},
+        {INFO_DST},
+        {ACKNACK, DATA}
+    };
+
+    for (const auto& submessages : cases)
+    {
+        std::vector<octet> message = build_message(submessages);
+        EXPECT_EQ(SendQueue::BULK_LANE, SendQueue::classify(message.data(), static_cast<uint32_t>(message.size())));
+    }
+}
+
+TEST_F(SendQueueTests, control_lane_is_sent_first)
+{
+    SendQueue queue(1000000, send_function());
+    Locator_t locator = destination(7400);
+
+    ASSERT_TRUE(push(queue, build_message({DATA}, 0), locator));
+    wait_held();
+
+    ASSERT_TRUE(push(queue, build_message({DATA}, 1), locator));
+    ASSERT_TRUE(push(queue, build_message({HEARTBEAT}, 2), locator));
+    ASSERT_TRUE(push(queue, build_message({ACKNACK}, 3), locator));
+    ASSERT_TRUE(push(queue, build_message({DATA_FRAG}, 4), locator));
+    ASSERT_TRUE(push(queue, build_message({GAP}, 5), locator));
+    release();
+    wait_sent(6);
+
+    // The heartbeat stays behind the data it announces
+    std::vector<std::pair<octet, uint32_t>> expected = {
+        {0, 7400}, {3, 7400}, {5, 7400}, {1, 7400}, {2, 7400}, {4, 7400}
+    };
+    EXPECT_EQ(expected, sent_);
+}
+
+TEST_F(SendQueueTests, destinations_are_visited_in_turns)
+{
+    SendQueue queue(1000000, send_function());
+    Locator_t first = destination(7400);
+    Locator_t second = destination(7410);
+
+    ASSERT_TRUE(push(queue, build_message({DATA}, 0), first));
+    wait_held();
+
+    ASSERT_TRUE(push(queue, build_message({DATA}, 1), first));
+    ASSERT_TRUE(push(queue, build_message({DATA}, 2), first));
+    ASSERT_TRUE(push(queue, build_message({DATA}, 3), first));
+    ASSERT_TRUE(push(queue, build_message({DATA}, 4), second));
+    ASSERT_TRUE(push(queue, build_message({DATA}, 5), second));
+    release();
+    wait_sent(6);
+
+    std::vector<std::pair<octet, uint32_t>> expected = {
+        {0, 7400}, {1, 7400}, {4, 7410}, {2, 7400}, {5, 7410}, {3, 7400}
+    };
+    EXPECT_EQ(expected, sent_);
+}
+
+TEST_F(SendQueueTests, stop_discards_after_max_drain_time)
+{
+    SendQueue queue(1000000, send_function());
+    Locator_t locator = destination(7400);
+
+    ASSERT_TRUE(push(queue, build_message({DATA}, 0), locator));
+    wait_held();
+    ASSERT_TRUE(push(queue, build_message({DATA}, 1), locator));
+    ASSERT_TRUE(push(queue, build_message({DATA}, 2), locator));
+
+    std::thread releaser([this]()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        release();
+    });
+
+    // The held message keeps the queue busy past the drain time
+    queue.stop(std::chrono::steady_clock::now() + std::chrono::milliseconds(50));
+    releaser.join();
+
+    std::vector<std::pair<octet, uint32_t>> expected = { {0, 7400} };
+    EXPECT_EQ(expected, sent_);
+    EXPECT_FALSE(push(queue, build_message({DATA}, 3), locator));
+}
+
+TEST_F(SendQueueTests, stop_sends_queued_messages)
+{
+    SendQueue queue(1000000, send_function());
+    Locator_t locator = destination(7400);
+
+    ASSERT_TRUE(push(queue, build_message({DATA}, 0), locator));
+    wait_held();
+    ASSERT_TRUE(push(queue, build_message({DATA}, 1), locator));
+    release();
+
+    queue.stop(std::chrono::steady_clock::now() + std::chrono::seconds(5));
+    EXPECT_EQ(2u, sent_.size());
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -18,6 +18,34 @@
 #include <fastrtps/rtps/writer/ReaderProxy.h>
 #include <fastrtps/rtps/writer/StatefulWriter.h>
 
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Counts the heap allocations made while counting is enabled
+static std::atomic<bool> g_count_allocations(false);
+static std::atomic<size_t> g_allocations(0);
+
+void* operator new(size_t size)
+{
+    if (g_count_allocations)
+    {
+        ++g_allocations;
+    }
+
+    void* ptr = std::malloc(size != 0 ? size : 1);
+    if (ptr == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
 //using namespace eprosima::fastrtps::rtps;
 namespace eprosima
 {
@@ -26,20 +54,66 @@ namespace fastrtps
 namespace rtps
 {
 
+// The ReaderProxy takes the changes from the history of the writer
+class HistoryChanges
+{
+public:
+
+    HistoryChanges(StatefulWriter& writer)
+        : history_(writer.history())
+    {
+    }
+
+    ~HistoryChanges()
+    {
+        for (CacheChange_t* change : history_->m_changes)
+        {
+            delete change;
+        }
+        history_->m_changes.clear();
+    }
+
+    ChangeForReader_t add(uint32_t seq)
+    {
+        CacheChange_t* change = new CacheChange_t();
+        change->sequenceNumber = SequenceNumber_t(0, seq);
+        history_->m_changes.push_back(change);
+        return ChangeForReader_t(change);
+    }
+
+    void remove(uint32_t seq)
+    {
+        for (auto it = history_->m_changes.begin(); it != history_->m_changes.end(); ++it)
+        {
+            if ((*it)->sequenceNumber == SequenceNumber_t(0, seq))
+            {
+                delete *it;
+                history_->m_changes.erase(it);
+                return;
+            }
+        }
+    }
+
+private:
+
+    WriterHistory* history_;
+};
+
 TEST(ReaderProxyTests, find_change_test)
 {
     //RemoteReaderAttributes rattr;
     StatefulWriter writerMock;
     WriterTimes wTimes;
     ReaderProxy rproxy(wTimes, &writerMock);
+    HistoryChanges history(writerMock);
 
-    rproxy.add_change(ChangeForReader_t(SequenceNumber_t(0, 1)), false);
-    rproxy.add_change(ChangeForReader_t(SequenceNumber_t(0, 2)), false);
-    rproxy.add_change(ChangeForReader_t(SequenceNumber_t(0, 3)), false);
-    //rproxy.add_change(ChangeForReader_t(SequenceNumber_t(0, 4)), false); // GAP
-    //rproxy.add_change(ChangeForReader_t(SequenceNumber_t(0, 5)), false); // GAP
-    rproxy.add_change(ChangeForReader_t(SequenceNumber_t(0, 6)), false);
-    rproxy.add_change(ChangeForReader_t(SequenceNumber_t(0, 7)), false);
+    rproxy.add_change(history.add(1), false);
+    rproxy.add_change(history.add(2), false);
+    rproxy.add_change(history.add(3), false);
+    //rproxy.add_change(history.add(4), false); // GAP
+    //rproxy.add_change(history.add(5), false); // GAP
+    rproxy.add_change(history.add(6), false);
+    rproxy.add_change(history.add(7), false);
 
     ASSERT_FALSE(rproxy.change_is_acked(SequenceNumber_t(0, 1)));
     ASSERT_FALSE(rproxy.change_is_acked(SequenceNumber_t(0, 2)));
@@ -83,13 +157,16 @@ TEST(ReaderProxyTests, find_change_removed_test)
     StatefulWriter writerMock;
     WriterTimes wTimes;
     ReaderProxy rproxy(wTimes, &writerMock);
+    HistoryChanges history(writerMock);
 
-    rproxy.add_change(ChangeForReader_t(SequenceNumber_t(0, 1)), false);
-    rproxy.add_change(ChangeForReader_t(SequenceNumber_t(0, 2)), false);
+    rproxy.add_change(history.add(1), false);
+    rproxy.add_change(history.add(2), false);
     rproxy.change_has_been_removed(SequenceNumber_t(0, 1));
-    rproxy.add_change(ChangeForReader_t(SequenceNumber_t(0, 3)), false);
+    history.remove(1);
+    rproxy.add_change(history.add(3), false);
     rproxy.change_has_been_removed(SequenceNumber_t(0, 2));
-    rproxy.add_change(ChangeForReader_t(SequenceNumber_t(0, 4)), false);
+    history.remove(2);
+    rproxy.add_change(history.add(4), false);
 
     ASSERT_TRUE(rproxy.change_is_acked(SequenceNumber_t(0, 1)));
     ASSERT_TRUE(rproxy.change_is_acked(SequenceNumber_t(0, 2)));
@@ -114,22 +191,363 @@ TEST(ReaderProxyTests, are_there_gaps)
     StatefulWriter writerMock;
     WriterTimes wTimes;
     ReaderProxy rproxy(wTimes, &writerMock);
+    HistoryChanges history(writerMock);
 
     ASSERT_FALSE(rproxy.are_there_gaps());
-    rproxy.add_change(ChangeForReader_t(SequenceNumber_t(0, 1)), false);
+    rproxy.add_change(history.add(1), false);
     ASSERT_FALSE(rproxy.are_there_gaps());
-    rproxy.add_change(ChangeForReader_t(SequenceNumber_t(0, 2)), false);
+    rproxy.add_change(history.add(2), false);
     ASSERT_FALSE(rproxy.are_there_gaps());
-    rproxy.add_change(ChangeForReader_t(SequenceNumber_t(0, 3)), false);
+    rproxy.add_change(history.add(3), false);
     ASSERT_FALSE(rproxy.are_there_gaps());
     rproxy.change_has_been_removed(SequenceNumber_t(0, 2));
+    history.remove(2);
     ASSERT_TRUE(rproxy.are_there_gaps());
     rproxy.change_has_been_removed(SequenceNumber_t(0, 1));
+    history.remove(1);
     ASSERT_TRUE(rproxy.are_there_gaps());
     rproxy.change_has_been_removed(SequenceNumber_t(0, 3));
+    history.remove(3);
+    ASSERT_FALSE(rproxy.are_there_gaps());
+}
+
+TEST(ReaderProxyTests, changes_state_from_history)
+{
+    StatefulWriter writerMock;
+    WriterTimes wTimes;
+    ReaderProxy rproxy(wTimes, &writerMock);
+    HistoryChanges history(writerMock);
+    RemoteReaderAttributes rattr;
+    rattr.guid.entityId.value[3] = 1;
+    rattr.endpoint.reliabilityKind = RELIABLE;
+    rproxy.start(rattr);
+
+    std::vector<SequenceNumber_t> unsent;
+    std::vector<SequenceNumber_t> irrelevant;
+    auto collect_unsent = [&]()
+    {
+        unsent.clear();
+        irrelevant.clear();
+        rproxy.for_each_unsent_change(SequenceNumber_t(0, 11),
+                [&](const SequenceNumber_t& seq_num, const ChangeForReader_t* change)
+        {
+            if (change == nullptr)
+            {
+                irrelevant.push_back(seq_num);
+            }
+            else
+            {
+                ASSERT_EQ(change->getSequenceNumber(), seq_num);
+                ASSERT_NE(change->getChange(), nullptr);
+                unsent.push_back(seq_num);
+            }
+        });
+    };
+
+    for (uint32_t i = 1; i <= 10; ++i)
+    {
+        rproxy.add_change(history.add(i), false);
+    }
+    collect_unsent();
+    ASSERT_EQ(unsent.size(), 10u);
+    ASSERT_TRUE(irrelevant.empty());
+
+    for (uint32_t i = 1; i <= 10; ++i)
+    {
+        ASSERT_TRUE(rproxy.set_change_to_status(SequenceNumber_t(0, i), UNDERWAY, false));
+    }
+    collect_unsent();
+    ASSERT_TRUE(unsent.empty());
+    ASSERT_FALSE(rproxy.has_unacknowledged());
+
+    // A removed change is a hole
+    rproxy.change_has_been_removed(SequenceNumber_t(0, 4));
+    history.remove(4);
+    ASSERT_TRUE(rproxy.are_there_gaps());
+    ASSERT_TRUE(rproxy.change_is_acked(SequenceNumber_t(0, 4)));
+    collect_unsent();
+    ASSERT_EQ(irrelevant, std::vector<SequenceNumber_t>{ SequenceNumber_t(0, 4) });
+
+    ASSERT_TRUE(rproxy.perform_nack_supression());
+    ASSERT_TRUE(rproxy.has_unacknowledged());
+
+    rproxy.acked_changes_set(SequenceNumber_t(0, 6));
+    ASSERT_FALSE(rproxy.are_there_gaps());
+    ASSERT_TRUE(rproxy.change_is_acked(SequenceNumber_t(0, 5)));
+    ASSERT_FALSE(rproxy.change_is_acked(SequenceNumber_t(0, 6)));
+
+    // Requested changes are sent again
+    SequenceNumberSet_t requested(SequenceNumber_t(0, 6));
+    requested.add(SequenceNumber_t(0, 7));
+    requested.add(SequenceNumber_t(0, 9));
+    ASSERT_TRUE(rproxy.requested_changes_set(requested));
+    ASSERT_FALSE(rproxy.requested_changes_set(requested));
+    ASSERT_TRUE(rproxy.perform_acknack_response());
+    collect_unsent();
+    ASSERT_EQ(unsent, (std::vector<SequenceNumber_t>{ SequenceNumber_t(0, 7), SequenceNumber_t(0, 9) }));
+
+    rproxy.set_change_to_status(SequenceNumber_t(0, 7), UNDERWAY, false);
+    rproxy.set_change_to_status(SequenceNumber_t(0, 9), UNDERWAY, false);
+    collect_unsent();
+    ASSERT_TRUE(unsent.empty());
+
+    rproxy.acked_changes_set(SequenceNumber_t(0, 11));
+    ASSERT_FALSE(rproxy.has_changes());
+    ASSERT_FALSE(rproxy.has_unacknowledged());
+    ASSERT_EQ(rproxy.changes_low_mark(), SequenceNumber_t(0, 10));
+}
+
+TEST(ReaderProxyTests, late_joiner_skips_irrelevant_changes)
+{
+    StatefulWriter writerMock;
+    WriterTimes wTimes;
+    ReaderProxy rproxy(wTimes, &writerMock);
+    HistoryChanges history(writerMock);
+
+    // Changes written before the reader matched are irrelevant to it
+    for (uint32_t i = 1; i <= 5; ++i)
+    {
+        ChangeForReader_t change = history.add(i);
+        change.setRelevance(false);
+        change.setStatus(UNACKNOWLEDGED);
+        rproxy.add_change(change, false);
+    }
+    ASSERT_FALSE(rproxy.has_changes());
+    ASSERT_FALSE(rproxy.are_there_gaps());
+
+    ChangeForReader_t change = history.add(6);
+    change.setStatus(UNACKNOWLEDGED);
+    rproxy.add_change(change, false);
+    ASSERT_TRUE(rproxy.has_changes());
+    ASSERT_TRUE(rproxy.are_there_gaps());
+    ASSERT_TRUE(rproxy.has_unacknowledged());
+    ASSERT_TRUE(rproxy.change_is_acked(SequenceNumber_t(0, 5)));
+    ASSERT_FALSE(rproxy.change_is_acked(SequenceNumber_t(0, 6)));
+
+    // Irrelevant changes cannot be requested
+    SequenceNumberSet_t requested(SequenceNumber_t(0, 1));
+    requested.add(SequenceNumber_t(0, 3));
+    ASSERT_FALSE(rproxy.requested_changes_set(requested));
+
+    rproxy.acked_changes_set(SequenceNumber_t(0, 7));
+    ASSERT_FALSE(rproxy.has_changes());
     ASSERT_FALSE(rproxy.are_there_gaps());
 }
 
+TEST(ReaderProxyTests, requested_changes_merged_between_readers)
+{
+    StatefulWriter writerMock;
+    WriterTimes wTimes;
+    ReaderProxy first_proxy(wTimes, &writerMock);
+    ReaderProxy second_proxy(wTimes, &writerMock);
+    HistoryChanges history(writerMock);
+    RemoteReaderAttributes rattr;
+    rattr.endpoint.reliabilityKind = RELIABLE;
+    rattr.guid.entityId.value[3] = 1;
+    first_proxy.start(rattr);
+    rattr.guid.entityId.value[3] = 2;
+    second_proxy.start(rattr);
+
+    for (uint32_t i = 1; i <= 5; ++i)
+    {
+        ChangeForReader_t change = history.add(i);
+        change.setStatus(UNACKNOWLEDGED);
+        first_proxy.add_change(change, false);
+        second_proxy.add_change(change, false);
+    }
+    second_proxy.acked_changes_set(SequenceNumber_t(0, 3));
+
+    auto requested_changes = [](const ReaderProxy& proxy)
+    {
+        SequenceNumberSet_t set(SequenceNumber_t(0, 1));
+        proxy.get_requested_changes(set);
+        std::vector<SequenceNumber_t> seqs;
+        set.for_each([&](const SequenceNumber_t& seq_num)
+        {
+            seqs.push_back(seq_num);
+        });
+        return seqs;
+    };
+
+    SequenceNumberSet_t requested(SequenceNumber_t(0, 1));
+    requested.add(SequenceNumber_t(0, 2));
+    requested.add(SequenceNumber_t(0, 4));
+    ASSERT_TRUE(first_proxy.requested_changes_set(requested));
+
+    std::vector<SequenceNumber_t> expected{ SequenceNumber_t(0, 2), SequenceNumber_t(0, 4) };
+    ASSERT_EQ(requested_changes(first_proxy), expected);
+    ASSERT_TRUE(requested_changes(second_proxy).empty());
+
+    // Only the changes the second reader has not acknowledged become requested
+    SequenceNumberSet_t merged(SequenceNumber_t(0, 1));
+    first_proxy.get_requested_changes(merged);
+    second_proxy.get_requested_changes(merged);
+    ASSERT_TRUE(second_proxy.requested_changes_set(merged));
+    expected = { SequenceNumber_t(0, 4) };
+    ASSERT_EQ(requested_changes(second_proxy), expected);
+
+    // Requested changes are sent to both readers
+    ASSERT_TRUE(first_proxy.perform_acknack_response());
+    ASSERT_TRUE(second_proxy.perform_acknack_response());
+    ASSERT_TRUE(requested_changes(first_proxy).empty());
+    ASSERT_TRUE(requested_changes(second_proxy).empty());
+}
+
+TEST(ReaderProxyTests, heartbeat_period_follows_acknack_round_trip_time)
+{
+    StatefulWriter writerMock;
+    WriterTimes wTimes;
+    ReaderProxy rproxy(wTimes, &writerMock);
+    RemoteReaderAttributes rattr;
+    rattr.guid.entityId.value[3] = 1;
+    rattr.endpoint.reliabilityKind = RELIABLE;
+    rproxy.start(rattr);
+
+    // Not measured yet
+    ASSERT_EQ(rproxy.heartbeat_period_millisec(10, 3000), 10);
+
+    auto start = std::chrono::steady_clock::now();
+    rproxy.heartbeat_sent(start);
+    rproxy.acknack_received(start + std::chrono::milliseconds(40));
+    ASSERT_DOUBLE_EQ(rproxy.acknack_rtt_millisec(), 40);
+    ASSERT_DOUBLE_EQ(rproxy.heartbeat_period_millisec(10, 3000), 80);
+
+    // Smoothed towards new samples
+    rproxy.heartbeat_sent(start + std::chrono::milliseconds(100));
+    rproxy.acknack_received(start + std::chrono::milliseconds(120));
+    ASSERT_DOUBLE_EQ(rproxy.acknack_rtt_millisec(), 37.5);
+
+    // Acknacks not answering a heartbeat are not measured
+    rproxy.acknack_received(start + std::chrono::milliseconds(500));
+    ASSERT_DOUBLE_EQ(rproxy.acknack_rtt_millisec(), 37.5);
+
+    // A single unanswered heartbeat may be a loss
+    rproxy.heartbeat_sent(start + std::chrono::milliseconds(600));
+    rproxy.heartbeat_sent(start + std::chrono::milliseconds(700));
+    ASSERT_EQ(rproxy.unanswered_heartbeats(), 1u);
+    ASSERT_DOUBLE_EQ(rproxy.heartbeat_period_millisec(10, 3000), 75);
+
+    // Backs off while the reader does not answer
+    rproxy.heartbeat_sent(start + std::chrono::milliseconds(800));
+    rproxy.heartbeat_sent(start + std::chrono::milliseconds(900));
+    ASSERT_EQ(rproxy.unanswered_heartbeats(), 3u);
+    ASSERT_DOUBLE_EQ(rproxy.heartbeat_period_millisec(10, 3000), 300);
+    ASSERT_DOUBLE_EQ(rproxy.heartbeat_period_millisec(10, 200), 200);
+
+    rproxy.acknack_received(start + std::chrono::milliseconds(930));
+    ASSERT_EQ(rproxy.unanswered_heartbeats(), 0u);
+    ASSERT_DOUBLE_EQ(rproxy.heartbeat_period_millisec(10, 3000), 2 * (0.875 * 37.5 + 0.125 * 30));
+}
+
+TEST(ReaderProxyTests, acknack_and_nack_frag_processing_do_not_allocate)
+{
+    StatefulWriter writerMock;
+    WriterTimes wTimes;
+    ReaderProxy rproxy(wTimes, &writerMock);
+    RemoteReaderAttributes rattr;
+    rattr.guid.entityId.value[3] = 1;
+    rattr.endpoint.reliabilityKind = RELIABLE;
+    rproxy.start(rattr);
+
+    // Five changes of 1000 fragments each
+    CacheChange_t changes[5];
+    for (uint32_t i = 0; i < 5; ++i)
+    {
+        changes[i].sequenceNumber = SequenceNumber_t(0, i + 1);
+        changes[i].serializedPayload.length = 100000;
+        changes[i].setFragmentSize(100);
+        writerMock.history()->m_changes.push_back(&changes[i]);
+        rproxy.add_change(ChangeForReader_t(&changes[i]), false);
+    }
+
+    bool was_last_fragment = false;
+    g_allocations = 0;
+    g_count_allocations = true;
+
+    // Every fragment is sent
+    for (uint32_t i = 0; i < 5; ++i)
+    {
+        for (FragmentNumber_t fn = 1; fn <= 1000; ++fn)
+        {
+            rproxy.mark_fragment_as_sent_for_change(changes[i].sequenceNumber, fn, was_last_fragment);
+        }
+        rproxy.set_change_to_status(changes[i].sequenceNumber, UNDERWAY, false);
+    }
+    bool all_sent = was_last_fragment;
+    bool underway = rproxy.perform_nack_supression();
+
+    // First change acknowledged, the others requested again
+    rproxy.acked_changes_set(SequenceNumber_t(0, 2));
+    SequenceNumberSet_t requested(SequenceNumber_t(0, 2));
+    requested.add(SequenceNumber_t(0, 3));
+    requested.add(SequenceNumber_t(0, 5));
+    bool changes_requested = rproxy.requested_changes_set(requested);
+    bool changes_unsent = rproxy.perform_acknack_response();
+
+    // Some fragments sent, and some of them requested again
+    for (FragmentNumber_t fn = 1; fn <= 600; ++fn)
+    {
+        rproxy.mark_fragment_as_sent_for_change(SequenceNumber_t(0, 3), fn, was_last_fragment);
+    }
+    FragmentNumberSet_t fragments(10);
+    fragments.add(10);
+    fragments.add(57);
+    fragments.add(200);
+    bool fragments_requested = rproxy.process_nack_frag(rattr.guid, 1, SequenceNumber_t(0, 3), fragments);
+    FragmentNumberSet_t unsent;
+    rproxy.for_each_unsent_change(SequenceNumber_t(0, 4),
+            [&unsent](const SequenceNumber_t& seq_num, const ChangeForReader_t* change)
+    {
+        if (change != nullptr && seq_num == SequenceNumber_t(0, 3))
+        {
+            unsent = change->getUnsentFragments();
+        }
+    });
+
+    g_count_allocations = false;
+
+    ASSERT_EQ(g_allocations.load(), 0u);
+    ASSERT_TRUE(all_sent);
+    ASSERT_TRUE(underway);
+    ASSERT_TRUE(changes_requested);
+    ASSERT_TRUE(changes_unsent);
+    ASSERT_TRUE(fragments_requested);
+    ASSERT_TRUE(rproxy.change_is_acked(SequenceNumber_t(0, 1)));
+    ASSERT_FALSE(rproxy.change_is_acked(SequenceNumber_t(0, 2)));
+
+    // The window of unsent fragments starts at the first requested one and does not reach the never sent ones.
+    std::vector<FragmentNumber_t> found;
+    unsent.for_each([&found](FragmentNumber_t fn)
+    {
+        found.push_back(fn);
+    });
+    ASSERT_EQ(found, std::vector<FragmentNumber_t>({ 10, 57, 200 }));
+
+    // Once the requested fragments are sent again, the window moves to the never sent ones.
+    rproxy.mark_fragment_as_sent_for_change(SequenceNumber_t(0, 3), 10, was_last_fragment);
+    rproxy.mark_fragment_as_sent_for_change(SequenceNumber_t(0, 3), 57, was_last_fragment);
+    rproxy.mark_fragment_as_sent_for_change(SequenceNumber_t(0, 3), 200, was_last_fragment);
+    rproxy.for_each_unsent_change(SequenceNumber_t(0, 4),
+            [&unsent](const SequenceNumber_t& seq_num, const ChangeForReader_t* change)
+    {
+        if (change != nullptr && seq_num == SequenceNumber_t(0, 3))
+        {
+            unsent = change->getUnsentFragments();
+        }
+    });
+    std::vector<FragmentNumber_t> expected;
+    for (FragmentNumber_t fn = 601; fn < 601 + 256; ++fn)
+    {
+        expected.push_back(fn);
+    }
+    found.clear();
+    unsent.for_each([&found](FragmentNumber_t fn)
+    {
+        found.push_back(fn);
+    });
+    ASSERT_EQ(found, expected);
+}
+
 } // namespace rtps
 } // namespace fastrtps
 } // namespace eprosima
@@ -0,0 +1,275 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/utils/Semaphore.h>
+#include <fastrtps/transport/SharedMemTransport.h>
+#include <fastrtps/transport/UDPv4TransportDescriptor.h>
+#include <fastrtps/rtps/network/NetworkFactory.h>
+#include <fastrtps/utils/IPLocator.h>
+#include <fastrtps/log/Log.h>
+#include <gtest/gtest.h>
+#include <thread>
+#include <memory>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <MockReceiverResource.h>
+#include "../../../src/cpp/transport/SharedMemPort.hpp"
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+static uint16_t g_default_port = 0;
+
+uint16_t get_port()
+{
+    uint16_t port = static_cast<uint16_t>(getpid());
+
+    if(4000 > port)
+    {
+        port += 4000;
+    }
+
+    return port;
+}
+
+class SharedMemTests: public ::testing::Test
+{
+    public:
+
+        SharedMemTransportDescriptor descriptor;
+        std::unique_ptr<std::thread> senderThread;
+};
+
+TEST_F(SharedMemTests, locators_with_kind_16_supported)
+{
+    // Given
+    SharedMemTransport transportUnderTest(descriptor);
+    ASSERT_TRUE(transportUnderTest.init());
+
+    Locator_t supportedLocator;
+    supportedLocator.kind = LOCATOR_KIND_SHM;
+    Locator_t unsupportedLocator;
+    unsupportedLocator.kind = LOCATOR_KIND_UDPv4;
+
+    // Then
+    ASSERT_TRUE(transportUnderTest.IsLocatorSupported(supportedLocator));
+    ASSERT_FALSE(transportUnderTest.IsLocatorSupported(unsupportedLocator));
+}
+
+TEST_F(SharedMemTests, opening_and_closing_input_channel)
+{
+    // Given
+    SharedMemTransport transportUnderTest(descriptor);
+    ASSERT_TRUE(transportUnderTest.init());
+
+    Locator_t inputLocator(LOCATOR_KIND_SHM, g_default_port);
+    transportUnderTest.fill_host_id(inputLocator);
+
+    // Then
+    ASSERT_FALSE (transportUnderTest.IsInputChannelOpen(inputLocator));
+    ASSERT_TRUE  (transportUnderTest.OpenInputChannel(inputLocator, nullptr, 0x8FFF));
+    ASSERT_TRUE  (transportUnderTest.IsInputChannelOpen(inputLocator));
+    ASSERT_TRUE  (transportUnderTest.CloseInputChannel(inputLocator));
+    ASSERT_FALSE (transportUnderTest.IsInputChannelOpen(inputLocator));
+    ASSERT_FALSE (transportUnderTest.CloseInputChannel(inputLocator));
+}
+
+TEST_F(SharedMemTests, port_already_in_use_cannot_be_opened)
+{
+    SharedMemTransport firstTransport(descriptor);
+    ASSERT_TRUE(firstTransport.init());
+    SharedMemTransport secondTransport(descriptor);
+    ASSERT_TRUE(secondTransport.init());
+
+    Locator_t inputLocator(LOCATOR_KIND_SHM, g_default_port);
+    firstTransport.fill_host_id(inputLocator);
+
+    ASSERT_TRUE (firstTransport.OpenInputChannel(inputLocator, nullptr, 0x8FFF));
+    ASSERT_FALSE(secondTransport.OpenInputChannel(inputLocator, nullptr, 0x8FFF));
+    ASSERT_TRUE (firstTransport.CloseInputChannel(inputLocator));
+    ASSERT_TRUE (secondTransport.OpenInputChannel(inputLocator, nullptr, 0x8FFF));
+    ASSERT_TRUE (secondTransport.CloseInputChannel(inputLocator));
+}
+
+TEST_F(SharedMemTests, send_and_receive_between_transports)
+{
+    SharedMemTransport receiverTransport(descriptor);
+    ASSERT_TRUE(receiverTransport.init());
+    SharedMemTransport senderTransport(descriptor);
+    ASSERT_TRUE(senderTransport.init());
+
+    Locator_t inputLocator(LOCATOR_KIND_SHM, g_default_port);
+    receiverTransport.fill_host_id(inputLocator);
+
+    MockReceiverResource receiver(receiverTransport, inputLocator);
+    MockMessageReceiver *msg_recv = dynamic_cast<MockMessageReceiver*>(receiver.CreateMessageReceiver());
+    ASSERT_TRUE(receiverTransport.IsInputChannelOpen(inputLocator));
+
+    SendResourceList send_resource_list;
+    ASSERT_TRUE(senderTransport.OpenOutputChannel(send_resource_list, inputLocator));
+    ASSERT_EQ(send_resource_list.size(), 1u);
+    ASSERT_TRUE(senderTransport.OpenOutputChannel(send_resource_list, inputLocator));
+    ASSERT_EQ(send_resource_list.size(), 1u);
+
+    octet message[5] = { 'H','e','l','l','o' };
+
+    Semaphore sem;
+    std::function<void()> recCallback = [&]()
+    {
+        EXPECT_EQ(memcmp(message,msg_recv->data,5), 0);
+        sem.post();
+    };
+
+    msg_recv->setCallback(recCallback);
+
+    auto sendThreadFunction = [&]()
+    {
+        EXPECT_TRUE(send_resource_list.at(0)->send(message, 5, inputLocator));
+    };
+
+    senderThread.reset(new std::thread(sendThreadFunction));
+    senderThread->join();
+    sem.wait();
+}
+
+TEST_F(SharedMemTests, send_to_closed_port_fails)
+{
+    SharedMemTransport transportUnderTest(descriptor);
+    ASSERT_TRUE(transportUnderTest.init());
+
+    Locator_t remoteLocator(LOCATOR_KIND_SHM, g_default_port + 1);
+    transportUnderTest.fill_host_id(remoteLocator);
+
+    octet message[5] = { 'H','e','l','l','o' };
+    ASSERT_FALSE(transportUnderTest.send(message, 5, remoteLocator));
+}
+
+TEST_F(SharedMemTests, stale_port_is_replaced_by_a_fresh_segment)
+{
+    uint16_t port = g_default_port + 2;
+    int listening[2];
+    int crash[2];
+    ASSERT_EQ(pipe(listening), 0);
+    ASSERT_EQ(pipe(crash), 0);
+
+    pid_t listener_pid = fork();
+    ASSERT_GE(listener_pid, 0);
+    if (listener_pid == 0)
+    {
+        // Listen, then die without closing the port
+        std::shared_ptr<SharedMemPort> crashed_listener = SharedMemPort::open_listener(port, 4, 64);
+        char opened = crashed_listener ? 1 : 0;
+        char unused;
+        (void)!write(listening[1], &opened, 1);
+        (void)!read(crash[0], &unused, 1);
+        _exit(0);
+    }
+
+    char opened = 0;
+    ASSERT_EQ(read(listening[0], &opened, 1), 1);
+    ASSERT_EQ(opened, 1);
+    std::shared_ptr<SharedMemPort> old_sender = SharedMemPort::open_sender(port);
+    ASSERT_TRUE(old_sender != nullptr);
+    ASSERT_EQ(write(crash[1], &opened, 1), 1);
+    waitpid(listener_pid, nullptr, 0);
+
+    // Wait for the period between liveness checks
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_FALSE(old_sender->listener_alive());
+
+    std::shared_ptr<SharedMemPort> listener = SharedMemPort::open_listener(port, 4, 64);
+    ASSERT_TRUE(listener != nullptr);
+
+    // The stale segment still mapped by the old sender is not the one being listened
+    octet message[5] = { 'H','e','l','l','o' };
+    octet buffer[64];
+    uint32_t size = 0;
+    EXPECT_TRUE(old_sender->push(message, 5));
+    EXPECT_FALSE(listener->pop(buffer, sizeof(buffer), size, 10));
+
+    std::shared_ptr<SharedMemPort> sender = SharedMemPort::open_sender(port);
+    ASSERT_TRUE(sender != nullptr);
+    EXPECT_TRUE(sender->push(message, 5));
+    ASSERT_TRUE(listener->pop(buffer, sizeof(buffer), size, 100));
+    EXPECT_EQ(size, 5u);
+    EXPECT_EQ(memcmp(message, buffer, 5), 0);
+
+    close(listening[0]);
+    close(listening[1]);
+    close(crash[0]);
+    close(crash[1]);
+}
+
+TEST_F(SharedMemTests, only_locators_of_this_host_are_local)
+{
+    SharedMemTransport transportUnderTest(descriptor);
+    ASSERT_TRUE(transportUnderTest.init());
+
+    Locator_t localLocator(LOCATOR_KIND_SHM, g_default_port);
+    transportUnderTest.fill_host_id(localLocator);
+    Locator_t remoteLocator(localLocator);
+    remoteLocator.address[15] ^= 0xFF;
+
+    ASSERT_TRUE(transportUnderTest.is_local_locator(localLocator));
+    ASSERT_FALSE(transportUnderTest.is_local_locator(remoteLocator));
+    ASSERT_FALSE(IPLocator::isMulticast(localLocator));
+
+    LocatorList_t list;
+    list.push_back(remoteLocator);
+    list.push_back(localLocator);
+    LocatorList_t result = transportUnderTest.ShrinkLocatorLists({list, list});
+    ASSERT_EQ(result.size(), 1u);
+    ASSERT_TRUE(*result.begin() == localLocator);
+}
+
+TEST_F(SharedMemTests, network_factory_prefers_shared_memory_locators)
+{
+    NetworkFactory factory;
+    UDPv4TransportDescriptor udp_descriptor;
+    ASSERT_TRUE(factory.RegisterTransport(&udp_descriptor));
+    ASSERT_TRUE(factory.RegisterTransport(&descriptor));
+
+    SharedMemTransport transport(descriptor);
+    Locator_t shmLocator(LOCATOR_KIND_SHM, g_default_port);
+    transport.fill_host_id(shmLocator);
+    Locator_t udpLocator(LOCATOR_KIND_UDPv4, g_default_port);
+    IPLocator::setIPv4(udpLocator, 127, 0, 0, 1);
+
+    LocatorList_t sameHostList;
+    sameHostList.push_back(udpLocator);
+    sameHostList.push_back(shmLocator);
+
+    LocatorList_t result = factory.ShrinkLocatorLists({sameHostList});
+    ASSERT_EQ(result.size(), 1u);
+    ASSERT_TRUE(*result.begin() == shmLocator);
+
+    Locator_t otherHostShmLocator(shmLocator);
+    otherHostShmLocator.address[15] ^= 0xFF;
+    LocatorList_t otherHostList;
+    otherHostList.push_back(udpLocator);
+    otherHostList.push_back(otherHostShmLocator);
+
+    result = factory.ShrinkLocatorLists({otherHostList});
+    ASSERT_EQ(result.size(), 1u);
+    ASSERT_TRUE(*result.begin() == udpLocator);
+}
+
+int main(int argc, char **argv)
+{
+    Log::SetVerbosity(Log::Warning);
+    g_default_port = get_port();
+
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,120 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/transport/tcp/RTCPMessageManager.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+//! Reference result, adding the bytes one at a time.
+static uint32_t per_byte_crc(
+        uint32_t crc,
+        const octet* data,
+        size_t size)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        crc = RTCPMessageManager::addToCRC(crc, data[i]);
+    }
+    return crc;
+}
+
+TEST(TCPChecksumTests, buffer_crc_matches_per_byte_crc)
+{
+    std::mt19937 generator(7410);
+    std::vector<octet> buffer(70000);
+    for (octet& value : buffer)
+    {
+        value = static_cast<octet>(generator());
+    }
+
+    const uint32_t initial_values[] = { 0u, 1u, 0x12345678u, 0xFFFFFF00u, 0xFFFFFFFFu };
+
+    for (uint32_t initial : initial_values)
+    {
+        // Every size around the word boundaries and some big ones, at every alignment
+        for (size_t size : { 0, 1, 7, 8, 9, 15, 16, 17, 63, 64, 65, 1023, 1024, 1025, 65536 })
+        {
+            for (size_t offset = 0; offset < 8; ++offset)
+            {
+                EXPECT_EQ(per_byte_crc(initial, &buffer[offset], size),
+                    RTCPMessageManager::addToCRC(initial, &buffer[offset], size));
+            }
+        }
+    }
+}
+
+TEST(TCPChecksumTests, buffer_crc_matches_per_byte_crc_when_wrapping)
+{
+    // Forces the end-around carry many times
+    std::vector<octet> buffer(20u * 1024u * 1024u, 0xFF);
+    EXPECT_EQ(per_byte_crc(0, buffer.data(), buffer.size()),
+        RTCPMessageManager::addToCRC(0, buffer.data(), buffer.size()));
+
+    std::vector<octet> zeros(1000, 0);
+    EXPECT_EQ(0u, RTCPMessageManager::addToCRC(0, zeros.data(), zeros.size()));
+    EXPECT_EQ(0xFFFFFFFFu, RTCPMessageManager::addToCRC(0xFFFFFFFFu, zeros.data(), zeros.size()));
+}
+
+TEST(TCPChecksumTests, benchmark)
+{
+    std::mt19937 generator(7411);
+    const size_t bytes_per_size = 64u * 1024u * 1024u;
+
+    std::cout << "    Size    Per byte (MB/s)    Buffer (MB/s)" << std::endl;
+    for (size_t size = 64; size <= 4u * 1024u * 1024u; size *= 4)
+    {
+        std::vector<octet> buffer(size);
+        for (octet& value : buffer)
+        {
+            value = static_cast<octet>(generator());
+        }
+
+        size_t repetitions = bytes_per_size / size;
+        uint32_t per_byte_result = 0;
+        uint32_t buffer_result = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < repetitions; ++i)
+        {
+            per_byte_result ^= per_byte_crc(0, buffer.data(), size);
+        }
+        auto middle = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < repetitions; ++i)
+        {
+            buffer_result ^= RTCPMessageManager::addToCRC(0, buffer.data(), size);
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        EXPECT_EQ(per_byte_result, buffer_result);
+
+        double megabytes = static_cast<double>(size * repetitions) / (1024.0 * 1024.0);
+        std::cout << std::setw(8) << size << "    " <<
+            std::setw(15) << megabytes / std::chrono::duration<double>(middle - start).count() << "    " <<
+            std::setw(13) << megabytes / std::chrono::duration<double>(end - middle).count() << std::endl;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
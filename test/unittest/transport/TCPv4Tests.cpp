@@ -234,6 +234,227 @@ TEST_F(TCPv4Tests, send_and_receive_between_ports)
     senderThread->join();
     sem.wait();
 }
+
+TEST_F(TCPv4Tests, send_and_receive_through_send_queue)
+{
+    TCPv4TransportDescriptor recvDescriptor;
+    recvDescriptor.add_listener_port(g_default_port);
+    recvDescriptor.wait_for_tcp_negotiation = true;
+    recvDescriptor.send_queue_capacity = 16;
+    TCPv4Transport receiveTransportUnderTest(recvDescriptor);
+    receiveTransportUnderTest.init();
+
+    TCPv4TransportDescriptor sendDescriptor;
+    sendDescriptor.wait_for_tcp_negotiation = true;
+    sendDescriptor.send_queue_capacity = 16;
+    sendDescriptor.send_queue_overflow_policy = TCPTransportDescriptor::BLOCK;
+    TCPv4Transport sendTransportUnderTest(sendDescriptor);
+    sendTransportUnderTest.init();
+
+    Locator_t inputLocator;
+    inputLocator.kind = LOCATOR_KIND_TCPv4;
+    inputLocator.port = g_default_port;
+    IPLocator::setIPv4(inputLocator, 127, 0, 0, 1);
+    IPLocator::setLogicalPort(inputLocator, 7410);
+
+    Locator_t outputLocator;
+    outputLocator.kind = LOCATOR_KIND_TCPv4;
+    IPLocator::setIPv4(outputLocator, 127, 0, 0, 1);
+    outputLocator.port = g_default_port;
+    IPLocator::setLogicalPort(outputLocator, 7410);
+
+    MockReceiverResource receiver(receiveTransportUnderTest, inputLocator);
+    MockMessageReceiver *msg_recv = dynamic_cast<MockMessageReceiver*>(receiver.CreateMessageReceiver());
+    ASSERT_TRUE(receiveTransportUnderTest.IsInputChannelOpen(inputLocator));
+
+    SendResourceList send_resource_list;
+    ASSERT_TRUE(sendTransportUnderTest.OpenOutputChannel(send_resource_list, outputLocator));
+    ASSERT_FALSE(send_resource_list.empty());
+    octet message[5] = { 'H','e','l','l','o' };
+    const int num_messages = 100;
+
+    // Queued messages are written in order
+    Semaphore sem;
+    int received = 0;
+    std::function<void()> recCallback = [&]()
+    {
+        EXPECT_EQ(memcmp(message, msg_recv->data, 4), 0);
+        EXPECT_EQ(msg_recv->data[4], static_cast<octet>(received));
+        if (++received == num_messages)
+        {
+            sem.post();
+        }
+    };
+
+    msg_recv->setCallback(recCallback);
+
+    auto sendThreadFunction = [&]()
+    {
+        bool sent = false;
+        message[4] = 0;
+        while (!sent)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            sent = send_resource_list.at(0)->send(message, 5, inputLocator);
+        }
+
+        for (int i = 1; i < num_messages; ++i)
+        {
+            message[4] = static_cast<octet>(i);
+            EXPECT_TRUE(send_resource_list.at(0)->send(message, 5, inputLocator));
+        }
+    };
+
+    senderThread.reset(new std::thread(sendThreadFunction));
+    senderThread->join();
+    sem.wait();
+}
+
+TEST_F(TCPv4Tests, send_and_receive_with_async_receive_threads)
+{
+    TCPv4TransportDescriptor recvDescriptor;
+    recvDescriptor.add_listener_port(g_default_port);
+    recvDescriptor.wait_for_tcp_negotiation = true;
+    recvDescriptor.async_receive_threads = 2;
+    TCPv4Transport receiveTransportUnderTest(recvDescriptor);
+    receiveTransportUnderTest.init();
+
+    TCPv4TransportDescriptor sendDescriptor;
+    sendDescriptor.wait_for_tcp_negotiation = true;
+    sendDescriptor.async_receive_threads = 2;
+    TCPv4Transport sendTransportUnderTest(sendDescriptor);
+    sendTransportUnderTest.init();
+
+    Locator_t inputLocator;
+    inputLocator.kind = LOCATOR_KIND_TCPv4;
+    inputLocator.port = g_default_port;
+    IPLocator::setIPv4(inputLocator, 127, 0, 0, 1);
+    IPLocator::setLogicalPort(inputLocator, 7410);
+
+    Locator_t outputLocator;
+    outputLocator.kind = LOCATOR_KIND_TCPv4;
+    IPLocator::setIPv4(outputLocator, 127, 0, 0, 1);
+    outputLocator.port = g_default_port;
+    IPLocator::setLogicalPort(outputLocator, 7410);
+
+    MockReceiverResource receiver(receiveTransportUnderTest, inputLocator);
+    MockMessageReceiver *msg_recv = dynamic_cast<MockMessageReceiver*>(receiver.CreateMessageReceiver());
+    ASSERT_TRUE(receiveTransportUnderTest.IsInputChannelOpen(inputLocator));
+
+    SendResourceList send_resource_list;
+    ASSERT_TRUE(sendTransportUnderTest.OpenOutputChannel(send_resource_list, outputLocator));
+    ASSERT_FALSE(send_resource_list.empty());
+    octet message[5] = { 'H','e','l','l','o' };
+    const int num_messages = 100;
+
+    // Messages of a channel are read in order, even with several receiving threads
+    Semaphore sem;
+    int received = 0;
+    std::function<void()> recCallback = [&]()
+    {
+        EXPECT_EQ(memcmp(message, msg_recv->data, 4), 0);
+        EXPECT_EQ(msg_recv->data[4], static_cast<octet>(received));
+        if (++received == num_messages)
+        {
+            sem.post();
+        }
+    };
+
+    msg_recv->setCallback(recCallback);
+
+    auto sendThreadFunction = [&]()
+    {
+        bool sent = false;
+        message[4] = 0;
+        while (!sent)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            sent = send_resource_list.at(0)->send(message, 5, inputLocator);
+        }
+        for (int i = 1; i < num_messages; ++i)
+        {
+            message[4] = static_cast<octet>(i);
+            EXPECT_TRUE(send_resource_list.at(0)->send(message, 5, inputLocator));
+        }
+    };
+
+    senderThread.reset(new std::thread(sendThreadFunction));
+    senderThread->join();
+    sem.wait();
+}
+
+TEST_F(TCPv4Tests, send_and_receive_coalesced_messages)
+{
+    TCPv4TransportDescriptor recvDescriptor;
+    recvDescriptor.add_listener_port(g_default_port);
+    recvDescriptor.wait_for_tcp_negotiation = true;
+    TCPv4Transport receiveTransportUnderTest(recvDescriptor);
+    receiveTransportUnderTest.init();
+
+    TCPv4TransportDescriptor sendDescriptor;
+    sendDescriptor.wait_for_tcp_negotiation = true;
+    sendDescriptor.coalescing_max_size = 1024;
+    sendDescriptor.coalescing_delay_us = 1000;
+    TCPv4Transport sendTransportUnderTest(sendDescriptor);
+    sendTransportUnderTest.init();
+
+    Locator_t inputLocator;
+    inputLocator.kind = LOCATOR_KIND_TCPv4;
+    inputLocator.port = g_default_port;
+    IPLocator::setIPv4(inputLocator, 127, 0, 0, 1);
+    IPLocator::setLogicalPort(inputLocator, 7410);
+
+    Locator_t outputLocator;
+    outputLocator.kind = LOCATOR_KIND_TCPv4;
+    IPLocator::setIPv4(outputLocator, 127, 0, 0, 1);
+    outputLocator.port = g_default_port;
+    IPLocator::setLogicalPort(outputLocator, 7410);
+
+    MockReceiverResource receiver(receiveTransportUnderTest, inputLocator);
+    MockMessageReceiver *msg_recv = dynamic_cast<MockMessageReceiver*>(receiver.CreateMessageReceiver());
+    ASSERT_TRUE(receiveTransportUnderTest.IsInputChannelOpen(inputLocator));
+
+    SendResourceList send_resource_list;
+    ASSERT_TRUE(sendTransportUnderTest.OpenOutputChannel(send_resource_list, outputLocator));
+    ASSERT_FALSE(send_resource_list.empty());
+    octet message[5] = { 'H','e','l','l','o' };
+    const int num_messages = 100;
+
+    // Gathered messages keep their headers, so they are received one by one and in order
+    Semaphore sem;
+    int received = 0;
+    std::function<void()> recCallback = [&]()
+    {
+        EXPECT_EQ(memcmp(message, msg_recv->data, 4), 0);
+        EXPECT_EQ(msg_recv->data[4], static_cast<octet>(received));
+        if (++received == num_messages)
+        {
+            sem.post();
+        }
+    };
+
+    msg_recv->setCallback(recCallback);
+
+    auto sendThreadFunction = [&]()
+    {
+        bool sent = false;
+        message[4] = 0;
+        while (!sent)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            sent = send_resource_list.at(0)->send(message, 5, inputLocator);
+        }
+        for (int i = 1; i < num_messages; ++i)
+        {
+            message[4] = static_cast<octet>(i);
+            EXPECT_TRUE(send_resource_list.at(0)->send(message, 5, inputLocator));
+        }
+    };
+
+    senderThread.reset(new std::thread(sendThreadFunction));
+    senderThread->join();
+    sem.wait();
+}
 #endif
 
 TEST_F(TCPv4Tests, send_is_rejected_if_buffer_size_is_bigger_to_size_specified_in_descriptor)
@@ -510,6 +731,82 @@ TEST_F(TCPv4Tests, send_and_receive_between_secure_ports_client_verifies)
     }
 }
 
+// The negotiation replies are sent through the secure channel, which needs the only io_service thread.
+TEST_F(TCPv4Tests, send_and_receive_between_secure_ports_with_one_async_receive_thread)
+{
+    using TLSOptions = TCPTransportDescriptor::TLSConfig::TLSOptions;
+    using TLSVerifyMode = TCPTransportDescriptor::TLSConfig::TLSVerifyMode;
+
+    TCPv4TransportDescriptor recvDescriptor;
+    recvDescriptor.add_listener_port(g_default_port);
+    recvDescriptor.apply_security = true;
+    recvDescriptor.async_receive_threads = 1;
+    recvDescriptor.tls_config.password = "test";
+    recvDescriptor.tls_config.cert_chain_file = "server.pem";
+    recvDescriptor.tls_config.private_key_file = "server.pem";
+    recvDescriptor.tls_config.tmp_dh_file = "dh2048.pem";
+    recvDescriptor.tls_config.add_option(TLSOptions::DEFAULT_WORKAROUNDS);
+    recvDescriptor.tls_config.add_option(TLSOptions::SINGLE_DH_USE);
+    recvDescriptor.tls_config.add_option(TLSOptions::NO_SSLV2);
+    TCPv4Transport receiveTransportUnderTest(recvDescriptor);
+    receiveTransportUnderTest.init();
+
+    TCPv4TransportDescriptor sendDescriptor;
+    sendDescriptor.apply_security = true;
+    sendDescriptor.async_receive_threads = 1;
+    sendDescriptor.tls_config.verify_file = "ca.pem";
+    sendDescriptor.tls_config.verify_mode = TLSVerifyMode::VERIFY_PEER;
+    TCPv4Transport sendTransportUnderTest(sendDescriptor);
+    sendTransportUnderTest.init();
+
+    Locator_t inputLocator;
+    inputLocator.kind = LOCATOR_KIND_TCPv4;
+    inputLocator.port = g_default_port;
+    IPLocator::setIPv4(inputLocator, 127, 0, 0, 1);
+    IPLocator::setLogicalPort(inputLocator, 7410);
+
+    Locator_t outputLocator;
+    outputLocator.kind = LOCATOR_KIND_TCPv4;
+    IPLocator::setIPv4(outputLocator, 127, 0, 0, 1);
+    outputLocator.port = g_default_port;
+    IPLocator::setLogicalPort(outputLocator, 7410);
+
+    {
+        MockReceiverResource receiver(receiveTransportUnderTest, inputLocator);
+        MockMessageReceiver *msg_recv = dynamic_cast<MockMessageReceiver*>(receiver.CreateMessageReceiver());
+        ASSERT_TRUE(receiveTransportUnderTest.IsInputChannelOpen(inputLocator));
+
+        SendResourceList send_resource_list;
+        ASSERT_TRUE(sendTransportUnderTest.OpenOutputChannel(send_resource_list, outputLocator));
+        ASSERT_FALSE(send_resource_list.empty());
+        octet message[5] = { 'H','e','l','l','o' };
+
+        Semaphore sem;
+        std::function<void()> recCallback = [&]()
+        {
+            EXPECT_EQ(memcmp(message, msg_recv->data, 5), 0);
+            sem.post();
+        };
+
+        msg_recv->setCallback(recCallback);
+
+        auto sendThreadFunction = [&]()
+        {
+            bool sent = send_resource_list.at(0)->send(message, 5, inputLocator);
+            for (int retries = 0; !sent && retries < 50; ++retries)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                sent = send_resource_list.at(0)->send(message, 5, inputLocator);
+            }
+            EXPECT_TRUE(sent);
+        };
+
+        senderThread.reset(new std::thread(sendThreadFunction));
+        senderThread->join();
+        sem.wait();
+    }
+}
+
 TEST_F(TCPv4Tests, send_and_receive_between_secure_ports_server_verifies)
 {
     Log::SetVerbosity(Log::Kind::Info);
@@ -17,6 +17,9 @@
 #include <fastrtps/rtps/network/NetworkFactory.h>
 #include <gtest/gtest.h>
 #include <thread>
+#include <atomic>
+#include <map>
+#include <set>
 #include <fastrtps/utils/IPFinder.h>
 #include <fastrtps/utils/IPLocator.h>
 //#include <fastrtps/log/Log.h>
@@ -217,6 +220,150 @@ TEST_F(UDPv4Tests, send_to_loopback)
     senderThread->join();
     sem.wait();
 }
+
+TEST_F(UDPv4Tests, send_and_receive_in_order_with_receive_batch)
+{
+    descriptor.receive_batch_size = 4;
+    UDPv4Transport transportUnderTest(descriptor);
+    transportUnderTest.init();
+
+    Locator_t inputLocator;
+    inputLocator.port = g_default_port;
+    inputLocator.kind = LOCATOR_KIND_UDPv4;
+    IPLocator::setIPv4(inputLocator, 127, 0, 0, 1);
+
+    MockReceiverResource receiver(transportUnderTest, inputLocator);
+    MockMessageReceiver *msg_recv = dynamic_cast<MockMessageReceiver*>(receiver.CreateMessageReceiver());
+
+    SendResourceList send_resource_list;
+    ASSERT_TRUE(transportUnderTest.OpenOutputChannel(send_resource_list, inputLocator));
+    ASSERT_FALSE(send_resource_list.empty());
+
+    const octet num_messages = 10;
+    octet expected = 0;
+    Semaphore sem;
+    std::function<void()> recCallback = [&]()
+    {
+        EXPECT_EQ(msg_recv->data[4], expected);
+        if (++expected == num_messages)
+        {
+            sem.post();
+        }
+    };
+
+    msg_recv->setCallback(recCallback);
+
+    auto sendThreadFunction = [&]()
+    {
+        for (octet i = 0; i < num_messages; ++i)
+        {
+            octet message[5] = { 'H','e','l','l', i };
+            EXPECT_TRUE(send_resource_list.at(0)->send(message, 5, inputLocator));
+        }
+    };
+
+    senderThread.reset(new std::thread(sendThreadFunction));
+    senderThread->join();
+    sem.wait();
+}
+
+#if defined(__linux__)
+TEST_F(UDPv4Tests, messages_of_a_participant_are_read_by_the_same_socket_with_guid_prefix_steering)
+{
+    descriptor.sendBufferSize = 65536;
+    descriptor.receiveBufferSize = 65536;
+    descriptor.receive_socket_count = 4;
+    descriptor.steer_by_guid_prefix = true;
+    UDPv4Transport transportUnderTest(descriptor);
+    ASSERT_TRUE(transportUnderTest.init());
+
+    Locator_t inputLocator;
+    inputLocator.port = g_default_port;
+    inputLocator.kind = LOCATOR_KIND_UDPv4;
+    IPLocator::setIPv4(inputLocator, 127, 0, 0, 1);
+
+    MockReceiverResource receiver(transportUnderTest, inputLocator);
+    MockMessageReceiver *msg_recv = dynamic_cast<MockMessageReceiver*>(receiver.CreateMessageReceiver());
+    ASSERT_TRUE(transportUnderTest.IsInputChannelOpen(inputLocator));
+
+    // Nobody else can join the sockets of the port
+    {
+        UDPv4Transport otherTransport(descriptor);
+        ASSERT_TRUE(otherTransport.init());
+        MockReceiverResource otherReceiver(otherTransport, inputLocator);
+        EXPECT_FALSE(otherTransport.IsInputChannelOpen(inputLocator));
+    }
+
+    SendResourceList send_resource_list;
+    ASSERT_TRUE(transportUnderTest.OpenOutputChannel(send_resource_list, inputLocator));
+    ASSERT_FALSE(send_resource_list.empty());
+
+    std::map<octet, std::set<std::thread::id>> threads_per_participant;
+    Semaphore sem;
+    std::function<void()> recCallback = [&]()
+    {
+        threads_per_participant[msg_recv->data[12]].insert(std::this_thread::get_id());
+        sem.post();
+    };
+
+    msg_recv->setCallback(recCallback);
+
+    // RTPS header whose GuidPrefix only changes in the byte of the process id
+    octet message[RTPSMESSAGE_HEADER_SIZE] = { 'R','T','P','S', 2, 3, 1, 15 };
+    for (uint32_t round = 0; round < 4; ++round)
+    {
+        for (octet participant = 0; participant < 8; ++participant)
+        {
+            message[12] = participant;
+            EXPECT_TRUE(send_resource_list.at(0)->send(message, RTPSMESSAGE_HEADER_SIZE, inputLocator));
+            sem.wait();
+        }
+    }
+
+    std::set<std::thread::id> threads;
+    for (const auto& participant : threads_per_participant)
+    {
+        EXPECT_EQ(participant.second.size(), 1u);
+        threads.insert(participant.second.begin(), participant.second.end());
+    }
+    EXPECT_EQ(threads_per_participant.size(), 8u);
+    EXPECT_EQ(threads.size(), 4u);
+}
+#endif
+
+TEST_F(UDPv4Tests, received_messages_carry_reception_timestamp)
+{
+    descriptor.enable_receive_timestamps = true;
+    UDPv4Transport transportUnderTest(descriptor);
+    transportUnderTest.init();
+
+    Locator_t inputLocator;
+    inputLocator.port = g_default_port;
+    inputLocator.kind = LOCATOR_KIND_UDPv4;
+    IPLocator::setIPv4(inputLocator, 127, 0, 0, 1);
+
+    MockReceiverResource receiver(transportUnderTest, inputLocator);
+    MockMessageReceiver *msg_recv = dynamic_cast<MockMessageReceiver*>(receiver.CreateMessageReceiver());
+
+    SendResourceList send_resource_list;
+    ASSERT_TRUE(transportUnderTest.OpenOutputChannel(send_resource_list, inputLocator));
+    ASSERT_FALSE(send_resource_list.empty());
+
+    Semaphore sem;
+    msg_recv->setCallback([&]() { sem.post(); });
+
+    int64_t before = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    octet message[5] = { 'H','e','l','l','o' };
+    EXPECT_TRUE(send_resource_list.at(0)->send(message, 5, inputLocator));
+    sem.wait();
+    int64_t after = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    int64_t stamp = receiver.reception_timestamp.to_ns();
+    EXPECT_GE(stamp, before);
+    EXPECT_LE(stamp, after);
+}
 #endif
 
 TEST_F(UDPv4Tests, send_is_rejected_if_buffer_size_is_bigger_to_size_specified_in_descriptor)
@@ -418,6 +565,107 @@ TEST_F(UDPv4Tests, send_and_receive_between_allowed_sockets_using_localhost)
     sem.wait();
 }
 
+TEST_F(UDPv4Tests, send_to_several_locators_at_once)
+{
+    descriptor.interfaceWhiteList.emplace_back("127.0.0.1");
+    UDPv4Transport transportUnderTest(descriptor);
+    transportUnderTest.init();
+
+    Locator_t firstLocator;
+    firstLocator.port = g_default_port;
+    firstLocator.kind = LOCATOR_KIND_UDPv4;
+    IPLocator::setIPv4(firstLocator, "127.0.0.1");
+
+    Locator_t secondLocator(firstLocator);
+    secondLocator.port = g_default_port + 2;
+
+    MockReceiverResource firstReceiver(transportUnderTest, firstLocator);
+    MockMessageReceiver *first_msg_recv = dynamic_cast<MockMessageReceiver*>(firstReceiver.CreateMessageReceiver());
+    MockReceiverResource secondReceiver(transportUnderTest, secondLocator);
+    MockMessageReceiver *second_msg_recv = dynamic_cast<MockMessageReceiver*>(secondReceiver.CreateMessageReceiver());
+
+    SendResourceList send_resource_list;
+    ASSERT_TRUE(transportUnderTest.OpenOutputChannel(send_resource_list, firstLocator));
+    ASSERT_FALSE(send_resource_list.empty());
+    octet message[5] = { 'H','e','l','l','o' };
+
+    Semaphore sem;
+    std::function<void()> firstCallback = [&]()
+    {
+        EXPECT_EQ(memcmp(message, first_msg_recv->data, 5), 0);
+        sem.post();
+    };
+    std::function<void()> secondCallback = [&]()
+    {
+        EXPECT_EQ(memcmp(message, second_msg_recv->data, 5), 0);
+        sem.post();
+    };
+
+    first_msg_recv->setCallback(firstCallback);
+    second_msg_recv->setCallback(secondCallback);
+
+    LocatorList_t destinations;
+    destinations.push_back(firstLocator);
+    destinations.push_back(secondLocator);
+
+    auto sendThreadFunction = [&]()
+    {
+        EXPECT_TRUE(send_resource_list.at(0)->send(message, 5, destinations));
+    };
+
+    senderThread.reset(new std::thread(sendThreadFunction));
+    senderThread->join();
+    sem.wait();
+    sem.wait();
+}
+
+TEST_F(UDPv4Tests, slices_of_a_message_are_received_as_a_single_datagram)
+{
+    descriptor.interfaceWhiteList.emplace_back("127.0.0.1");
+    UDPv4Transport transportUnderTest(descriptor);
+    transportUnderTest.init();
+
+    Locator_t outputChannelLocator;
+    outputChannelLocator.port = g_default_port;
+    outputChannelLocator.kind = LOCATOR_KIND_UDPv4;
+    IPLocator::setIPv4(outputChannelLocator, "127.0.0.1");
+
+    MockReceiverResource receiver(transportUnderTest, outputChannelLocator);
+    MockMessageReceiver *msg_recv = dynamic_cast<MockMessageReceiver*>(receiver.CreateMessageReceiver());
+
+    SendResourceList send_resource_list;
+    ASSERT_TRUE(transportUnderTest.OpenOutputChannel(send_resource_list, outputChannelLocator));
+    ASSERT_FALSE(send_resource_list.empty());
+    octet header[2] = { 'H','e' };
+    octet payload[3] = { 'l','l','o' };
+    octet message[5] = { 'H','e','l','l','o' };
+
+    std::vector<NetworkBuffer> buffers;
+    buffers.emplace_back(header, 2);
+    buffers.emplace_back(payload, 3);
+
+    Semaphore sem;
+    std::function<void()> recCallback = [&]()
+    {
+        EXPECT_EQ(memcmp(message, msg_recv->data, 5), 0);
+        sem.post();
+    };
+
+    msg_recv->setCallback(recCallback);
+
+    LocatorList_t destinations;
+    destinations.push_back(outputChannelLocator);
+
+    auto sendThreadFunction = [&]()
+    {
+        EXPECT_TRUE(send_resource_list.at(0)->send(buffers, 5, destinations));
+    };
+
+    senderThread.reset(new std::thread(sendThreadFunction));
+    senderThread->join();
+    sem.wait();
+}
+
 TEST_F(UDPv4Tests, send_and_receive_between_allowed_sockets_using_unicast)
 {
     std::vector<IPFinder::info_IP> interfaces;
@@ -469,6 +717,71 @@ TEST_F(UDPv4Tests, send_and_receive_between_allowed_sockets_using_unicast)
     sem.wait();
 }
 
+TEST_F(UDPv4Tests, unicast_is_sent_only_through_the_egress_interface)
+{
+    std::vector<IPFinder::info_IP> interfaces;
+    GetIP4s(interfaces);
+
+    descriptor.interfaceWhiteList.emplace_back("127.0.0.1");
+    for(const auto& interface : interfaces)
+    {
+        descriptor.interfaceWhiteList.push_back(interface.name);
+    }
+
+    UDPInterfaceOptions loopback_options;
+    loopback_options.address = "127.0.0.1";
+    loopback_options.sendBufferSize = 65536;
+    loopback_options.tos = 0xB8;
+    descriptor.interface_options.push_back(loopback_options);
+
+    UDPv4Transport transportUnderTest(descriptor);
+    ASSERT_TRUE(transportUnderTest.init());
+
+    Locator_t unicastLocator;
+    unicastLocator.port = g_default_port;
+    unicastLocator.kind = LOCATOR_KIND_UDPv4;
+    IPLocator::setIPv4(unicastLocator, "127.0.0.1");
+
+    Locator_t outputChannelLocator;
+    outputChannelLocator.port = g_default_port + 1;
+    outputChannelLocator.kind = LOCATOR_KIND_UDPv4;
+    IPLocator::setIPv4(outputChannelLocator, "127.0.0.1");
+
+    MockReceiverResource receiver(transportUnderTest, unicastLocator);
+    MockMessageReceiver *msg_recv = dynamic_cast<MockMessageReceiver*>(receiver.CreateMessageReceiver());
+
+    SendResourceList send_resource_list;
+    ASSERT_TRUE(transportUnderTest.OpenOutputChannel(send_resource_list, outputChannelLocator));
+    ASSERT_EQ(send_resource_list.size(), interfaces.size() + 1);
+    octet message[5] = { 'H','e','l','l','o' };
+
+    std::atomic<uint32_t> received(0);
+    Semaphore sem;
+    std::function<void()> recCallback = [&]()
+    {
+        EXPECT_EQ(memcmp(message, msg_recv->data, 5), 0);
+        ++received;
+        sem.post();
+    };
+
+    msg_recv->setCallback(recCallback);
+
+    // Every socket is asked to send, but only the loopback one does
+    uint32_t sent = 0;
+    for (auto& send_resource : send_resource_list)
+    {
+        if (send_resource->send(message, 5, unicastLocator))
+        {
+            ++sent;
+        }
+    }
+    EXPECT_EQ(sent, 1u);
+
+    sem.wait();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(received.load(), 1u);
+}
+
 TEST_F(UDPv4Tests, send_and_receive_between_allowed_sockets_using_unicast_to_multicast)
 {
     std::vector<IPFinder::info_IP> interfaces;
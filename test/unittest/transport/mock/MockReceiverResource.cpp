@@ -68,6 +68,13 @@ void MockReceiverResource::OnDataReceived(const octet* buf, const uint32_t size,
     }
 }
 
+void MockReceiverResource::OnDataReceived(const octet* buf, const uint32_t size,
+    const Locator_t& local, const Locator_t& remote, const Time_t& timestamp)
+{
+    reception_timestamp = timestamp;
+    OnDataReceived(buf, size, local, remote);
+}
+
 void MockMessageReceiver::setCallback(std::function<void()> cb)
 {
     this->callback = cb;
@@ -31,10 +31,13 @@ class MockReceiverResource : public ReceiverResource
 public:
     virtual void OnDataReceived(const octet*, const uint32_t,
         const Locator_t&, const Locator_t&) override;
+    virtual void OnDataReceived(const octet*, const uint32_t,
+        const Locator_t&, const Locator_t&, const Time_t&) override;
     MockReceiverResource(TransportInterface& transport, const Locator_t& locator);
     ~MockReceiverResource();
     MessageReceiver* CreateMessageReceiver() override;
     MockMessageReceiver* msg_receiver;
+    Time_t reception_timestamp;
 };
 
 class MockMessageReceiver : public MessageReceiver
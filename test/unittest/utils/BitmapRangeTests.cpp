@@ -241,6 +241,45 @@ TEST_F(BitmapRangeTests, traversal)
     ASSERT_TRUE(items.empty());
 }
 
+TEST_F(BitmapRangeTests, removal)
+{
+    TestType uut(explicit_base);
+    uut.add(explicit_base + 3UL);
+    uut.add(explicit_base + 40UL);
+    uut.add(explicit_base + 200UL);
+
+    // Removing an item out of the range does nothing
+    uut.remove(explicit_base - 1UL);
+    uut.remove(explicit_base + 201UL);
+    ASSERT_EQ(explicit_base + 200UL, uut.max());
+
+    // Removing an item in the middle keeps the maximum
+    uut.remove(explicit_base + 40UL);
+    ASSERT_EQ(explicit_base + 200UL, uut.max());
+
+    // Removing the highest item lowers the maximum to the next one set
+    uut.add(explicit_base + 40UL);
+    uut.remove(explicit_base + 200UL);
+    ASSERT_EQ(explicit_base + 40UL, uut.max());
+    uut.remove(explicit_base + 40UL);
+    ASSERT_EQ(explicit_base + 3UL, uut.max());
+    uut.remove(explicit_base + 3UL);
+    ASSERT_TRUE(uut.empty());
+
+    // Traversal does not find removed items
+    uut.add(explicit_base + 31UL);
+    uut.add(explicit_base + 32UL);
+    uut.remove(explicit_base + 32UL);
+    std::vector<ValueType> items;
+    uut.for_each([&](const ValueType& t)
+    {
+        items.push_back(t);
+    });
+    ASSERT_EQ(1u, items.size());
+    ASSERT_EQ(explicit_base + 31UL, items[0]);
+    ASSERT_EQ(explicit_base + 31UL, uut.max());
+}
+
 int main(int argc, char **argv)
 {
     testing::InitGoogleTest(&argc, argv);
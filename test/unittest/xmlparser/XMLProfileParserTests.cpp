@@ -100,6 +100,8 @@ TEST_F(XMLProfileParserTests, XMLParserParcipant)
     locator.port = 1979;
     EXPECT_EQ(rtps_atts.sendSocketBufferSize, 32u);
     EXPECT_EQ(rtps_atts.listenSocketBufferSize, 1000u);
+    EXPECT_EQ(rtps_atts.receiveWorkerThreads, 2u);
+    EXPECT_EQ(rtps_atts.sendQueueSize, 65536u);
     EXPECT_EQ(builtin.discovery_config.discoveryProtocol, eprosima::fastrtps::rtps::DiscoveryProtocol::SIMPLE);
     EXPECT_EQ(builtin.use_WriterLivelinessProtocol, false);
     EXPECT_EQ(builtin.discovery_config.use_SIMPLE_EndpointDiscoveryProtocol, true);
@@ -169,6 +171,8 @@ TEST_F(XMLProfileParserTests, XMLParserDefaultParcipantProfile)
     locator.port = 1979;
     EXPECT_EQ(rtps_atts.sendSocketBufferSize, 32u);
     EXPECT_EQ(rtps_atts.listenSocketBufferSize, 1000u);
+    EXPECT_EQ(rtps_atts.receiveWorkerThreads, 2u);
+    EXPECT_EQ(rtps_atts.sendQueueSize, 65536u);
     EXPECT_EQ(builtin.discovery_config.discoveryProtocol, eprosima::fastrtps::rtps::DiscoveryProtocol::SIMPLE);
     EXPECT_EQ(builtin.use_WriterLivelinessProtocol, false);
     EXPECT_EQ(builtin.discovery_config.use_SIMPLE_EndpointDiscoveryProtocol, true);
@@ -254,6 +258,13 @@ TEST_F(XMLProfileParserTests, XMLParserPublisher)
     EXPECT_EQ(pub_times.nackResponseDelay, c_TimeZero);
     EXPECT_EQ(pub_times.nackSupressionDuration.seconds, 121);
     EXPECT_EQ(pub_times.nackSupressionDuration.nanosec, 332u);
+    EXPECT_TRUE(pub_times.adaptiveHeartbeat);
+    EXPECT_EQ(pub_times.heartbeatPeriodMin.seconds, 0);
+    EXPECT_EQ(pub_times.heartbeatPeriodMin.nanosec, 20000000u);
+    EXPECT_EQ(pub_times.heartbeatPeriodMax.seconds, 5);
+    EXPECT_EQ(pub_times.heartbeatPeriodMax.nanosec, 0u);
+    EXPECT_EQ(pub_times.nackAggregationWindow.seconds, 0);
+    EXPECT_EQ(pub_times.nackAggregationWindow.nanosec, 50000000u);
     IPLocator::setIPv4(locator, 192, 168, 1, 3);
     locator.port = 197;
     EXPECT_EQ(*(loc_list_it = publisher_atts.unicastLocatorList.begin()), locator);
@@ -322,6 +333,13 @@ TEST_F(XMLProfileParserTests, XMLParserDefaultPublisherProfile)
     EXPECT_EQ(pub_times.nackResponseDelay, c_TimeZero);
     EXPECT_EQ(pub_times.nackSupressionDuration.seconds, 121);
     EXPECT_EQ(pub_times.nackSupressionDuration.nanosec, 332u);
+    EXPECT_TRUE(pub_times.adaptiveHeartbeat);
+    EXPECT_EQ(pub_times.heartbeatPeriodMin.seconds, 0);
+    EXPECT_EQ(pub_times.heartbeatPeriodMin.nanosec, 20000000u);
+    EXPECT_EQ(pub_times.heartbeatPeriodMax.seconds, 5);
+    EXPECT_EQ(pub_times.heartbeatPeriodMax.nanosec, 0u);
+    EXPECT_EQ(pub_times.nackAggregationWindow.seconds, 0);
+    EXPECT_EQ(pub_times.nackAggregationWindow.nanosec, 50000000u);
     IPLocator::setIPv4(locator, 192, 168, 1, 3);
     locator.port = 197;
     EXPECT_EQ(*(loc_list_it = publisher_atts.unicastLocatorList.begin()), locator);
@@ -635,12 +653,44 @@ TEST_F(XMLProfileParserTests, UDP_transport_descriptors_config)
     EXPECT_EQ(descriptor->receiveBufferSize, 8192u);
     EXPECT_EQ(descriptor->TTL, 250u);
     EXPECT_EQ(descriptor->non_blocking_send, true);
+    EXPECT_EQ(descriptor->receive_batch_size, 16u);
+    EXPECT_EQ(descriptor->enable_receive_timestamps, true);
+    EXPECT_EQ(descriptor->receive_socket_count, 4u);
+    EXPECT_EQ(descriptor->steer_by_guid_prefix, true);
     EXPECT_EQ(descriptor->maxMessageSize, 16384u);
     EXPECT_EQ(descriptor->maxInitialPeersRange, 100u);
     EXPECT_EQ(descriptor->interfaceWhiteList.size(), 2u);
     EXPECT_EQ(descriptor->interfaceWhiteList[0], "192.168.1.41");
     EXPECT_EQ(descriptor->interfaceWhiteList[1], "127.0.0.1");
     EXPECT_EQ(descriptor->m_output_udp_socket, 5101u);
+    ASSERT_EQ(descriptor->interface_options.size(), 1u);
+    EXPECT_EQ(descriptor->interface_options[0].address, "192.168.1.41");
+    EXPECT_EQ(descriptor->interface_options[0].sendBufferSize, 32768u);
+    EXPECT_EQ(descriptor->interface_options[0].receiveBufferSize, 65536u);
+    EXPECT_EQ(descriptor->interface_options[0].tos, 184);
+}
+
+TEST_F(XMLProfileParserTests, TCP_transport_descriptors_config)
+{
+    ASSERT_EQ(  xmlparser::XMLP_ret::XML_OK,
+        xmlparser::XMLProfileManager::loadXMLFile("TCP_transport_descriptors_config.xml"));
+
+    xmlparser::sp_transport_t transport = xmlparser::XMLProfileManager::getTransportById("Test");
+
+    using TCPDescriptor = std::shared_ptr<TCPTransportDescriptor>;
+    TCPDescriptor descriptor = std::dynamic_pointer_cast<TCPTransportDescriptor>(transport);
+
+    ASSERT_NE(descriptor, nullptr);
+    EXPECT_EQ(descriptor->keep_alive_frequency_ms, 2000u);
+    EXPECT_EQ(descriptor->keep_alive_timeout_ms, 6000u);
+    EXPECT_EQ(descriptor->enable_tcp_nodelay, true);
+    EXPECT_EQ(descriptor->send_queue_capacity, 64u);
+    EXPECT_EQ(descriptor->send_queue_overflow_policy, TCPTransportDescriptor::DISCONNECT);
+    EXPECT_EQ(descriptor->async_receive_threads, 4u);
+    EXPECT_EQ(descriptor->coalescing_max_size, 8192u);
+    EXPECT_EQ(descriptor->coalescing_delay_us, 250u);
+    ASSERT_EQ(descriptor->listening_ports.size(), 1u);
+    EXPECT_EQ(descriptor->listening_ports[0], 5100u);
 }
 
 int main(int argc, char **argv)